@@ -29,4 +29,14 @@ void ScaleToFloat(const int16_t* src, int size, float* dest) {
     dest[i] = ScaleToFloat(src[i]);
 }
 
+void FloatToFloatS16(const float* src, int size, float* dest) {
+  for (int i = 0; i < size; ++i)
+    dest[i] = FloatToFloatS16(src[i]);
+}
+
+void FloatS16ToFloat(const float* src, int size, float* dest) {
+  for (int i = 0; i < size; ++i)
+    dest[i] = FloatS16ToFloat(src[i]);
+}
+
 }  // namespace VoIP
@@ -46,6 +46,20 @@ static inline float ScaleToFloat(int16_t v) {
   return v * (v > 0 ? kMaxInt16Inverse : -kMinInt16Inverse);
 }
 
+// Scale from [-1, 1] to the int16 range without rounding or clamping, i.e.
+// RoundToInt16(FloatToFloatS16(v)) == ScaleAndRoundToInt16(v).
+static inline float FloatToFloatS16(float v) {
+  return v * (v > 0 ? limits_int16::max() : -limits_int16::min());
+}
+
+// Scale from the int16 range to float [-1, 1]. For integral |v| this is the
+// same as ScaleToFloat().
+static inline float FloatS16ToFloat(float v) {
+  const float kMaxInt16Inverse = 1.f / limits_int16::max();
+  const float kMinInt16Inverse = 1.f / limits_int16::min();
+  return v * (v > 0 ? kMaxInt16Inverse : -kMinInt16Inverse);
+}
+
 // Round |size| elements of |src| to int16 with clamping and write to |dest|.
 void RoundToInt16(const float* src, int size, int16_t* dest);
 
@@ -56,6 +70,14 @@ void ScaleAndRoundToInt16(const float* src, int size, int16_t* dest);
 // Scale |size| elements of |src| to float [-1, 1] and write to |dest|.
 void ScaleToFloat(const int16_t* src, int size, float* dest);
 
+// Scale |size| elements of |src| from [-1, 1] to the int16 range and write to
+// |dest|.
+void FloatToFloatS16(const float* src, int size, float* dest);
+
+// Scale |size| elements of |src| from the int16 range to [-1, 1] and write to
+// |dest|.
+void FloatS16ToFloat(const float* src, int size, float* dest);
+
 // Deinterleave audio from |interleaved| to the channel buffers pointed to
 // by |deinterleaved|. There must be sufficient space allocated in the
 // |deinterleaved| buffers (|num_channel| buffers with |samples_per_channel|
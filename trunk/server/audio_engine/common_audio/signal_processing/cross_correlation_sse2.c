@@ -0,0 +1,66 @@
+/*
+ *  Copyright (c) 2014 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <emmintrin.h>
+
+#include "audio_engine/common_audio/signal_processing/include/signal_processing_library.h"
+
+static __inline int32_t HorizontalSumW32(__m128i sum) {
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+  return _mm_cvtsi128_si32(sum);
+}
+
+// Version of WebRtcSpl_CrossCorrelation() for x86 platforms with SSE2.
+// The output is bit-exact with WebRtcSpl_CrossCorrelationC(): each product is
+// shifted individually before it is accumulated, and the 32-bit sums wrap
+// around the same way.
+void WebRtcSpl_CrossCorrelationSSE2(int32_t* cross_correlation,
+                                    const int16_t* seq1,
+                                    const int16_t* seq2,
+                                    int16_t dim_seq,
+                                    int16_t dim_cross_correlation,
+                                    int16_t right_shifts,
+                                    int16_t step_seq2) {
+  int i = 0, j = 0;
+  const int blocks = dim_seq & ~7;
+  const __m128i shift = _mm_cvtsi32_si128(right_shifts);
+
+  for (i = 0; i < dim_cross_correlation; i++) {
+    const int16_t* seq2_ptr = &seq2[step_seq2 * i];
+    __m128i sum = _mm_setzero_si128();
+    int32_t tail = 0;
+
+    if (right_shifts == 0) {
+      // Without shifts, the pairwise sums of _mm_madd_epi16() are exact.
+      for (j = 0; j < blocks; j += 8) {
+        const __m128i a = _mm_loadu_si128((const __m128i*)&seq1[j]);
+        const __m128i b = _mm_loadu_si128((const __m128i*)&seq2_ptr[j]);
+        sum = _mm_add_epi32(sum, _mm_madd_epi16(a, b));
+      }
+    } else {
+      for (j = 0; j < blocks; j += 8) {
+        const __m128i a = _mm_loadu_si128((const __m128i*)&seq1[j]);
+        const __m128i b = _mm_loadu_si128((const __m128i*)&seq2_ptr[j]);
+        const __m128i lo = _mm_mullo_epi16(a, b);
+        const __m128i hi = _mm_mulhi_epi16(a, b);
+        // Full 32-bit products of elements 0-3 and 4-7.
+        const __m128i p0 = _mm_unpacklo_epi16(lo, hi);
+        const __m128i p1 = _mm_unpackhi_epi16(lo, hi);
+        sum = _mm_add_epi32(sum, _mm_sra_epi32(p0, shift));
+        sum = _mm_add_epi32(sum, _mm_sra_epi32(p1, shift));
+      }
+    }
+    for (; j < dim_seq; j++) {
+      tail += (seq1[j] * seq2_ptr[j]) >> right_shifts;
+    }
+    *cross_correlation++ = HorizontalSumW32(sum) + tail;
+  }
+}
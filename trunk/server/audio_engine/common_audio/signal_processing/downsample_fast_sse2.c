@@ -0,0 +1,98 @@
+/*
+ *  Copyright (c) 2014 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <emmintrin.h>
+
+#include "audio_engine/common_audio/signal_processing/include/signal_processing_library.h"
+
+// Longest filter handled by the vectorized loop. All filters used in the
+// code base are much shorter.
+#define MAX_COEFFICIENTS_LENGTH 64
+
+// Version of WebRtcSpl_DownsampleFast() for x86 platforms with SSE2.
+// The filter taps are reversed and zero padded to a multiple of eight, so that
+// each output sample becomes a dot product of contiguous vectors. The result is
+// bit-exact with WebRtcSpl_DownsampleFastC().
+int WebRtcSpl_DownsampleFastSSE2(const int16_t* data_in,
+                                 int data_in_length,
+                                 int16_t* data_out,
+                                 int data_out_length,
+                                 const int16_t* __restrict coefficients,
+                                 int coefficients_length,
+                                 int factor,
+                                 int delay) {
+  int i = 0;
+  int j = 0;
+  int32_t out_s32 = 0;
+  int endpos = delay + factor * (data_out_length - 1) + 1;
+  int padded_length = (coefficients_length + 7) & ~7;
+  int vector_endpos = 0;
+  __m128i sum;
+  // Reversed and zero padded |coefficients|. 16-byte aligned.
+  int16_t reversed_memory[MAX_COEFFICIENTS_LENGTH + 8];
+  int16_t* reversed = (int16_t*)(((uintptr_t)reversed_memory + 15) & ~15);
+
+  // Return error if any of the running conditions doesn't meet.
+  if (data_out_length <= 0 || coefficients_length <= 0
+                           || data_in_length < endpos) {
+    return -1;
+  }
+  if (coefficients_length > MAX_COEFFICIENTS_LENGTH) {
+    return WebRtcSpl_DownsampleFastC(data_in, data_in_length, data_out,
+                                     data_out_length, coefficients,
+                                     coefficients_length, factor, delay);
+  }
+
+  for (j = 0; j < coefficients_length; j++) {
+    reversed[j] = coefficients[coefficients_length - 1 - j];
+  }
+  for (; j < padded_length; j++) {
+    reversed[j] = 0;
+  }
+
+  // The padded dot product for output index |i| reads
+  // data_in[i - coefficients_length + 1 .. i - coefficients_length +
+  // padded_length], which must stay inside |data_in|.
+  vector_endpos = WEBRTC_SPL_MIN(
+      endpos, data_in_length - padded_length + coefficients_length);
+
+  for (i = delay; i < vector_endpos; i += factor) {
+    const int16_t* data_ptr = &data_in[i - coefficients_length + 1];
+    sum = _mm_setzero_si128();
+    for (j = 0; j < padded_length; j += 8) {
+      const __m128i c = _mm_load_si128((const __m128i*)&reversed[j]);
+      const __m128i d = _mm_loadu_si128((const __m128i*)&data_ptr[j]);
+      sum = _mm_add_epi32(sum, _mm_madd_epi16(c, d));
+    }
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+    out_s32 = 2048 + _mm_cvtsi128_si32(sum);  // Round value, 0.5 in Q12.
+    out_s32 >>= 12;  // Q0.
+
+    // Saturate and store the output.
+    *data_out++ = WebRtcSpl_SatW32ToW16(out_s32);
+  }
+
+  // Remaining outputs near the end of |data_in|.
+  for (; i < endpos; i += factor) {
+    out_s32 = 2048;  // Round value, 0.5 in Q12.
+
+    for (j = 0; j < coefficients_length; j++) {
+      out_s32 += coefficients[j] * data_in[i - j];  // Q12.
+    }
+
+    out_s32 >>= 12;  // Q0.
+
+    // Saturate and store the output.
+    *data_out++ = WebRtcSpl_SatW32ToW16(out_s32);
+  }
+
+  return 0;
+}
@@ -17,11 +17,11 @@
 
 #include "audio_engine/common_audio/signal_processing/include/signal_processing_library.h"
 
-void WebRtcSpl_FilterMAFastQ12(int16_t* in_ptr,
-                               int16_t* out_ptr,
-                               int16_t* B,
-                               int16_t B_length,
-                               int16_t length)
+void WebRtcSpl_FilterMAFastQ12C(int16_t* in_ptr,
+                                int16_t* out_ptr,
+                                int16_t* B,
+                                int16_t B_length,
+                                int16_t length)
 {
     int32_t o;
     int i, j;
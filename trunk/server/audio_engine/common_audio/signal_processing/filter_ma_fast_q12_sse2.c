@@ -0,0 +1,77 @@
+/*
+ *  Copyright (c) 2014 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <emmintrin.h>
+
+#include "audio_engine/common_audio/signal_processing/include/signal_processing_library.h"
+
+// Version of WebRtcSpl_FilterMAFastQ12() for x86 platforms with SSE2.
+// Eight output samples are filtered at a time. Two taps are applied per
+// _mm_madd_epi16() by interleaving the input delayed by j and j + 1 samples.
+// The 32-bit sums wrap around the same way as in WebRtcSpl_FilterMAFastQ12C(),
+// so the result is bit-exact.
+void WebRtcSpl_FilterMAFastQ12SSE2(int16_t* in_ptr,
+                                   int16_t* out_ptr,
+                                   int16_t* B,
+                                   int16_t B_length,
+                                   int16_t length) {
+  const __m128i kMax = _mm_set1_epi32(134215679);
+  const __m128i kMin = _mm_set1_epi32(-134217728);
+  const __m128i kRound = _mm_set1_epi32(2048);
+  const __m128i zero = _mm_setzero_si128();
+  int i = 0, j = 0;
+
+  for (i = 0; i + 8 <= length; i += 8) {
+    __m128i sum_lo = _mm_setzero_si128();
+    __m128i sum_hi = _mm_setzero_si128();
+    __m128i mask;
+
+    for (j = 0; j + 2 <= B_length; j += 2) {
+      const __m128i x0 = _mm_loadu_si128((const __m128i*)&in_ptr[i - j]);
+      const __m128i x1 = _mm_loadu_si128((const __m128i*)&in_ptr[i - j - 1]);
+      const __m128i b = _mm_set1_epi32((uint16_t)B[j] | (B[j + 1] << 16));
+      sum_lo = _mm_add_epi32(sum_lo,
+                             _mm_madd_epi16(_mm_unpacklo_epi16(x0, x1), b));
+      sum_hi = _mm_add_epi32(sum_hi,
+                             _mm_madd_epi16(_mm_unpackhi_epi16(x0, x1), b));
+    }
+    if (j < B_length) {
+      // The last tap of an odd length filter is paired with zero.
+      const __m128i x0 = _mm_loadu_si128((const __m128i*)&in_ptr[i - j]);
+      const __m128i b = _mm_set1_epi32((uint16_t)B[j]);
+      sum_lo = _mm_add_epi32(sum_lo,
+                             _mm_madd_epi16(_mm_unpacklo_epi16(x0, zero), b));
+      sum_hi = _mm_add_epi32(sum_hi,
+                             _mm_madd_epi16(_mm_unpackhi_epi16(x0, zero), b));
+    }
+
+    // Saturate to the Q12 range of an int16_t, round and pack.
+    mask = _mm_cmpgt_epi32(sum_lo, kMax);
+    sum_lo = _mm_or_si128(_mm_and_si128(mask, kMax),
+                          _mm_andnot_si128(mask, sum_lo));
+    mask = _mm_cmplt_epi32(sum_lo, kMin);
+    sum_lo = _mm_or_si128(_mm_and_si128(mask, kMin),
+                          _mm_andnot_si128(mask, sum_lo));
+    mask = _mm_cmpgt_epi32(sum_hi, kMax);
+    sum_hi = _mm_or_si128(_mm_and_si128(mask, kMax),
+                          _mm_andnot_si128(mask, sum_hi));
+    mask = _mm_cmplt_epi32(sum_hi, kMin);
+    sum_hi = _mm_or_si128(_mm_and_si128(mask, kMin),
+                          _mm_andnot_si128(mask, sum_hi));
+    sum_lo = _mm_srai_epi32(_mm_add_epi32(sum_lo, kRound), 12);
+    sum_hi = _mm_srai_epi32(_mm_add_epi32(sum_hi, kRound), 12);
+    _mm_storeu_si128((__m128i*)&out_ptr[i], _mm_packs_epi32(sum_lo, sum_hi));
+  }
+
+  if (i < length) {
+    WebRtcSpl_FilterMAFastQ12C(&in_ptr[i], &out_ptr[i], B, B_length,
+                               (int16_t)(length - i));
+  }
+}
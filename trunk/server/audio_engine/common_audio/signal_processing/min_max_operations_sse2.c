@@ -0,0 +1,221 @@
+/*
+ *  Copyright (c) 2014 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+/*
+ * This file contains the SSE2 implementations of the functions
+ * WebRtcSpl_MaxAbsValueW16()
+ * WebRtcSpl_MaxAbsValueW32()
+ * WebRtcSpl_MaxValueW16()
+ * WebRtcSpl_MaxValueW32()
+ * WebRtcSpl_MinValueW16()
+ * WebRtcSpl_MinValueW32()
+ *
+ * The description header can be found in signal_processing_library.h.
+ * The results are identical to the generic C versions.
+ */
+
+#include <emmintrin.h>
+#include <stdlib.h>
+
+#include "audio_engine/common_audio/signal_processing/include/signal_processing_library.h"
+
+// Selects the larger of |a| and |b| in each 32-bit lane. SSE2 has no
+// _mm_max_epi32().
+static __inline __m128i MaxW32(__m128i a, __m128i b) {
+  const __m128i a_greater = _mm_cmpgt_epi32(a, b);
+  return _mm_or_si128(_mm_and_si128(a_greater, a),
+                      _mm_andnot_si128(a_greater, b));
+}
+
+static __inline __m128i MinW32(__m128i a, __m128i b) {
+  const __m128i a_greater = _mm_cmpgt_epi32(a, b);
+  return _mm_or_si128(_mm_and_si128(a_greater, b),
+                      _mm_andnot_si128(a_greater, a));
+}
+
+// Reduces the eight 16-bit lanes of |max_values| and |min_values|.
+static __inline void ReduceW16(__m128i* max_values, __m128i* min_values) {
+  __m128i shuffled = _mm_shuffle_epi32(*max_values, _MM_SHUFFLE(1, 0, 3, 2));
+  *max_values = _mm_max_epi16(*max_values, shuffled);
+  shuffled = _mm_shuffle_epi32(*max_values, _MM_SHUFFLE(2, 3, 0, 1));
+  *max_values = _mm_max_epi16(*max_values, shuffled);
+  *max_values = _mm_max_epi16(*max_values, _mm_srli_epi32(*max_values, 16));
+  shuffled = _mm_shuffle_epi32(*min_values, _MM_SHUFFLE(1, 0, 3, 2));
+  *min_values = _mm_min_epi16(*min_values, shuffled);
+  shuffled = _mm_shuffle_epi32(*min_values, _MM_SHUFFLE(2, 3, 0, 1));
+  *min_values = _mm_min_epi16(*min_values, shuffled);
+  *min_values = _mm_min_epi16(*min_values, _mm_srli_epi32(*min_values, 16));
+}
+
+// Finds the largest and smallest element of |vector|.
+static void MaxMinW16(const int16_t* vector, int length,
+                      int16_t* maximum, int16_t* minimum) {
+  int i = 0;
+  int16_t max_value = WEBRTC_SPL_WORD16_MIN;
+  int16_t min_value = WEBRTC_SPL_WORD16_MAX;
+  __m128i max_values = _mm_set1_epi16(WEBRTC_SPL_WORD16_MIN);
+  __m128i min_values = _mm_set1_epi16(WEBRTC_SPL_WORD16_MAX);
+
+  if (length >= 8) {
+    for (i = 0; i + 8 <= length; i += 8) {
+      const __m128i v = _mm_loadu_si128((const __m128i*)&vector[i]);
+      max_values = _mm_max_epi16(max_values, v);
+      min_values = _mm_min_epi16(min_values, v);
+    }
+    ReduceW16(&max_values, &min_values);
+    max_value = (int16_t)_mm_cvtsi128_si32(max_values);
+    min_value = (int16_t)_mm_cvtsi128_si32(min_values);
+  }
+  for (; i < length; i++) {
+    if (vector[i] > max_value)
+      max_value = vector[i];
+    if (vector[i] < min_value)
+      min_value = vector[i];
+  }
+  *maximum = max_value;
+  *minimum = min_value;
+}
+
+// Maximum absolute value of word16 vector.
+int16_t WebRtcSpl_MaxAbsValueW16SSE2(const int16_t* vector, int length) {
+  int16_t max_value = 0;
+  int16_t min_value = 0;
+  int maximum = 0;
+
+  if (vector == NULL || length <= 0) {
+    return -1;
+  }
+
+  MaxMinW16(vector, length, &max_value, &min_value);
+  maximum = WEBRTC_SPL_MAX(abs((int)max_value), abs((int)min_value));
+
+  // Guard the case for abs(-32768).
+  if (maximum > WEBRTC_SPL_WORD16_MAX) {
+    maximum = WEBRTC_SPL_WORD16_MAX;
+  }
+
+  return (int16_t)maximum;
+}
+
+// Maximum absolute value of word32 vector.
+int32_t WebRtcSpl_MaxAbsValueW32SSE2(const int32_t* vector, int length) {
+  // Use uint32_t for the local variables, to accommodate the return value
+  // of abs(0x80000000), which is 0x80000000.
+  uint32_t absolute = 0, maximum = 0;
+  uint32_t lanes[4];
+  int i = 0;
+  // Unsigned comparisons are done as signed comparisons with the sign bit
+  // flipped.
+  const __m128i sign_bit = _mm_set1_epi32((int32_t)0x80000000);
+  __m128i max_values = sign_bit;
+
+  if (vector == NULL || length <= 0) {
+    return -1;
+  }
+
+  for (i = 0; i + 4 <= length; i += 4) {
+    const __m128i v = _mm_loadu_si128((const __m128i*)&vector[i]);
+    const __m128i sign = _mm_srai_epi32(v, 31);
+    const __m128i abs_v = _mm_sub_epi32(_mm_xor_si128(v, sign), sign);
+    max_values = MaxW32(max_values, _mm_xor_si128(abs_v, sign_bit));
+  }
+  _mm_storeu_si128((__m128i*)lanes, _mm_xor_si128(max_values, sign_bit));
+  maximum = WEBRTC_SPL_MAX(WEBRTC_SPL_MAX(lanes[0], lanes[1]),
+                           WEBRTC_SPL_MAX(lanes[2], lanes[3]));
+
+  for (; i < length; i++) {
+    absolute = abs((int)vector[i]);
+    if (absolute > maximum) {
+      maximum = absolute;
+    }
+  }
+
+  maximum = WEBRTC_SPL_MIN(maximum, WEBRTC_SPL_WORD32_MAX);
+
+  return (int32_t)maximum;
+}
+
+// Maximum value of word16 vector.
+int16_t WebRtcSpl_MaxValueW16SSE2(const int16_t* vector, int length) {
+  int16_t maximum = WEBRTC_SPL_WORD16_MIN;
+  int16_t minimum = WEBRTC_SPL_WORD16_MAX;
+
+  if (vector == NULL || length <= 0) {
+    return maximum;
+  }
+
+  MaxMinW16(vector, length, &maximum, &minimum);
+  return maximum;
+}
+
+// Maximum value of word32 vector.
+int32_t WebRtcSpl_MaxValueW32SSE2(const int32_t* vector, int length) {
+  int32_t maximum = WEBRTC_SPL_WORD32_MIN;
+  int32_t lanes[4];
+  int i = 0;
+  __m128i max_values = _mm_set1_epi32(WEBRTC_SPL_WORD32_MIN);
+
+  if (vector == NULL || length <= 0) {
+    return maximum;
+  }
+
+  for (i = 0; i + 4 <= length; i += 4) {
+    max_values = MaxW32(max_values,
+                        _mm_loadu_si128((const __m128i*)&vector[i]));
+  }
+  _mm_storeu_si128((__m128i*)lanes, max_values);
+  maximum = WEBRTC_SPL_MAX(WEBRTC_SPL_MAX(lanes[0], lanes[1]),
+                           WEBRTC_SPL_MAX(lanes[2], lanes[3]));
+
+  for (; i < length; i++) {
+    if (vector[i] > maximum)
+      maximum = vector[i];
+  }
+  return maximum;
+}
+
+// Minimum value of word16 vector.
+int16_t WebRtcSpl_MinValueW16SSE2(const int16_t* vector, int length) {
+  int16_t maximum = WEBRTC_SPL_WORD16_MIN;
+  int16_t minimum = WEBRTC_SPL_WORD16_MAX;
+
+  if (vector == NULL || length <= 0) {
+    return minimum;
+  }
+
+  MaxMinW16(vector, length, &maximum, &minimum);
+  return minimum;
+}
+
+// Minimum value of word32 vector.
+int32_t WebRtcSpl_MinValueW32SSE2(const int32_t* vector, int length) {
+  int32_t minimum = WEBRTC_SPL_WORD32_MAX;
+  int32_t lanes[4];
+  int i = 0;
+  __m128i min_values = _mm_set1_epi32(WEBRTC_SPL_WORD32_MAX);
+
+  if (vector == NULL || length <= 0) {
+    return minimum;
+  }
+
+  for (i = 0; i + 4 <= length; i += 4) {
+    min_values = MinW32(min_values,
+                        _mm_loadu_si128((const __m128i*)&vector[i]));
+  }
+  _mm_storeu_si128((__m128i*)lanes, min_values);
+  minimum = WEBRTC_SPL_MIN(WEBRTC_SPL_MIN(lanes[0], lanes[1]),
+                           WEBRTC_SPL_MIN(lanes[2], lanes[3]));
+
+  for (; i < length; i++) {
+    if (vector[i] < minimum)
+      minimum = vector[i];
+  }
+  return minimum;
+}
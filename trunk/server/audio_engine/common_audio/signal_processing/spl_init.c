@@ -9,7 +9,7 @@
  */
 
 /* The global function contained in this file initializes SPL function
- * pointers, currently only for ARM platforms.
+ * pointers, currently for ARM, MIPS and x86 platforms.
  *
  * Some code came from common/rtcd.c in the WebM project.
  */
@@ -27,6 +27,7 @@ MinValueW16 WebRtcSpl_MinValueW16;
 MinValueW32 WebRtcSpl_MinValueW32;
 CrossCorrelation WebRtcSpl_CrossCorrelation;
 DownsampleFast WebRtcSpl_DownsampleFast;
+FilterMAFastQ12 WebRtcSpl_FilterMAFastQ12;
 ScaleAndAddVectorsWithRound WebRtcSpl_ScaleAndAddVectorsWithRound;
 CreateRealFFT WebRtcSpl_CreateRealFFT;
 FreeRealFFT WebRtcSpl_FreeRealFFT;
@@ -34,7 +35,8 @@ RealForwardFFT WebRtcSpl_RealForwardFFT;
 RealInverseFFT WebRtcSpl_RealInverseFFT;
 
 #if (defined(WEBRTC_DETECT_ARM_NEON) || !defined(VOIP_ARCH_ARM_NEON)) && \
-     !defined(MIPS32_LE)
+     !defined(MIPS32_LE) && \
+     !(defined(VOIP_ARCH_X86_FAMILY) && defined(__SSE2__))
 /* Initialize function pointers to the generic C version. */
 static void InitPointersToC() {
   WebRtcSpl_MaxAbsValueW16 = WebRtcSpl_MaxAbsValueW16C;
@@ -45,6 +47,7 @@ static void InitPointersToC() {
   WebRtcSpl_MinValueW32 = WebRtcSpl_MinValueW32C;
   WebRtcSpl_CrossCorrelation = WebRtcSpl_CrossCorrelationC;
   WebRtcSpl_DownsampleFast = WebRtcSpl_DownsampleFastC;
+  WebRtcSpl_FilterMAFastQ12 = WebRtcSpl_FilterMAFastQ12C;
   WebRtcSpl_ScaleAndAddVectorsWithRound =
       WebRtcSpl_ScaleAndAddVectorsWithRoundC;
   WebRtcSpl_CreateRealFFT = WebRtcSpl_CreateRealFFTC;
@@ -65,6 +68,7 @@ static void InitPointersToNeon() {
   WebRtcSpl_MinValueW32 = WebRtcSpl_MinValueW32Neon;
   WebRtcSpl_CrossCorrelation = WebRtcSpl_CrossCorrelationNeon;
   WebRtcSpl_DownsampleFast = WebRtcSpl_DownsampleFastNeon;
+  WebRtcSpl_FilterMAFastQ12 = WebRtcSpl_FilterMAFastQ12C;
   WebRtcSpl_ScaleAndAddVectorsWithRound =
       WebRtcSpl_ScaleAndAddVectorsWithRoundNeon;
   WebRtcSpl_CreateRealFFT = WebRtcSpl_CreateRealFFTNeon;
@@ -74,6 +78,27 @@ static void InitPointersToNeon() {
 }
 #endif
 
+#if defined(VOIP_ARCH_X86_FAMILY)
+/* Initialize function pointers to the SSE2 version. */
+static void InitPointersToSSE2() {
+  WebRtcSpl_MaxAbsValueW16 = WebRtcSpl_MaxAbsValueW16SSE2;
+  WebRtcSpl_MaxAbsValueW32 = WebRtcSpl_MaxAbsValueW32SSE2;
+  WebRtcSpl_MaxValueW16 = WebRtcSpl_MaxValueW16SSE2;
+  WebRtcSpl_MaxValueW32 = WebRtcSpl_MaxValueW32SSE2;
+  WebRtcSpl_MinValueW16 = WebRtcSpl_MinValueW16SSE2;
+  WebRtcSpl_MinValueW32 = WebRtcSpl_MinValueW32SSE2;
+  WebRtcSpl_CrossCorrelation = WebRtcSpl_CrossCorrelationSSE2;
+  WebRtcSpl_DownsampleFast = WebRtcSpl_DownsampleFastSSE2;
+  WebRtcSpl_FilterMAFastQ12 = WebRtcSpl_FilterMAFastQ12SSE2;
+  WebRtcSpl_ScaleAndAddVectorsWithRound =
+      WebRtcSpl_ScaleAndAddVectorsWithRoundSSE2;
+  WebRtcSpl_CreateRealFFT = WebRtcSpl_CreateRealFFTC;
+  WebRtcSpl_FreeRealFFT = WebRtcSpl_FreeRealFFTC;
+  WebRtcSpl_RealForwardFFT = WebRtcSpl_RealForwardFFTC;
+  WebRtcSpl_RealInverseFFT = WebRtcSpl_RealInverseFFTC;
+}
+#endif
+
 #if defined(MIPS32_LE)
 /* Initialize function pointers to the MIPS version. */
 static void InitPointersToMIPS() {
@@ -84,6 +109,7 @@ static void InitPointersToMIPS() {
   WebRtcSpl_MinValueW32 = WebRtcSpl_MinValueW32_mips;
   WebRtcSpl_CrossCorrelation = WebRtcSpl_CrossCorrelation_mips;
   WebRtcSpl_DownsampleFast = WebRtcSpl_DownsampleFast_mips;
+  WebRtcSpl_FilterMAFastQ12 = WebRtcSpl_FilterMAFastQ12C;
   WebRtcSpl_CreateRealFFT = WebRtcSpl_CreateRealFFTC;
   WebRtcSpl_FreeRealFFT = WebRtcSpl_FreeRealFFTC;
   WebRtcSpl_RealForwardFFT = WebRtcSpl_RealForwardFFTC;
@@ -111,6 +137,14 @@ static void InitFunctionPointers(void) {
   InitPointersToNeon();
 #elif defined(MIPS32_LE)
   InitPointersToMIPS();
+#elif defined(VOIP_ARCH_X86_FAMILY) && defined(__SSE2__)
+  InitPointersToSSE2();
+#elif defined(VOIP_ARCH_X86_FAMILY)
+  if (WebRtc_GetCPUInfo(kSSE2)) {
+    InitPointersToSSE2();
+  } else {
+    InitPointersToC();
+  }
 #else
   InitPointersToC();
 #endif  /* WEBRTC_DETECT_ARM_NEON */
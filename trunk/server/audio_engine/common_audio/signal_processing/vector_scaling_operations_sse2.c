@@ -0,0 +1,59 @@
+/*
+ *  Copyright (c) 2014 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <emmintrin.h>
+
+#include "audio_engine/common_audio/signal_processing/include/signal_processing_library.h"
+
+// SSE2 version of WebRtcSpl_ScaleAndAddVectorsWithRound() for x86 platforms.
+// Bit-exact with WebRtcSpl_ScaleAndAddVectorsWithRoundC(), including the
+// truncation (not saturation) of the result to 16 bits.
+int WebRtcSpl_ScaleAndAddVectorsWithRoundSSE2(const int16_t* in_vector1,
+                                              int16_t in_vector1_scale,
+                                              const int16_t* in_vector2,
+                                              int16_t in_vector2_scale,
+                                              int right_shifts,
+                                              int16_t* out_vector,
+                                              int length) {
+  int i = 0;
+  int round_value = (1 << right_shifts) >> 1;
+  // Interleaved (scale1, scale2) pairs for _mm_madd_epi16().
+  const __m128i scales = _mm_set1_epi32(
+      ((int32_t)in_vector2_scale << 16) | (uint16_t)in_vector1_scale);
+  const __m128i round = _mm_set1_epi32(round_value);
+  const __m128i shift = _mm_cvtsi32_si128(right_shifts);
+
+  if (in_vector1 == NULL || in_vector2 == NULL || out_vector == NULL ||
+      length <= 0 || right_shifts < 0) {
+    return -1;
+  }
+
+  for (i = 0; i + 8 <= length; i += 8) {
+    const __m128i a = _mm_loadu_si128((const __m128i*)&in_vector1[i]);
+    const __m128i b = _mm_loadu_si128((const __m128i*)&in_vector2[i]);
+    __m128i lo = _mm_madd_epi16(_mm_unpacklo_epi16(a, b), scales);
+    __m128i hi = _mm_madd_epi16(_mm_unpackhi_epi16(a, b), scales);
+    lo = _mm_sra_epi32(_mm_add_epi32(lo, round), shift);
+    hi = _mm_sra_epi32(_mm_add_epi32(hi, round), shift);
+    // Keep the low 16 bits, sign extended, so that the pack does not
+    // saturate.
+    lo = _mm_srai_epi32(_mm_slli_epi32(lo, 16), 16);
+    hi = _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16);
+    _mm_storeu_si128((__m128i*)&out_vector[i], _mm_packs_epi32(lo, hi));
+  }
+  for (; i < length; i++) {
+    out_vector[i] = (int16_t)((
+        WEBRTC_SPL_MUL_16_16(in_vector1[i], in_vector1_scale)
+        + WEBRTC_SPL_MUL_16_16(in_vector2[i], in_vector2_scale)
+        + round_value) >> right_shifts);
+  }
+
+  return 0;
+}
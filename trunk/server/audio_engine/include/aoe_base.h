@@ -51,7 +51,10 @@ class VOIP_DLLEXPORT AudioEngine
 {
 public:
     // Creates a AudioEngine object, which can then be used to acquire
-    // sub-APIs. Returns NULL on failure.
+    // sub-APIs. Returns NULL on failure. Channels use the legacy audio coding
+    // module unless |config| sets NewAudioCodingModuleFactory, which selects
+    // the new one (acm2) that lazy decoders, unheard mode and Opus
+    // complexity control need.
     static AudioEngine* Create();
     static AudioEngine* Create(const Config& config);
 
@@ -155,6 +158,32 @@ public:
     // Gets the last AudioEngine error code.
     virtual int LastError() = 0;
 
+    // Encodes the sending channels on |numThreads| worker threads in addition
+    // to the capture thread. Each 10 ms frame is still fully encoded and sent
+    // before the capture callback returns. 0 (the default) encodes all
+    // channels on the capture thread. Only enable this if the Transport of
+    // every channel can be called from several threads at once.
+    virtual int SetEncodeThreads(int numThreads) = 0;
+
+    // Gets the number of encode worker threads.
+    virtual int GetEncodeThreads(int& numThreads) = 0;
+
+    // Enables or disables overload protection. When enabled, the engine
+    // watches the time spent on each 10 ms capture and playout tick and,
+    // while the ticks come close to overrunning, degrades quality step by
+    // step (see LoadSheddingLevels) rather than producing audio gaps. Steps
+    // are undone once the load has stayed low for a while. Each change is
+    // reported to the AudioEngineObserver as VE_LOAD_SHEDDING_WARNING (level
+    // raised) or VE_LOAD_SHEDDING_REDUCED_WARNING (level lowered). Disabled
+    // by default; disabling undoes all steps. The concealment and encoder
+    // steps need the new audio coding module (see Create()); while a channel
+    // uses the legacy one, the level stops at kLoadSheddingMixing.
+    virtual int SetLoadShedding(bool enable) = 0;
+
+    // Gets the overload protection status and the current degradation level.
+    virtual int GetLoadSheddingStatus(bool& enabled,
+                                      LoadSheddingLevels& level) = 0;
+
     virtual AudioTransport* audio_transport() { return NULL; }
 
 protected:
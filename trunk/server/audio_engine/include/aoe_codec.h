@@ -71,6 +71,34 @@ public:
     // Gets |codec| which is used as secondary codec in |channel|.
     virtual int GetSecondarySendCodec(int channel, CodecInst& codec) = 0;
 
+    // Limits the time all Opus encoders of the engine together may spend
+    // encoding to |cpuPercent| percent of one CPU core, by lowering their
+    // complexity while the budget is exceeded and raising it again when there
+    // is headroom. With |perStream| each sending channel is held to an equal
+    // share of the budget, otherwise all channels use the same complexity.
+    // 0 (default) disables the budget. Only channels on the new audio coding
+    // module are controlled, see AudioEngine::Create().
+    virtual int SetOpusComplexityBudget(int cpuPercent, bool perStream) = 0;
+
+    // Gets the complexity currently used by the send codec of |channel| and
+    // the encode time it was chosen from.
+    virtual int GetEncodingStatistics(int channel,
+                                      AudioEncodingStats& stats) = 0;
+
+    // Creates |numInstances| encoder and decoder instances of |codec| ahead
+    // of a burst of channel setups, so that setting it as send codec or
+    // receiving it on a new channel does not allocate and initialize codec
+    // state. Instances freed by deleted channels and codec changes are kept
+    // for reuse as well, at least |numInstances| per codec.
+    virtual int PrewarmCodecPool(const CodecInst& codec, int numInstances) = 0;
+
+    // Deletes the decoders of |channel| once it has received nothing for
+    // |timeoutMs| milliseconds, to save memory on idle channels. A decoder is
+    // created again by the next packet of its payload type. 0 (default) keeps
+    // decoders for the lifetime of the channel. Needs the new audio coding
+    // module, see AudioEngine::Create().
+    virtual int SetDecoderIdleTimeout(int channel, int timeoutMs) = 0;
+
     // Gets the currently received |codec| for a specific |channel|.
     virtual int GetRecCodec(int channel, CodecInst& codec) = 0;
 
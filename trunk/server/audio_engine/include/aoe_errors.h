@@ -79,6 +79,8 @@
 #define VE_CANNOT_GET_SECONDARY_SEND_CODEC 8114
 #define VE_CANNOT_REMOVE_SECONDARY_SEND_CODEC 8115
 #define VE_TYPING_NOISE_OFF_WARNING 8116
+#define VE_LOAD_SHEDDING_WARNING 8117
+#define VE_LOAD_SHEDDING_REDUCED_WARNING 8118
 
 // Errors causing limited functionality
 #define VE_RTCP_SOCKET_ERROR 9001
@@ -362,6 +362,21 @@ struct AudioDecodingCallStats {
   int decoded_plc_cng;  // Number of calls resulted where PLC faded to CNG.
 };
 
+// Statistics for the encoder of the send codec, see
+// AudioCodingModule::GetEncodingStatistics().
+struct AudioEncodingStats {
+  AudioEncodingStats()
+      : complexity(-1),
+        max_complexity(-1),
+        complexity_changes(0),
+        encode_time_us(-1) {}
+
+  int complexity;  // Current encoder complexity, -1 if not adjustable.
+  int max_complexity;  // Complexity used when the CPU budget allows it.
+  int complexity_changes;  // Adjustments made by the complexity controller.
+  int encode_time_us;  // Encode time per 10 ms of audio, -1 if not measured.
+};
+
 typedef struct
 {
     int min;              // minumum
@@ -482,6 +497,15 @@ enum OnHoldModes            // On Hold direction
     kHoldPlayOnly            // Put only playing in on-hold state.
 };
 
+enum LoadSheddingLevels     // Quality degradation steps taken on overload;
+{                           // each level includes the ones below it.
+    kLoadSheddingOff = 0,
+    kLoadSheddingRxProcessing,  // No receive NS/AGC on non-speaking channels.
+    kLoadSheddingMixing,        // Fewer participants are mixed.
+    kLoadSheddingConcealment,   // Cheap loss concealment for unmixed channels.
+    kLoadSheddingEncoder        // Lower Opus encoder complexity.
+};
+
 // TODO(henrika): to be removed.
 enum AmrMode
 {
@@ -12,13 +12,205 @@
 #include "g711_interface.h"
 #include "include/typedefs.h"
 
+// SSE2 is part of the x86-64 baseline; on 32-bit x86 it is only used when the
+// compiler is allowed to assume it.
+#if defined(VOIP_ARCH_X86_64) || defined(__SSE2__) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define G711_SSE2
+#include <emmintrin.h>
+#endif
+
+// The payload is one byte per sample, in sample order, on both big and little
+// endian machines. The kernels below write it byte by byte; when the number
+// of samples is odd, the unused half of the last word is set to zero.
+
+// alaw_to_linear() and ulaw_to_linear() for all code words.
+static const int16_t kAlawToLinear[256] = {
+   -5504,  -5248,  -6016,  -5760,  -4480,  -4224,  -4992,  -4736,
+   -7552,  -7296,  -8064,  -7808,  -6528,  -6272,  -7040,  -6784,
+   -2752,  -2624,  -3008,  -2880,  -2240,  -2112,  -2496,  -2368,
+   -3776,  -3648,  -4032,  -3904,  -3264,  -3136,  -3520,  -3392,
+  -22016, -20992, -24064, -23040, -17920, -16896, -19968, -18944,
+  -30208, -29184, -32256, -31232, -26112, -25088, -28160, -27136,
+  -11008, -10496, -12032, -11520,  -8960,  -8448,  -9984,  -9472,
+  -15104, -14592, -16128, -15616, -13056, -12544, -14080, -13568,
+    -344,   -328,   -376,   -360,   -280,   -264,   -312,   -296,
+    -472,   -456,   -504,   -488,   -408,   -392,   -440,   -424,
+     -88,    -72,   -120,   -104,    -24,     -8,    -56,    -40,
+    -216,   -200,   -248,   -232,   -152,   -136,   -184,   -168,
+   -1376,  -1312,  -1504,  -1440,  -1120,  -1056,  -1248,  -1184,
+   -1888,  -1824,  -2016,  -1952,  -1632,  -1568,  -1760,  -1696,
+    -688,   -656,   -752,   -720,   -560,   -528,   -624,   -592,
+    -944,   -912,  -1008,   -976,   -816,   -784,   -880,   -848,
+    5504,   5248,   6016,   5760,   4480,   4224,   4992,   4736,
+    7552,   7296,   8064,   7808,   6528,   6272,   7040,   6784,
+    2752,   2624,   3008,   2880,   2240,   2112,   2496,   2368,
+    3776,   3648,   4032,   3904,   3264,   3136,   3520,   3392,
+   22016,  20992,  24064,  23040,  17920,  16896,  19968,  18944,
+   30208,  29184,  32256,  31232,  26112,  25088,  28160,  27136,
+   11008,  10496,  12032,  11520,   8960,   8448,   9984,   9472,
+   15104,  14592,  16128,  15616,  13056,  12544,  14080,  13568,
+     344,    328,    376,    360,    280,    264,    312,    296,
+     472,    456,    504,    488,    408,    392,    440,    424,
+      88,     72,    120,    104,     24,      8,     56,     40,
+     216,    200,    248,    232,    152,    136,    184,    168,
+    1376,   1312,   1504,   1440,   1120,   1056,   1248,   1184,
+    1888,   1824,   2016,   1952,   1632,   1568,   1760,   1696,
+     688,    656,    752,    720,    560,    528,    624,    592,
+     944,    912,   1008,    976,    816,    784,    880,    848
+};
+
+static const int16_t kUlawToLinear[256] = {
+  -32124, -31100, -30076, -29052, -28028, -27004, -25980, -24956,
+  -23932, -22908, -21884, -20860, -19836, -18812, -17788, -16764,
+  -15996, -15484, -14972, -14460, -13948, -13436, -12924, -12412,
+  -11900, -11388, -10876, -10364,  -9852,  -9340,  -8828,  -8316,
+   -7932,  -7676,  -7420,  -7164,  -6908,  -6652,  -6396,  -6140,
+   -5884,  -5628,  -5372,  -5116,  -4860,  -4604,  -4348,  -4092,
+   -3900,  -3772,  -3644,  -3516,  -3388,  -3260,  -3132,  -3004,
+   -2876,  -2748,  -2620,  -2492,  -2364,  -2236,  -2108,  -1980,
+   -1884,  -1820,  -1756,  -1692,  -1628,  -1564,  -1500,  -1436,
+   -1372,  -1308,  -1244,  -1180,  -1116,  -1052,   -988,   -924,
+    -876,   -844,   -812,   -780,   -748,   -716,   -684,   -652,
+    -620,   -588,   -556,   -524,   -492,   -460,   -428,   -396,
+    -372,   -356,   -340,   -324,   -308,   -292,   -276,   -260,
+    -244,   -228,   -212,   -196,   -180,   -164,   -148,   -132,
+    -120,   -112,   -104,    -96,    -88,    -80,    -72,    -64,
+     -56,    -48,    -40,    -32,    -24,    -16,     -8,      0,
+   32124,  31100,  30076,  29052,  28028,  27004,  25980,  24956,
+   23932,  22908,  21884,  20860,  19836,  18812,  17788,  16764,
+   15996,  15484,  14972,  14460,  13948,  13436,  12924,  12412,
+   11900,  11388,  10876,  10364,   9852,   9340,   8828,   8316,
+    7932,   7676,   7420,   7164,   6908,   6652,   6396,   6140,
+    5884,   5628,   5372,   5116,   4860,   4604,   4348,   4092,
+    3900,   3772,   3644,   3516,   3388,   3260,   3132,   3004,
+    2876,   2748,   2620,   2492,   2364,   2236,   2108,   1980,
+    1884,   1820,   1756,   1692,   1628,   1564,   1500,   1436,
+    1372,   1308,   1244,   1180,   1116,   1052,    988,    924,
+     876,    844,    812,    780,    748,    716,    684,    652,
+     620,    588,    556,    524,    492,    460,    428,    396,
+     372,    356,    340,    324,    308,    292,    276,    260,
+     244,    228,    212,    196,    180,    164,    148,    132,
+     120,    112,    104,     96,     88,     80,     72,     64,
+      56,     48,     40,     32,     24,     16,      8,      0
+};
+
+#if defined(G711_SSE2)
+// Counts the samples of |value| above |threshold| into |seg|, and lowers
+// their |multiplier| by |step|. A sequence of calls finds the segment of each
+// sample and the power of two that does the variable shift of its
+// quantization bits as a multiplication.
+static __inline void UpdateSegmentSSE2(__m128i value, int16_t threshold,
+                                       int16_t step, __m128i* seg,
+                                       __m128i* multiplier) {
+  const __m128i above = _mm_cmpgt_epi16(value, _mm_set1_epi16(threshold));
+  *seg = _mm_sub_epi16(*seg, above);
+  *multiplier = _mm_sub_epi16(*multiplier,
+                              _mm_and_si128(above, _mm_set1_epi16(step)));
+}
+
+// Encodes eight samples with linear_to_alaw().
+static __inline __m128i LinearToAlawSSE2(__m128i linear) {
+  const __m128i sign = _mm_srai_epi16(linear, 15);
+  // |linear| for positive and -|linear| - 1 for negative samples.
+  const __m128i magnitude = _mm_xor_si128(linear, sign);
+  const __m128i mask = _mm_or_si128(
+      _mm_set1_epi16(ALAW_AMI_MASK),
+      _mm_andnot_si128(sign, _mm_set1_epi16(0x80)));
+  __m128i seg = _mm_setzero_si128();
+  // Segments 0 and 1 shift by 4, segment s > 1 by s + 3.
+  __m128i multiplier = _mm_set1_epi16(1 << 12);
+  __m128i quant;
+
+  UpdateSegmentSSE2(magnitude, 0x00FF, 0, &seg, &multiplier);
+  UpdateSegmentSSE2(magnitude, 0x01FF, 1 << 11, &seg, &multiplier);
+  UpdateSegmentSSE2(magnitude, 0x03FF, 1 << 10, &seg, &multiplier);
+  UpdateSegmentSSE2(magnitude, 0x07FF, 1 << 9, &seg, &multiplier);
+  UpdateSegmentSSE2(magnitude, 0x0FFF, 1 << 8, &seg, &multiplier);
+  UpdateSegmentSSE2(magnitude, 0x1FFF, 1 << 7, &seg, &multiplier);
+  UpdateSegmentSSE2(magnitude, 0x3FFF, 1 << 6, &seg, &multiplier);
+  quant = _mm_and_si128(_mm_mulhi_epi16(magnitude, multiplier),
+                        _mm_set1_epi16(0x0F));
+  return _mm_xor_si128(_mm_or_si128(_mm_slli_epi16(seg, 4), quant), mask);
+}
+
+// Encodes eight samples with linear_to_ulaw(). The biased magnitude saturates
+// at 32767, which gives the same code word (0x7F before the mask) as the
+// out-of-range branch of the scalar version.
+static __inline __m128i LinearToUlawSSE2(__m128i linear) {
+  const __m128i sign = _mm_srai_epi16(linear, 15);
+  const __m128i biased = _mm_adds_epi16(_mm_xor_si128(linear, sign),
+                                        _mm_set1_epi16(ULAW_BIAS));
+  const __m128i mask = _mm_or_si128(
+      _mm_set1_epi16(0x7F), _mm_andnot_si128(sign, _mm_set1_epi16(0x80)));
+  __m128i seg = _mm_setzero_si128();
+  // Segment s shifts by s + 3.
+  __m128i multiplier = _mm_set1_epi16(1 << 13);
+  __m128i quant;
+
+  UpdateSegmentSSE2(biased, 0x00FF, 1 << 12, &seg, &multiplier);
+  UpdateSegmentSSE2(biased, 0x01FF, 1 << 11, &seg, &multiplier);
+  UpdateSegmentSSE2(biased, 0x03FF, 1 << 10, &seg, &multiplier);
+  UpdateSegmentSSE2(biased, 0x07FF, 1 << 9, &seg, &multiplier);
+  UpdateSegmentSSE2(biased, 0x0FFF, 1 << 8, &seg, &multiplier);
+  UpdateSegmentSSE2(biased, 0x1FFF, 1 << 7, &seg, &multiplier);
+  UpdateSegmentSSE2(biased, 0x3FFF, 1 << 6, &seg, &multiplier);
+  quant = _mm_and_si128(_mm_mulhi_epi16(biased, multiplier),
+                        _mm_set1_epi16(0x0F));
+  return _mm_xor_si128(_mm_or_si128(_mm_slli_epi16(seg, 4), quant), mask);
+}
+#endif
+
+static void EncodeAlaw(const int16_t* speech, int len, uint8_t* encoded) {
+  int n = 0;
+#if defined(G711_SSE2)
+  for (; n + 16 <= len; n += 16) {
+    const __m128i low = LinearToAlawSSE2(
+        _mm_loadu_si128((const __m128i*) &speech[n]));
+    const __m128i high = LinearToAlawSSE2(
+        _mm_loadu_si128((const __m128i*) &speech[n + 8]));
+    _mm_storeu_si128((__m128i*) &encoded[n], _mm_packus_epi16(low, high));
+  }
+#endif
+  for (; n < len; n++) {
+    encoded[n] = linear_to_alaw(speech[n]);
+  }
+  if (len & 0x1) {
+    encoded[len] = 0;
+  }
+}
+
+static void EncodeUlaw(const int16_t* speech, int len, uint8_t* encoded) {
+  int n = 0;
+#if defined(G711_SSE2)
+  for (; n + 16 <= len; n += 16) {
+    const __m128i low = LinearToUlawSSE2(
+        _mm_loadu_si128((const __m128i*) &speech[n]));
+    const __m128i high = LinearToUlawSSE2(
+        _mm_loadu_si128((const __m128i*) &speech[n + 8]));
+    _mm_storeu_si128((__m128i*) &encoded[n], _mm_packus_epi16(low, high));
+  }
+#endif
+  for (; n < len; n++) {
+    encoded[n] = linear_to_ulaw(speech[n]);
+  }
+  if (len & 0x1) {
+    encoded[len] = 0;
+  }
+}
+
+static void Decode(const int16_t* table, const uint8_t* encoded, int len,
+                   int16_t* decoded) {
+  int n;
+  for (n = 0; n < len; n++) {
+    decoded[n] = table[encoded[n]];
+  }
+}
+
 int16_t WebRtcG711_EncodeA(void* state,
                            int16_t* speechIn,
                            int16_t len,
                            int16_t* encoded) {
-  int n;
-  uint16_t tempVal, tempVal2;
-
   // Set and discard to avoid getting warnings
   (void)(state = NULL);
 
@@ -27,26 +219,7 @@ int16_t WebRtcG711_EncodeA(void* state,
     return (-1);
   }
 
-  // Loop over all samples
-  for (n = 0; n < len; n++) {
-    tempVal = (uint16_t) linear_to_alaw(speechIn[n]);
-
-#ifdef VOIP_ARCH_BIG_ENDIAN
-    if ((n & 0x1) == 1) {
-      encoded[n >> 1] |= ((uint16_t) tempVal);
-    } else {
-      encoded[n >> 1] = ((uint16_t) tempVal) << 8;
-    }
-#else
-    if ((n & 0x1) == 1) {
-      tempVal2 |= ((uint16_t) tempVal) << 8;
-      encoded[n >> 1] |= ((uint16_t) tempVal) << 8;
-    } else {
-      tempVal2 = ((uint16_t) tempVal);
-      encoded[n >> 1] = ((uint16_t) tempVal);
-    }
-#endif
-  }
+  EncodeAlaw(speechIn, len, (uint8_t*) encoded);
   return (len);
 }
 
@@ -54,9 +227,6 @@ int16_t WebRtcG711_EncodeU(void* state,
                            int16_t* speechIn,
                            int16_t len,
                            int16_t* encoded) {
-  int n;
-  uint16_t tempVal;
-
   // Set and discard to avoid getting warnings
   (void)(state = NULL);
 
@@ -65,23 +235,38 @@ int16_t WebRtcG711_EncodeU(void* state,
     return (-1);
   }
 
-  // Loop over all samples
-  for (n = 0; n < len; n++) {
-    tempVal = (uint16_t) linear_to_ulaw(speechIn[n]);
-
-#ifdef VOIP_ARCH_BIG_ENDIAN
-    if ((n & 0x1) == 1) {
-      encoded[n >> 1] |= ((uint16_t) tempVal);
-    } else {
-      encoded[n >> 1] = ((uint16_t) tempVal) << 8;
-    }
-#else
-    if ((n & 0x1) == 1) {
-      encoded[n >> 1] |= ((uint16_t) tempVal) << 8;
-    } else {
-      encoded[n >> 1] = ((uint16_t) tempVal);
-    }
-#endif
+  EncodeUlaw(speechIn, len, (uint8_t*) encoded);
+  return (len);
+}
+
+int16_t WebRtcG711_EncodeABatch(int16_t* const* speechIn,
+                                int16_t numFrames,
+                                int16_t len,
+                                int16_t* const* encoded) {
+  int k;
+
+  if (len < 0 || numFrames < 0) {
+    return (-1);
+  }
+
+  for (k = 0; k < numFrames; k++) {
+    EncodeAlaw(speechIn[k], len, (uint8_t*) encoded[k]);
+  }
+  return (len);
+}
+
+int16_t WebRtcG711_EncodeUBatch(int16_t* const* speechIn,
+                                int16_t numFrames,
+                                int16_t len,
+                                int16_t* const* encoded) {
+  int k;
+
+  if (len < 0 || numFrames < 0) {
+    return (-1);
+  }
+
+  for (k = 0; k < numFrames; k++) {
+    EncodeUlaw(speechIn[k], len, (uint8_t*) encoded[k]);
   }
   return (len);
 }
@@ -91,9 +276,6 @@ int16_t WebRtcG711_DecodeA(void* state,
                            int16_t len,
                            int16_t* decoded,
                            int16_t* speechType) {
-  int n;
-  uint16_t tempVal;
-
   // Set and discard to avoid getting warnings
   (void)(state = NULL);
 
@@ -102,22 +284,7 @@ int16_t WebRtcG711_DecodeA(void* state,
     return (-1);
   }
 
-  for (n = 0; n < len; n++) {
-#ifdef VOIP_ARCH_BIG_ENDIAN
-    if ((n & 0x1) == 1) {
-      tempVal = ((uint16_t) encoded[n >> 1] & 0xFF);
-    } else {
-      tempVal = ((uint16_t) encoded[n >> 1] >> 8);
-    }
-#else
-    if ((n & 0x1) == 1) {
-      tempVal = (encoded[n >> 1] >> 8);
-    } else {
-      tempVal = (encoded[n >> 1] & 0xFF);
-    }
-#endif
-    decoded[n] = (int16_t) alaw_to_linear(tempVal);
-  }
+  Decode(kAlawToLinear, (const uint8_t*) encoded, len, decoded);
 
   *speechType = 1;
   return (len);
@@ -128,9 +295,6 @@ int16_t WebRtcG711_DecodeU(void* state,
                            int16_t len,
                            int16_t* decoded,
                            int16_t* speechType) {
-  int n;
-  uint16_t tempVal;
-
   // Set and discard to avoid getting warnings
   (void)(state = NULL);
 
@@ -139,22 +303,7 @@ int16_t WebRtcG711_DecodeU(void* state,
     return (-1);
   }
 
-  for (n = 0; n < len; n++) {
-#ifdef VOIP_ARCH_BIG_ENDIAN
-    if ((n & 0x1) == 1) {
-      tempVal = ((uint16_t) encoded[n >> 1] & 0xFF);
-    } else {
-      tempVal = ((uint16_t) encoded[n >> 1] >> 8);
-    }
-#else
-    if ((n & 0x1) == 1) {
-      tempVal = (encoded[n >> 1] >> 8);
-    } else {
-      tempVal = (encoded[n >> 1] & 0xFF);
-    }
-#endif
-    decoded[n] = (int16_t) ulaw_to_linear(tempVal);
-  }
+  Decode(kUlawToLinear, (const uint8_t*) encoded, len, decoded);
 
   *speechType = 1;
   return (len);
@@ -69,6 +69,36 @@ int16_t WebRtcG711_EncodeU(void* state,
                            int16_t len,
                            int16_t* encoded);
 
+/****************************************************************************
+ * WebRtcG711_EncodeABatch(...)
+ * WebRtcG711_EncodeUBatch(...)
+ *
+ * These functions encode one A-law or U-law frame for each of several
+ * channels in one call. The output for each frame is the same as that of
+ * WebRtcG711_EncodeA/U.
+ *
+ * Input:
+ *      - speechIn           : Input speech vectors, one per frame
+ *      - numFrames          : Number of frames
+ *      - len                : Samples in each frame
+ *
+ * Output:
+ *      - encoded            : The encoded data vectors, one per frame
+ *
+ * Return value              : >0 - Length (in bytes) of each coded frame
+ *                             -1 - Error
+ */
+
+int16_t WebRtcG711_EncodeABatch(int16_t* const* speechIn,
+                                int16_t numFrames,
+                                int16_t len,
+                                int16_t* const* encoded);
+
+int16_t WebRtcG711_EncodeUBatch(int16_t* const* speechIn,
+                                int16_t numFrames,
+                                int16_t len,
+                                int16_t* const* encoded);
+
 /****************************************************************************
  * WebRtcG711_DecodeA(...)
  *
@@ -41,6 +41,14 @@
 #include "include/typedefs.h"
 #include "g722_enc_dec.h"
 
+/* SSE2 is part of the x86-64 baseline; on 32-bit x86 it is only used when the
+   compiler is allowed to assume it. */
+#if defined(VOIP_ARCH_X86_64) || defined(__SSE2__) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define G722_SSE2
+#include <emmintrin.h>
+#endif
+
 
 #if !defined(FALSE)
 #define FALSE 0
@@ -49,6 +57,14 @@
 #define TRUE (!FALSE)
 #endif
 
+/* The receive QMF is run over blocks of up to 10 ms of 16 kHz output */
+#define QMF_BLOCK_PAIRS 80
+
+static const int qmf_coeffs[12] =
+{
+       3,  -11,   12,   32, -210,  951, 3876, -805,  362, -156,   53,  -11,
+};
+
 static __inline int16_t saturate(int32_t amp)
 {
     int16_t amp16;
@@ -63,95 +79,173 @@ static __inline int16_t saturate(int32_t amp)
 }
 /*- End of function --------------------------------------------------------*/
 
-static void block4(g722_decode_state_t *s, int band, int d);
-
-static void block4(g722_decode_state_t *s, int band, int d)
+/* Blocks 4L/4H. The sign history and updated coefficients of UPPOL1/2 and
+   UPZERO are kept in locals, and UPZERO, DELAYA and FILTEZ are merged into
+   one pass over the zero section. The arithmetic is unchanged. */
+static void block4(g722_band_t *band, int d)
 {
     int wd1;
     int wd2;
     int wd3;
+    int sg0;
+    int sg1;
+    int sg2;
+    int ap1;
+    int ap2;
+    int sz;
     int i;
 
     /* Block 4, RECONS */
-    s->band[band].d[0] = d;
-    s->band[band].r[0] = saturate(s->band[band].s + d);
+    band->d[0] = d;
+    band->r[0] = saturate(band->s + d);
 
     /* Block 4, PARREC */
-    s->band[band].p[0] = saturate(s->band[band].sz + d);
+    band->p[0] = saturate(band->sz + d);
 
     /* Block 4, UPPOL2 */
-    for (i = 0;  i < 3;  i++)
-        s->band[band].sg[i] = s->band[band].p[i] >> 15;
-    wd1 = saturate(s->band[band].a[1] << 2);
+    sg0 = band->p[0] >> 15;
+    sg1 = band->p[1] >> 15;
+    sg2 = band->p[2] >> 15;
+    wd1 = saturate(band->a[1] << 2);
 
-    wd2 = (s->band[band].sg[0] == s->band[band].sg[1])  ?  -wd1  :  wd1;
+    wd2 = (sg0 == sg1)  ?  -wd1  :  wd1;
     if (wd2 > 32767)
         wd2 = 32767;
-    wd3 = (s->band[band].sg[0] == s->band[band].sg[2])  ?  128  :  -128;
-    wd3 += (wd2 >> 7);
-    wd3 += (s->band[band].a[2]*32512) >> 15;
+    wd3 = (wd2 >> 7) + ((sg0 == sg2)  ?  128  :  -128);
+    wd3 += (band->a[2]*32512) >> 15;
     if (wd3 > 12288)
         wd3 = 12288;
     else if (wd3 < -12288)
         wd3 = -12288;
-    s->band[band].ap[2] = wd3;
+    ap2 = wd3;
 
     /* Block 4, UPPOL1 */
-    s->band[band].sg[0] = s->band[band].p[0] >> 15;
-    s->band[band].sg[1] = s->band[band].p[1] >> 15;
-    wd1 = (s->band[band].sg[0] == s->band[band].sg[1])  ?  192  :  -192;
-    wd2 = (s->band[band].a[1]*32640) >> 15;
-
-    s->band[band].ap[1] = saturate(wd1 + wd2);
-    wd3 = saturate(15360 - s->band[band].ap[2]);
-    if (s->band[band].ap[1] > wd3)
-        s->band[band].ap[1] = wd3;
-    else if (s->band[band].ap[1] < -wd3)
-        s->band[band].ap[1] = -wd3;
-
-    /* Block 4, UPZERO */
+    wd1 = (sg0 == sg1)  ?  192  :  -192;
+    wd2 = (band->a[1]*32640) >> 15;
+
+    ap1 = saturate(wd1 + wd2);
+    wd3 = saturate(15360 - ap2);
+    if (ap1 > wd3)
+        ap1 = wd3;
+    else if (ap1 < -wd3)
+        ap1 = -wd3;
+
+    /* Block 4, UPZERO, DELAYA and FILTEZ. Going down from the oldest tap,
+       d[i - 1] is still the old value when it is moved up. */
     wd1 = (d == 0)  ?  0  :  128;
-    s->band[band].sg[0] = d >> 15;
-    for (i = 1;  i < 7;  i++)
+    sg0 = d >> 15;
+    sz = 0;
+    for (i = 6;  i > 0;  i--)
     {
-        s->band[band].sg[i] = s->band[band].d[i] >> 15;
-        wd2 = (s->band[band].sg[i] == s->band[band].sg[0])  ?  wd1  :  -wd1;
-        wd3 = (s->band[band].b[i]*32640) >> 15;
-        s->band[band].bp[i] = saturate(wd2 + wd3);
+        wd2 = ((band->d[i] >> 15) == sg0)  ?  wd1  :  -wd1;
+        wd3 = (band->b[i]*32640) >> 15;
+        band->b[i] = saturate(wd2 + wd3);
+        band->d[i] = band->d[i - 1];
+        wd2 = saturate(band->d[i] + band->d[i]);
+        sz += (band->b[i]*wd2) >> 15;
     }
 
     /* Block 4, DELAYA */
-    for (i = 6;  i > 0;  i--)
+    band->r[2] = band->r[1];
+    band->r[1] = band->r[0];
+    band->p[2] = band->p[1];
+    band->p[1] = band->p[0];
+    band->a[2] = ap2;
+    band->a[1] = ap1;
+
+    /* Block 4, FILTEP */
+    wd1 = saturate(band->r[1] + band->r[1]);
+    wd1 = (band->a[1]*wd1) >> 15;
+    wd2 = saturate(band->r[2] + band->r[2]);
+    wd2 = (band->a[2]*wd2) >> 15;
+    band->sp = saturate(wd1 + wd2);
+
+    /* Block 4, FILTEZ */
+    band->sz = saturate(sz);
+
+    /* Block 4, PREDIC */
+    band->s = saturate(band->sp + band->sz);
+}
+/*- End of function --------------------------------------------------------*/
+
+#ifdef G722_SSE2
+/* SSE2 version of qmf_synthesis() for eight sample pairs at a time. The eight
+   samples from x[2*k + 2*i] are tap i of the pairs k to k + 3, as (sum,
+   difference) lanes, and _mm_madd_epi16() with one of the two coefficients
+   set to zero picks the products of one of them. The sums cannot overflow,
+   and _mm_packs_epi32() saturates like saturate(), so the result is
+   bit-exact. Returns the number of pairs done. */
+static __inline int qmf_synthesis_sse2(const int16_t x[], int pairs,
+                                       int16_t amp[])
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i coeffs_even[12];
+    __m128i coeffs_odd[12];
+    int i;
+    int k;
+
+    for (i = 0;  i < 12;  i++)
     {
-        s->band[band].d[i] = s->band[band].d[i - 1];
-        s->band[band].b[i] = s->band[band].bp[i];
+        coeffs_even[i] = _mm_unpacklo_epi16(_mm_set1_epi16((int16_t) qmf_coeffs[i]), zero);
+        coeffs_odd[i] = _mm_unpacklo_epi16(zero, _mm_set1_epi16((int16_t) qmf_coeffs[11 - i]));
     }
-    
-    for (i = 2;  i > 0;  i--)
+    for (k = 0;  k + 8 <= pairs;  k += 8)
     {
-        s->band[band].r[i] = s->band[band].r[i - 1];
-        s->band[band].p[i] = s->band[band].p[i - 1];
-        s->band[band].a[i] = s->band[band].ap[i];
+        __m128i xout1_0 = _mm_setzero_si128();
+        __m128i xout1_1 = _mm_setzero_si128();
+        __m128i xout2_0 = _mm_setzero_si128();
+        __m128i xout2_1 = _mm_setzero_si128();
+        __m128i out1;
+        __m128i out2;
+
+        for (i = 0;  i < 12;  i++)
+        {
+            const __m128i x0 = _mm_loadu_si128((const __m128i *) &x[2*(k + i)]);
+            const __m128i x1 = _mm_loadu_si128((const __m128i *) &x[2*(k + i) + 8]);
+            xout1_0 = _mm_add_epi32(xout1_0, _mm_madd_epi16(x0, coeffs_odd[i]));
+            xout1_1 = _mm_add_epi32(xout1_1, _mm_madd_epi16(x1, coeffs_odd[i]));
+            xout2_0 = _mm_add_epi32(xout2_0, _mm_madd_epi16(x0, coeffs_even[i]));
+            xout2_1 = _mm_add_epi32(xout2_1, _mm_madd_epi16(x1, coeffs_even[i]));
+        }
+        out1 = _mm_packs_epi32(_mm_srai_epi32(xout1_0, 11), _mm_srai_epi32(xout1_1, 11));
+        out2 = _mm_packs_epi32(_mm_srai_epi32(xout2_0, 11), _mm_srai_epi32(xout2_1, 11));
+        _mm_storeu_si128((__m128i *) &amp[2*k], _mm_unpacklo_epi16(out1, out2));
+        _mm_storeu_si128((__m128i *) &amp[2*k + 8], _mm_unpackhi_epi16(out1, out2));
     }
+    return k;
+}
+/*- End of function --------------------------------------------------------*/
+#endif
 
-    /* Block 4, FILTEP */
-    wd1 = saturate(s->band[band].r[1] + s->band[band].r[1]);
-    wd1 = (s->band[band].a[1]*wd1) >> 15;
-    wd2 = saturate(s->band[band].r[2] + s->band[band].r[2]);
-    wd2 = (s->band[band].a[2]*wd2) >> 15;
-    s->band[band].sp = saturate(wd1 + wd2);
+/* Apply the receive QMF to |pairs| pairs of sum and difference samples. x[]
+   holds the 22 previous samples followed by the new ones, so pair k uses
+   x[2*k] to x[2*k + 23]. */
+static void qmf_synthesis(const int16_t x[], int pairs, int16_t amp[])
+{
+    int xout1;
+    int xout2;
+    int i;
+    int k;
 
-    /* Block 4, FILTEZ */
-    s->band[band].sz = 0;
-    for (i = 6;  i > 0;  i--)
+    k = 0;
+#ifdef G722_SSE2
+    k = qmf_synthesis_sse2(x, pairs, amp);
+#endif
+    for (  ;  k < pairs;  k++)
     {
-        wd1 = saturate(s->band[band].d[i] + s->band[band].d[i]);
-        s->band[band].sz += (s->band[band].b[i]*wd1) >> 15;
+        xout1 = 0;
+        xout2 = 0;
+        for (i = 0;  i < 12;  i++)
+        {
+            xout2 += x[2*(k + i)]*qmf_coeffs[i];
+            xout1 += x[2*(k + i) + 1]*qmf_coeffs[11 - i];
+        }
+        /* We shift by 12 to allow for the QMF filters (DC gain = 4096), less 1
+           to allow for the 15 bit input to the G.722 algorithm. */
+        /* WebRtc, tlegrand: added saturation */
+        amp[2*k] = saturate(xout1 >> 11);
+        amp[2*k + 1] = saturate(xout2 >> 11);
     }
-    s->band[band].sz = saturate(s->band[band].sz);
-
-    /* Block 4, PREDIC */
-    s->band[band].s = saturate(s->band[band].sp + s->band[band].sz);
 }
 /*- End of function --------------------------------------------------------*/
 
@@ -244,18 +338,12 @@ int WebRtc_g722_decode(g722_decode_state_t *s, int16_t amp[],
            1688,   1360,   1040,    728,
             432,    136,   -432,   -136
     };
-    static const int qmf_coeffs[12] =
-    {
-           3,  -11,   12,   32, -210,  951, 3876, -805,  362, -156,   53,  -11,
-    };
 
     int dlowt;
     int rlow;
     int ihigh;
     int dhigh;
     int rhigh;
-    int xout1;
-    int xout2;
     int wd1;
     int wd2;
     int wd3;
@@ -263,9 +351,15 @@ int WebRtc_g722_decode(g722_decode_state_t *s, int16_t amp[],
     int outlen;
     int i;
     int j;
+    int pairs;
+    /* QMF history and the sum and difference samples of one block */
+    int16_t x[22 + 2*QMF_BLOCK_PAIRS];
 
     outlen = 0;
     rhigh = 0;
+    pairs = 0;
+    for (i = 0;  i < 22;  i++)
+        x[i] = (int16_t) s->x[i + 2];
     for (j = 0;  j < len;  )
     {
         if (s->packed)
@@ -336,7 +430,7 @@ int WebRtc_g722_decode(g722_decode_state_t *s, int16_t amp[],
         wd3 = (wd2 < 0)  ?  (ilb[wd1] << -wd2)  :  (ilb[wd1] >> wd2);
         s->band[0].det = wd3 << 2;
 
-        block4(s, 0, dlowt);
+        block4(&s->band[0], dlowt);
         
         if (!s->eight_k)
         {
@@ -367,7 +461,7 @@ int WebRtc_g722_decode(g722_decode_state_t *s, int16_t amp[],
             wd3 = (wd2 < 0)  ?  (ilb[wd1] << -wd2)  :  (ilb[wd1] >> wd2);
             s->band[1].det = wd3 << 2;
 
-            block4(s, 1, dhigh);
+            block4(&s->band[1], dhigh);
         }
 
         if (s->itu_test_mode)
@@ -383,27 +477,31 @@ int WebRtc_g722_decode(g722_decode_state_t *s, int16_t amp[],
             }
             else
             {
-                /* Apply the receive QMF */
-                for (i = 0;  i < 22;  i++)
-                    s->x[i] = s->x[i + 2];
-                s->x[22] = rlow + rhigh;
-                s->x[23] = rlow - rhigh;
-
-                xout1 = 0;
-                xout2 = 0;
-                for (i = 0;  i < 12;  i++)
+                /* Queue the input of the receive QMF. The sum and
+                   difference of the two bands fit in 16 bits. */
+                x[22 + 2*pairs] = (int16_t) (rlow + rhigh);
+                x[23 + 2*pairs] = (int16_t) (rlow - rhigh);
+                if (++pairs == QMF_BLOCK_PAIRS)
                 {
-                    xout2 += s->x[2*i]*qmf_coeffs[i];
-                    xout1 += s->x[2*i + 1]*qmf_coeffs[11 - i];
+                    qmf_synthesis(x, pairs, &amp[outlen]);
+                    outlen += 2*pairs;
+                    for (i = 0;  i < 22;  i++)
+                        x[i] = x[2*pairs + i];
+                    pairs = 0;
                 }
-                /* We shift by 12 to allow for the QMF filters (DC gain = 4096), less 1
-                   to allow for the 15 bit input to the G.722 algorithm. */
-                /* WebRtc, tlegrand: added saturation */
-                amp[outlen++] = saturate(xout1 >> 11);
-                amp[outlen++] = saturate(xout2 >> 11);
             }
         }
     }
+    if (pairs > 0)
+    {
+        /* Apply the receive QMF to the rest of the block */
+        qmf_synthesis(x, pairs, &amp[outlen]);
+        outlen += 2*pairs;
+        for (i = 0;  i < 22;  i++)
+            x[i] = x[2*pairs + i];
+    }
+    for (i = 0;  i < 22;  i++)
+        s->x[i + 2] = x[i];
     return outlen;
 }
 /*- End of function --------------------------------------------------------*/
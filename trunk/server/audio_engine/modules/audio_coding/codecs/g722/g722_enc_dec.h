@@ -53,6 +53,21 @@ enum
     G722_PACKED = 0x0002
 };
 
+/*! ADPCM predictor and quantizer state of one sub-band */
+typedef struct
+{
+    int s;
+    int sp;
+    int sz;
+    int r[3];
+    int a[3];
+    int p[3];
+    int d[7];
+    int b[7];
+    int nb;
+    int det;
+} g722_band_t;
+
 typedef struct
 {
     /*! TRUE if the operating in the special ITU test mode, with the band split filters
@@ -68,22 +83,7 @@ typedef struct
     /*! Signal history for the QMF */
     int x[24];
 
-    struct
-    {
-        int s;
-        int sp;
-        int sz;
-        int r[3];
-        int a[3];
-        int ap[3];
-        int p[3];
-        int d[7];
-        int b[7];
-        int bp[7];
-        int sg[7];
-        int nb;
-        int det;
-    } band[2];
+    g722_band_t band[2];
 
     unsigned int in_buffer;
     int in_bits;
@@ -106,22 +106,7 @@ typedef struct
     /*! Signal history for the QMF */
     int x[24];
 
-    struct
-    {
-        int s;
-        int sp;
-        int sz;
-        int r[3];
-        int a[3];
-        int ap[3];
-        int p[3];
-        int d[7];
-        int b[7];
-        int bp[7];
-        int sg[7];
-        int nb;
-        int det;
-    } band[2];
+    g722_band_t band[2];
     
     unsigned int in_buffer;
     int in_bits;
@@ -41,6 +41,14 @@
 #include "include/typedefs.h"
 #include "g722_enc_dec.h"
 
+/* SSE2 is part of the x86-64 baseline; on 32-bit x86 it is only used when the
+   compiler is allowed to assume it. */
+#if defined(VOIP_ARCH_X86_64) || defined(__SSE2__) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define G722_SSE2
+#include <emmintrin.h>
+#endif
+
 #if !defined(FALSE)
 #define FALSE 0
 #endif
@@ -48,6 +56,14 @@
 #define TRUE (!FALSE)
 #endif
 
+/* The transmit QMF is run over blocks of up to 10 ms of 16 kHz input */
+#define QMF_BLOCK_PAIRS 80
+
+static const int qmf_coeffs[12] =
+{
+       3,  -11,   12,   32, -210,  951, 3876, -805,  362, -156,   53,  -11,
+};
+
 static __inline int16_t saturate(int32_t amp)
 {
     int16_t amp16;
@@ -62,92 +78,172 @@ static __inline int16_t saturate(int32_t amp)
 }
 /*- End of function --------------------------------------------------------*/
 
-static void block4(g722_encode_state_t *s, int band, int d)
+/* Blocks 4L/4H. The sign history and updated coefficients of UPPOL1/2 and
+   UPZERO are kept in locals, and UPZERO, DELAYA and FILTEZ are merged into
+   one pass over the zero section. The arithmetic is unchanged. */
+static void block4(g722_band_t *band, int d)
 {
     int wd1;
     int wd2;
     int wd3;
+    int sg0;
+    int sg1;
+    int sg2;
+    int ap1;
+    int ap2;
+    int sz;
     int i;
 
     /* Block 4, RECONS */
-    s->band[band].d[0] = d;
-    s->band[band].r[0] = saturate(s->band[band].s + d);
+    band->d[0] = d;
+    band->r[0] = saturate(band->s + d);
 
     /* Block 4, PARREC */
-    s->band[band].p[0] = saturate(s->band[band].sz + d);
+    band->p[0] = saturate(band->sz + d);
 
     /* Block 4, UPPOL2 */
-    for (i = 0;  i < 3;  i++)
-        s->band[band].sg[i] = s->band[band].p[i] >> 15;
-    wd1 = saturate(s->band[band].a[1] << 2);
+    sg0 = band->p[0] >> 15;
+    sg1 = band->p[1] >> 15;
+    sg2 = band->p[2] >> 15;
+    wd1 = saturate(band->a[1] << 2);
 
-    wd2 = (s->band[band].sg[0] == s->band[band].sg[1])  ?  -wd1  :  wd1;
+    wd2 = (sg0 == sg1)  ?  -wd1  :  wd1;
     if (wd2 > 32767)
         wd2 = 32767;
-    wd3 = (wd2 >> 7) + ((s->band[band].sg[0] == s->band[band].sg[2])  ?  128  :  -128);
-    wd3 += (s->band[band].a[2]*32512) >> 15;
+    wd3 = (wd2 >> 7) + ((sg0 == sg2)  ?  128  :  -128);
+    wd3 += (band->a[2]*32512) >> 15;
     if (wd3 > 12288)
         wd3 = 12288;
     else if (wd3 < -12288)
         wd3 = -12288;
-    s->band[band].ap[2] = wd3;
+    ap2 = wd3;
 
     /* Block 4, UPPOL1 */
-    s->band[band].sg[0] = s->band[band].p[0] >> 15;
-    s->band[band].sg[1] = s->band[band].p[1] >> 15;
-    wd1 = (s->band[band].sg[0] == s->band[band].sg[1])  ?  192  :  -192;
-    wd2 = (s->band[band].a[1]*32640) >> 15;
-
-    s->band[band].ap[1] = saturate(wd1 + wd2);
-    wd3 = saturate(15360 - s->band[band].ap[2]);
-    if (s->band[band].ap[1] > wd3)
-        s->band[band].ap[1] = wd3;
-    else if (s->band[band].ap[1] < -wd3)
-        s->band[band].ap[1] = -wd3;
-
-    /* Block 4, UPZERO */
+    wd1 = (sg0 == sg1)  ?  192  :  -192;
+    wd2 = (band->a[1]*32640) >> 15;
+
+    ap1 = saturate(wd1 + wd2);
+    wd3 = saturate(15360 - ap2);
+    if (ap1 > wd3)
+        ap1 = wd3;
+    else if (ap1 < -wd3)
+        ap1 = -wd3;
+
+    /* Block 4, UPZERO, DELAYA and FILTEZ. Going down from the oldest tap,
+       d[i - 1] is still the old value when it is moved up. */
     wd1 = (d == 0)  ?  0  :  128;
-    s->band[band].sg[0] = d >> 15;
-    for (i = 1;  i < 7;  i++)
+    sg0 = d >> 15;
+    sz = 0;
+    for (i = 6;  i > 0;  i--)
     {
-        s->band[band].sg[i] = s->band[band].d[i] >> 15;
-        wd2 = (s->band[band].sg[i] == s->band[band].sg[0])  ?  wd1  :  -wd1;
-        wd3 = (s->band[band].b[i]*32640) >> 15;
-        s->band[band].bp[i] = saturate(wd2 + wd3);
+        wd2 = ((band->d[i] >> 15) == sg0)  ?  wd1  :  -wd1;
+        wd3 = (band->b[i]*32640) >> 15;
+        band->b[i] = saturate(wd2 + wd3);
+        band->d[i] = band->d[i - 1];
+        wd2 = saturate(band->d[i] + band->d[i]);
+        sz += (band->b[i]*wd2) >> 15;
     }
 
     /* Block 4, DELAYA */
-    for (i = 6;  i > 0;  i--)
+    band->r[2] = band->r[1];
+    band->r[1] = band->r[0];
+    band->p[2] = band->p[1];
+    band->p[1] = band->p[0];
+    band->a[2] = ap2;
+    band->a[1] = ap1;
+
+    /* Block 4, FILTEP */
+    wd1 = saturate(band->r[1] + band->r[1]);
+    wd1 = (band->a[1]*wd1) >> 15;
+    wd2 = saturate(band->r[2] + band->r[2]);
+    wd2 = (band->a[2]*wd2) >> 15;
+    band->sp = saturate(wd1 + wd2);
+
+    /* Block 4, FILTEZ */
+    band->sz = saturate(sz);
+
+    /* Block 4, PREDIC */
+    band->s = saturate(band->sp + band->sz);
+}
+/*- End of function --------------------------------------------------------*/
+
+#ifdef G722_SSE2
+/* SSE2 version of qmf_analysis() for eight sample pairs at a time. The eight
+   samples from x[2*k + 2*i] are tap i of the pairs k to k + 3, as (even, odd)
+   lanes, so one _mm_madd_epi16() adds the even and odd tap products of four
+   pairs. The sums cannot overflow, so the result is bit-exact. Returns the
+   number of pairs done. */
+static __inline int qmf_analysis_sse2(const int16_t x[], int pairs,
+                                      int16_t xlow[], int16_t xhigh[])
+{
+    __m128i coeffs_low[12];
+    __m128i coeffs_high[12];
+    int i;
+    int k;
+
+    for (i = 0;  i < 12;  i++)
     {
-        s->band[band].d[i] = s->band[band].d[i - 1];
-        s->band[band].b[i] = s->band[band].bp[i];
+        const __m128i odd = _mm_set1_epi16((int16_t) qmf_coeffs[11 - i]);
+        coeffs_low[i] = _mm_unpacklo_epi16(_mm_set1_epi16((int16_t) qmf_coeffs[i]), odd);
+        coeffs_high[i] = _mm_unpacklo_epi16(_mm_set1_epi16((int16_t) -qmf_coeffs[i]), odd);
     }
-    
-    for (i = 2;  i > 0;  i--)
+    for (k = 0;  k + 8 <= pairs;  k += 8)
     {
-        s->band[band].r[i] = s->band[band].r[i - 1];
-        s->band[band].p[i] = s->band[band].p[i - 1];
-        s->band[band].a[i] = s->band[band].ap[i];
+        __m128i low0 = _mm_setzero_si128();
+        __m128i low1 = _mm_setzero_si128();
+        __m128i high0 = _mm_setzero_si128();
+        __m128i high1 = _mm_setzero_si128();
+
+        for (i = 0;  i < 12;  i++)
+        {
+            const __m128i x0 = _mm_loadu_si128((const __m128i *) &x[2*(k + i)]);
+            const __m128i x1 = _mm_loadu_si128((const __m128i *) &x[2*(k + i) + 8]);
+            low0 = _mm_add_epi32(low0, _mm_madd_epi16(x0, coeffs_low[i]));
+            low1 = _mm_add_epi32(low1, _mm_madd_epi16(x1, coeffs_low[i]));
+            high0 = _mm_add_epi32(high0, _mm_madd_epi16(x0, coeffs_high[i]));
+            high1 = _mm_add_epi32(high1, _mm_madd_epi16(x1, coeffs_high[i]));
+        }
+        _mm_storeu_si128((__m128i *) &xlow[k],
+                         _mm_packs_epi32(_mm_srai_epi32(low0, 14), _mm_srai_epi32(low1, 14)));
+        _mm_storeu_si128((__m128i *) &xhigh[k],
+                         _mm_packs_epi32(_mm_srai_epi32(high0, 14), _mm_srai_epi32(high1, 14)));
     }
+    return k;
+}
+/*- End of function --------------------------------------------------------*/
+#endif
 
-    /* Block 4, FILTEP */
-    wd1 = saturate(s->band[band].r[1] + s->band[band].r[1]);
-    wd1 = (s->band[band].a[1]*wd1) >> 15;
-    wd2 = saturate(s->band[band].r[2] + s->band[band].r[2]);
-    wd2 = (s->band[band].a[2]*wd2) >> 15;
-    s->band[band].sp = saturate(wd1 + wd2);
+/* Apply the transmit QMF to |pairs| pairs of input samples. x[] holds the 22
+   previous samples followed by the new ones, so pair k uses x[2*k] to
+   x[2*k + 23]. Every other QMF output is discarded. */
+static void qmf_analysis(const int16_t x[], int pairs,
+                         int16_t xlow[], int16_t xhigh[])
+{
+    /* Even and odd tap accumulators */
+    int sumeven;
+    int sumodd;
+    int i;
+    int k;
 
-    /* Block 4, FILTEZ */
-    s->band[band].sz = 0;
-    for (i = 6;  i > 0;  i--)
+    k = 0;
+#ifdef G722_SSE2
+    k = qmf_analysis_sse2(x, pairs, xlow, xhigh);
+#endif
+    for (  ;  k < pairs;  k++)
     {
-        wd1 = saturate(s->band[band].d[i] + s->band[band].d[i]);
-        s->band[band].sz += (s->band[band].b[i]*wd1) >> 15;
+        sumeven = 0;
+        sumodd = 0;
+        for (i = 0;  i < 12;  i++)
+        {
+            sumodd += x[2*(k + i)]*qmf_coeffs[i];
+            sumeven += x[2*(k + i) + 1]*qmf_coeffs[11 - i];
+        }
+        /* We shift by 12 to allow for the QMF filters (DC gain = 4096), plus 1
+           to allow for us summing two filters, plus 1 to allow for the 15 bit
+           input to the G.722 algorithm. */
+        xlow[k] = (int16_t) ((sumeven + sumodd) >> 14);
+        xhigh[k] = (int16_t) ((sumeven - sumodd) >> 14);
     }
-    s->band[band].sz = saturate(s->band[band].sz);
-
-    /* Block 4, PREDIC */
-    s->band[band].s = saturate(s->band[band].sp + s->band[band].sz);
 }
 /*- End of function --------------------------------------------------------*/
 
@@ -253,10 +349,6 @@ int WebRtc_g722_encode(g722_encode_state_t *s, uint8_t g722_data[],
     {
         -7408,  -1616,   7408,   1616
     };
-    static const int qmf_coeffs[12] =
-    {
-           3,  -11,   12,   32, -210,  951, 3876, -805,  362, -156,   53,  -11,
-    };
     static const int ihn[3] = {0, 1, 0};
     static const int ihp[3] = {0, 3, 2};
     static const int wh[3] = {0, -214, 798};
@@ -276,156 +368,159 @@ int WebRtc_g722_encode(g722_encode_state_t *s, uint8_t g722_data[],
     int mih;
     int i;
     int j;
-    /* Low and high band PCM from the QMF */
-    int xlow;
-    int xhigh;
     int g722_bytes;
-    /* Even and odd tap accumulators */
-    int sumeven;
-    int sumodd;
     int ihigh;
     int ilow;
     int code;
+    int k;
+    int n;
+    int pairs;
+    /* QMF history and input of one block */
+    int16_t x[22 + 2*QMF_BLOCK_PAIRS];
+    /* Low and high band PCM from the QMF */
+    int16_t xlow[QMF_BLOCK_PAIRS];
+    int16_t xhigh[QMF_BLOCK_PAIRS];
 
     g722_bytes = 0;
-    xhigh = 0;
-    for (j = 0;  j < len;  )
+    for (j = 0;  j < len;  j += n)
     {
         if (s->itu_test_mode)
         {
-            xlow =
-            xhigh = amp[j++] >> 1;
+            n = (len - j < QMF_BLOCK_PAIRS)  ?  len - j  :  QMF_BLOCK_PAIRS;
+            pairs = n;
+            for (k = 0;  k < n;  k++)
+                xlow[k] =
+                xhigh[k] = amp[j + k] >> 1;
+        }
+        else if (s->eight_k)
+        {
+            n = (len - j < QMF_BLOCK_PAIRS)  ?  len - j  :  QMF_BLOCK_PAIRS;
+            pairs = n;
+            /* We shift by 1 to allow for the 15 bit input to the G.722 algorithm. */
+            for (k = 0;  k < n;  k++)
+                xlow[k] = amp[j + k] >> 1;
         }
         else
         {
-            if (s->eight_k)
-            {
-                /* We shift by 1 to allow for the 15 bit input to the G.722 algorithm. */
-                xlow = amp[j++] >> 1;
-            }
-            else
-            {
-                /* Apply the transmit QMF */
-                /* Shuffle the buffer down */
-                for (i = 0;  i < 22;  i++)
-                    s->x[i] = s->x[i + 2];
-                s->x[22] = amp[j++];
-                s->x[23] = amp[j++];
-    
-                /* Discard every other QMF output */
-                sumeven = 0;
-                sumodd = 0;
-                for (i = 0;  i < 12;  i++)
-                {
-                    sumodd += s->x[2*i]*qmf_coeffs[i];
-                    sumeven += s->x[2*i + 1]*qmf_coeffs[11 - i];
-                }
-                /* We shift by 12 to allow for the QMF filters (DC gain = 4096), plus 1
-                   to allow for us summing two filters, plus 1 to allow for the 15 bit
-                   input to the G.722 algorithm. */
-                xlow = (sumeven + sumodd) >> 14;
-                xhigh = (sumeven - sumodd) >> 14;
+            /* Apply the transmit QMF to the whole block. An odd trailing
+               sample is paired with zero. */
+            n = (len - j < 2*QMF_BLOCK_PAIRS)  ?  len - j  :  2*QMF_BLOCK_PAIRS;
+            pairs = (n + 1) >> 1;
+            for (i = 0;  i < 22;  i++)
+                x[i] = (int16_t) s->x[i + 2];
+            memcpy(&x[22], &amp[j], n*sizeof(amp[0]));
+            if (n & 1)
+                x[22 + n] = 0;
+            qmf_analysis(x, pairs, xlow, xhigh);
+            for (i = 0;  i < 22;  i++)
+                s->x[i + 2] = x[2*pairs + i];
 
 #ifdef RUN_LIKE_REFERENCE_G722
-                /* The following lines are only used to verify bit-exactness
-                 * with reference implementation of G.722. Higher precision
-                 * is achieved without limiting the values.
-                 */
-                xlow = limitValues(xlow);
-                xhigh = limitValues(xhigh);
-#endif
+            /* The following lines are only used to verify bit-exactness
+             * with reference implementation of G.722. Higher precision
+             * is achieved without limiting the values.
+             */
+            for (k = 0;  k < pairs;  k++)
+            {
+                xlow[k] = limitValues(xlow[k]);
+                xhigh[k] = limitValues(xhigh[k]);
             }
+#endif
         }
-        /* Block 1L, SUBTRA */
-        el = saturate(xlow - s->band[0].s);
 
-        /* Block 1L, QUANTL */
-        wd = (el >= 0)  ?  el  :  -(el + 1);
-
-        for (i = 1;  i < 30;  i++)
-        {
-            wd1 = (q6[i]*s->band[0].det) >> 12;
-            if (wd < wd1)
-                break;
-        }
-        ilow = (el < 0)  ?  iln[i]  :  ilp[i];
-
-        /* Block 2L, INVQAL */
-        ril = ilow >> 2;
-        wd2 = qm4[ril];
-        dlow = (s->band[0].det*wd2) >> 15;
-
-        /* Block 3L, LOGSCL */
-        il4 = rl42[ril];
-        wd = (s->band[0].nb*127) >> 7;
-        s->band[0].nb = wd + wl[il4];
-        if (s->band[0].nb < 0)
-            s->band[0].nb = 0;
-        else if (s->band[0].nb > 18432)
-            s->band[0].nb = 18432;
-
-        /* Block 3L, SCALEL */
-        wd1 = (s->band[0].nb >> 6) & 31;
-        wd2 = 8 - (s->band[0].nb >> 11);
-        wd3 = (wd2 < 0)  ?  (ilb[wd1] << -wd2)  :  (ilb[wd1] >> wd2);
-        s->band[0].det = wd3 << 2;
-
-        block4(s, 0, dlow);
-        
-        if (s->eight_k)
-        {
-            /* Just leave the high bits as zero */
-            code = (0xC0 | ilow) >> (8 - s->bits_per_sample);
-        }
-        else
+        for (k = 0;  k < pairs;  k++)
         {
-            /* Block 1H, SUBTRA */
-            eh = saturate(xhigh - s->band[1].s);
-
-            /* Block 1H, QUANTH */
-            wd = (eh >= 0)  ?  eh  :  -(eh + 1);
-            wd1 = (564*s->band[1].det) >> 12;
-            mih = (wd >= wd1)  ?  2  :  1;
-            ihigh = (eh < 0)  ?  ihn[mih]  :  ihp[mih];
-
-            /* Block 2H, INVQAH */
-            wd2 = qm2[ihigh];
-            dhigh = (s->band[1].det*wd2) >> 15;
-
-            /* Block 3H, LOGSCH */
-            ih2 = rh2[ihigh];
-            wd = (s->band[1].nb*127) >> 7;
-            s->band[1].nb = wd + wh[ih2];
-            if (s->band[1].nb < 0)
-                s->band[1].nb = 0;
-            else if (s->band[1].nb > 22528)
-                s->band[1].nb = 22528;
-
-            /* Block 3H, SCALEH */
-            wd1 = (s->band[1].nb >> 6) & 31;
-            wd2 = 10 - (s->band[1].nb >> 11);
+            /* Block 1L, SUBTRA */
+            el = saturate(xlow[k] - s->band[0].s);
+
+            /* Block 1L, QUANTL */
+            wd = (el >= 0)  ?  el  :  -(el + 1);
+
+            for (i = 1;  i < 30;  i++)
+            {
+                wd1 = (q6[i]*s->band[0].det) >> 12;
+                if (wd < wd1)
+                    break;
+            }
+            ilow = (el < 0)  ?  iln[i]  :  ilp[i];
+
+            /* Block 2L, INVQAL */
+            ril = ilow >> 2;
+            wd2 = qm4[ril];
+            dlow = (s->band[0].det*wd2) >> 15;
+
+            /* Block 3L, LOGSCL */
+            il4 = rl42[ril];
+            wd = (s->band[0].nb*127) >> 7;
+            s->band[0].nb = wd + wl[il4];
+            if (s->band[0].nb < 0)
+                s->band[0].nb = 0;
+            else if (s->band[0].nb > 18432)
+                s->band[0].nb = 18432;
+
+            /* Block 3L, SCALEL */
+            wd1 = (s->band[0].nb >> 6) & 31;
+            wd2 = 8 - (s->band[0].nb >> 11);
             wd3 = (wd2 < 0)  ?  (ilb[wd1] << -wd2)  :  (ilb[wd1] >> wd2);
-            s->band[1].det = wd3 << 2;
+            s->band[0].det = wd3 << 2;
 
-            block4(s, 1, dhigh);
-            code = ((ihigh << 6) | ilow) >> (8 - s->bits_per_sample);
-        }
+            block4(&s->band[0], dlow);
+        
+            if (s->eight_k)
+            {
+                /* Just leave the high bits as zero */
+                code = (0xC0 | ilow) >> (8 - s->bits_per_sample);
+            }
+            else
+            {
+                /* Block 1H, SUBTRA */
+                eh = saturate(xhigh[k] - s->band[1].s);
+
+                /* Block 1H, QUANTH */
+                wd = (eh >= 0)  ?  eh  :  -(eh + 1);
+                wd1 = (564*s->band[1].det) >> 12;
+                mih = (wd >= wd1)  ?  2  :  1;
+                ihigh = (eh < 0)  ?  ihn[mih]  :  ihp[mih];
+
+                /* Block 2H, INVQAH */
+                wd2 = qm2[ihigh];
+                dhigh = (s->band[1].det*wd2) >> 15;
+
+                /* Block 3H, LOGSCH */
+                ih2 = rh2[ihigh];
+                wd = (s->band[1].nb*127) >> 7;
+                s->band[1].nb = wd + wh[ih2];
+                if (s->band[1].nb < 0)
+                    s->band[1].nb = 0;
+                else if (s->band[1].nb > 22528)
+                    s->band[1].nb = 22528;
+
+                /* Block 3H, SCALEH */
+                wd1 = (s->band[1].nb >> 6) & 31;
+                wd2 = 10 - (s->band[1].nb >> 11);
+                wd3 = (wd2 < 0)  ?  (ilb[wd1] << -wd2)  :  (ilb[wd1] >> wd2);
+                s->band[1].det = wd3 << 2;
+
+                block4(&s->band[1], dhigh);
+                code = ((ihigh << 6) | ilow) >> (8 - s->bits_per_sample);
+            }
 
-        if (s->packed)
-        {
-            /* Pack the code bits */
-            s->out_buffer |= (code << s->out_bits);
-            s->out_bits += s->bits_per_sample;
-            if (s->out_bits >= 8)
+            if (s->packed)
             {
-                g722_data[g722_bytes++] = (uint8_t) (s->out_buffer & 0xFF);
-                s->out_bits -= 8;
-                s->out_buffer >>= 8;
+                /* Pack the code bits */
+                s->out_buffer |= (code << s->out_bits);
+                s->out_bits += s->bits_per_sample;
+                if (s->out_bits >= 8)
+                {
+                    g722_data[g722_bytes++] = (uint8_t) (s->out_buffer & 0xFF);
+                    s->out_bits -= 8;
+                    s->out_buffer >>= 8;
+                }
+            }
+            else
+            {
+                g722_data[g722_bytes++] = (uint8_t) code;
             }
-        }
-        else
-        {
-            g722_data[g722_bytes++] = (uint8_t) code;
         }
     }
     return g722_bytes;
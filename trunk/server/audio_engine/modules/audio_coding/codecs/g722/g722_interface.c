@@ -57,6 +57,26 @@ int16_t WebRtcG722_Encode(G722EncInst *G722enc_inst,
                        codechar, speechIn, len);
 }
 
+int16_t WebRtcG722_EncodeBatch(G722EncInst* const* G722enc_inst,
+                               int16_t* const* speechIn,
+                               int16_t numChannels,
+                               int16_t len,
+                               int16_t* const* encoded)
+{
+    int16_t bytes = 0;
+    int k;
+
+    if (len < 0 || numChannels < 0) {
+        return -1;
+    }
+
+    for (k = 0; k < numChannels; k++) {
+        bytes = WebRtcG722_Encode(G722enc_inst[k], speechIn[k], len,
+                                  encoded[k]);
+    }
+    return bytes;
+}
+
 int16_t WebRtcG722_CreateDecoder(G722DecInst **G722dec_inst)
 {
     *G722dec_inst=(G722DecInst*)malloc(sizeof(g722_decode_state_t));
@@ -98,6 +118,27 @@ int16_t WebRtcG722_Decode(G722DecInst *G722dec_inst,
                               decoded, (uint8_t*) encoded, len);
 }
 
+int16_t WebRtcG722_DecodeBatch(G722DecInst* const* G722dec_inst,
+                               int16_t* const* encoded,
+                               int16_t numChannels,
+                               int16_t len,
+                               int16_t* const* decoded,
+                               int16_t *speechType)
+{
+    int16_t samples = 0;
+    int k;
+
+    if (len < 0 || numChannels < 0) {
+        return -1;
+    }
+
+    for (k = 0; k < numChannels; k++) {
+        samples = WebRtcG722_Decode(G722dec_inst[k], encoded[k], len,
+                                    decoded[k], speechType);
+    }
+    return samples;
+}
+
 int16_t WebRtcG722_Version(char *versionStr, short len)
 {
     // Get version string
@@ -101,6 +101,33 @@ int16_t WebRtcG722_Encode(G722EncInst *G722enc_inst,
                           int16_t *encoded);
 
 
+/****************************************************************************
+ * WebRtcG722_EncodeBatch(...)
+ *
+ * This function encodes one frame for each of several channels in one call,
+ * e.g. the legs of a conference. Each channel has its own encoder instance,
+ * and the output for each channel is the same as that of WebRtcG722_Encode.
+ *
+ * Input:
+ *     - G722enc_inst         : G722 instances, one per channel
+ *     - speechIn             : Input speech vectors, one per channel
+ *     - numChannels          : Number of channels
+ *     - len                  : Samples in each speech vector
+ *
+ * Output:
+ *        - encoded           : The encoded data vectors, one per channel
+ *
+ * Return value               : >0 - Length (in bytes) of each coded frame
+ *                              -1 - Error
+ */
+
+int16_t WebRtcG722_EncodeBatch(G722EncInst* const* G722enc_inst,
+                               int16_t* const* speechIn,
+                               int16_t numChannels,
+                               int16_t len,
+                               int16_t* const* encoded);
+
+
 /****************************************************************************
  * WebRtcG722_CreateDecoder(...)
  *
@@ -173,6 +200,35 @@ int16_t WebRtcG722_Decode(G722DecInst *G722dec_inst,
                           int16_t *decoded,
                           int16_t *speechType);
 
+/****************************************************************************
+ * WebRtcG722_DecodeBatch(...)
+ *
+ * This function decodes one packet for each of several channels in one call.
+ * Each channel has its own decoder instance, and the output for each channel
+ * is the same as that of WebRtcG722_Decode.
+ *
+ * Input:
+ *     - G722dec_inst       : G722 instances, one per channel
+ *     - encoded            : Encoded G722 frame(s), one vector per channel
+ *     - numChannels        : Number of channels
+ *     - len                : Bytes in each encoded vector
+ *
+ * Output:
+ *        - decoded         : The decoded vectors, one per channel
+ *      - speechType        : 1 normal, 2 CNG (Since G722 does not have its own
+ *                            DTX/CNG scheme it should always return 1)
+ *
+ * Return value             : >0 - Samples in each decoded vector
+ *                            -1 - Error
+ */
+
+int16_t WebRtcG722_DecodeBatch(G722DecInst* const* G722dec_inst,
+                               int16_t* const* encoded,
+                               int16_t numChannels,
+                               int16_t len,
+                               int16_t* const* decoded,
+                               int16_t *speechType);
+
 /****************************************************************************
  * WebRtcG722_Version(...)
  *
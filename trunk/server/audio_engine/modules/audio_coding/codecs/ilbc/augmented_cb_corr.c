@@ -36,28 +36,30 @@ void WebRtcIlbcfix_AugmentedCbCorr(
 {
   int lagcount;
   int16_t ilow;
-  int16_t *targetPtr;
   int32_t *crossDotPtr;
   int16_t *iSPtr=interpSamples;
+  int16_t augVec[SUBL];
 
   /* Calculate the correlation between the target and the
-     interpolated codebook. The correlation is calculated in
-     3 sections with the interpolated part in the middle */
+     interpolated codebook. The codebook vector is assembled from its
+     3 sections, with the interpolated part in the middle, so that each
+     correlation is a single (vectorized) cross correlation */
   crossDotPtr=crossDot;
   for (lagcount=low; lagcount<=high; lagcount++) {
 
     ilow = (int16_t) (lagcount-4);
 
-    /* Compute dot product for the first (lagcount-4) samples */
-    (*crossDotPtr) = WebRtcSpl_DotProductWithScale(target, buffer-lagcount, ilow, scale);
+    /* The first (lagcount-4) samples */
+    WEBRTC_SPL_MEMCPY_W16(augVec, buffer-lagcount, ilow);
 
-    /* Compute dot product on the interpolated samples */
-    (*crossDotPtr) += WebRtcSpl_DotProductWithScale(target+ilow, iSPtr, 4, scale);
-    targetPtr = target + lagcount;
+    /* The interpolated samples */
+    WEBRTC_SPL_MEMCPY_W16(augVec+ilow, iSPtr, 4);
     iSPtr += lagcount-ilow;
 
-    /* Compute dot product for the remaining samples */
-    (*crossDotPtr) += WebRtcSpl_DotProductWithScale(targetPtr, buffer-lagcount, SUBL-lagcount, scale);
+    /* The remaining samples */
+    WEBRTC_SPL_MEMCPY_W16(augVec+lagcount, buffer-lagcount, SUBL-lagcount);
+
+    WebRtcSpl_CrossCorrelation(crossDotPtr, target, augVec, SUBL, 1, scale, 1);
     crossDotPtr++;
   }
 }
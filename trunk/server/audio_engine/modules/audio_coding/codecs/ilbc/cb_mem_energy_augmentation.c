@@ -28,34 +28,26 @@ void WebRtcIlbcfix_CbMemEnergyAugmentation(
     int16_t *energyShifts /* (o) Shift value of the energy */
                                            ){
   int32_t energy, tmp32;
-  int16_t *ppe, *pp, *interpSamplesPtr;
+  int16_t *interpSamplesPtr;
   int16_t *CBmemPtr, lagcount;
   int16_t *enPtr=&energyW16[base_size-20];
   int16_t *enShPtr=&energyShifts[base_size-20];
-  int32_t nrjRecursive;
+  int16_t augVec[SUBL];
 
   CBmemPtr = CBmem+147;
   interpSamplesPtr = interpSamples;
 
-  /* Compute the energy for the first (low-5) noninterpolated samples */
-  nrjRecursive = WebRtcSpl_DotProductWithScale( CBmemPtr-19, CBmemPtr-19, 15, scale);
-  ppe = CBmemPtr - 20;
-
   for (lagcount=20; lagcount<=39; lagcount++) {
 
-    /* Update the energy recursively to save complexity */
-    nrjRecursive = nrjRecursive +
-        WEBRTC_SPL_MUL_16_16_RSFT(*ppe, *ppe, scale);
-    ppe--;
-    energy = nrjRecursive;
-
-    /* interpolation */
-    energy += WebRtcSpl_DotProductWithScale(interpSamplesPtr, interpSamplesPtr, 4, scale);
+    /* Assemble the codebook vector, with the interpolated samples
+       between the two noninterpolated parts, and compute its energy
+       with a single (vectorized) correlation */
+    WEBRTC_SPL_MEMCPY_W16(augVec, CBmemPtr-lagcount, lagcount-4);
+    WEBRTC_SPL_MEMCPY_W16(augVec+lagcount-4, interpSamplesPtr, 4);
     interpSamplesPtr += 4;
+    WEBRTC_SPL_MEMCPY_W16(augVec+lagcount, CBmemPtr-lagcount, SUBL-lagcount);
 
-    /* Compute energy for the remaining samples */
-    pp = CBmemPtr - lagcount;
-    energy += WebRtcSpl_DotProductWithScale(pp, pp, SUBL-lagcount, scale);
+    WebRtcSpl_CrossCorrelation(&energy, augVec, augVec, SUBL, 1, scale, 1);
 
     /* Normalize the energy and store the number of shifts */
     (*enShPtr) = (int16_t)WebRtcSpl_NormW32(energy);
@@ -19,6 +19,110 @@
 #include "defines.h"
 #include "constants.h"
 
+/* SSE2 is part of the x86-64 baseline; on 32-bit x86 it is only used when
+   the compiler is allowed to assume it. */
+#if defined(VOIP_ARCH_X86_64) || defined(__SSE2__) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CB_SEARCH_CORE_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(CB_SEARCH_CORE_SSE2)
+/* Clamps the negative cross correlations of stage 0 to zero */
+static void ClampToZeroSSE2(int32_t *cDot, int range) {
+  int i;
+  for (i=0;i+4<=range;i+=4) {
+    __m128i x = _mm_loadu_si128((__m128i*)&cDot[i]);
+    x = _mm_and_si128(x, _mm_cmpgt_epi32(x, _mm_setzero_si128()));
+    _mm_storeu_si128((__m128i*)&cDot[i], x);
+  }
+  for (;i<range;i++) {
+    cDot[i]=WEBRTC_SPL_MAX(0, cDot[i]);
+  }
+}
+
+/* Calculates the criteria of the first (range & ~7) entries, eight at a
+   time, in the same way as the scalar loop below. Returns the maximum
+   shift of the entries with a nonzero criteria, or WEBRTC_SPL_WORD16_MIN
+   if there are none */
+static int16_t CriteriaSSE2(const int32_t *cDot, int range, int16_t sh,
+                            const int16_t *inverseEnergy,
+                            const int16_t *inverseEnergyShift,
+                            int32_t *Crit) {
+  const __m128i shift = _mm_cvtsi32_si128(sh);
+  const __m128i zero = _mm_setzero_si128();
+  __m128i max = _mm_set1_epi16(WEBRTC_SPL_WORD16_MIN);
+  int16_t maxLanes[8];
+  int i;
+
+  for (i=0;i+8<=range;i+=8) {
+    /* cDot is normalized, so the upper halves fit in an int16_t */
+    __m128i lo = _mm_sll_epi32(_mm_loadu_si128((__m128i*)&cDot[i]), shift);
+    __m128i hi = _mm_sll_epi32(_mm_loadu_si128((__m128i*)&cDot[i+4]), shift);
+    __m128i tmp16 = _mm_packs_epi32(_mm_srai_epi32(lo, 16),
+                                    _mm_srai_epi32(hi, 16));
+    __m128i cDotSq = _mm_mulhi_epi16(tmp16, tmp16);
+    __m128i invE = _mm_loadu_si128((__m128i*)&inverseEnergy[i]);
+    __m128i invESh = _mm_loadu_si128((__m128i*)&inverseEnergyShift[i]);
+    __m128i prodLo = _mm_mullo_epi16(cDotSq, invE);
+    __m128i prodHi = _mm_mulhi_epi16(cDotSq, invE);
+    /* The criteria is zero exactly when one of the factors is zero */
+    __m128i isZero = _mm_or_si128(_mm_cmpeq_epi16(cDotSq, zero),
+                                  _mm_cmpeq_epi16(invE, zero));
+
+    _mm_storeu_si128((__m128i*)&Crit[i], _mm_unpacklo_epi16(prodLo, prodHi));
+    _mm_storeu_si128((__m128i*)&Crit[i+4],
+                     _mm_unpackhi_epi16(prodLo, prodHi));
+    max = _mm_max_epi16(max, _mm_or_si128(
+        _mm_andnot_si128(isZero, invESh),
+        _mm_and_si128(isZero, _mm_set1_epi16(WEBRTC_SPL_WORD16_MIN))));
+  }
+
+  _mm_storeu_si128((__m128i*)maxLanes, max);
+  return WebRtcSpl_MaxValueW16(maxLanes, 8);
+}
+
+/* Shifts the first (range & ~3) criteria right by
+   min(16, max-inverseEnergyShift[i]). Entries with a negative shift have
+   a zero criteria, so the shift is limited to [0, 16] and applied as five
+   conditional shifts of 1, 2, 4, 8 and 16 */
+static void AlignCriteriaSSE2(int32_t *Crit, int range, int16_t max,
+                              const int16_t *inverseEnergyShift) {
+  const __m128i maxShift = _mm_set1_epi32(max);
+  const __m128i limit = _mm_set1_epi32(16);
+  const __m128i zero = _mm_setzero_si128();
+  int i;
+
+  for (i=0;i+4<=range;i+=4) {
+    __m128i crit = _mm_loadu_si128((__m128i*)&Crit[i]);
+    __m128i sh = _mm_loadl_epi64((__m128i*)&inverseEnergyShift[i]);
+    __m128i count, mask;
+
+    /* Sign extend the shifts to 32 bits */
+    sh = _mm_srai_epi32(_mm_unpacklo_epi16(sh, sh), 16);
+    count = _mm_sub_epi32(maxShift, sh);
+    count = _mm_and_si128(count, _mm_cmpgt_epi32(count, zero));
+    mask = _mm_cmpgt_epi32(count, limit);
+    count = _mm_or_si128(_mm_and_si128(mask, limit),
+                         _mm_andnot_si128(mask, count));
+
+#define ALIGN_CRIT_STEP(n)                                              \
+    mask = _mm_cmpeq_epi32(_mm_and_si128(count, _mm_set1_epi32(n)),     \
+                           _mm_set1_epi32(n));                          \
+    crit = _mm_or_si128(_mm_and_si128(mask, _mm_srai_epi32(crit, n)),   \
+                        _mm_andnot_si128(mask, crit))
+    ALIGN_CRIT_STEP(1);
+    ALIGN_CRIT_STEP(2);
+    ALIGN_CRIT_STEP(4);
+    ALIGN_CRIT_STEP(8);
+    ALIGN_CRIT_STEP(16);
+#undef ALIGN_CRIT_STEP
+
+    _mm_storeu_si128((__m128i*)&Crit[i], crit);
+  }
+}
+#endif
+
 void WebRtcIlbcfix_CbSearchCore(
     int32_t *cDot,    /* (i) Cross Correlation */
     int16_t range,    /* (i) Search range */
@@ -43,27 +147,38 @@ void WebRtcIlbcfix_CbSearchCore(
   int16_t *inverseEnergyPtr;
   int32_t *critPtr;
   int16_t *inverseEnergyShiftPtr;
+  int start;
 
   /* Don't allow negative values for stage 0 */
   if (stage==0) {
+#if defined(CB_SEARCH_CORE_SSE2)
+    ClampToZeroSSE2(cDot, range);
+#else
     cDotPtr=cDot;
     for (i=0;i<range;i++) {
       *cDotPtr=WEBRTC_SPL_MAX(0, (*cDotPtr));
       cDotPtr++;
     }
+#endif
   }
 
   /* Normalize cDot to int16_t, calculate the square of cDot and store the upper int16_t */
   maxW32 = WebRtcSpl_MaxAbsValueW32(cDot, range);
 
   sh = (int16_t)WebRtcSpl_NormW32(maxW32);
-  cDotPtr = cDot;
-  inverseEnergyPtr = inverseEnergy;
-  critPtr = Crit;
-  inverseEnergyShiftPtr=inverseEnergyShift;
+#if defined(CB_SEARCH_CORE_SSE2)
+  start = range & ~7;
+  max = CriteriaSSE2(cDot, start, sh, inverseEnergy, inverseEnergyShift, Crit);
+#else
+  start = 0;
   max=WEBRTC_SPL_WORD16_MIN;
+#endif
+  cDotPtr = cDot+start;
+  inverseEnergyPtr = inverseEnergy+start;
+  critPtr = Crit+start;
+  inverseEnergyShiftPtr=inverseEnergyShift+start;
 
-  for (i=0;i<range;i++) {
+  for (i=start;i<range;i++) {
     /* Calculate cDot*cDot and put the result in a int16_t */
     tmp32 = WEBRTC_SPL_LSHIFT_W32(*cDotPtr,sh);
     tmp16 = (int16_t)WEBRTC_SPL_RSHIFT_W32(tmp32,16);
@@ -90,9 +205,15 @@ void WebRtcIlbcfix_CbSearchCore(
   }
 
   /* Modify the criterias, so that all of them use the same Q domain */
-  critPtr=Crit;
-  inverseEnergyShiftPtr=inverseEnergyShift;
-  for (i=0;i<range;i++) {
+#if defined(CB_SEARCH_CORE_SSE2)
+  start = range & ~3;
+  AlignCriteriaSSE2(Crit, start, max, inverseEnergyShift);
+#else
+  start = 0;
+#endif
+  critPtr=Crit+start;
+  inverseEnergyShiftPtr=inverseEnergyShift+start;
+  for (i=start;i<range;i++) {
     /* Guarantee that the shift value is less than 16
        in order to simplify for DSP's (and guard against >31) */
     tmp16 = WEBRTC_SPL_MIN(16, max-(*inverseEnergyShiftPtr));
@@ -101,6 +101,17 @@ void WebRtcIsacfix_Spec2TimeNeon(int16_t* inreQ7,
                                  int32_t* outre2Q16);
 #endif
 
+#if defined(VOIP_ARCH_X86_FAMILY)
+void WebRtcIsacfix_Time2SpecSSE2(int16_t* inre1Q9,
+                                 int16_t* inre2Q9,
+                                 int16_t* outre,
+                                 int16_t* outim);
+void WebRtcIsacfix_Spec2TimeSSE2(int16_t* inreQ7,
+                                 int16_t* inimQ7,
+                                 int32_t* outre1Q16,
+                                 int32_t* outre2Q16);
+#endif
+
 
 /* filterbank functions */
 
@@ -149,7 +160,7 @@ void WebRtcIsacfix_NormLatticeFilterAr(int16_t orderCoef,
 
 /* TODO(kma): Remove the following functions into individual header files. */
 
-/* Internal functions in both C and ARM Neon versions */
+/* Internal functions in C, ARM Neon and x86 SSE2 versions */
 
 int WebRtcIsacfix_AutocorrC(int32_t* __restrict r,
                             const int16_t* __restrict x,
@@ -179,6 +190,21 @@ void WebRtcIsacfix_FilterMaLoopNeon(int16_t input0,
                                     int32_t* ptr2);
 #endif
 
+#if defined(VOIP_ARCH_X86_FAMILY)
+int WebRtcIsacfix_AutocorrSSE2(int32_t* __restrict r,
+                               const int16_t* __restrict x,
+                               int16_t N,
+                               int16_t order,
+                               int16_t* __restrict scale);
+
+void WebRtcIsacfix_FilterMaLoopSSE2(int16_t input0,
+                                    int16_t input1,
+                                    int32_t input2,
+                                    int32_t* ptr0,
+                                    int32_t* ptr1,
+                                    int32_t* ptr2);
+#endif
+
 /* Function pointers associated with the above functions. */
 
 typedef int (*AutocorrFix)(int32_t* __restrict r,
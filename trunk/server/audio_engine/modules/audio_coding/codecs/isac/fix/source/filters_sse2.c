@@ -0,0 +1,81 @@
+/*
+ *  Copyright (c) 2014 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <assert.h>
+#include <emmintrin.h>
+
+#include "audio_engine/modules/audio_coding/codecs/isac/fix/source/codec.h"
+
+// Returns the 64-bit sum of the products x[j] * y[j], 0 <= j < n.
+static int64_t DotProductW64(const int16_t* x, const int16_t* y, int n) {
+  const __m128i kMinW32 = _mm_set1_epi32((int32_t)0x80000000);
+  __m128i sum = _mm_setzero_si128();
+  int64_t result = 0;
+  int j = 0;
+
+  for (j = 0; j + 8 <= n; j += 8) {
+    const __m128i a = _mm_loadu_si128((const __m128i*)&x[j]);
+    const __m128i b = _mm_loadu_si128((const __m128i*)&y[j]);
+    const __m128i pairs = _mm_madd_epi16(a, b);
+    // A pair sum only overflows if both products are (-32768)^2, which wraps
+    // to INT32_MIN. No other pair sum can be INT32_MIN, so that value is
+    // taken as positive when sign-extending to 64 bits.
+    const __m128i sign = _mm_andnot_si128(_mm_cmpeq_epi32(pairs, kMinW32),
+                                          _mm_srai_epi32(pairs, 31));
+    sum = _mm_add_epi64(sum, _mm_unpacklo_epi32(pairs, sign));
+    sum = _mm_add_epi64(sum, _mm_unpackhi_epi32(pairs, sign));
+  }
+  sum = _mm_add_epi64(sum, _mm_unpackhi_epi64(sum, sum));
+  _mm_storel_epi64((__m128i*)&result, sum);
+
+  for (; j < n; j++) {
+    result += WEBRTC_SPL_MUL_16_16(x[j], y[j]);
+  }
+  return result;
+}
+
+// Version of WebRtcIsacfix_AutocorrC() for x86 platforms with SSE2. The
+// products are accumulated in 64 bits as in the C version, so the results are
+// bit-exact.
+int WebRtcIsacfix_AutocorrSSE2(int32_t* __restrict r,
+                               const int16_t* __restrict x,
+                               int16_t N,
+                               int16_t order,
+                               int16_t* __restrict scale) {
+  int i = 0;
+  int16_t scaling = 0;
+  uint32_t temp = 0;
+  int64_t prod = 0;
+
+  assert(N % 4 == 0);
+  assert(N >= 8);
+
+  // Calculate r[0].
+  prod = DotProductW64(x, x, N);
+
+  // Calculate scaling (the value of shifting).
+  temp = (uint32_t)(prod >> 31);
+  if (temp == 0) {
+    scaling = 0;
+  } else {
+    scaling = 32 - WebRtcSpl_NormU32(temp);
+  }
+  r[0] = (int32_t)(prod >> scaling);
+
+  // Perform the actual correlation calculation.
+  for (i = 1; i < order + 1; i++) {
+    prod = DotProductW64(x, &x[i], N - i);
+    r[i] = (int32_t)(prod >> scaling);
+  }
+
+  *scale = scaling;
+
+  return(order + 1);
+}
@@ -0,0 +1,79 @@
+/*
+ *  Copyright (c) 2014 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+/*
+ * fixed_point_sse2.h
+ *
+ * SSE2 versions of the 16 x 32 bit multiplication macros of the signal
+ * processing library, shared by the x86 versions of the iSAC-fix kernels.
+ * All of them work on four int32_t lanes and are bit-exact with the macros,
+ * including the wrap-around of the 32-bit intermediate results.
+ *
+ * The 16-bit factor |a| is given in two forms, which are computed once per
+ * call with Mul16Factors(): |a_lo| has a in the low half of each lane and
+ * zero in the high half, |a_hi| has a in the high half and zero in the low
+ * half, i.e. it equals a << 16.
+ */
+
+#ifndef WEBRTC_MODULES_AUDIO_CODING_CODECS_ISAC_FIX_SOURCE_FIXED_POINT_SSE2_H_
+#define WEBRTC_MODULES_AUDIO_CODING_CODECS_ISAC_FIX_SOURCE_FIXED_POINT_SSE2_H_
+
+#include <emmintrin.h>
+
+// Splits the 16-bit values in the low halves of the lanes of |a|.
+static __inline void Mul16Factors(__m128i a, __m128i* a_lo, __m128i* a_hi) {
+  *a_hi = _mm_slli_epi32(a, 16);
+  *a_lo = _mm_srli_epi32(*a_hi, 16);
+}
+
+// a * (b >> 16), i.e. WEBRTC_SPL_MUL_16_16(a, b >> 16).
+static __inline __m128i MulHigh16x32(__m128i a_hi, __m128i b) {
+  return _mm_madd_epi16(b, a_hi);
+}
+
+// a * (uint16_t)b, i.e. WEBRTC_SPL_MUL_16_U16(a, b). _mm_madd_epi16() takes
+// the low half of |b| as signed, which is off by 65536 * a when bit 15 is set.
+static __inline __m128i MulLowU16x32(__m128i a_lo, __m128i a_hi, __m128i b) {
+  const __m128i bit15 = _mm_srai_epi32(_mm_slli_epi32(b, 16), 31);
+  return _mm_add_epi32(_mm_madd_epi16(b, a_lo), _mm_and_si128(bit15, a_hi));
+}
+
+// The low 32 bits of a * b, i.e. WEBRTC_SPL_MUL(a, b) for a 16-bit a.
+static __inline __m128i Mul16x32(__m128i a_lo, __m128i a_hi, __m128i b) {
+  return _mm_add_epi32(_mm_slli_epi32(MulHigh16x32(a_hi, b), 16),
+                       MulLowU16x32(a_lo, a_hi, b));
+}
+
+// WEBRTC_SPL_MUL_16_32_RSFT11/14/15(a, b), which only differ in the shifts.
+#define MUL_16_32_RSFT_SSE2(a_lo, a_hi, b, q)                           \
+  _mm_add_epi32(                                                        \
+      _mm_slli_epi32(MulHigh16x32(a_hi, b), 16 - (q)),                  \
+      _mm_srai_epi32(                                                   \
+          _mm_add_epi32(_mm_srai_epi32(MulLowU16x32(a_lo, a_hi, b), 1), \
+                        _mm_set1_epi32(1 << ((q) - 2))),                \
+          (q) - 1))
+
+// WEBRTC_SPL_MUL_16_32_RSFT16(a, b).
+static __inline __m128i Mul16x32Rsft16(__m128i a_lo, __m128i a_hi, __m128i b) {
+  // (b & 0xffff) >> 1 fits in 15 bits, so the signed product is exact.
+  const __m128i b_lo = _mm_srli_epi32(_mm_slli_epi32(b, 16), 17);
+  const __m128i lo = _mm_srai_epi32(
+      _mm_add_epi32(_mm_madd_epi16(b_lo, a_lo), _mm_set1_epi32(0x4000)), 15);
+  return _mm_add_epi32(MulHigh16x32(a_hi, b), lo);
+}
+
+// Truncates the lanes of |lo| and |hi| to 16 bits, like an (int16_t) cast.
+static __inline __m128i TruncateW32ToW16(__m128i lo, __m128i hi) {
+  lo = _mm_srai_epi32(_mm_slli_epi32(lo, 16), 16);
+  hi = _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16);
+  return _mm_packs_epi32(lo, hi);
+}
+
+#endif  // WEBRTC_MODULES_AUDIO_CODING_CODECS_ISAC_FIX_SOURCE_FIXED_POINT_SSE2_H_
@@ -199,6 +199,21 @@ static void WebRtcIsacfix_InitNeon(void) {
 }
 #endif
 
+/****************************************************************************
+ * WebRtcIsacfix_InitSSE2(...)
+ *
+ * This function initializes function pointers for x86 platforms with SSE2.
+ */
+
+#if defined(VOIP_ARCH_X86_FAMILY)
+static void WebRtcIsacfix_InitSSE2(void) {
+  WebRtcIsacfix_AutocorrFix = WebRtcIsacfix_AutocorrSSE2;
+  WebRtcIsacfix_FilterMaLoopFix = WebRtcIsacfix_FilterMaLoopSSE2;
+  WebRtcIsacfix_Spec2Time = WebRtcIsacfix_Spec2TimeSSE2;
+  WebRtcIsacfix_Time2Spec = WebRtcIsacfix_Time2SpecSSE2;
+}
+#endif
+
 /****************************************************************************
  * WebRtcIsacfix_EncoderInit(...)
  *
@@ -294,6 +309,12 @@ int16_t WebRtcIsacfix_EncoderInit(ISACFIX_MainStruct *ISAC_main_inst,
   }
 #elif defined(VOIP_ARCH_ARM_NEON)
   WebRtcIsacfix_InitNeon();
+#elif defined(VOIP_ARCH_X86_FAMILY) && defined(__SSE2__)
+  WebRtcIsacfix_InitSSE2();
+#elif defined(VOIP_ARCH_X86_FAMILY)
+  if (WebRtc_GetCPUInfo(kSSE2)) {
+    WebRtcIsacfix_InitSSE2();
+  }
 #endif
 
   return statusInit;
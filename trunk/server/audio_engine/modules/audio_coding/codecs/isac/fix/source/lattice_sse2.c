@@ -0,0 +1,72 @@
+/*
+ *  Copyright (c) 2014 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <emmintrin.h>
+
+#include "audio_engine/modules/audio_coding/codecs/isac/fix/source/codec.h"
+#include "audio_engine/modules/audio_coding/codecs/isac/fix/source/fixed_point_sse2.h"
+#include "audio_engine/modules/audio_coding/codecs/isac/fix/source/settings.h"
+
+// Version of WebRtcIsacfix_FilterMaLoopC() for x86 platforms with SSE2. The
+// iterations of the loop are independent, so four samples are filtered at a
+// time. Unlike the Neon version, it is bit-exact with the C version: the
+// 32 x 32 bit multiplication by |input2| is split into 16-bit halves in the
+// same way as LATTICE_MUL_32_32_RSFT16.
+void WebRtcIsacfix_FilterMaLoopSSE2(int16_t input0,  // Filter coefficient
+                                    int16_t input1,  // Filter coefficient
+                                    int32_t input2,  // Inverse coeff (1/input1)
+                                    int32_t* ptr0,   // Sample buffer
+                                    int32_t* ptr1,   // Sample buffer
+                                    int32_t* ptr2) { // Sample buffer
+  int n = 0;
+  __m128i in0_lo, in0_hi, in1_lo, in1_hi, t16a_lo, t16a_hi, t16b_lo, t16b_hi;
+
+  // Separate the 32-bit variable input2 into two 16-bit integers (high 16 and
+  // low 16 bits), as in the C version.
+  int16_t t16a = (int16_t)(input2 >> 16);
+  int16_t t16b = (int16_t)input2;
+  if (t16b < 0) t16a++;
+
+  Mul16Factors(_mm_set1_epi32(input0), &in0_lo, &in0_hi);
+  Mul16Factors(_mm_set1_epi32(input1), &in1_lo, &in1_hi);
+  Mul16Factors(_mm_set1_epi32(t16a), &t16a_lo, &t16a_hi);
+  Mul16Factors(_mm_set1_epi32(t16b), &t16b_lo, &t16b_hi);
+
+  for (n = 0; n + 4 <= HALF_SUBFRAMELEN - 1; n += 4) {
+    const __m128i x0 = _mm_loadu_si128((const __m128i*)&ptr0[n]);
+    const __m128i x2 = _mm_loadu_si128((const __m128i*)&ptr2[n]);
+    __m128i tmp, y2, y1;
+
+    // *ptr2 = input2 * (*ptr2 + input0 * (*ptr0));
+    tmp = _mm_add_epi32(x2, MUL_16_32_RSFT_SSE2(in0_lo, in0_hi, x0, 15));
+    y2 = _mm_add_epi32(Mul16x32(t16a_lo, t16a_hi, tmp),
+                       Mul16x32Rsft16(t16b_lo, t16b_hi, tmp));
+    _mm_storeu_si128((__m128i*)&ptr2[n], y2);
+
+    // *ptr1 = input1 * (*ptr0) + input0 * (*ptr2);
+    y1 = _mm_add_epi32(MUL_16_32_RSFT_SSE2(in1_lo, in1_hi, x0, 15),
+                       MUL_16_32_RSFT_SSE2(in0_lo, in0_hi, y2, 15));
+    _mm_storeu_si128((__m128i*)&ptr1[n], y1);
+  }
+
+  for (; n < HALF_SUBFRAMELEN - 1; n++) {
+    int32_t tmp32a = 0;
+    int32_t tmp32b = 0;
+
+    tmp32a = WEBRTC_SPL_MUL_16_32_RSFT15(input0, ptr0[n]);
+    tmp32b = ptr2[n] + tmp32a;
+    ptr2[n] = WEBRTC_SPL_MUL(t16a, tmp32b) +
+        WEBRTC_SPL_MUL_16_32_RSFT16(t16b, tmp32b);
+
+    tmp32a = WEBRTC_SPL_MUL_16_32_RSFT15(input1, ptr0[n]);
+    tmp32b = WEBRTC_SPL_MUL_16_32_RSFT15(input0, ptr2[n]);
+    ptr1[n] = tmp32a + tmp32b;
+  }
+}
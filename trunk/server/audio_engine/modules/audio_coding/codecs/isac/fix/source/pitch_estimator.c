@@ -224,16 +224,9 @@ static void PCorr2Q32(const int16_t *in, int32_t *logcorQ8)
       csum32 += vbuff[3];
     }
 #else
-    csum32 = 0;
-    if(scaling == 0) {
-      for (n = 0; n < PITCH_CORR_LEN2; n++) {
-        csum32 += x[n] * inptr[n];
-      }
-    } else {
-      for (n = 0; n < PITCH_CORR_LEN2; n++) {
-        csum32 += (x[n] * inptr[n]) >> scaling;
-      }
-    }
+    // Dispatched to the SSE2 version on x86.
+    WebRtcSpl_CrossCorrelation(&csum32, x, inptr, PITCH_CORR_LEN2, 1, scaling,
+                               1);
 #endif
 
     logcorQ8--;
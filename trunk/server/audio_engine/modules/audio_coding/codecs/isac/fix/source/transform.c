@@ -28,8 +28,9 @@ extern const int16_t WebRtcIsacfix_kSinTab1[FRAMESAMPLES/2];
 /* Sine table 2 in Q14 */
 extern const int16_t WebRtcIsacfix_kSinTab2[FRAMESAMPLES/4];
 #else
+/* The tables are also used by the SSE2 versions in transform_sse2.c. */
 /* Cosine table 1 in Q14 */
-static const int16_t WebRtcIsacfix_kCosTab1[FRAMESAMPLES/2] = {
+const int16_t WebRtcIsacfix_kCosTab1[FRAMESAMPLES/2] = {
   16384,  16383,  16378,  16371,  16362,  16349,  16333,  16315,  16294,  16270,
   16244,  16214,  16182,  16147,  16110,  16069,  16026,  15980,  15931,  15880,
   15826,  15769,  15709,  15647,  15582,  15515,  15444,  15371,  15296,  15218,
@@ -58,7 +59,7 @@ static const int16_t WebRtcIsacfix_kCosTab1[FRAMESAMPLES/2] = {
 };
 
 /* Sine table 1 in Q14 */
-static const int16_t WebRtcIsacfix_kSinTab1[FRAMESAMPLES/2] = {
+const int16_t WebRtcIsacfix_kSinTab1[FRAMESAMPLES/2] = {
   0,   214,   429,   643,   857,  1072,  1285,  1499,  1713,  1926,
   2139,  2351,  2563,  2775,  2986,  3196,  3406,  3616,  3825,  4033,
   4240,  4447,  4653,  4859,  5063,  5266,  5469,  5671,  5872,  6071,
@@ -87,7 +88,7 @@ static const int16_t WebRtcIsacfix_kSinTab1[FRAMESAMPLES/2] = {
 
 
 /* Sine table 2 in Q14 */
-static const int16_t WebRtcIsacfix_kSinTab2[FRAMESAMPLES/4] = {
+const int16_t WebRtcIsacfix_kSinTab2[FRAMESAMPLES/4] = {
   16384, -16381, 16375, -16367, 16356, -16342, 16325, -16305, 16283, -16257,
   16229, -16199, 16165, -16129, 16090, -16048, 16003, -15956, 15906, -15853,
   15798, -15739, 15679, -15615, 15549, -15480, 15408, -15334, 15257, -15178,
@@ -0,0 +1,275 @@
+/*
+ *  Copyright (c) 2014 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+/*
+ * transform_sse2.c
+ *
+ * Versions of the transform functions for x86 platforms with SSE2. The
+ * modulation, scaling and separation loops around the FFT work on four or
+ * eight samples at a time; the FFT itself is shared with the C versions.
+ * Both functions are bit-exact with the C versions.
+ *
+ */
+
+#include <emmintrin.h>
+
+#include "audio_engine/modules/audio_coding/codecs/isac/fix/source/codec.h"
+#include "audio_engine/modules/audio_coding/codecs/isac/fix/source/fft.h"
+#include "audio_engine/modules/audio_coding/codecs/isac/fix/source/fixed_point_sse2.h"
+#include "audio_engine/modules/audio_coding/codecs/isac/fix/source/settings.h"
+
+/* Tables are defined in transform.c. */
+extern const int16_t WebRtcIsacfix_kCosTab1[FRAMESAMPLES/2];
+extern const int16_t WebRtcIsacfix_kSinTab1[FRAMESAMPLES/2];
+extern const int16_t WebRtcIsacfix_kSinTab2[FRAMESAMPLES/4];
+
+// Loads four int16_t values, sign-extended to int32_t.
+static __inline __m128i LoadW16ToW32(const int16_t* p) {
+  const __m128i x = _mm_loadl_epi64((const __m128i*)p);
+  return _mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16);
+}
+
+// Stores the lanes of |x|, truncated to int16_t, to p[0..3].
+static __inline void StoreW32ToW16(int16_t* p, __m128i x) {
+  _mm_storel_epi64((__m128i*)p, TruncateW32ToW16(x, x));
+}
+
+static __inline __m128i Reverse(__m128i x) {
+  return _mm_shuffle_epi32(x, _MM_SHUFFLE(0, 1, 2, 3));
+}
+
+// Scales |in1| and |in2| to Q(16+sh) in |out1| and |out2| before the FFT.
+static void ScaleW32ToW16(const int32_t* in1,
+                          const int32_t* in2,
+                          int16_t sh,
+                          int16_t* out1,
+                          int16_t* out2) {
+  int k;
+  if (sh >= 0) {
+    const __m128i shift = _mm_cvtsi32_si128(sh);
+    for (k = 0; k < FRAMESAMPLES/2; k += 8) {
+      __m128i lo = _mm_loadu_si128((const __m128i*)&in1[k]);
+      __m128i hi = _mm_loadu_si128((const __m128i*)&in1[k + 4]);
+      _mm_storeu_si128((__m128i*)&out1[k],
+                       TruncateW32ToW16(_mm_sll_epi32(lo, shift),
+                                        _mm_sll_epi32(hi, shift)));
+      lo = _mm_loadu_si128((const __m128i*)&in2[k]);
+      hi = _mm_loadu_si128((const __m128i*)&in2[k + 4]);
+      _mm_storeu_si128((__m128i*)&out2[k],
+                       TruncateW32ToW16(_mm_sll_epi32(lo, shift),
+                                        _mm_sll_epi32(hi, shift)));
+    }
+  } else {
+    const __m128i shift = _mm_cvtsi32_si128(-sh);
+    const __m128i round = _mm_set1_epi32(WEBRTC_SPL_LSHIFT_W32((int32_t)1,
+                                                               -sh - 1));
+    for (k = 0; k < FRAMESAMPLES/2; k += 8) {
+      __m128i lo = _mm_loadu_si128((const __m128i*)&in1[k]);
+      __m128i hi = _mm_loadu_si128((const __m128i*)&in1[k + 4]);
+      lo = _mm_sra_epi32(_mm_add_epi32(lo, round), shift);
+      hi = _mm_sra_epi32(_mm_add_epi32(hi, round), shift);
+      _mm_storeu_si128((__m128i*)&out1[k], TruncateW32ToW16(lo, hi));
+      lo = _mm_loadu_si128((const __m128i*)&in2[k]);
+      hi = _mm_loadu_si128((const __m128i*)&in2[k + 4]);
+      lo = _mm_sra_epi32(_mm_add_epi32(lo, round), shift);
+      hi = _mm_sra_epi32(_mm_add_epi32(hi, round), shift);
+      _mm_storeu_si128((__m128i*)&out2[k], TruncateW32ToW16(lo, hi));
+    }
+  }
+}
+
+// Scales four samples from Q(16+sh) back to Q16 after the FFT.
+static __inline __m128i UnscaleW16ToW32(const int16_t* in, int16_t sh) {
+  const __m128i x = LoadW16ToW32(in);
+  if (sh >= 0) {
+    return _mm_sra_epi32(x, _mm_cvtsi32_si128(sh));
+  }
+  return _mm_sll_epi32(x, _mm_cvtsi32_si128(-sh));
+}
+
+// Returns the larger of the maximum absolute values of |in1| and |in2|.
+static int32_t MaxAbsValue(const int32_t* in1, const int32_t* in2) {
+  int32_t max1 = WebRtcSpl_MaxAbsValueW32(in1, FRAMESAMPLES/2);
+  int32_t max2 = WebRtcSpl_MaxAbsValueW32(in2, FRAMESAMPLES/2);
+  return (max2 > max1) ? max2 : max1;
+}
+
+void WebRtcIsacfix_Time2SpecSSE2(int16_t* inre1Q9,
+                                 int16_t* inre2Q9,
+                                 int16_t* outreQ7,
+                                 int16_t* outimQ7) {
+  int k;
+  int32_t tmpreQ16[FRAMESAMPLES/2], tmpimQ16[FRAMESAMPLES/2];
+  int16_t sh;
+  __m128i fact_lo, fact_hi;
+
+  /* Multiply with complex exponentials and combine into one complex vector */
+  // 0.5/sqrt(240) in Q19 is round(.5/sqrt(240)*(2^19)) = 16921
+  Mul16Factors(_mm_set1_epi32(16921), &fact_lo, &fact_hi);
+  for (k = 0; k < FRAMESAMPLES/2; k += 8) {
+    const __m128i re1 = _mm_loadu_si128((const __m128i*)&inre1Q9[k]);
+    const __m128i re2 = _mm_loadu_si128((const __m128i*)&inre2Q9[k]);
+    const __m128i cos_tab =
+        _mm_loadu_si128((const __m128i*)&WebRtcIsacfix_kCosTab1[k]);
+    const __m128i sin_tab =
+        _mm_loadu_si128((const __m128i*)&WebRtcIsacfix_kSinTab1[k]);
+    const __m128i neg_sin = _mm_sub_epi16(_mm_setzero_si128(), sin_tab);
+    const __m128i cs_lo = _mm_unpacklo_epi16(cos_tab, sin_tab);
+    const __m128i cs_hi = _mm_unpackhi_epi16(cos_tab, sin_tab);
+    const __m128i cns_lo = _mm_unpacklo_epi16(cos_tab, neg_sin);
+    const __m128i cns_hi = _mm_unpackhi_epi16(cos_tab, neg_sin);
+    const __m128i kRound = _mm_set1_epi32(4);
+    __m128i xr, xi;
+
+    // xr = (cos * re1 + sin * re2) >> 7, xi = (cos * re2 - sin * re1) >> 7.
+    xr = _mm_madd_epi16(_mm_unpacklo_epi16(re1, re2), cs_lo);
+    xi = _mm_madd_epi16(_mm_unpacklo_epi16(re2, re1), cns_lo);
+    xr = Mul16x32Rsft16(fact_lo, fact_hi, _mm_srai_epi32(xr, 7));
+    xi = Mul16x32Rsft16(fact_lo, fact_hi, _mm_srai_epi32(xi, 7));
+    _mm_storeu_si128((__m128i*)&tmpreQ16[k],
+                     _mm_srai_epi32(_mm_add_epi32(xr, kRound), 3));
+    _mm_storeu_si128((__m128i*)&tmpimQ16[k],
+                     _mm_srai_epi32(_mm_add_epi32(xi, kRound), 3));
+
+    xr = _mm_madd_epi16(_mm_unpackhi_epi16(re1, re2), cs_hi);
+    xi = _mm_madd_epi16(_mm_unpackhi_epi16(re2, re1), cns_hi);
+    xr = Mul16x32Rsft16(fact_lo, fact_hi, _mm_srai_epi32(xr, 7));
+    xi = Mul16x32Rsft16(fact_lo, fact_hi, _mm_srai_epi32(xi, 7));
+    _mm_storeu_si128((__m128i*)&tmpreQ16[k + 4],
+                     _mm_srai_epi32(_mm_add_epi32(xr, kRound), 3));
+    _mm_storeu_si128((__m128i*)&tmpimQ16[k + 4],
+                     _mm_srai_epi32(_mm_add_epi32(xi, kRound), 3));
+  }
+
+  sh = WebRtcSpl_NormW32(MaxAbsValue(tmpreQ16, tmpimQ16));
+  sh = sh - 24;
+  ScaleW32ToW16(tmpreQ16, tmpimQ16, sh, inre1Q9, inre2Q9);
+
+  /* Get DFT */
+  WebRtcIsacfix_FftRadix16Fastest(inre1Q9, inre2Q9, -1); // real call
+
+  for (k = 0; k < FRAMESAMPLES/2; k += 4) {
+    _mm_storeu_si128((__m128i*)&tmpreQ16[k],
+                     UnscaleW16ToW32(&inre1Q9[k], sh));
+    _mm_storeu_si128((__m128i*)&tmpimQ16[k],
+                     UnscaleW16ToW32(&inre2Q9[k], sh));
+  }
+
+  /* Use symmetry to separate into two complex vectors and center frames in time around zero */
+  for (k = 0; k < FRAMESAMPLES/4; k += 4) {
+    const int k2 = FRAMESAMPLES/2 - 4 - k;  // Mirrored block, reversed.
+    const __m128i re = _mm_loadu_si128((const __m128i*)&tmpreQ16[k]);
+    const __m128i im = _mm_loadu_si128((const __m128i*)&tmpimQ16[k]);
+    const __m128i re2 =
+        Reverse(_mm_loadu_si128((const __m128i*)&tmpreQ16[k2]));
+    const __m128i im2 =
+        Reverse(_mm_loadu_si128((const __m128i*)&tmpimQ16[k2]));
+    const __m128i xr = _mm_add_epi32(re, re2);
+    const __m128i yi = _mm_sub_epi32(re2, re);
+    const __m128i xi = _mm_sub_epi32(im, im2);
+    const __m128i yr = _mm_add_epi32(im, im2);
+    __m128i r_lo, r_hi, i_lo, i_hi, v1, v2;
+
+    Mul16Factors(_mm_sub_epi32(_mm_setzero_si128(), Reverse(LoadW16ToW32(
+        &WebRtcIsacfix_kSinTab2[FRAMESAMPLES/4 - 4 - k]))), &r_lo, &r_hi);
+    Mul16Factors(LoadW16ToW32(&WebRtcIsacfix_kSinTab2[k]), &i_lo, &i_hi);
+
+    v1 = _mm_sub_epi32(MUL_16_32_RSFT_SSE2(r_lo, r_hi, xr, 14),
+                       MUL_16_32_RSFT_SSE2(i_lo, i_hi, xi, 14));
+    v2 = _mm_add_epi32(MUL_16_32_RSFT_SSE2(i_lo, i_hi, xr, 14),
+                       MUL_16_32_RSFT_SSE2(r_lo, r_hi, xi, 14));
+    StoreW32ToW16(&outreQ7[k], _mm_srai_epi32(v1, 9));
+    StoreW32ToW16(&outimQ7[k], _mm_srai_epi32(v2, 9));
+
+    v1 = _mm_sub_epi32(
+        _mm_sub_epi32(_mm_setzero_si128(),
+                      MUL_16_32_RSFT_SSE2(i_lo, i_hi, yr, 14)),
+        MUL_16_32_RSFT_SSE2(r_lo, r_hi, yi, 14));
+    v2 = _mm_sub_epi32(MUL_16_32_RSFT_SSE2(i_lo, i_hi, yi, 14),
+                       MUL_16_32_RSFT_SSE2(r_lo, r_hi, yr, 14));
+    StoreW32ToW16(&outreQ7[k2], Reverse(_mm_srai_epi32(v1, 9)));
+    StoreW32ToW16(&outimQ7[k2], Reverse(_mm_srai_epi32(v2, 9)));
+  }
+}
+
+void WebRtcIsacfix_Spec2TimeSSE2(int16_t* inreQ7,
+                                 int16_t* inimQ7,
+                                 int32_t* outre1Q16,
+                                 int32_t* outre2Q16) {
+  int k;
+  int16_t sh;
+  __m128i scale_lo, scale_hi, fact_lo, fact_hi;
+
+  for (k = 0; k < FRAMESAMPLES/4; k += 4) {
+    const int k2 = FRAMESAMPLES/2 - 4 - k;  // Mirrored block, reversed.
+    // Move zero in time to beginning of frames, Q7 -> Q16.
+    const __m128i in_re = _mm_slli_epi32(LoadW16ToW32(&inreQ7[k]), 9);
+    const __m128i in_im = _mm_slli_epi32(LoadW16ToW32(&inimQ7[k]), 9);
+    const __m128i in_re2 =
+        _mm_slli_epi32(Reverse(LoadW16ToW32(&inreQ7[k2])), 9);
+    const __m128i in_im2 =
+        _mm_slli_epi32(Reverse(LoadW16ToW32(&inimQ7[k2])), 9);
+    __m128i r_lo, r_hi, i_lo, i_hi, xr, xi, yr, yi;
+
+    Mul16Factors(_mm_sub_epi32(_mm_setzero_si128(), Reverse(LoadW16ToW32(
+        &WebRtcIsacfix_kSinTab2[FRAMESAMPLES/4 - 4 - k]))), &r_lo, &r_hi);
+    Mul16Factors(LoadW16ToW32(&WebRtcIsacfix_kSinTab2[k]), &i_lo, &i_hi);
+
+    xr = _mm_add_epi32(MUL_16_32_RSFT_SSE2(r_lo, r_hi, in_re, 14),
+                       MUL_16_32_RSFT_SSE2(i_lo, i_hi, in_im, 14));
+    xi = _mm_sub_epi32(MUL_16_32_RSFT_SSE2(r_lo, r_hi, in_im, 14),
+                       MUL_16_32_RSFT_SSE2(i_lo, i_hi, in_re, 14));
+    yr = _mm_sub_epi32(
+        _mm_sub_epi32(_mm_setzero_si128(),
+                      MUL_16_32_RSFT_SSE2(r_lo, r_hi, in_im2, 14)),
+        MUL_16_32_RSFT_SSE2(i_lo, i_hi, in_re2, 14));
+    yi = _mm_sub_epi32(MUL_16_32_RSFT_SSE2(i_lo, i_hi, in_im2, 14),
+                       MUL_16_32_RSFT_SSE2(r_lo, r_hi, in_re2, 14));
+
+    /* Combine into one vector,  z = x + j * y */
+    _mm_storeu_si128((__m128i*)&outre1Q16[k], _mm_sub_epi32(xr, yi));
+    _mm_storeu_si128((__m128i*)&outre1Q16[k2],
+                     Reverse(_mm_add_epi32(xr, yi)));
+    _mm_storeu_si128((__m128i*)&outre2Q16[k], _mm_add_epi32(xi, yr));
+    _mm_storeu_si128((__m128i*)&outre2Q16[k2],
+                     Reverse(_mm_sub_epi32(yr, xi)));
+  }
+
+  /* Get IDFT */
+  sh = WebRtcSpl_NormW32(MaxAbsValue(outre1Q16, outre2Q16));
+  sh = sh - 24;
+  ScaleW32ToW16(outre1Q16, outre2Q16, sh, inreQ7, inimQ7);
+
+  WebRtcIsacfix_FftRadix16Fastest(inreQ7, inimQ7, 1); // real call
+
+  /* Scale back to Q16, divide through by the normalizing constant (273/65536
+     ~= 1/240), then demodulate and separate */
+  Mul16Factors(_mm_set1_epi32(273), &scale_lo, &scale_hi);
+  // sqrt(240) in Q11 is round(15.49193338482967*2048) = 31727
+  Mul16Factors(_mm_set1_epi32(31727), &fact_lo, &fact_hi);
+  for (k = 0; k < FRAMESAMPLES/2; k += 4) {
+    const __m128i re = Mul16x32Rsft16(scale_lo, scale_hi,
+                                      UnscaleW16ToW32(&inreQ7[k], sh));
+    const __m128i im = Mul16x32Rsft16(scale_lo, scale_hi,
+                                      UnscaleW16ToW32(&inimQ7[k], sh));
+    __m128i c_lo, c_hi, s_lo, s_hi, xr, xi;
+
+    Mul16Factors(LoadW16ToW32(&WebRtcIsacfix_kCosTab1[k]), &c_lo, &c_hi);
+    Mul16Factors(LoadW16ToW32(&WebRtcIsacfix_kSinTab1[k]), &s_lo, &s_hi);
+    xr = _mm_sub_epi32(MUL_16_32_RSFT_SSE2(c_lo, c_hi, re, 14),
+                       MUL_16_32_RSFT_SSE2(s_lo, s_hi, im, 14));
+    xi = _mm_add_epi32(MUL_16_32_RSFT_SSE2(c_lo, c_hi, im, 14),
+                       MUL_16_32_RSFT_SSE2(s_lo, s_hi, re, 14));
+    _mm_storeu_si128((__m128i*)&outre1Q16[k],
+                     MUL_16_32_RSFT_SSE2(fact_lo, fact_hi, xr, 11));
+    _mm_storeu_si128((__m128i*)&outre2Q16[k],
+                     MUL_16_32_RSFT_SSE2(fact_lo, fact_hi, xi, 11));
+  }
+}
@@ -15,6 +15,7 @@
 #include "pitch_estimator.h"
 #include "lpc_analysis.h"
 #include "codec.h"
+#include "os_specific_inline.h"
 
 
 
@@ -84,6 +85,42 @@ void WebRtcIsac_ZeroPoleFilter(double *In, double *ZeroCoef, double *PoleCoef, i
 }
 
 
+#ifdef WEBRTC_ISAC_SSE2
+/* Computes the correlations of x at the eight lags lag0, ..., lag0 + 7 and
+ * stores them in r[0], ..., r[7]. Each lane accumulates its products in the
+ * same order as the plain C loop below, so the sums are bit-exact. */
+static void AutoCorrEightLagsSSE2(double *r, const double *x, int N, int lag0)
+{
+  __m128d sum0 = _mm_setzero_pd();
+  __m128d sum1 = _mm_setzero_pd();
+  __m128d sum2 = _mm_setzero_pd();
+  __m128d sum3 = _mm_setzero_pd();
+  const double *x_lag = &x[lag0];
+  int n, k;
+
+  /* All eight lags have a product for n < N - lag0 - 7. */
+  for (n = 0; n < N - lag0 - 7; n++) {
+    const __m128d xn = _mm_set1_pd(x[n]);
+    sum0 = _mm_add_pd(sum0, _mm_mul_pd(xn, _mm_loadu_pd(&x_lag[n])));
+    sum1 = _mm_add_pd(sum1, _mm_mul_pd(xn, _mm_loadu_pd(&x_lag[n + 2])));
+    sum2 = _mm_add_pd(sum2, _mm_mul_pd(xn, _mm_loadu_pd(&x_lag[n + 4])));
+    sum3 = _mm_add_pd(sum3, _mm_mul_pd(xn, _mm_loadu_pd(&x_lag[n + 6])));
+  }
+  _mm_storeu_pd(&r[0], sum0);
+  _mm_storeu_pd(&r[2], sum1);
+  _mm_storeu_pd(&r[4], sum2);
+  _mm_storeu_pd(&r[6], sum3);
+
+  /* The shorter lags have up to seven products left. */
+  for (k = 0; k < 8; k++) {
+    int m;
+    for (m = n; m < N - lag0 - k; m++) {
+      r[k] += x[m] * x_lag[m + k];
+    }
+  }
+}
+#endif
+
 void WebRtcIsac_AutoCorr(
     double *r,
     const double *x,
@@ -95,7 +132,21 @@ void WebRtcIsac_AutoCorr(
   double sum, prod;
   const double *x_lag;
 
-  for (lag = 0; lag <= order; lag++)
+  lag = 0;
+#ifdef WEBRTC_ISAC_SSE2
+  for (; lag + 8 <= order + 1; lag += 8) {
+    AutoCorrEightLagsSSE2(&r[lag], x, N, lag);
+  }
+  if (lag <= order) {
+    /* The lags beyond the order are computed as well and dropped. */
+    double r_tmp[8];
+    AutoCorrEightLagsSSE2(r_tmp, x, N, lag);
+    for (; lag <= order; lag++) {
+      r[lag] = r_tmp[lag & 7];
+    }
+  }
+#endif
+  for (; lag <= order; lag++)
   {
     sum = 0.0f;
     x_lag = &x[lag];
@@ -21,6 +21,125 @@
 #include "settings.h"
 #include "filterbank_tables.h"
 #include "codec.h"
+#include "os_specific_inline.h"
+
+#ifdef WEBRTC_ISAC_SSE2
+/* Returns the lanes of |a| where |mask| is set and those of |b| elsewhere. */
+static __inline __m128 SelectPs(__m128 mask, __m128 a, __m128 b) {
+  return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+/* Version of WebRtcIsac_AllPassFilter2Float() for up to four sections. The
+ * sections are run as a wavefront: in step t, lane j applies section j to
+ * sample t - j, whose input is the output of section j - 1 in step t - 1.
+ * Each section sees its samples in order and does the same float operations
+ * as the C version, so the output is bit-exact, but the dependency chain of
+ * a step is shared by all sections instead of being repeated per section. */
+static void AllPassFilter2FloatSSE2(float *InOut, const float *APSectionFactors,
+                                    int lengthInOut, int NumberOfSections,
+                                    float *FilterState)
+{
+  const int last = NumberOfSections - 1;
+  const __m128i lane = _mm_set_epi32(3, 2, 1, 0);
+  __m128 factors, neg_factors, state, temp;
+  float buf[4];
+  int t, j;
+
+  for (j = 0; j < 4; j++) {
+    buf[j] = j < NumberOfSections ? APSectionFactors[j] : 0.0f;
+  }
+  factors = _mm_loadu_ps(buf);
+  neg_factors = _mm_xor_ps(factors, _mm_set1_ps(-0.0f));
+  for (j = 0; j < 4; j++) {
+    buf[j] = j < NumberOfSections ? FilterState[j] : 0.0f;
+  }
+  state = _mm_loadu_ps(buf);
+  temp = _mm_setzero_ps();
+
+  for (t = 0; t < lengthInOut + last; t++) {
+    const __m128 in = _mm_set_ss(t < lengthInOut ? InOut[t] : 0.0f);
+    const __m128 x =
+        _mm_move_ss(_mm_shuffle_ps(temp, temp, _MM_SHUFFLE(2, 1, 0, 0)), in);
+    __m128 new_state;
+
+    temp = _mm_add_ps(state, _mm_mul_ps(factors, x));
+    new_state = _mm_add_ps(_mm_mul_ps(neg_factors, temp), x);
+    if (t < last || t >= lengthInOut) {
+      /* While the wavefront fills and drains, only the lanes with
+       * 0 <= t - j < lengthInOut hold a sample. */
+      const __m128 valid = _mm_castsi128_ps(_mm_and_si128(
+          _mm_cmplt_epi32(lane, _mm_set1_epi32(t + 1)),
+          _mm_cmpgt_epi32(lane, _mm_set1_epi32(t - lengthInOut))));
+      new_state = SelectPs(valid, new_state, state);
+    }
+    state = new_state;
+    if (t >= last) {
+      _mm_storeu_ps(buf, temp);
+      InOut[t - last] = buf[last];
+    }
+  }
+
+  _mm_storeu_ps(buf, state);
+  for (j = 0; j < NumberOfSections; j++) {
+    FilterState[j] = buf[j];
+  }
+}
+
+/* Filters two channels of NUMBEROFCHANNELAPSECTIONS (two) sections each at
+ * the same time, lanes 0 and 1 running the wavefront of the first channel and
+ * lanes 2 and 3 that of the second. Bit-exact like the function above. */
+static void AllPassFilter2FloatTwoChannelsSSE2(float *InOut1,
+                                               const float *APSectionFactors1,
+                                               float *FilterState1,
+                                               float *InOut2,
+                                               const float *APSectionFactors2,
+                                               float *FilterState2,
+                                               int lengthInOut)
+{
+  const __m128 factors = _mm_setr_ps(APSectionFactors1[0], APSectionFactors1[1],
+                                     APSectionFactors2[0], APSectionFactors2[1]);
+  const __m128 neg_factors = _mm_xor_ps(factors, _mm_set1_ps(-0.0f));
+  /* The first section of both channels, and the second one. */
+  const __m128 first = _mm_castsi128_ps(_mm_setr_epi32(-1, 0, -1, 0));
+  __m128 state = _mm_setr_ps(FilterState1[0], FilterState1[1],
+                             FilterState2[0], FilterState2[1]);
+  __m128 temp = _mm_setzero_ps();
+  float buf[4];
+  int t;
+
+  for (t = 0; t <= lengthInOut; t++) {
+    __m128 in, x, new_state;
+
+    if (t < lengthInOut) {
+      in = _mm_unpacklo_ps(_mm_set_ss(InOut1[t]), _mm_set_ss(InOut2[t]));
+    } else {
+      in = _mm_setzero_ps();
+    }
+    /* x = {InOut1[t], temp[0], InOut2[t], temp[2]}. */
+    x = _mm_unpacklo_ps(in, _mm_shuffle_ps(temp, temp, _MM_SHUFFLE(2, 0, 2, 0)));
+
+    temp = _mm_add_ps(state, _mm_mul_ps(factors, x));
+    new_state = _mm_add_ps(_mm_mul_ps(neg_factors, temp), x);
+    if (t == 0) {
+      new_state = SelectPs(first, new_state, state);
+    } else if (t == lengthInOut) {
+      new_state = SelectPs(first, state, new_state);
+    }
+    state = new_state;
+    if (t > 0) {
+      _mm_storeu_ps(buf, temp);
+      InOut1[t - 1] = buf[1];
+      InOut2[t - 1] = buf[3];
+    }
+  }
+
+  _mm_storeu_ps(buf, state);
+  FilterState1[0] = buf[0];
+  FilterState1[1] = buf[1];
+  FilterState2[0] = buf[2];
+  FilterState2[1] = buf[3];
+}
+#endif
 
 /* This function performs all-pass filtering--a series of first order all-pass
  * sections are used to filter the input in a cascade manner.
@@ -32,6 +151,13 @@ static void WebRtcIsac_AllPassFilter2Float(float *InOut, const float *APSectionF
 {
   int n, j;
   float temp;
+#ifdef WEBRTC_ISAC_SSE2
+  if (NumberOfSections <= 4) {
+    AllPassFilter2FloatSSE2(InOut, APSectionFactors, lengthInOut,
+                            NumberOfSections, FilterState);
+    return;
+  }
+#endif
   for (j=0; j<NumberOfSections; j++){
     for (n=0;n<lengthInOut;n++){
       temp = FilterState[j] + APSectionFactors[j] * InOut[n];
@@ -41,6 +167,27 @@ static void WebRtcIsac_AllPassFilter2Float(float *InOut, const float *APSectionF
   }
 }
 
+/* Filters two independent channels of NUMBEROFCHANNELAPSECTIONS sections. */
+static void AllPassFilter2FloatTwoChannels(float *InOut1,
+                                           const float *APSectionFactors1,
+                                           float *FilterState1,
+                                           float *InOut2,
+                                           const float *APSectionFactors2,
+                                           float *FilterState2,
+                                           int lengthInOut)
+{
+#if defined(WEBRTC_ISAC_SSE2) && (NUMBEROFCHANNELAPSECTIONS == 2)
+  AllPassFilter2FloatTwoChannelsSSE2(InOut1, APSectionFactors1, FilterState1,
+                                     InOut2, APSectionFactors2, FilterState2,
+                                     lengthInOut);
+#else
+  WebRtcIsac_AllPassFilter2Float(InOut1, APSectionFactors1, lengthInOut,
+                                 NUMBEROFCHANNELAPSECTIONS, FilterState1);
+  WebRtcIsac_AllPassFilter2Float(InOut2, APSectionFactors2, lengthInOut,
+                                 NUMBEROFCHANNELAPSECTIONS, FilterState2);
+#endif
+}
+
 /* HPstcoeff_in = {a1, a2, b1 - b0 * a1, b2 - b0 * a2}; */
 static const float kHpStCoefInFloat[4] =
 {-1.94895953203325f, 0.94984516000000f, -0.05101826139794f, 0.05015484000000f};
@@ -214,10 +361,10 @@ void WebRtcIsac_SplitAndFilterFloat(float *pin, float *LP, float *HP,
   /* the backward filtered samples are now forward filtered with the corresponding channel filters */
   /* The all pass filtering automatically updates the filter states which are exported in the
      prefiltdata structure */
-  WebRtcIsac_AllPassFilter2Float(tempin_ch1,WebRtcIsac_kUpperApFactorsFloat,
-                                 FRAMESAMPLES_HALF, NUMBEROFCHANNELAPSECTIONS, prefiltdata->INSTAT1_float);
-  WebRtcIsac_AllPassFilter2Float(tempin_ch2,WebRtcIsac_kLowerApFactorsFloat,
-                                 FRAMESAMPLES_HALF, NUMBEROFCHANNELAPSECTIONS, prefiltdata->INSTAT2_float);
+  AllPassFilter2FloatTwoChannels(tempin_ch1, WebRtcIsac_kUpperApFactorsFloat,
+                                 prefiltdata->INSTAT1_float,
+                                 tempin_ch2, WebRtcIsac_kLowerApFactorsFloat,
+                                 prefiltdata->INSTAT2_float, FRAMESAMPLES_HALF);
 
   /* Now Construct low-pass and high-pass signals as combinations of polyphase components */
   for (k=0; k<FRAMESAMPLES_HALF; k++) {
@@ -240,10 +387,10 @@ void WebRtcIsac_SplitAndFilterFloat(float *pin, float *LP, float *HP,
 
   /* the input filter states are passed in and updated by the all-pass filtering routine and
      exported in the prefiltdata structure*/
-  WebRtcIsac_AllPassFilter2Float(tempin_ch1,WebRtcIsac_kUpperApFactorsFloat,
-                                 FRAMESAMPLES_HALF, NUMBEROFCHANNELAPSECTIONS, prefiltdata->INSTATLA1_float);
-  WebRtcIsac_AllPassFilter2Float(tempin_ch2,WebRtcIsac_kLowerApFactorsFloat,
-                                 FRAMESAMPLES_HALF, NUMBEROFCHANNELAPSECTIONS, prefiltdata->INSTATLA2_float);
+  AllPassFilter2FloatTwoChannels(tempin_ch1, WebRtcIsac_kUpperApFactorsFloat,
+                                 prefiltdata->INSTATLA1_float,
+                                 tempin_ch2, WebRtcIsac_kLowerApFactorsFloat,
+                                 prefiltdata->INSTATLA2_float, FRAMESAMPLES_HALF);
 
   for (k=0; k<FRAMESAMPLES_HALF; k++) {
     LP_la[k] = (float)(0.5f*(tempin_ch1[k] + tempin_ch2[k])); /*low pass */
@@ -304,15 +451,14 @@ void WebRtcIsac_FilterAndCombineFloat(float *InLP,
   /* all-pass filter the new upper channel signal. HOWEVER, use the all-pass filter factors
      that were used as a lower channel at the encoding side.  So at the decoder, the
      corresponding all-pass filter factors for each channel are swapped.*/
-  WebRtcIsac_AllPassFilter2Float(tempin_ch1, WebRtcIsac_kLowerApFactorsFloat,
-                                 FRAMESAMPLES_HALF, NUMBEROFCHANNELAPSECTIONS,postfiltdata->STATE_0_UPPER_float);
-
-  /* Now, all-pass filter the new lower channel signal. But since all-pass filter factors
+  /* Likewise, all-pass filter the new lower channel signal. But since all-pass filter factors
      at the decoder are swapped from the ones at the encoder, the 'upper' channel
      all-pass filter factors (WebRtcIsac_kUpperApFactorsFloat) are used to filter this new
-     lower channel signal */
-  WebRtcIsac_AllPassFilter2Float(tempin_ch2, WebRtcIsac_kUpperApFactorsFloat,
-                                 FRAMESAMPLES_HALF, NUMBEROFCHANNELAPSECTIONS,postfiltdata->STATE_0_LOWER_float);
+     lower channel signal. Both channels are filtered in one call. */
+  AllPassFilter2FloatTwoChannels(tempin_ch1, WebRtcIsac_kLowerApFactorsFloat,
+                                 postfiltdata->STATE_0_UPPER_float,
+                                 tempin_ch2, WebRtcIsac_kUpperApFactorsFloat,
+                                 postfiltdata->STATE_0_LOWER_float, FRAMESAMPLES_HALF);
 
 
   /* Merge outputs to form the full length output signal.*/
@@ -16,6 +16,7 @@
  */
 #include "settings.h"
 #include "codec.h"
+#include "os_specific_inline.h"
 
 #include <math.h>
 #include <memory.h>
@@ -79,7 +80,26 @@ void WebRtcIsac_NormLatticeFilterMa(int orderCoef,
     /* filtering */
     for(k=0;k<orderCoef;k++)
     {
-      for(n=0;n<(HALF_SUBFRAMELEN-1);n++)
+      n = 0;
+#ifdef WEBRTC_ISAC_SSE2
+      {
+        /* The samples of a stage only depend on the previous stage, so four
+           are filtered at a time with the same float operations as below. */
+        const __m128 inv_cth4 = _mm_set1_ps(inv_cth[k]);
+        const __m128 sth4 = _mm_set1_ps(sth[k]);
+        const __m128 cth4 = _mm_set1_ps(cth[k]);
+        for(;n+4<=(HALF_SUBFRAMELEN-1);n+=4)
+        {
+          const __m128 g_prev = _mm_loadu_ps(&g[k][n]);
+          const __m128 f_new = _mm_mul_ps(inv_cth4, _mm_add_ps(
+              _mm_loadu_ps(&f[k][n+1]), _mm_mul_ps(sth4, g_prev)));
+          _mm_storeu_ps(&f[k+1][n+1], f_new);
+          _mm_storeu_ps(&g[k+1][n+1], _mm_add_ps(_mm_mul_ps(cth4, g_prev),
+                                                 _mm_mul_ps(sth4, f_new)));
+        }
+      }
+#endif
+      for(;n<(HALF_SUBFRAMELEN-1);n++)
       {
         f[k+1][n+1] = inv_cth[k]*(f[k][n+1] + sth[k]*g[k][n]);
         g[k+1][n+1] = cth[k]*g[k][n] + sth[k]* f[k+1][n+1];
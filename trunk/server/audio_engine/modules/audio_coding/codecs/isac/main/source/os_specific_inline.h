@@ -38,4 +38,14 @@ static __inline long int WebRtcIsac_lrint(double x_dbl) {
 
 #endif
 
+// The SSE2 kernels of the codec are bit-exact with the plain C code only when
+// the latter does its float and double arithmetic in SSE registers as well,
+// which is always the case on x86-64 and on 32-bit x86 when the compiler is
+// allowed to use SSE2 (-msse2, /arch:SSE2). x87 builds keep the C code.
+#if defined(VOIP_ARCH_X86_64) || defined(__SSE2__) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define WEBRTC_ISAC_SSE2
+#include <emmintrin.h>
+#endif
+
 #endif  // WEBRTC_MODULES_AUDIO_CODING_CODECS_ISAC_MAIN_SOURCE_OS_SPECIFIC_INLINE_H_
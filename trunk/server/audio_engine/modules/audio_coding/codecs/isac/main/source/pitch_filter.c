@@ -118,6 +118,155 @@ typedef struct {
   double gain_mult[4];
 } PitchFilterParam;
 
+#ifdef WEBRTC_ISAC_SSE2
+/*
+ * Filters |block| samples through the damping filter. |damper_in| holds the
+ * block's input, preceded by the PITCH_DAMPORDER - 1 previous ones. With
+ * |negate| the products are subtracted from zero instead of added to it.
+ */
+static void DampBlockSSE2(const double* damper_in, int block, int negate,
+                          double* out) {
+  int n;
+  int m;
+
+  for (n = 0; n + 2 <= block; n += 2) {
+    __m128d sum = _mm_setzero_pd();
+    for (m = 0; m < PITCH_DAMPORDER; ++m) {
+      const __m128d prod = _mm_mul_pd(_mm_loadu_pd(&damper_in[n - m]),
+                                      _mm_set1_pd(kDampFilter[m]));
+      sum = negate ? _mm_sub_pd(sum, prod) : _mm_add_pd(sum, prod);
+    }
+    _mm_storeu_pd(&out[n], sum);
+  }
+  for (; n < block; ++n) {
+    double sum = 0.0;
+    for (m = 0; m < PITCH_DAMPORDER; ++m) {
+      if (negate) {
+        sum -= damper_in[n - m] * kDampFilter[m];
+      } else {
+        sum += damper_in[n - m] * kDampFilter[m];
+      }
+    }
+    out[n] = sum;
+  }
+}
+
+/*
+ * Version of FilterSegment() for x86 platforms with SSE2. A sample only reads
+ * the buffers up to PITCH_FRACORDER - 1 samples after its lagged position, so
+ * the first |lag_offset| - PITCH_FRACORDER + 1 samples of the segment only
+ * depend on samples filtered before. Blocks of that many samples are filtered
+ * two at a time. Every lane does the same double operations in the same order
+ * as the per-sample loop of FilterSegment(), so the output is bit-exact.
+ */
+static void FilterSegmentSSE2(const double* in_data,
+                              PitchFilterParam* parameters,
+                              double* out_data,
+                              double out_dg[][PITCH_FRAME_LEN + QLOOKAHEAD]) {
+  /* Input of the damping filter for the block, preceded by its state. */
+  double damper_in[PITCH_DAMPORDER - 1 + QLOOKAHEAD];
+  double* damper_block = &damper_in[PITCH_DAMPORDER - 1];
+  /* Fractional pitch of the block, before the gain is applied. */
+  double frac[QLOOKAHEAD];
+  double damped[QLOOKAHEAD];
+  const double* coeff = parameters->interpol_coeff;
+  const int max_block = parameters->lag_offset - (PITCH_FRACORDER - 1);
+  int remaining = parameters->num_samples;
+  int n;
+  int m;
+  int j;
+
+  while (remaining > 0) {
+    const int block = remaining < max_block ? remaining : max_block;
+    const int pos = parameters->index + PITCH_BUFFSIZE;
+    const double* lagged = &parameters->buffer[pos - parameters->lag_offset];
+    const __m128d gain = _mm_set1_pd(parameters->gain);
+
+    /* Filter to get fractional pitch, and multiply with gain. */
+    for (n = 0; n + 2 <= block; n += 2) {
+      __m128d sum = _mm_setzero_pd();
+      for (m = 0; m < PITCH_FRACORDER; ++m) {
+        sum = _mm_add_pd(sum, _mm_mul_pd(_mm_loadu_pd(&lagged[n + m]),
+                                         _mm_set1_pd(coeff[m])));
+      }
+      _mm_storeu_pd(&frac[n], sum);
+      _mm_storeu_pd(&damper_block[n], _mm_mul_pd(gain, sum));
+    }
+    for (; n < block; ++n) {
+      frac[n] = 0.0;
+      for (m = 0; m < PITCH_FRACORDER; ++m) {
+        frac[n] += lagged[n + m] * coeff[m];
+      }
+      damper_block[n] = parameters->gain * frac[n];
+    }
+
+    /* Filter with damping filter, subtract from input and update buffer. */
+    for (m = 1; m < PITCH_DAMPORDER; ++m) {
+      damper_block[-m] = parameters->damper_state[m - 1];
+    }
+    DampBlockSSE2(damper_block, block, 0, damped);
+    for (m = 0; m < PITCH_DAMPORDER; ++m) {
+      parameters->damper_state[m] = damper_block[block - 1 - m];
+    }
+    for (n = 0; n < block; ++n) {
+      const int index = parameters->index + n;
+      out_data[index] = in_data[index] - damped[n];
+      parameters->buffer[pos + n] = in_data[index] + out_data[index];
+    }
+
+    if (parameters->mode == kPitchFilterPreGain) {
+      const int lag_index = parameters->index - parameters->lag_offset;
+      /* The damper states of the later sub-frames are still all zero. */
+      for (j = 0; j < parameters->sub_frame + 1; ++j) {
+        const double* lagged_dg = &out_dg[j][lag_index];
+        const __m128d gain_mult = _mm_set1_pd(parameters->gain_mult[j]);
+
+        /* Filter for fractional pitch and add the contribution of
+         * differential gain change. */
+        for (n = 0; n < block; n += 2) {
+          if (n + 2 <= block && lag_index + n >= 0) {
+            __m128d sum2 = _mm_setzero_pd();
+            for (m = PITCH_FRACORDER - 1; m >= 0; --m) {
+              sum2 = _mm_add_pd(sum2, _mm_mul_pd(_mm_loadu_pd(&lagged_dg[n + m]),
+                                                 _mm_set1_pd(coeff[m])));
+            }
+            _mm_storeu_pd(&damper_block[n],
+                          _mm_add_pd(_mm_mul_pd(gain_mult,
+                                                _mm_loadu_pd(&frac[n])),
+                                     _mm_mul_pd(gain, sum2)));
+          } else {
+            /* Samples before |out_dg[j]| are taken as zero, see
+             * FilterSegment(). */
+            int k;
+            for (k = n; k < n + 2 && k < block; ++k) {
+              const int m_tmp = (lag_index + k < 0) ? -(lag_index + k) : 0;
+              double sum2 = 0.0;
+              for (m = PITCH_FRACORDER - 1; m >= m_tmp; --m) {
+                sum2 += lagged_dg[k + m] * coeff[m];
+              }
+              damper_block[k] = parameters->gain_mult[j] * frac[k] +
+                  parameters->gain * sum2;
+            }
+          }
+        }
+
+        /* Filter with damping filter, and store the results. */
+        for (m = 1; m < PITCH_DAMPORDER; ++m) {
+          damper_block[-m] = parameters->damper_state_dg[j][m - 1];
+        }
+        DampBlockSSE2(damper_block, block, 1, &out_dg[j][parameters->index]);
+        for (m = 0; m < PITCH_DAMPORDER; ++m) {
+          parameters->damper_state_dg[j][m] = damper_block[block - 1 - m];
+        }
+      }
+    }
+
+    parameters->index += block;
+    remaining -= block;
+  }
+}
+#endif
+
 /**********************************************************************
  * FilterSegment()
  * Filter one segment, a quarter of a frame.
@@ -146,6 +295,13 @@ static void FilterSegment(const double* in_data, PitchFilterParam* parameters,
    * computation. */
   int pos_lag = pos - parameters->lag_offset;
 
+#ifdef WEBRTC_ISAC_SSE2
+  if (parameters->lag_offset >= PITCH_FRACORDER) {
+    FilterSegmentSSE2(in_data, parameters, out_data, out_dg);
+    return;
+  }
+#endif
+
   for (n = 0; n < parameters->num_samples; ++n) {
     /* Shift low pass filter states. */
     for (m = PITCH_DAMPORDER - 1; m > 0; --m) {
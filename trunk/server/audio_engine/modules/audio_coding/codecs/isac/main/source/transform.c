@@ -13,12 +13,32 @@
 #include "codec.h"
 #include "os_specific_inline.h"
 #include <math.h>
+#include <string.h>
 
 static double costab1[FRAMESAMPLES_HALF];
 static double sintab1[FRAMESAMPLES_HALF];
 static double costab2[FRAMESAMPLES_QUARTER];
 static double sintab2[FRAMESAMPLES_QUARTER];
 
+#ifdef WEBRTC_ISAC_SSE2
+/* Swaps the two lanes. */
+static __inline __m128d ReversePd(__m128d v) {
+  return _mm_shuffle_pd(v, v, 1);
+}
+
+/* Rounds the two lanes like WebRtcIsac_lrint() and stores them to p[0] and
+ * p[1], or to p[1] and p[0] if |reverse| is set, truncated to 16 bits like an
+ * (int16_t) cast. */
+static __inline void StoreRoundedW16(int16_t* p, __m128d v, int reverse) {
+  const __m128i v32 = _mm_cvtpd_epi32(v);
+  const __m128i v16 = reverse ?
+      _mm_shufflelo_epi16(v32, _MM_SHUFFLE(3, 3, 0, 2)) :
+      _mm_shufflelo_epi16(v32, _MM_SHUFFLE(3, 3, 2, 0));
+  const int32_t pair = _mm_cvtsi128_si32(v16);
+  memcpy(p, &pair, sizeof(pair));
+}
+#endif
+
 void WebRtcIsac_InitTransform()
 {
   int k;
@@ -60,7 +80,24 @@ void WebRtcIsac_Time2Spec(double *inre1,
 
   /* Multiply with complex exponentials and combine into one complex vector */
   fact = 0.5 / sqrt(FRAMESAMPLES_HALF);
-  for (k = 0; k < FRAMESAMPLES_HALF; k++) {
+  k = 0;
+#ifdef WEBRTC_ISAC_SSE2
+  /* The SSE2 loops do the same double operations as the plain ones. */
+  {
+    const __m128d fact2 = _mm_set1_pd(fact);
+    for (; k + 2 <= FRAMESAMPLES_HALF; k += 2) {
+      const __m128d c = _mm_loadu_pd(&costab1[k]);
+      const __m128d s = _mm_loadu_pd(&sintab1[k]);
+      const __m128d x1 = _mm_loadu_pd(&inre1[k]);
+      const __m128d x2 = _mm_loadu_pd(&inre2[k]);
+      _mm_storeu_pd(&tmpre[k], _mm_mul_pd(_mm_add_pd(
+          _mm_mul_pd(x1, c), _mm_mul_pd(x2, s)), fact2));
+      _mm_storeu_pd(&tmpim[k], _mm_mul_pd(_mm_sub_pd(
+          _mm_mul_pd(x2, c), _mm_mul_pd(x1, s)), fact2));
+    }
+  }
+#endif
+  for (; k < FRAMESAMPLES_HALF; k++) {
     tmp1r = costab1[k];
     tmp1i = sintab1[k];
     tmpre[k] = (inre1[k] * tmp1r + inre2[k] * tmp1i) * fact;
@@ -72,7 +109,40 @@ void WebRtcIsac_Time2Spec(double *inre1,
   WebRtcIsac_Fftns(1, dims, tmpre, tmpim, -1, 1.0, fftstr_obj);
 
   /* Use symmetry to separate into two complex vectors and center frames in time around zero */
-  for (k = 0; k < FRAMESAMPLES_QUARTER; k++) {
+  k = 0;
+#ifdef WEBRTC_ISAC_SSE2
+  {
+    const __m128d kScale = _mm_set1_pd(128.0);
+    const __m128d kSign = _mm_set1_pd(-0.0);
+    for (; k + 2 <= FRAMESAMPLES_QUARTER; k += 2) {
+      /* Lanes k and k + 1, the mirrored ones at FRAMESAMPLES_HALF - 1 - k
+       * and FRAMESAMPLES_HALF - 2 - k. */
+      const __m128d re = _mm_loadu_pd(&tmpre[k]);
+      const __m128d im = _mm_loadu_pd(&tmpim[k]);
+      const __m128d re_mirror =
+          ReversePd(_mm_loadu_pd(&tmpre[FRAMESAMPLES_HALF - 2 - k]));
+      const __m128d im_mirror =
+          ReversePd(_mm_loadu_pd(&tmpim[FRAMESAMPLES_HALF - 2 - k]));
+      const __m128d xr2 = _mm_add_pd(re, re_mirror);
+      const __m128d yi2 = _mm_add_pd(_mm_xor_pd(re, kSign), re_mirror);
+      const __m128d xi2 = _mm_sub_pd(im, im_mirror);
+      const __m128d yr2 = _mm_add_pd(im, im_mirror);
+      const __m128d neg_yr2 = _mm_xor_pd(yr2, kSign);
+      const __m128d c = _mm_loadu_pd(&costab2[k]);
+      const __m128d s = _mm_loadu_pd(&sintab2[k]);
+
+      StoreRoundedW16(&outreQ7[k], _mm_mul_pd(_mm_sub_pd(
+          _mm_mul_pd(xr2, c), _mm_mul_pd(xi2, s)), kScale), 0);
+      StoreRoundedW16(&outimQ7[k], _mm_mul_pd(_mm_add_pd(
+          _mm_mul_pd(xr2, s), _mm_mul_pd(xi2, c)), kScale), 0);
+      StoreRoundedW16(&outreQ7[FRAMESAMPLES_HALF - 2 - k], _mm_mul_pd(
+          _mm_sub_pd(_mm_mul_pd(neg_yr2, s), _mm_mul_pd(yi2, c)), kScale), 1);
+      StoreRoundedW16(&outimQ7[FRAMESAMPLES_HALF - 2 - k], _mm_mul_pd(
+          _mm_add_pd(_mm_mul_pd(neg_yr2, c), _mm_mul_pd(yi2, s)), kScale), 1);
+    }
+  }
+#endif
+  for (; k < FRAMESAMPLES_QUARTER; k++) {
     xr = tmpre[k] + tmpre[FRAMESAMPLES_HALF - 1 - k];
     yi = -tmpre[k] + tmpre[FRAMESAMPLES_HALF - 1 - k];
     xi = tmpim[k] - tmpim[FRAMESAMPLES_HALF - 1 - k];
@@ -98,7 +168,40 @@ void WebRtcIsac_Spec2time(double *inre, double *inim, double *outre1, double *ou
 
   dims = FRAMESAMPLES_HALF;
 
-  for (k = 0; k < FRAMESAMPLES_QUARTER; k++) {
+  k = 0;
+#ifdef WEBRTC_ISAC_SSE2
+  /* The SSE2 loops do the same double operations as the plain ones. */
+  {
+    const __m128d kSign = _mm_set1_pd(-0.0);
+    for (; k + 2 <= FRAMESAMPLES_QUARTER; k += 2) {
+      /* Lanes k and k + 1, the mirrored ones at FRAMESAMPLES_HALF - 1 - k
+       * and FRAMESAMPLES_HALF - 2 - k. */
+      const __m128d c = _mm_loadu_pd(&costab2[k]);
+      const __m128d s = _mm_loadu_pd(&sintab2[k]);
+      const __m128d re = _mm_loadu_pd(&inre[k]);
+      const __m128d im = _mm_loadu_pd(&inim[k]);
+      const __m128d re_mirror =
+          ReversePd(_mm_loadu_pd(&inre[FRAMESAMPLES_HALF - 2 - k]));
+      const __m128d im_mirror =
+          ReversePd(_mm_loadu_pd(&inim[FRAMESAMPLES_HALF - 2 - k]));
+      const __m128d xr2 = _mm_add_pd(_mm_mul_pd(re, c), _mm_mul_pd(im, s));
+      const __m128d xi2 = _mm_sub_pd(_mm_mul_pd(im, c), _mm_mul_pd(re, s));
+      const __m128d yr2 = _mm_sub_pd(
+          _mm_mul_pd(_mm_xor_pd(im_mirror, kSign), c), _mm_mul_pd(re_mirror, s));
+      const __m128d yi2 = _mm_add_pd(
+          _mm_mul_pd(_mm_xor_pd(re_mirror, kSign), c), _mm_mul_pd(im_mirror, s));
+
+      /* Combine into one vector,  z = x + j * y */
+      _mm_storeu_pd(&outre1[k], _mm_sub_pd(xr2, yi2));
+      _mm_storeu_pd(&outre1[FRAMESAMPLES_HALF - 2 - k],
+                    ReversePd(_mm_add_pd(xr2, yi2)));
+      _mm_storeu_pd(&outre2[k], _mm_add_pd(xi2, yr2));
+      _mm_storeu_pd(&outre2[FRAMESAMPLES_HALF - 2 - k],
+                    ReversePd(_mm_add_pd(_mm_xor_pd(xi2, kSign), yr2)));
+    }
+  }
+#endif
+  for (; k < FRAMESAMPLES_QUARTER; k++) {
     /* Move zero in time to beginning of frames */
     tmp1r = costab2[k];
     tmp1i = sintab2[k];
@@ -121,7 +224,23 @@ void WebRtcIsac_Spec2time(double *inre, double *inim, double *outre1, double *ou
 
   /* Demodulate and separate */
   fact = sqrt(FRAMESAMPLES_HALF);
-  for (k = 0; k < FRAMESAMPLES_HALF; k++) {
+  k = 0;
+#ifdef WEBRTC_ISAC_SSE2
+  {
+    const __m128d fact2 = _mm_set1_pd(fact);
+    for (; k + 2 <= FRAMESAMPLES_HALF; k += 2) {
+      const __m128d c = _mm_loadu_pd(&costab1[k]);
+      const __m128d s = _mm_loadu_pd(&sintab1[k]);
+      const __m128d x1 = _mm_loadu_pd(&outre1[k]);
+      const __m128d x2 = _mm_loadu_pd(&outre2[k]);
+      _mm_storeu_pd(&outre1[k], _mm_mul_pd(_mm_sub_pd(
+          _mm_mul_pd(x1, c), _mm_mul_pd(x2, s)), fact2));
+      _mm_storeu_pd(&outre2[k], _mm_mul_pd(_mm_add_pd(
+          _mm_mul_pd(x2, c), _mm_mul_pd(x1, s)), fact2));
+    }
+  }
+#endif
+  for (; k < FRAMESAMPLES_HALF; k++) {
     tmp1r = costab1[k];
     tmp1i = sintab1[k];
     xr = (outre1[k] * tmp1r - outre2[k] * tmp1i) * fact;
@@ -14,6 +14,20 @@ typedef struct WebRtcOpusDecInst OpusDecInst;
 int16_t WebRtcOpus_EncoderCreate(OpusEncInst** inst, int32_t channels);
 int16_t WebRtcOpus_EncoderFree(OpusEncInst* inst);
 
+/****************************************************************************
+ * WebRtcOpus_EncoderInit(...)
+ *
+ * This function resets an encoder to the state and settings it had right
+ * after WebRtcOpus_EncoderCreate(), without reallocating it.
+ *
+ * Input:
+ *      - inst               : Encoder context
+ *
+ * Return value              :  0 - Success
+ *                             -1 - Error
+ */
+int16_t WebRtcOpus_EncoderInit(OpusEncInst* inst);
+
 /****************************************************************************
  * WebRtcOpus_Encode(...)
  *
@@ -117,6 +131,33 @@ int16_t WebRtcOpus_DecoderFree(OpusDecInst* inst);
  */
 int WebRtcOpus_DecoderChannels(OpusDecInst* inst);
 
+/****************************************************************************
+ * WebRtcOpus_DecoderSetSampleRate(...)
+ *
+ * This function sets the sample rate of the decoded audio and resets the
+ * decoder state. Opus decodes natively at 8, 16 and 48 kHz. The default,
+ * 32 kHz, is produced by decoding at 48 kHz and resampling. The rate applies
+ * to WebRtcOpus_DecodeNew(), WebRtcOpus_DecodePlc(), WebRtcOpus_DecodeFec()
+ * and WebRtcOpus_DurationEst(); the master/slave functions used by the old
+ * NetEq require the default rate.
+ *
+ * Input:
+ *      - inst               : Decoder context
+ *      - sample_rate_hz     : 8000, 16000, 32000 or 48000
+ *
+ * Return value              :  0 - Success
+ *                             -1 - Error
+ */
+int16_t WebRtcOpus_DecoderSetSampleRate(OpusDecInst* inst,
+                                        int32_t sample_rate_hz);
+
+/****************************************************************************
+ * WebRtcOpus_DecoderSampleRate(...)
+ *
+ * This function returns the sample rate of the decoded audio.
+ */
+int WebRtcOpus_DecoderSampleRate(OpusDecInst* inst);
+
 /****************************************************************************
  * WebRtcOpus_DecoderInit(...)
  *
@@ -136,7 +177,8 @@ int16_t WebRtcOpus_DecoderInitSlave(OpusDecInst* inst);
  * WebRtcOpus_Decode(...)
  *
  * This function decodes an Opus packet into one or more audio frames at the
- * ACM interface's sampling rate (32 kHz).
+ * decoder's sample rate (32 kHz unless changed with
+ * WebRtcOpus_DecoderSetSampleRate()).
  *
  * Input:
  *      - inst               : Decoder context
@@ -190,7 +232,7 @@ int16_t WebRtcOpus_DecodePlcSlave(OpusDecInst* inst, int16_t* decoded,
  * WebRtcOpus_DecodeFec(...)
  *
  * This function decodes the FEC data from an Opus packet into one or more audio
- * frames at the ACM interface's sampling rate (32 kHz).
+ * frames at the decoder's sample rate.
  *
  * Input:
  *      - inst               : Decoder context
@@ -211,7 +253,8 @@ int16_t WebRtcOpus_DecodeFec(OpusDecInst* inst, const uint8_t* encoded,
 /****************************************************************************
  * WebRtcOpus_DurationEst(...)
  *
- * This function calculates the duration of an opus packet.
+ * This function calculates the duration of an opus packet, in samples at the
+ * decoder's sample rate.
  * Input:
  *        - inst                 : Decoder context
  *        - payload              : Encoded data pointer
@@ -231,7 +274,8 @@ int WebRtcOpus_DurationEst(OpusDecInst* inst,
 /****************************************************************************
  * WebRtcOpus_FecDurationEst(...)
  *
- * This function calculates the duration of the FEC data within an opus packet.
+ * This function calculates the duration of the FEC data within an opus packet,
+ * in samples at the default decoder rate (32 kHz).
  * Input:
  *        - payload              : Encoded data pointer
  *        - payload_length_bytes : Bytes of encoded data
@@ -257,6 +301,21 @@ int WebRtcOpus_FecDurationEst(const uint8_t* payload,
 int WebRtcOpus_PacketHasFec(const uint8_t* payload,
                             int payload_length_bytes);
 
+/****************************************************************************
+ * WebRtcOpus_PacketSampleRate(...)
+ *
+ * This function returns the lowest sample rate that carries the audio
+ * bandwidth coded in an opus packet.
+ * Input:
+ *        - payload              : Encoded data pointer
+ *        - payload_length_bytes : Bytes of encoded data
+ *
+ * Return value                  : >0 - 8000, 12000, 16000, 24000 or 48000.
+ *                                 -1 - Invalid packet.
+ */
+int WebRtcOpus_PacketSampleRate(const uint8_t* payload,
+                                int payload_length_bytes);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
@@ -44,25 +44,33 @@ enum {
 
   /* Default frame size, 20 ms @ 48 kHz, in samples (for one channel). */
   kWebRtcOpusDefaultFrameSize = 960,
+
+  /* Default output sample rate of the decoder. Opus cannot decode at 32 kHz,
+   * so the audio is decoded at 48 kHz and resampled. */
+  kWebRtcOpusDefaultOutputRate = 32000,
 };
 
 struct WebRtcOpusEncInst {
   OpusEncoder* encoder;
+  int channels;
 };
 
+/* Default to VoIP application for mono, and AUDIO for stereo. */
+static int EncoderApplication(int32_t channels) {
+  return (channels == 1) ? OPUS_APPLICATION_VOIP : OPUS_APPLICATION_AUDIO;
+}
+
 int16_t WebRtcOpus_EncoderCreate(OpusEncInst** inst, int32_t channels) {
   OpusEncInst* state;
   if (inst != NULL) {
     state = (OpusEncInst*) calloc(1, sizeof(OpusEncInst));
     if (state) {
       int error;
-      /* Default to VoIP application for mono, and AUDIO for stereo. */
-      int application = (channels == 1) ? OPUS_APPLICATION_VOIP :
-          OPUS_APPLICATION_AUDIO;
-
-      state->encoder = opus_encoder_create(48000, channels, application,
+      state->encoder = opus_encoder_create(48000, channels,
+                                           EncoderApplication(channels),
                                            &error);
       if (error == OPUS_OK && state->encoder != NULL) {
+        state->channels = channels;
         *inst = state;
         return 0;
       }
@@ -82,6 +90,18 @@ int16_t WebRtcOpus_EncoderFree(OpusEncInst* inst) {
   }
 }
 
+int16_t WebRtcOpus_EncoderInit(OpusEncInst* inst) {
+  if (inst) {
+    /* Unlike OPUS_RESET_STATE, this also restores the default settings. */
+    int error = opus_encoder_init(inst->encoder, 48000, inst->channels,
+                                  EncoderApplication(inst->channels));
+    if (error == OPUS_OK) {
+      return 0;
+    }
+  }
+  return -1;
+}
+
 int16_t WebRtcOpus_Encode(OpusEncInst* inst, int16_t* audio_in, int16_t samples,
                           int16_t length_encoded_buffer, uint8_t* encoded) {
   opus_int16* audio = (opus_int16*) audio_in;
@@ -149,8 +169,15 @@ struct WebRtcOpusDecInst {
   OpusDecoder* decoder_right;
   int prev_decoded_samples;
   int channels;
+  int sample_rate_hz;
 };
 
+/* Returns the rate the Opus decoders of |inst| are running at. */
+static opus_int32 DecoderRateHz(const OpusDecInst* inst) {
+  return (inst->sample_rate_hz == kWebRtcOpusDefaultOutputRate) ?
+      48000 : inst->sample_rate_hz;
+}
+
 int16_t WebRtcOpus_DecoderCreate(OpusDecInst** inst, int channels) {
   int error_l;
   int error_r;
@@ -171,6 +198,7 @@ int16_t WebRtcOpus_DecoderCreate(OpusDecInst** inst, int channels) {
       /* Creation of memory all ok. */
       state->channels = channels;
       state->prev_decoded_samples = kWebRtcOpusDefaultFrameSize;
+      state->sample_rate_hz = kWebRtcOpusDefaultOutputRate;
       *inst = state;
       return 0;
     }
@@ -202,6 +230,47 @@ int WebRtcOpus_DecoderChannels(OpusDecInst* inst) {
   return inst->channels;
 }
 
+int16_t WebRtcOpus_DecoderSetSampleRate(OpusDecInst* inst,
+                                        int32_t sample_rate_hz) {
+  opus_int32 decoder_rate_hz;
+  if (inst == NULL) {
+    return -1;
+  }
+  switch (sample_rate_hz) {
+    case 8000:
+    case 16000:
+    case 48000: {
+      decoder_rate_hz = sample_rate_hz;
+      break;
+    }
+    case kWebRtcOpusDefaultOutputRate: {
+      decoder_rate_hz = 48000;
+      break;
+    }
+    default: {
+      return -1;
+    }
+  }
+  /* The size of the decoder state does not depend on the sample rate, so the
+   * decoders are initialized again in place. */
+  if (opus_decoder_init(inst->decoder_left, decoder_rate_hz,
+                        inst->channels) != OPUS_OK ||
+      opus_decoder_init(inst->decoder_right, decoder_rate_hz,
+                        inst->channels) != OPUS_OK) {
+    return -1;
+  }
+  memset(inst->state_48_32_left, 0, sizeof(inst->state_48_32_left));
+  memset(inst->state_48_32_right, 0, sizeof(inst->state_48_32_right));
+  inst->sample_rate_hz = sample_rate_hz;
+  /* 20 ms at the new decoder rate. */
+  inst->prev_decoded_samples = decoder_rate_hz / 50;
+  return 0;
+}
+
+int WebRtcOpus_DecoderSampleRate(OpusDecInst* inst) {
+  return inst->sample_rate_hz;
+}
+
 int16_t WebRtcOpus_DecoderInitNew(OpusDecInst* inst) {
   int error = opus_decoder_ctl(inst->decoder_left, OPUS_RESET_STATE);
   if (error == OPUS_OK) {
@@ -343,6 +412,18 @@ int16_t WebRtcOpus_DecodeNew(OpusDecInst* inst, const uint8_t* encoded,
   int decoded_samples;
   int resampled_samples;
 
+  if (inst->sample_rate_hz != kWebRtcOpusDefaultOutputRate) {
+    /* The decoder runs at the output rate; decode straight to |decoded|. */
+    decoded_samples = DecodeNative(inst->decoder_left, coded, encoded_bytes,
+                                   kWebRtcOpusMaxFrameSizePerChannel,
+                                   decoded, audio_type);
+    if (decoded_samples < 0) {
+      return -1;
+    }
+    inst->prev_decoded_samples = decoded_samples;
+    return decoded_samples;
+  }
+
   /* If mono case, just do a regular call to the decoder.
    * If stereo, we need to de-interleave the stereo output into blocks with
    * left and right channel. Each block is resampled to 32 kHz, and then
@@ -478,6 +559,11 @@ int16_t WebRtcOpus_DecodePlc(OpusDecInst* inst, int16_t* decoded,
   plc_samples = number_of_lost_frames * inst->prev_decoded_samples;
   plc_samples = (plc_samples <= kWebRtcOpusMaxFrameSizePerChannel) ?
       plc_samples : kWebRtcOpusMaxFrameSizePerChannel;
+  if (inst->sample_rate_hz != kWebRtcOpusDefaultOutputRate) {
+    /* The decoder runs at the output rate; decode straight to |decoded|. */
+    return DecodeNative(inst->decoder_left, NULL, 0, plc_samples, decoded,
+                        &audio_type);
+  }
   decoded_samples = DecodeNative(inst->decoder_left, NULL, 0, plc_samples,
                                  buffer, &audio_type);
   if (decoded_samples < 0) {
@@ -607,7 +693,14 @@ int16_t WebRtcOpus_DecodeFec(OpusDecInst* inst, const uint8_t* encoded,
     return 0;
   }
 
-  fec_samples = opus_packet_get_samples_per_frame(encoded, 48000);
+  fec_samples = opus_packet_get_samples_per_frame(encoded,
+                                                  DecoderRateHz(inst));
+
+  if (inst->sample_rate_hz != kWebRtcOpusDefaultOutputRate) {
+    /* The decoder runs at the output rate; decode straight to |decoded|. */
+    return DecodeFec(inst->decoder_left, coded, encoded_bytes, fec_samples,
+                     decoded, audio_type);
+  }
 
   /* Decode to a temporary buffer. */
   decoded_samples = DecodeFec(inst->decoder_left, coded, encoded_bytes,
@@ -652,10 +745,10 @@ int WebRtcOpus_DurationEst(OpusDecInst* inst,
     /* Invalid payload duration. */
     return 0;
   }
-  /* Compensate for the down-sampling from 48 kHz to 32 kHz.
-   * This should be removed when the resampling in WebRtcOpus_Decode is
-   * removed. */
-  samples = samples * 2 / 3;
+  /* Convert to the output rate of the decoder. With the default output rate
+   * this compensates for the down-sampling from 48 kHz to 32 kHz, which
+   * should be removed when the resampling in WebRtcOpus_Decode is removed. */
+  samples = samples * inst->sample_rate_hz / 48000;
   return samples;
 }
 
@@ -734,3 +827,24 @@ int WebRtcOpus_PacketHasFec(const uint8_t* payload,
 
   return 0;
 }
+
+int WebRtcOpus_PacketSampleRate(const uint8_t* payload,
+                                int payload_length_bytes) {
+  if (payload == NULL || payload_length_bytes <= 0)
+    return -1;
+
+  switch (opus_packet_get_bandwidth(payload)) {
+    case OPUS_BANDWIDTH_NARROWBAND:
+      return 8000;
+    case OPUS_BANDWIDTH_MEDIUMBAND:
+      return 12000;
+    case OPUS_BANDWIDTH_WIDEBAND:
+      return 16000;
+    case OPUS_BANDWIDTH_SUPERWIDEBAND:
+      return 24000;
+    case OPUS_BANDWIDTH_FULLBAND:
+      return 48000;
+    default:
+      return -1;
+  }
+}
@@ -58,6 +58,27 @@ int16_t WebRtcPcm16b_Encode(int16_t *speech16b,
                             int16_t len,
                             unsigned char *speech8b);
 
+/****************************************************************************
+ * WebRtcPcm16b_EncodeBatch(...)
+ *
+ * "Encode" one frame for each of several channels, as WebRtcPcm16b_Encode
+ *
+ * Input:
+ *		- speech16b		: Input speech vectors, one per frame
+ *		- numFrames		: Number of frames
+ *		- len			: Number of samples in each frame
+ *
+ * Output:
+ *		- speech8b		: Encoded data vectors (big endian 16 bit)
+ *
+ * Returned value		: Size in bytes of each encoded frame, -1 on error
+ */
+
+int16_t WebRtcPcm16b_EncodeBatch(int16_t *const *speech16b,
+                                 int16_t numFrames,
+                                 int16_t len,
+                                 unsigned char *const *speech8b);
+
 /****************************************************************************
  * WebRtcPcm16b_DecodeW16(...)
  *
@@ -19,9 +19,32 @@
 #include "signal_processing_library.h"
 #endif
 
+// SSE2 is part of the x86-64 baseline; on 32-bit x86 it is only used when the
+// compiler is allowed to assume it.
+#if defined(VOIP_ARCH_X86_64) || defined(__SSE2__) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PCM16B_SSE2
+#include <emmintrin.h>
+#endif
+
 #define HIGHEND 0xFF00
 #define LOWEND    0xFF
 
+#if defined(PCM16B_SSE2)
+/* Swaps the bytes of the 16 bit words of |in| into |out|, eight at a time.
+   Returns the number of words swapped; the caller does the rest. */
+static int SwapBytesSSE2(const void *in, int len, void *out)
+{
+    int i;
+    __m128i words;
+    for (i=0;i+8<=len;i+=8) {
+        words=_mm_loadu_si128((const __m128i *)((const int16_t *)in+i));
+        words=_mm_or_si128(_mm_slli_epi16(words,8),_mm_srli_epi16(words,8));
+        _mm_storeu_si128((__m128i *)((int16_t *)out+i),words);
+    }
+    return(i);
+}
+#endif
 
 
 /* Encoder with int16_t Output */
@@ -32,8 +55,11 @@ int16_t WebRtcPcm16b_EncodeW16(int16_t *speechIn16b,
 #ifdef VOIP_ARCH_BIG_ENDIAN
     WEBRTC_SPL_MEMCPY_W16(speechOut16b, speechIn16b, len);
 #else
-    int i;
-    for (i=0;i<len;i++) {
+    int i=0;
+#if defined(PCM16B_SSE2)
+    i=SwapBytesSSE2(speechIn16b,len,speechOut16b);
+#endif
+    for (;i<len;i++) {
         speechOut16b[i]=(((uint16_t)speechIn16b[i])>>8)|((((uint16_t)speechIn16b[i])<<8)&0xFF00);
     }
 #endif
@@ -50,7 +76,11 @@ int16_t WebRtcPcm16b_Encode(int16_t *speech16b,
     int16_t pos;
     int16_t short1;
     int16_t short2;
-    for (pos=0;pos<len;pos++) {
+    pos=0;
+#if defined(PCM16B_SSE2)
+    pos=SwapBytesSSE2(speech16b,len,speech8b);
+#endif
+    for (;pos<len;pos++) {
         short1=HIGHEND & speech16b[pos];
         short2=LOWEND & speech16b[pos];
         short1=short1>>8;
@@ -61,6 +91,23 @@ int16_t WebRtcPcm16b_Encode(int16_t *speech16b,
 }
 
 
+/* Encoder for one frame of each of several channels */
+int16_t WebRtcPcm16b_EncodeBatch(int16_t *const *speech16b,
+                                 int16_t numFrames,
+                                 int16_t len,
+                                 unsigned char *const *speech8b)
+{
+    int k;
+    if (numFrames<0) {
+        return(-1);
+    }
+    for (k=0;k<numFrames;k++) {
+        WebRtcPcm16b_Encode(speech16b[k],len,speech8b[k]);
+    }
+    return(len*2);
+}
+
+
 /* Decoder with int16_t Input instead of char when the int16_t Encoder is used */
 int16_t WebRtcPcm16b_DecodeW16(void *inst,
                                int16_t *speechIn16b,
@@ -71,10 +118,13 @@ int16_t WebRtcPcm16b_DecodeW16(void *inst,
 #ifdef VOIP_ARCH_BIG_ENDIAN
     WEBRTC_SPL_MEMCPY_W8(speechOut16b, speechIn16b, ((len*sizeof(int16_t)+1)>>1));
 #else
-    int i;
+    int i=0;
     int samples=len>>1;
 
-    for (i=0;i<samples;i++) {
+#if defined(PCM16B_SSE2)
+    i=SwapBytesSSE2(speechIn16b,samples,speechOut16b);
+#endif
+    for (;i<samples;i++) {
         speechOut16b[i]=(((uint16_t)speechIn16b[i])>>8)|(((uint16_t)(speechIn16b[i]&0xFF))<<8);
     }
 #endif
@@ -95,7 +145,11 @@ int16_t WebRtcPcm16b_Decode(unsigned char *speech8b,
     int16_t samples=len>>1;
     int16_t pos;
     int16_t shortval;
-    for (pos=0;pos<samples;pos++) {
+    pos=0;
+#if defined(PCM16B_SSE2)
+    pos=SwapBytesSSE2(speech8b,samples,speech16b);
+#endif
+    for (;pos<samples;pos++) {
         shortval=((unsigned short) speech8b[pos*2]);
         shortval=(shortval<<8)&HIGHEND;
         shortval=shortval|(((unsigned short) speech8b[pos*2+1])&LOWEND);
@@ -0,0 +1,719 @@
+/*
+ *  Copyright (c) 2014 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Measures the CPU time per frame spent in the encoder, the decoder and the
+// packet loss concealment of every bundled codec, on a reference speech file
+// or, without one, on a synthetic speech-like signal. The input is resampled
+// to the rate of each codec and coded frame by frame; every tenth frame is
+// treated as lost and concealed instead of decoded, for the codecs that have
+// a concealment. The minimum, median, 99th percentile and mean time per frame
+// are reported as JSON, so that runs before and after a change to a codec can
+// be compared.
+//
+// Usage: audio_codec_speed_benchmark [--input=FILE] [--input_rate_hz=N]
+//                                    [--passes=N] [--codec=NAME]
+//                                    [--output=FILE]
+// FILE is raw 16-bit mono PCM in host byte order.
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "audio_engine/common_audio/resampler/include/push_resampler.h"
+#include "audio_engine/modules/audio_coding/codecs/cng/include/webrtc_cng.h"
+#include "audio_engine/modules/audio_coding/codecs/g711/include/g711_interface.h"
+#include "audio_engine/modules/audio_coding/codecs/g722/include/g722_interface.h"
+#include "audio_engine/modules/audio_coding/codecs/ilbc/interface/ilbc.h"
+#include "audio_engine/modules/audio_coding/codecs/isac/fix/interface/isacfix.h"
+#include "audio_engine/modules/audio_coding/codecs/isac/main/interface/isac.h"
+#include "audio_engine/modules/audio_coding/codecs/opus/interface/opus_interface.h"
+#include "audio_engine/modules/audio_coding/codecs/pcm16b/include/pcm16b.h"
+#include "audio_engine/system_wrappers/interface/tick_util.h"
+#include "audio_engine/include/typedefs.h"
+
+namespace VoIP {
+namespace test {
+namespace {
+
+const int kDefaultInputRateHz = 48000;
+const int kSyntheticDurationMs = 10000;
+const int kMaxSampleRateHz = 48000;
+const int kMaxFrameMs = 60;
+const int kMaxFrameSamples = kMaxSampleRateHz / 1000 * kMaxFrameMs;
+const int kMaxPayloadBytes = 1500;
+// Frames at the start of each codec run that are coded but not measured, so
+// that caches and the state of adaptive codecs have settled.
+const int kWarmupFrames = 10;
+// Every |kPlcInterval|-th frame is concealed instead of decoded.
+const int kPlcInterval = 10;
+
+// Interface to one codec configuration. Encode() and Decode() process exactly
+// one frame of frame_ms() milliseconds at sample_rate_hz().
+class CodecUnderTest {
+ public:
+  virtual ~CodecUnderTest() {}
+
+  virtual const char* name() const = 0;
+  // Free-form description of the settings, e.g. the bitrate.
+  virtual std::string config() const { return ""; }
+  virtual int sample_rate_hz() const = 0;
+  virtual int frame_ms() const = 0;
+
+  // Creates and initializes the encoder and decoder. Returns false on error.
+  virtual bool Init() = 0;
+  // Returns the number of payload bytes, or -1 on error.
+  virtual int Encode(const int16_t* audio, uint8_t* payload) = 0;
+  // Returns the number of decoded samples, or -1 on error.
+  virtual int Decode(const uint8_t* payload, int payload_bytes,
+                     int16_t* audio) = 0;
+  virtual bool SupportsPlc() const { return false; }
+  // Conceals one lost frame. Returns the number of samples, or -1 on error.
+  virtual int DecodePlc(int16_t* audio) { return -1; }
+
+  int frame_samples() const { return sample_rate_hz() / 1000 * frame_ms(); }
+};
+
+class G711Codec : public CodecUnderTest {
+ public:
+  explicit G711Codec(bool a_law) : a_law_(a_law) {}
+
+  virtual const char* name() const { return a_law_ ? "g711a" : "g711u"; }
+  virtual int sample_rate_hz() const { return 8000; }
+  virtual int frame_ms() const { return 20; }
+  virtual bool Init() { return true; }
+  virtual int Encode(const int16_t* audio, uint8_t* payload) {
+    int16_t* in = const_cast<int16_t*>(audio);
+    int16_t* out = reinterpret_cast<int16_t*>(payload);
+    return a_law_ ? WebRtcG711_EncodeA(NULL, in, frame_samples(), out) :
+        WebRtcG711_EncodeU(NULL, in, frame_samples(), out);
+  }
+  virtual int Decode(const uint8_t* payload, int payload_bytes,
+                     int16_t* audio) {
+    int16_t* in = reinterpret_cast<int16_t*>(const_cast<uint8_t*>(payload));
+    int16_t speech_type;
+    return a_law_ ?
+        WebRtcG711_DecodeA(NULL, in, payload_bytes, audio, &speech_type) :
+        WebRtcG711_DecodeU(NULL, in, payload_bytes, audio, &speech_type);
+  }
+
+ private:
+  const bool a_law_;
+};
+
+class G722Codec : public CodecUnderTest {
+ public:
+  G722Codec() : encoder_(NULL), decoder_(NULL) {}
+  virtual ~G722Codec() {
+    if (encoder_)
+      WebRtcG722_FreeEncoder(encoder_);
+    if (decoder_)
+      WebRtcG722_FreeDecoder(decoder_);
+  }
+
+  virtual const char* name() const { return "g722"; }
+  virtual int sample_rate_hz() const { return 16000; }
+  virtual int frame_ms() const { return 20; }
+  virtual bool Init() {
+    return WebRtcG722_CreateEncoder(&encoder_) == 0 &&
+        WebRtcG722_EncoderInit(encoder_) == 0 &&
+        WebRtcG722_CreateDecoder(&decoder_) == 0 &&
+        WebRtcG722_DecoderInit(decoder_) == 0;
+  }
+  virtual int Encode(const int16_t* audio, uint8_t* payload) {
+    return WebRtcG722_Encode(encoder_, const_cast<int16_t*>(audio),
+                             frame_samples(),
+                             reinterpret_cast<int16_t*>(payload));
+  }
+  virtual int Decode(const uint8_t* payload, int payload_bytes,
+                     int16_t* audio) {
+    int16_t speech_type;
+    return WebRtcG722_Decode(
+        decoder_, reinterpret_cast<int16_t*>(const_cast<uint8_t*>(payload)),
+        payload_bytes, audio, &speech_type);
+  }
+
+ private:
+  G722EncInst* encoder_;
+  G722DecInst* decoder_;
+};
+
+class Pcm16bCodec : public CodecUnderTest {
+ public:
+  virtual const char* name() const { return "pcm16b"; }
+  virtual int sample_rate_hz() const { return 16000; }
+  virtual int frame_ms() const { return 20; }
+  virtual bool Init() { return true; }
+  virtual int Encode(const int16_t* audio, uint8_t* payload) {
+    return WebRtcPcm16b_Encode(const_cast<int16_t*>(audio), frame_samples(),
+                               payload);
+  }
+  virtual int Decode(const uint8_t* payload, int payload_bytes,
+                     int16_t* audio) {
+    int16_t speech_type;
+    return WebRtcPcm16b_DecodeW16(
+        NULL, reinterpret_cast<int16_t*>(const_cast<uint8_t*>(payload)),
+        payload_bytes, audio, &speech_type);
+  }
+};
+
+class IlbcCodec : public CodecUnderTest {
+ public:
+  explicit IlbcCodec(int frame_ms)
+      : frame_ms_(frame_ms), encoder_(NULL), decoder_(NULL) {}
+  virtual ~IlbcCodec() {
+    if (encoder_)
+      WebRtcIlbcfix_EncoderFree(encoder_);
+    if (decoder_)
+      WebRtcIlbcfix_DecoderFree(decoder_);
+  }
+
+  virtual const char* name() const { return "ilbc"; }
+  virtual int sample_rate_hz() const { return 8000; }
+  virtual int frame_ms() const { return frame_ms_; }
+  virtual bool Init() {
+    return WebRtcIlbcfix_EncoderCreate(&encoder_) == 0 &&
+        WebRtcIlbcfix_EncoderInit(encoder_, frame_ms_) == 0 &&
+        WebRtcIlbcfix_DecoderCreate(&decoder_) == 0 &&
+        WebRtcIlbcfix_DecoderInit(decoder_, frame_ms_) == 0;
+  }
+  virtual int Encode(const int16_t* audio, uint8_t* payload) {
+    return WebRtcIlbcfix_Encode(encoder_, audio, frame_samples(),
+                                reinterpret_cast<int16_t*>(payload));
+  }
+  virtual int Decode(const uint8_t* payload, int payload_bytes,
+                     int16_t* audio) {
+    int16_t speech_type;
+    return WebRtcIlbcfix_Decode(
+        decoder_, reinterpret_cast<const int16_t*>(payload), payload_bytes,
+        audio, &speech_type);
+  }
+  virtual bool SupportsPlc() const { return true; }
+  virtual int DecodePlc(int16_t* audio) {
+    return WebRtcIlbcfix_DecodePlc(decoder_, audio, 1);
+  }
+
+ private:
+  const int frame_ms_;
+  iLBC_encinst_t* encoder_;
+  iLBC_decinst_t* decoder_;
+};
+
+// iSAC codes 10 ms blocks; Encode() feeds all blocks of a frame and returns
+// the packet that they complete.
+const int kIsacRateBps = 32000;
+const int kIsacFrameMs = 30;
+
+class IsacFloatCodec : public CodecUnderTest {
+ public:
+  IsacFloatCodec() : inst_(NULL) {}
+  virtual ~IsacFloatCodec() {
+    if (inst_)
+      WebRtcIsac_Free(inst_);
+  }
+
+  virtual const char* name() const { return "isac"; }
+  virtual int sample_rate_hz() const { return 16000; }
+  virtual int frame_ms() const { return kIsacFrameMs; }
+  virtual bool Init() {
+    // Instantaneous mode, so that the bitrate is fixed.
+    return WebRtcIsac_Create(&inst_) == 0 &&
+        WebRtcIsac_EncoderInit(inst_, 1) == 0 &&
+        WebRtcIsac_Control(inst_, kIsacRateBps, kIsacFrameMs) == 0 &&
+        WebRtcIsac_DecoderInit(inst_) == 0;
+  }
+  virtual int Encode(const int16_t* audio, uint8_t* payload) {
+    int bytes = 0;
+    for (int block = 0; block < kIsacFrameMs / 10; ++block) {
+      const int result = WebRtcIsac_Encode(
+          inst_, audio + block * 160, reinterpret_cast<int16_t*>(payload));
+      if (result != 0)
+        bytes = result;
+    }
+    return bytes;
+  }
+  virtual int Decode(const uint8_t* payload, int payload_bytes,
+                     int16_t* audio) {
+    int16_t speech_type;
+    return WebRtcIsac_Decode(inst_, reinterpret_cast<const uint16_t*>(payload),
+                             payload_bytes, audio, &speech_type);
+  }
+  virtual bool SupportsPlc() const { return true; }
+  virtual int DecodePlc(int16_t* audio) {
+    return WebRtcIsac_DecodePlc(inst_, audio, 1);
+  }
+
+ private:
+  ISACStruct* inst_;
+};
+
+class IsacFixCodec : public CodecUnderTest {
+ public:
+  IsacFixCodec() : inst_(NULL) {}
+  virtual ~IsacFixCodec() {
+    if (inst_)
+      WebRtcIsacfix_Free(inst_);
+  }
+
+  virtual const char* name() const { return "isacfix"; }
+  virtual int sample_rate_hz() const { return 16000; }
+  virtual int frame_ms() const { return kIsacFrameMs; }
+  virtual bool Init() {
+    return WebRtcIsacfix_Create(&inst_) == 0 &&
+        WebRtcIsacfix_EncoderInit(inst_, 1) == 0 &&
+        WebRtcIsacfix_Control(inst_, kIsacRateBps, kIsacFrameMs) == 0 &&
+        WebRtcIsacfix_DecoderInit(inst_) == 0;
+  }
+  virtual int Encode(const int16_t* audio, uint8_t* payload) {
+    int bytes = 0;
+    for (int block = 0; block < kIsacFrameMs / 10; ++block) {
+      const int result = WebRtcIsacfix_Encode(
+          inst_, audio + block * 160, reinterpret_cast<int16_t*>(payload));
+      if (result != 0)
+        bytes = result;
+    }
+    return bytes;
+  }
+  virtual int Decode(const uint8_t* payload, int payload_bytes,
+                     int16_t* audio) {
+    int16_t speech_type;
+    return WebRtcIsacfix_Decode(inst_,
+                                reinterpret_cast<const uint16_t*>(payload),
+                                payload_bytes, audio, &speech_type);
+  }
+  virtual bool SupportsPlc() const { return true; }
+  virtual int DecodePlc(int16_t* audio) {
+    return WebRtcIsacfix_DecodePlc(inst_, audio, 1);
+  }
+
+ private:
+  ISACFIX_MainStruct* inst_;
+};
+
+class OpusCodec : public CodecUnderTest {
+ public:
+  OpusCodec(int complexity, int bitrate_bps)
+      : complexity_(complexity),
+        bitrate_bps_(bitrate_bps),
+        encoder_(NULL),
+        decoder_(NULL) {}
+  virtual ~OpusCodec() {
+    if (encoder_)
+      WebRtcOpus_EncoderFree(encoder_);
+    if (decoder_)
+      WebRtcOpus_DecoderFree(decoder_);
+  }
+
+  virtual const char* name() const { return "opus"; }
+  virtual std::string config() const {
+    char buffer[64];
+    sprintf(buffer, "complexity=%d bitrate=%d", complexity_, bitrate_bps_);
+    return buffer;
+  }
+  virtual int sample_rate_hz() const { return 48000; }
+  virtual int frame_ms() const { return 20; }
+  virtual bool Init() {
+    return WebRtcOpus_EncoderCreate(&encoder_, 1) == 0 &&
+        WebRtcOpus_SetComplexity(encoder_, complexity_) == 0 &&
+        WebRtcOpus_SetBitRate(encoder_, bitrate_bps_) == 0 &&
+        WebRtcOpus_DecoderCreate(&decoder_, 1) == 0 &&
+        WebRtcOpus_DecoderInitNew(decoder_) == 0;
+  }
+  virtual int Encode(const int16_t* audio, uint8_t* payload) {
+    return WebRtcOpus_Encode(encoder_, const_cast<int16_t*>(audio),
+                             frame_samples(), kMaxPayloadBytes, payload);
+  }
+  virtual int Decode(const uint8_t* payload, int payload_bytes,
+                     int16_t* audio) {
+    int16_t audio_type;
+    return WebRtcOpus_DecodeNew(decoder_, payload, payload_bytes, audio,
+                                &audio_type);
+  }
+  virtual bool SupportsPlc() const { return true; }
+  virtual int DecodePlc(int16_t* audio) {
+    return WebRtcOpus_DecodePlc(decoder_, audio, 1);
+  }
+
+ private:
+  const int complexity_;
+  const int bitrate_bps_;
+  OpusEncInst* encoder_;
+  OpusDecInst* decoder_;
+};
+
+// Comfort noise. Every frame is analyzed into a SID frame; decoding updates
+// the generator with it and generates one frame of noise.
+class CngCodec : public CodecUnderTest {
+ public:
+  CngCodec() : encoder_(NULL), decoder_(NULL), first_(true) {}
+  virtual ~CngCodec() {
+    if (encoder_)
+      WebRtcCng_FreeEnc(encoder_);
+    if (decoder_)
+      WebRtcCng_FreeDec(decoder_);
+  }
+
+  virtual const char* name() const { return "cng"; }
+  virtual int sample_rate_hz() const { return 16000; }
+  virtual int frame_ms() const { return 20; }
+  virtual bool Init() {
+    first_ = true;
+    return WebRtcCng_CreateEnc(&encoder_) == 0 &&
+        WebRtcCng_InitEnc(encoder_, sample_rate_hz(), 100, 8) == 0 &&
+        WebRtcCng_CreateDec(&decoder_) == 0 &&
+        WebRtcCng_InitDec(decoder_) == 0;
+  }
+  virtual int Encode(const int16_t* audio, uint8_t* payload) {
+    int16_t bytes = 0;
+    if (WebRtcCng_Encode(encoder_, const_cast<int16_t*>(audio),
+                         frame_samples(), payload, &bytes, 1) < 0) {
+      return -1;
+    }
+    return bytes;
+  }
+  virtual int Decode(const uint8_t* payload, int payload_bytes,
+                     int16_t* audio) {
+    if (WebRtcCng_UpdateSid(decoder_, const_cast<uint8_t*>(payload),
+                            payload_bytes) < 0 ||
+        WebRtcCng_Generate(decoder_, audio, frame_samples(),
+                           first_ ? 1 : 0) < 0) {
+      return -1;
+    }
+    first_ = false;
+    return frame_samples();
+  }
+
+ private:
+  CNG_enc_inst* encoder_;
+  CNG_dec_inst* decoder_;
+  bool first_;
+};
+
+struct Statistics {
+  Statistics() : min_us(0), median_us(0), p99_us(0), mean_us(0) {}
+  double min_us;
+  double median_us;
+  double p99_us;
+  double mean_us;
+};
+
+struct CodecResult {
+  int frames;
+  double bitrate_bps;
+  Statistics encode;
+  Statistics decode;
+  bool has_plc;
+  Statistics plc;
+};
+
+// Returns the time from |start| to |end| in microseconds, without rounding
+// to whole microseconds; the cheapest codecs take less than that per frame.
+double ElapsedUs(const TickTime& start, const TickTime& end) {
+  return TickTime::TicksToMilliseconds(
+      (end.Ticks() - start.Ticks()) * 1000000) / 1000.0;
+}
+
+Statistics ComputeStatistics(std::vector<double>* times_us) {
+  Statistics stats;
+  if (times_us->empty())
+    return stats;
+  std::sort(times_us->begin(), times_us->end());
+  const size_t n = times_us->size();
+  double sum = 0;
+  for (size_t i = 0; i < n; ++i)
+    sum += (*times_us)[i];
+  stats.min_us = (*times_us)[0];
+  stats.median_us = (*times_us)[n / 2];
+  stats.p99_us = (*times_us)[std::min(n - 1, n * 99 / 100)];
+  stats.mean_us = sum / n;
+  return stats;
+}
+
+// A speech-like test signal: a harmonic voice with gliding pitch, shaped into
+// syllables, on top of a little noise.
+std::vector<int16_t> SyntheticSpeech(int sample_rate_hz, int duration_ms) {
+  const double kPi = 3.14159265358979323846;
+  const int num_samples = sample_rate_hz / 1000 * duration_ms;
+  std::vector<int16_t> audio(num_samples);
+  double phase = 0;
+  unsigned int noise_state = 1;
+  for (int n = 0; n < num_samples; ++n) {
+    const double t = static_cast<double>(n) / sample_rate_hz;
+    const double pitch_hz = 150 + 60 * sin(2 * kPi * 0.7 * t);
+    phase += 2 * kPi * pitch_hz / sample_rate_hz;
+    double voice = 0;
+    for (int harmonic = 1; harmonic <= 20; ++harmonic) {
+      if (harmonic * pitch_hz >= sample_rate_hz / 2)
+        break;
+      voice += sin(harmonic * phase) / harmonic;
+    }
+    const double envelope = std::max(0.0, sin(2 * kPi * 4 * t));
+    noise_state = noise_state * 1103515245 + 12345;
+    const double noise =
+        static_cast<int>((noise_state >> 16) & 0x7fff) / 32768.0 - 0.5;
+    audio[n] = static_cast<int16_t>(6000 * envelope * voice + 300 * noise);
+  }
+  return audio;
+}
+
+bool ReadPcmFile(const std::string& file_name, std::vector<int16_t>* audio) {
+  FILE* file = fopen(file_name.c_str(), "rb");
+  if (!file)
+    return false;
+  int16_t buffer[1024];
+  size_t read;
+  while ((read = fread(buffer, sizeof(buffer[0]), 1024, file)) > 0)
+    audio->insert(audio->end(), buffer, buffer + read);
+  fclose(file);
+  return !audio->empty();
+}
+
+bool Resample(const std::vector<int16_t>& input, int input_rate_hz,
+              int output_rate_hz, std::vector<int16_t>* output) {
+  if (input_rate_hz == output_rate_hz) {
+    *output = input;
+    return true;
+  }
+  PushResampler<int16_t> resampler;
+  if (resampler.InitializeIfNeeded(input_rate_hz, output_rate_hz, 1) != 0)
+    return false;
+  const int input_block = input_rate_hz / 100;
+  const int output_block = output_rate_hz / 100;
+  output->resize(input.size() / input_block * output_block);
+  for (size_t block = 0; block < input.size() / input_block; ++block) {
+    if (resampler.Resample(&input[block * input_block], input_block,
+                           &(*output)[block * output_block],
+                           output_block) != output_block) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool RunCodec(CodecUnderTest* codec, const std::vector<int16_t>& audio,
+              int passes, CodecResult* result) {
+  if (!codec->Init())
+    return false;
+  const int frame_samples = codec->frame_samples();
+  const int frames_per_pass = static_cast<int>(audio.size()) / frame_samples;
+  if (frames_per_pass <= kWarmupFrames)
+    return false;
+
+  std::vector<double> encode_us;
+  std::vector<double> decode_us;
+  std::vector<double> plc_us;
+  int64_t total_bytes = 0;
+  // Aligned for the codecs that take the payload as 16-bit words.
+  uint16_t payload_words[kMaxPayloadBytes / 2];
+  uint8_t* payload = reinterpret_cast<uint8_t*>(payload_words);
+  int16_t decoded[kMaxFrameSamples];
+  int frame_count = 0;
+  for (int pass = 0; pass < passes; ++pass) {
+    for (int frame = 0; frame < frames_per_pass; ++frame, ++frame_count) {
+      const bool measure = frame_count >= kWarmupFrames;
+      TickTime start = TickTime::Now();
+      const int bytes = codec->Encode(&audio[frame * frame_samples], payload);
+      TickTime end = TickTime::Now();
+      if (bytes < 0 || bytes > kMaxPayloadBytes)
+        return false;
+      if (measure) {
+        encode_us.push_back(ElapsedUs(start, end));
+        total_bytes += bytes;
+      }
+
+      const bool lost = codec->SupportsPlc() &&
+          frame_count % kPlcInterval == kPlcInterval - 1;
+      if (bytes == 0 && !lost)
+        continue;
+      start = TickTime::Now();
+      const int samples = lost ? codec->DecodePlc(decoded) :
+          codec->Decode(payload, bytes, decoded);
+      end = TickTime::Now();
+      if (samples < 0)
+        return false;
+      if (measure)
+        (lost ? plc_us : decode_us).push_back(ElapsedUs(start, end));
+    }
+  }
+
+  result->frames = static_cast<int>(encode_us.size());
+  result->bitrate_bps =
+      total_bytes * 8 * 1000.0 / (result->frames * codec->frame_ms());
+  result->encode = ComputeStatistics(&encode_us);
+  result->decode = ComputeStatistics(&decode_us);
+  result->has_plc = !plc_us.empty();
+  result->plc = ComputeStatistics(&plc_us);
+  return true;
+}
+
+void PrintJsonString(FILE* out, const char* value) {
+  fputc('"', out);
+  for (const char* c = value; *c; ++c) {
+    if (*c == '"' || *c == '\\')
+      fputc('\\', out);
+    fputc(*c, out);
+  }
+  fputc('"', out);
+}
+
+void PrintStatistics(FILE* out, const char* name, const Statistics& stats,
+                     bool valid, bool last) {
+  if (!valid) {
+    fprintf(out, "      \"%s\": null%s\n", name, last ? "" : ",");
+    return;
+  }
+  fprintf(out, "      \"%s\": { \"min\": %.3f, \"median\": %.3f, "
+          "\"p99\": %.3f, \"mean\": %.3f }%s\n", name, stats.min_us,
+          stats.median_us, stats.p99_us, stats.mean_us, last ? "" : ",");
+}
+
+void PrintCodec(FILE* out, const CodecUnderTest& codec,
+                const CodecResult& result, bool last) {
+  fprintf(out, "    {\n");
+  fprintf(out, "      \"codec\": \"%s\",\n", codec.name());
+  fprintf(out, "      \"config\": \"%s\",\n", codec.config().c_str());
+  fprintf(out, "      \"sample_rate_hz\": %d,\n", codec.sample_rate_hz());
+  fprintf(out, "      \"frame_ms\": %d,\n", codec.frame_ms());
+  fprintf(out, "      \"frames\": %d,\n", result.frames);
+  fprintf(out, "      \"bitrate_bps\": %.0f,\n", result.bitrate_bps);
+  PrintStatistics(out, "encode_us", result.encode, true, false);
+  PrintStatistics(out, "decode_us", result.decode, true, false);
+  PrintStatistics(out, "plc_us", result.plc, result.has_plc, true);
+  fprintf(out, "    }%s\n", last ? "" : ",");
+}
+
+void CreateCodecs(std::vector<CodecUnderTest*>* codecs) {
+  codecs->push_back(new G711Codec(true));
+  codecs->push_back(new G711Codec(false));
+  codecs->push_back(new G722Codec);
+  codecs->push_back(new Pcm16bCodec);
+  codecs->push_back(new IlbcCodec(20));
+  codecs->push_back(new IlbcCodec(30));
+  codecs->push_back(new IsacFloatCodec);
+  codecs->push_back(new IsacFixCodec);
+  const int kOpusComplexities[] = { 0, 5, 10 };
+  for (size_t i = 0; i < sizeof(kOpusComplexities) / sizeof(int); ++i)
+    codecs->push_back(new OpusCodec(kOpusComplexities[i], 32000));
+  // At 16 kbps mono the encoder runs SILK in wideband, i.e. the voice path.
+  for (size_t i = 0; i < sizeof(kOpusComplexities) / sizeof(int); ++i)
+    codecs->push_back(new OpusCodec(kOpusComplexities[i], 16000));
+  codecs->push_back(new OpusCodec(10, 64000));
+  codecs->push_back(new CngCodec);
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace VoIP
+
+int main(int argc, char* argv[]) {
+  std::string input_file;
+  int input_rate_hz = VoIP::test::kDefaultInputRateHz;
+  int passes = 1;
+  std::string codec_filter;
+  std::string output_file;
+  for (int i = 1; i < argc; ++i) {
+    if (strncmp(argv[i], "--input=", 8) == 0) {
+      input_file = argv[i] + 8;
+    } else if (strncmp(argv[i], "--input_rate_hz=", 16) == 0) {
+      input_rate_hz = atoi(argv[i] + 16);
+    } else if (strncmp(argv[i], "--passes=", 9) == 0) {
+      passes = atoi(argv[i] + 9);
+    } else if (strncmp(argv[i], "--codec=", 8) == 0) {
+      codec_filter = argv[i] + 8;
+    } else if (strncmp(argv[i], "--output=", 9) == 0) {
+      output_file = argv[i] + 9;
+    } else {
+      fprintf(stderr, "Usage: %s [--input=FILE] [--input_rate_hz=N] "
+              "[--passes=N] [--codec=NAME] [--output=FILE]\n", argv[0]);
+      return 1;
+    }
+  }
+  if (input_rate_hz <= 0 || input_rate_hz % 100 != 0 ||
+      input_rate_hz > VoIP::test::kMaxSampleRateHz || passes <= 0) {
+    fprintf(stderr, "Invalid input rate or number of passes.\n");
+    return 1;
+  }
+
+  std::vector<int16_t> input;
+  if (input_file.empty()) {
+    input = VoIP::test::SyntheticSpeech(input_rate_hz,
+                                        VoIP::test::kSyntheticDurationMs);
+  } else if (!VoIP::test::ReadPcmFile(input_file, &input)) {
+    fprintf(stderr, "Cannot read %s.\n", input_file.c_str());
+    return 1;
+  }
+
+  std::vector<VoIP::test::CodecUnderTest*> codecs;
+  VoIP::test::CreateCodecs(&codecs);
+  std::vector<VoIP::test::CodecUnderTest*> selected;
+  for (size_t i = 0; i < codecs.size(); ++i) {
+    if (codec_filter.empty() || codec_filter == codecs[i]->name())
+      selected.push_back(codecs[i]);
+  }
+  if (selected.empty()) {
+    fprintf(stderr, "Codec %s not supported.\n", codec_filter.c_str());
+    return 1;
+  }
+
+  std::map<int, std::vector<int16_t> > resampled;
+  std::vector<VoIP::test::CodecResult> results(selected.size());
+  int status = 0;
+  for (size_t i = 0; i < selected.size() && status == 0; ++i) {
+    const int rate_hz = selected[i]->sample_rate_hz();
+    if (resampled.find(rate_hz) == resampled.end() &&
+        !VoIP::test::Resample(input, input_rate_hz, rate_hz,
+                              &resampled[rate_hz])) {
+      fprintf(stderr, "Cannot resample to %d Hz.\n", rate_hz);
+      status = 1;
+    } else if (!VoIP::test::RunCodec(selected[i], resampled[rate_hz], passes,
+                                     &results[i])) {
+      fprintf(stderr, "Codec %s %s failed.\n", selected[i]->name(),
+              selected[i]->config().c_str());
+      status = 1;
+    }
+  }
+
+  FILE* out = stdout;
+  if (status == 0 && !output_file.empty()) {
+    out = fopen(output_file.c_str(), "w");
+    if (!out) {
+      fprintf(stderr, "Cannot open %s.\n", output_file.c_str());
+      status = 1;
+    }
+  }
+  if (status == 0) {
+    fprintf(out, "{\n");
+    fprintf(out, "  \"input\": ");
+    VoIP::test::PrintJsonString(
+        out, input_file.empty() ? "synthetic" : input_file.c_str());
+    fprintf(out, ",\n");
+    fprintf(out, "  \"input_rate_hz\": %d,\n", input_rate_hz);
+    fprintf(out, "  \"input_duration_ms\": %d,\n",
+            static_cast<int>(input.size() * 1000 / input_rate_hz));
+    fprintf(out, "  \"passes\": %d,\n", passes);
+    fprintf(out, "  \"codecs\": [\n");
+    for (size_t i = 0; i < selected.size(); ++i) {
+      VoIP::test::PrintCodec(out, *selected[i], results[i],
+                             i + 1 == selected.size());
+    }
+    fprintf(out, "  ]\n");
+    fprintf(out, "}\n");
+    if (out != stdout)
+      fclose(out);
+  }
+  for (size_t i = 0; i < codecs.size(); ++i)
+    delete codecs[i];
+  return status;
+}
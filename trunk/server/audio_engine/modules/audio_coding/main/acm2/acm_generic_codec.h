@@ -26,8 +26,10 @@ struct WebRtcCngEncInst;
 
 namespace VoIP {
 
+struct AudioEncodingStats;
 struct WebRtcACMCodecParams;
 struct CodecInst;
+class OpusComplexityController;
 
 namespace acm2 {
 
@@ -560,6 +562,19 @@ class ACMGenericCodec {
   //
   virtual AudioDecoder* Decoder(int /* codec_id */) { return NULL; }
 
+  //
+  // Lets |controller| adjust the complexity of the encoder to keep the total
+  // encode time within a CPU budget. NULL detaches the encoder. Only codecs
+  // with an adjustable complexity implement this.
+  //
+  virtual void SetComplexityController(
+      OpusComplexityController* /* controller */) {}
+
+  //
+  // Fills in the encoder statistics supported by the codec.
+  //
+  virtual void GetEncodingStatistics(AudioEncodingStats* /* stats */) {}
+
  protected:
   ///////////////////////////////////////////////////////////////////////////
   // All the functions with FunctionNameSafe(...) contain the actual
@@ -14,6 +14,8 @@
 #include "audio_engine/modules/audio_coding/codecs/opus/interface/opus_interface.h"
 #include "audio_engine/modules/audio_coding/main/acm2/acm_codec_database.h"
 #include "audio_engine/modules/audio_coding/main/acm2/acm_common_defs.h"
+#include "audio_engine/modules/audio_coding/main/interface/opus_complexity_controller.h"
+#include "audio_engine/system_wrappers/interface/tick_util.h"
 #include "audio_engine/system_wrappers/interface/trace.h"
 #endif
 
@@ -27,7 +29,11 @@ ACMOpus::ACMOpus(int16_t /* codec_id */)
     : encoder_inst_ptr_(NULL),
       sample_freq_(0),
       bitrate_(0),
-      channels_(1) {
+      channels_(1),
+      complexity_(-1),
+      max_complexity_(-1),
+      complexity_controller_(NULL),
+      controller_stream_id_(-1) {
   return;
 }
 
@@ -64,13 +70,49 @@ int16_t ACMOpus::SetBitRateSafe(const int32_t /*rate*/) {
   return -1;
 }
 
+void ACMOpus::SetComplexityController(
+    OpusComplexityController* /* controller */) {
+  return;
+}
+
+void ACMOpus::GetEncodingStatistics(AudioEncodingStats* /* stats */) {
+  return;
+}
+
+void ACMOpus::UpdateComplexity(int /* complexity */) {
+  return;
+}
+
+void ACMOpus::AddToController() {
+  return;
+}
+
+void ACMOpus::RemoveFromController() {
+  return;
+}
+
 #else  //===================== Actual Implementation =======================
 
+// Complexity the Opus encoder is created with.
+static const int kOpusDefaultComplexity = 9;
+
+// On Android, iOS and/or ARM, use a lower complexity setting as default, to
+// save encoder complexity.
+#if defined(VOIP_ANDROID) || defined(VOIP_IOS) || defined(WEBRTC_ARCH_ARM)
+static const int kOpusMaxComplexity = 5;
+#else
+static const int kOpusMaxComplexity = kOpusDefaultComplexity;
+#endif
+
 ACMOpus::ACMOpus(int16_t codec_id)
     : encoder_inst_ptr_(NULL),
       sample_freq_(32000),  // Default sampling frequency.
       bitrate_(20000),  // Default bit-rate.
-      channels_(1) {  // Default mono
+      channels_(1),  // Default mono
+      complexity_(kOpusMaxComplexity),
+      max_complexity_(kOpusMaxComplexity),
+      complexity_controller_(NULL),
+      controller_stream_id_(-1) {
   codec_id_ = codec_id;
   // Opus has internal DTX, but we dont use it for now.
   has_internal_dtx_ = false;
@@ -85,6 +127,7 @@ ACMOpus::ACMOpus(int16_t codec_id)
 }
 
 ACMOpus::~ACMOpus() {
+  RemoveFromController();
   if (encoder_inst_ptr_ != NULL) {
     WebRtcOpus_EncoderFree(encoder_inst_ptr_);
     encoder_inst_ptr_ = NULL;
@@ -93,6 +136,14 @@ ACMOpus::~ACMOpus() {
 
 int16_t ACMOpus::InternalEncode(uint8_t* bitstream,
                                 int16_t* bitstream_len_byte) {
+  // Only time the encoder when the controller will use the result.
+  const bool timed = complexity_controller_ != NULL &&
+      controller_stream_id_ >= 0;
+  TickTime start;
+  if (timed) {
+    start = TickTime::Now();
+  }
+
   // Call Encoder.
   *bitstream_len_byte = WebRtcOpus_Encode(encoder_inst_ptr_,
                                           &in_audio_[in_audio_ix_read_],
@@ -110,17 +161,33 @@ int16_t ACMOpus::InternalEncode(uint8_t* bitstream,
   // we have gone forward in reading the audio buffer.
   in_audio_ix_read_ += frame_len_smpl_ * channels_;
 
+  if (timed) {
+    const int encode_time_us =
+        static_cast<int>((TickTime::Now() - start).Microseconds());
+    const int audio_ms =
+        frame_len_smpl_ * 1000 / encoder_params_.codec_inst.plfreq;
+    UpdateComplexity(complexity_controller_->EncodeDone(
+        controller_stream_id_, encode_time_us, audio_ms));
+  }
+
   return *bitstream_len_byte;
 }
 
 int16_t ACMOpus::InternalInitEncoder(WebRtcACMCodecParams* codec_params) {
   int16_t ret;
-  if (encoder_inst_ptr_ != NULL) {
-    WebRtcOpus_EncoderFree(encoder_inst_ptr_);
-    encoder_inst_ptr_ = NULL;
+  if (encoder_inst_ptr_ != NULL &&
+      channels_ == codec_params->codec_inst.channels) {
+    // Reinitialize in place, so that reusing an instance, e.g. one taken
+    // from an ACMCodecPool, does not allocate.
+    ret = WebRtcOpus_EncoderInit(encoder_inst_ptr_);
+  } else {
+    if (encoder_inst_ptr_ != NULL) {
+      WebRtcOpus_EncoderFree(encoder_inst_ptr_);
+      encoder_inst_ptr_ = NULL;
+    }
+    ret = WebRtcOpus_EncoderCreate(&encoder_inst_ptr_,
+                                   codec_params->codec_inst.channels);
   }
-  ret = WebRtcOpus_EncoderCreate(&encoder_inst_ptr_,
-                                 codec_params->codec_inst.channels);
   // Store number of channels.
   channels_ = codec_params->codec_inst.channels;
 
@@ -140,20 +207,19 @@ int16_t ACMOpus::InternalInitEncoder(WebRtcACMCodecParams* codec_params) {
   // Store bitrate.
   bitrate_ = codec_params->codec_inst.rate;
 
-  // TODO(tlegrand): Remove this code when we have proper APIs to set the
-  // complexity at a higher level.
-#if defined(VOIP_ANDROID) || defined(VOIP_IOS) || defined(WEBRTC_ARCH_ARM)
-  // If we are on Android, iOS and/or ARM, use a lower complexity setting as
-  // default, to save encoder complexity.
-  const int kOpusComplexity5 = 5;
-  WebRtcOpus_SetComplexity(encoder_inst_ptr_, kOpusComplexity5);
-  if (ret < 0) {
-     WEBRTC_TRACE(VoIP::kTraceError, VoIP::kTraceAudioCoding, unique_id_,
-                  "Setting complexity failed for Opus");
-     return ret;
-   }
-#endif
+  // A new encoder starts at the Opus default complexity. Apply the current
+  // setting if it differs: the lower default on mobile platforms, or a level
+  // chosen by the complexity controller.
+  if (complexity_ != kOpusDefaultComplexity) {
+    ret = WebRtcOpus_SetComplexity(encoder_inst_ptr_, complexity_);
+    if (ret < 0) {
+      WEBRTC_TRACE(VoIP::kTraceError, VoIP::kTraceAudioCoding, unique_id_,
+                   "Setting complexity failed for Opus");
+      return ret;
+    }
+  }
 
+  AddToController();
   return 0;
 }
 
@@ -167,6 +233,7 @@ int16_t ACMOpus::InternalCreateEncoder() {
 }
 
 void ACMOpus::DestructEncoderSafe() {
+  RemoveFromController();
   if (encoder_inst_ptr_) {
     WebRtcOpus_EncoderFree(encoder_inst_ptr_);
     encoder_inst_ptr_ = NULL;
@@ -198,6 +265,59 @@ int16_t ACMOpus::SetBitRateSafe(const int32_t rate) {
   return -1;
 }
 
+void ACMOpus::SetComplexityController(OpusComplexityController* controller) {
+  WriteLockScoped lockCodec(codec_wrapper_lock_);
+  if (controller == complexity_controller_) {
+    return;
+  }
+  RemoveFromController();
+  complexity_controller_ = controller;
+  if (!complexity_controller_) {
+    UpdateComplexity(max_complexity_);
+  }
+  AddToController();
+}
+
+void ACMOpus::GetEncodingStatistics(AudioEncodingStats* stats) {
+  ReadLockScoped lockCodec(codec_wrapper_lock_);
+  stats->complexity = complexity_;
+  stats->max_complexity = max_complexity_;
+  if (complexity_controller_ && controller_stream_id_ >= 0) {
+    complexity_controller_->GetStatistics(controller_stream_id_, stats);
+  }
+}
+
+void ACMOpus::UpdateComplexity(int complexity) {
+  if (complexity == complexity_) {
+    return;
+  }
+  if (encoder_inst_ptr_ != NULL &&
+      WebRtcOpus_SetComplexity(encoder_inst_ptr_, complexity) < 0) {
+    WEBRTC_TRACE(VoIP::kTraceError, VoIP::kTraceAudioCoding, unique_id_,
+                 "UpdateComplexity: Setting complexity failed for Opus");
+    return;
+  }
+  WEBRTC_TRACE(VoIP::kTraceStateInfo, VoIP::kTraceAudioCoding, unique_id_,
+               "Opus complexity changed from %d to %d", complexity_,
+               complexity);
+  complexity_ = complexity;
+}
+
+void ACMOpus::AddToController() {
+  if (complexity_controller_ && controller_stream_id_ < 0 &&
+      encoder_inst_ptr_ != NULL) {
+    controller_stream_id_ =
+        complexity_controller_->AddStream(max_complexity_);
+  }
+}
+
+void ACMOpus::RemoveFromController() {
+  if (complexity_controller_ && controller_stream_id_ >= 0) {
+    complexity_controller_->RemoveStream(controller_stream_id_);
+  }
+  controller_stream_id_ = -1;
+}
+
 #endif  // WEBRTC_CODEC_OPUS
 
 }  // namespace acm2
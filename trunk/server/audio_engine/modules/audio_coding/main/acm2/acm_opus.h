@@ -32,6 +32,10 @@ class ACMOpus : public ACMGenericCodec {
 
   int16_t InternalInitEncoder(WebRtcACMCodecParams *codec_params);
 
+  void SetComplexityController(OpusComplexityController* controller);
+
+  void GetEncodingStatistics(AudioEncodingStats* stats);
+
  protected:
   void DestructEncoderSafe();
 
@@ -41,10 +45,23 @@ class ACMOpus : public ACMGenericCodec {
 
   int16_t SetBitRateSafe(const int32_t rate);
 
+  // Applies |complexity| to the encoder if it differs from the current one.
+  void UpdateComplexity(int complexity);
+
+  // Registers the encoder with |complexity_controller_| once both exist.
+  void AddToController();
+
+  void RemoveFromController();
+
   WebRtcOpusEncInst* encoder_inst_ptr_;
   uint16_t sample_freq_;
   uint16_t bitrate_;
   int channels_;
+  int complexity_;
+  // Complexity used unless the controller lowers it.
+  const int max_complexity_;
+  OpusComplexityController* complexity_controller_;
+  int controller_stream_id_;
 };
 
 }  // namespace acm2
@@ -29,6 +29,10 @@
 #include "audio_engine/system_wrappers/interface/tick_util.h"
 #include "audio_engine/system_wrappers/interface/trace.h"
 
+#ifdef WEBRTC_CODEC_OPUS
+#include "audio_engine/modules/audio_coding/codecs/opus/interface/opus_interface.h"
+#endif
+
 namespace VoIP {
 
 namespace acm2 {
@@ -70,6 +74,11 @@ void SetAudioFrameActivityAndType(bool vad_enabled,
         audio_frame->speech_type_ = AudioFrame::kPLCCNG;
         break;
       }
+      case kOutputIdle: {
+        audio_frame->vad_activity_ = AudioFrame::kVadPassive;
+        audio_frame->speech_type_ = AudioFrame::kIdle;
+        break;
+      }
       default:
         assert(false);
     }
@@ -93,6 +102,10 @@ void SetAudioFrameActivityAndType(bool vad_enabled,
         audio_frame->speech_type_ = AudioFrame::kPLCCNG;
         break;
       }
+      case kOutputIdle: {
+        audio_frame->speech_type_ = AudioFrame::kIdle;
+        break;
+      }
       case kOutputVADPassive: {
         // Normally, we should no get any VAD decision if post-decoding VAD is
         // not active. However, if post-decoding VAD has been active then
@@ -116,16 +129,19 @@ bool IsCng(int codec_id) {
 
 }  // namespace
 
-AcmReceiver::AcmReceiver()
+AcmReceiver::AcmReceiver(const NetEq::Config& neteq_config)
     : id_(0),
-      neteq_config_(),
+      neteq_config_(neteq_config),
       neteq_(NetEq::Create(neteq_config_)),
       last_audio_decoder_(-1),  // Invalid value.
+      last_audio_bandwidth_hz_(0),
+      preferred_sample_rate_hz_(-1),
       decode_lock_(RWLockWrapper::CreateRWLock()),
       neteq_crit_sect_(CriticalSectionWrapper::CreateCriticalSection()),
       vad_enabled_(true),
       previous_audio_activity_(AudioFrame::kVadPassive),
       current_sample_rate_hz_(neteq_config_.sample_rate_hz),
+      last_output_idle_(false),
       nack_(),
       nack_enabled_(false),
       av_sync_(false),
@@ -308,7 +324,19 @@ int AcmReceiver::InsertPacket(const WebRtcRTPHeader& rtp_header,
           nack_->UpdateSampleRate(sample_rate_hz);
         }
         last_audio_decoder_ = codec_id;
+        last_audio_bandwidth_hz_ = 0;
+      }
+#ifdef WEBRTC_CODEC_OPUS
+      // Keep track of the bandwidth of Opus streams, which often is lower
+      // than their 48 kHz clock rate. RED packets are not inspected.
+      if (codec_id == ACMCodecDB::kOpus &&
+          header->payloadType == decoders_[codec_id].payload_type) {
+        const int bandwidth_hz =
+            WebRtcOpus_PacketSampleRate(incoming_payload, length_payload);
+        if (bandwidth_hz > last_audio_bandwidth_hz_)
+          last_audio_bandwidth_hz_ = bandwidth_hz;
       }
+#endif
       packet_type = InitialDelayManager::kAudioPacket;
     }
 
@@ -370,6 +398,14 @@ int AcmReceiver::GetAudio(int desired_freq_hz, AudioFrame* audio_frame) {
                                           late_packets_sync_stream_.get());
     }
 
+    if (desired_freq_hz != -1 &&
+        desired_freq_hz != preferred_sample_rate_hz_) {
+      // Let decoders that support it (Opus) decode at the requested rate, so
+      // that their output needs no resampling.
+      neteq_->SetPreferredSampleRate(desired_freq_hz);
+      preferred_sample_rate_hz_ = desired_freq_hz;
+    }
+
     if (!return_silence) {
       // This is our initial guess regarding whether a resampling will be
       // required. It is based on previous sample rate of netEq. Most often,
@@ -423,7 +459,20 @@ int AcmReceiver::GetAudio(int desired_freq_hz, AudioFrame* audio_frame) {
   bool need_resampling = (desired_freq_hz != -1) &&
       (current_sample_rate_hz_ != desired_freq_hz);
 
-  if (ptr_audio_buffer == audio_buffer_) {
+  if (last_output_idle_ && type != kOutputIdle) {
+    // The idle silence bypassed the resampler, which still holds the audio
+    // from before it.
+    resampler_.Reset();
+  }
+  last_output_idle_ = (type == kOutputIdle);
+
+  if (type == kOutputIdle) {
+    // NetEq produced silence; write it directly at the desired rate.
+    if (need_resampling)
+      samples_per_channel = desired_freq_hz / 100;
+    memset(audio_frame->data_, 0, samples_per_channel * num_channels *
+           sizeof(int16_t));
+  } else if (ptr_audio_buffer == audio_buffer_) {
     // Data is written to local buffer.
     if (need_resampling) {
       samples_per_channel = resampler_.Resample10Msec(
@@ -534,6 +583,30 @@ void AcmReceiver::DisableVad() {
   vad_enabled_ = false;
 }
 
+void AcmReceiver::EnableIdleFastPath() {
+  neteq_->EnableIdleFastPath();
+}
+
+void AcmReceiver::DisableIdleFastPath() {
+  neteq_->DisableIdleFastPath();
+}
+
+void AcmReceiver::EnableUnheardMode() {
+  neteq_->EnableUnheardMode();
+}
+
+void AcmReceiver::DisableUnheardMode() {
+  neteq_->DisableUnheardMode();
+}
+
+void AcmReceiver::SetDecoderIdleTimeout(int timeout_ms) {
+  neteq_->SetDecoderIdleTimeout(timeout_ms);
+}
+
+void AcmReceiver::SetDecoderPool(AudioDecoderPool* pool) {
+  neteq_->SetDecoderPool(pool);
+}
+
 void AcmReceiver::FlushBuffers() {
   neteq_->FlushBuffers();
 }
@@ -556,6 +629,7 @@ int AcmReceiver::RemoveAllCodecs() {
   }
   // No codec is registered, invalidate last audio decoder.
   last_audio_decoder_ = -1;
+  last_audio_bandwidth_hz_ = 0;
   return ret_val;
 }
 
@@ -570,8 +644,10 @@ int AcmReceiver::RemoveCodec(uint8_t payload_type) {
   }
   CriticalSectionScoped lock(neteq_crit_sect_);
   decoders_[codec_index].registered = false;
-  if (last_audio_decoder_ == codec_index)
+  if (last_audio_decoder_ == codec_index) {
     last_audio_decoder_ = -1;  // Codec is removed, invalidate last decoder.
+    last_audio_bandwidth_hz_ = 0;
+  }
   return 0;
 }
 
@@ -594,6 +670,11 @@ int AcmReceiver::last_audio_codec_id() const {
   return last_audio_decoder_;
 }
 
+int AcmReceiver::last_audio_bandwidth_hz() const {
+  CriticalSectionScoped lock(neteq_crit_sect_);
+  return last_audio_bandwidth_hz_;
+}
+
 int AcmReceiver::last_audio_payload_type() const {
   CriticalSectionScoped lock(neteq_crit_sect_);
   if (last_audio_decoder_ < 0)
@@ -47,7 +47,7 @@ class AcmReceiver {
   };
 
   // Constructor of the class
-  AcmReceiver();
+  explicit AcmReceiver(const NetEq::Config& neteq_config);
 
   explicit AcmReceiver(NetEq* neteq);
 
@@ -210,6 +210,37 @@ class AcmReceiver {
   //
   bool vad_enabled() const { return vad_enabled_; }
 
+  //
+  // Enable the idle fast path of NetEq. Long idle streams are then returned
+  // as silence of type AudioFrame::kIdle, without resampling.
+  //
+  void EnableIdleFastPath();
+
+  //
+  // Disable the idle fast path of NetEq.
+  //
+  void DisableIdleFastPath();
+
+  //
+  // Put NetEq in or out of unheard mode. In unheard mode packet loss is
+  // concealed with silence, which is cheap, while jitter buffering and
+  // statistics go on as usual.
+  //
+  void EnableUnheardMode();
+  void DisableUnheardMode();
+
+  //
+  // Delete the decoders created by NetEq after |timeout_ms| without any
+  // packet to decode. 0 keeps them.
+  //
+  void SetDecoderIdleTimeout(int timeout_ms);
+
+  //
+  // Take the decoders created by NetEq from |pool|, see
+  // NetEq::SetDecoderPool().
+  //
+  void SetDecoderPool(AudioDecoderPool* pool);
+
   //
   // Get the decode lock used to protect decoder instances while decoding.
   //
@@ -255,6 +286,13 @@ class AcmReceiver {
   //
   int last_audio_codec_id() const;  // TODO(turajs): can be inline.
 
+  //
+  // Return the lowest sample rate that carries the audio bandwidth received
+  // since the last change of audio codec, or 0 if the codec does not signal
+  // its bandwidth. Currently only Opus packets are inspected.
+  //
+  int last_audio_bandwidth_hz() const;
+
   //
   // Return the payload-type of the last non-CNG/non-DTMF RTP packet. If no
   // non-CNG/non-DTMF packet is received -1 is returned.
@@ -344,12 +382,16 @@ class AcmReceiver {
   NetEq* neteq_;
   Decoder decoders_[ACMCodecDB::kMaxNumCodecs];
   int last_audio_decoder_;
+  int last_audio_bandwidth_hz_;
+  // Sample rate last passed to NetEq::SetPreferredSampleRate(), or -1.
+  int preferred_sample_rate_hz_;
   RWLockWrapper* decode_lock_;
   CriticalSectionWrapper* neteq_crit_sect_;
   bool vad_enabled_;
   AudioFrame::VADActivity previous_audio_activity_;
   int current_sample_rate_hz_;
   ACMResampler resampler_;
+  bool last_output_idle_;  // True if the last GetAudio() output was kIdle.
   // Used in GetAudio, declared as member to avoid allocating every 10ms.
   int16_t audio_buffer_[AudioFrame::kMaxDataSizeSamples];
   scoped_ptr<Nack> nack_;
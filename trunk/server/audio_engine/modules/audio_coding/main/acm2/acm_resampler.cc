@@ -18,7 +18,7 @@
 namespace VoIP {
 namespace acm2 {
 
-ACMResampler::ACMResampler() {
+ACMResampler::ACMResampler() : resampler_(new PushResampler<int16_t>) {
 }
 
 ACMResampler::~ACMResampler() {
@@ -36,14 +36,14 @@ int ACMResampler::Resample10Msec(const int16_t* in_audio,
     return in_length / num_audio_channels;
   }
 
-  if (resampler_.InitializeIfNeeded(in_freq_hz, out_freq_hz,
-                                    num_audio_channels) != 0) {
+  if (resampler_->InitializeIfNeeded(in_freq_hz, out_freq_hz,
+                                     num_audio_channels) != 0) {
     LOG_FERR3(LS_ERROR, InitializeIfNeeded, in_freq_hz, out_freq_hz,
               num_audio_channels);
     return -1;
   }
 
-  out_length = resampler_.Resample(in_audio, in_length, out_audio, out_length);
+  out_length = resampler_->Resample(in_audio, in_length, out_audio, out_length);
   if (out_length == -1) {
     LOG_FERR4(LS_ERROR, Resample, in_audio, in_length, out_audio, out_length);
     return -1;
@@ -52,5 +52,9 @@ int ACMResampler::Resample10Msec(const int16_t* in_audio,
   return out_length / num_audio_channels;
 }
 
+void ACMResampler::Reset() {
+  resampler_.reset(new PushResampler<int16_t>);
+}
+
 }  // namespace acm2
 }  // namespace VoIP
@@ -13,6 +13,7 @@
 
 #include "audio_engine/common_audio/resampler/include/push_resampler.h"
 #include "audio_engine/include/typedefs.h"
+#include "audio_engine/system_wrappers/interface/scoped_ptr.h"
 
 namespace VoIP {
 namespace acm2 {
@@ -28,8 +29,12 @@ class ACMResampler {
                      int num_audio_channels,
                      int16_t* out_audio);
 
+  // Drops the audio kept from earlier calls, so that the next call starts
+  // from silence.
+  void Reset();
+
  private:
-  PushResampler<int16_t> resampler_;
+  scoped_ptr<PushResampler<int16_t> > resampler_;
 };
 
 }  // namespace acm2
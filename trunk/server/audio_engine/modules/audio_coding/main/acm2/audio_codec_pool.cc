@@ -0,0 +1,163 @@
+/*
+ *  Copyright (c) 2014 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "audio_engine/modules/audio_coding/main/interface/audio_codec_pool.h"
+
+#include "audio_engine/modules/audio_coding/main/acm2/acm_codec_database.h"
+#include "audio_engine/modules/audio_coding/main/acm2/acm_common_defs.h"
+#include "audio_engine/modules/audio_coding/main/acm2/acm_generic_codec.h"
+#include "audio_engine/system_wrappers/interface/critical_section_wrapper.h"
+#include "audio_engine/system_wrappers/interface/rw_lock_wrapper.h"
+
+namespace VoIP {
+
+using acm2::ACMCodecDB;
+using acm2::ACMGenericCodec;
+
+const int AudioCodecPool::kDefaultMaxIdleEncoders;
+
+AudioCodecPool::AudioCodecPool()
+    : crit_sect_(CriticalSectionWrapper::CreateCriticalSection()),
+      idle_decode_lock_(RWLockWrapper::CreateRWLock()) {
+}
+
+AudioCodecPool::~AudioCodecPool() {
+  for (EntryMap::iterator it = entries_.begin(); it != entries_.end(); ++it) {
+    for (size_t i = 0; i < it->second.idle.size(); ++i)
+      delete it->second.idle[i];
+  }
+}
+
+int AudioCodecPool::Prewarm(const CodecInst& codec, int count) {
+  int mirror_id;
+  const int codec_id = ACMCodecDB::CodecNumber(codec, &mirror_id);
+  if (codec_id < 0 || count < 0)
+    return -1;
+
+  NetEqDecoder decoder_type = ACMCodecDB::neteq_decoders_[codec_id];
+  if (decoder_type == kDecoderOpus && codec.channels == 2)
+    decoder_type = kDecoderOpus_2ch;
+  if (!ACMCodecDB::OwnsDecoder(codec_id) &&
+      AudioDecoder::CodecSupported(decoder_type)) {
+    decoder_pool_.Prewarm(decoder_type, count);
+  }
+
+  Key key;
+  if (!GetKey(codec, &key))
+    return 0;
+  int missing;
+  {
+    CriticalSectionScoped lock(crit_sect_.get());
+    Entry& entry = entries_[key];
+    if (count > entry.max_idle)
+      entry.max_idle = count;
+    missing = count - static_cast<int>(entry.idle.size());
+  }
+  // Create and initialize outside the lock; this is the expensive part that
+  // the pool exists to keep off the channel setup path.
+  WebRtcACMCodecParams params;
+  params.codec_inst = codec;
+  params.enable_dtx = false;
+  params.enable_vad = false;
+  params.vad_mode = VADNormal;
+  std::vector<ACMGenericCodec*> created;
+  for (int i = 0; i < missing; ++i) {
+    ACMGenericCodec* encoder = ACMCodecDB::CreateCodecInstance(codec);
+    if (!encoder)
+      break;
+    encoder->SetNetEqDecodeLock(idle_decode_lock_.get());
+    if (encoder->InitEncoder(&params, true) < 0) {
+      delete encoder;
+      break;
+    }
+    created.push_back(encoder);
+  }
+  CriticalSectionScoped lock(crit_sect_.get());
+  Entry& entry = entries_[key];
+  for (size_t i = 0; i < created.size(); ++i) {
+    if (static_cast<int>(entry.idle.size()) < entry.max_idle) {
+      entry.idle.push_back(created[i]);
+    } else {
+      delete created[i];
+    }
+  }
+  return 0;
+}
+
+int AudioCodecPool::NumIdleEncoders(const CodecInst& codec) const {
+  Key key;
+  if (!GetKey(codec, &key))
+    return 0;
+  CriticalSectionScoped lock(crit_sect_.get());
+  EntryMap::const_iterator it = entries_.find(key);
+  return (it == entries_.end()) ? 0 : static_cast<int>(it->second.idle.size());
+}
+
+ACMGenericCodec* AudioCodecPool::AcquireEncoder(const CodecInst& codec) {
+  Key key;
+  if (GetKey(codec, &key)) {
+    CriticalSectionScoped lock(crit_sect_.get());
+    EntryMap::iterator it = entries_.find(key);
+    if (it != entries_.end() && !it->second.idle.empty()) {
+      ACMGenericCodec* encoder = it->second.idle.back();
+      it->second.idle.pop_back();
+      return encoder;
+    }
+  }
+  return ACMCodecDB::CreateCodecInstance(codec);
+}
+
+void AudioCodecPool::ReleaseEncoder(ACMGenericCodec* encoder) {
+  if (!encoder)
+    return;
+  WebRtcACMCodecParams params;
+  Key key;
+  if (!encoder->EncoderInitialized() || encoder->EncoderParams(&params) < 0 ||
+      !GetKey(params.codec_inst, &key)) {
+    delete encoder;
+    return;
+  }
+  // Detach from the state of the module that used it. The encoder state is
+  // kept; InitEncoder() resets it when the instance is used again.
+  encoder->SetComplexityController(NULL);
+  encoder->SetNetEqDecodeLock(idle_decode_lock_.get());
+  {
+    CriticalSectionScoped lock(crit_sect_.get());
+    Entry& entry = entries_[key];
+    if (static_cast<int>(entry.idle.size()) < entry.max_idle) {
+      entry.idle.push_back(encoder);
+      return;
+    }
+  }
+  delete encoder;
+}
+
+bool AudioCodecPool::GetKey(const CodecInst& codec, Key* key) {
+  const int codec_id = ACMCodecDB::CodecId(codec);
+  if (codec_id < 0 || ACMCodecDB::OwnsDecoder(codec_id))
+    return false;
+  // Comfort noise, RED and DTMF are never instantiated as send codecs.
+  switch (ACMCodecDB::neteq_decoders_[codec_id]) {
+    case kDecoderRED:
+    case kDecoderAVT:
+    case kDecoderCNGnb:
+    case kDecoderCNGwb:
+    case kDecoderCNGswb32kHz:
+    case kDecoderCNGswb48kHz:
+      return false;
+    default:
+      break;
+  }
+  key->first = codec_id;
+  key->second = codec.channels;
+  return true;
+}
+
+}  // namespace VoIP
@@ -101,7 +101,9 @@ AudioCodingModule* AudioCodingModuleFactory::Create(int id) const {
 }
 
 AudioCodingModule* NewAudioCodingModuleFactory::Create(int id) const {
-  return new acm2::AudioCodingModuleImpl(id);
+  NetEq::Config neteq_config;
+  neteq_config.decode_on_arrival = decode_on_arrival;
+  return new acm2::AudioCodingModuleImpl(id, neteq_config);
 }
 
 }  // namespace VoIP
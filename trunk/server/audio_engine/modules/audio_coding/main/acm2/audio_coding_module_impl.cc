@@ -15,6 +15,7 @@
 #include <vector>
 
 #include "audio_engine/include/engine_configurations.h"
+#include "audio_engine/modules/audio_coding/main/interface/audio_codec_pool.h"
 #include "audio_engine/modules/audio_coding/main/interface/audio_coding_module_typedefs.h"
 #include "audio_engine/modules/audio_coding/main/acm2/acm_codec_database.h"
 #include "audio_engine/modules/audio_coding/main/acm2/acm_common_defs.h"
@@ -114,7 +115,8 @@ static int TimestampLessThan(uint32_t t1, uint32_t t2) {
 
 }  // namespace
 
-AudioCodingModuleImpl::AudioCodingModuleImpl(int id)
+AudioCodingModuleImpl::AudioCodingModuleImpl(
+    int id, const NetEq::Config& neteq_config)
     : packetization_callback_(NULL),
       id_(id),
       expected_codec_ts_(0xD87F3F9F),
@@ -131,6 +133,7 @@ AudioCodingModuleImpl::AudioCodingModuleImpl(int id)
       stereo_send_(false),
       current_send_codec_idx_(-1),
       send_codec_registered_(false),
+      receiver_(neteq_config),
       acm_crit_sect_(CriticalSectionWrapper::CreateCriticalSection()),
       vad_callback_(NULL),
       is_first_red_(true),
@@ -142,7 +145,9 @@ AudioCodingModuleImpl::AudioCodingModuleImpl(int id)
       callback_crit_sect_(CriticalSectionWrapper::CreateCriticalSection()),
       secondary_send_codec_inst_(),
       codec_timestamp_(expected_codec_ts_),
-      first_10ms_data_(false) {
+      first_10ms_data_(false),
+      opus_complexity_controller_(NULL),
+      codec_pool_(NULL) {
 
   // Nullify send codec memory, set payload type and set codec name to
   // invalid values.
@@ -214,13 +219,14 @@ AudioCodingModuleImpl::~AudioCodingModuleImpl() {
         // Mirror index holds the address of the codec memory.
         assert(mirror_codec_idx_[i] > -1);
         if (codecs_[mirror_codec_idx_[i]] != NULL) {
-          delete codecs_[mirror_codec_idx_[i]];
+          DeleteCodec(codecs_[mirror_codec_idx_[i]]);
           codecs_[mirror_codec_idx_[i]] = NULL;
         }
 
         codecs_[i] = NULL;
       }
     }
+    DeleteCodec(secondary_encoder_.release());
 
     if (red_buffer_ != NULL) {
       delete[] red_buffer_;
@@ -740,7 +746,11 @@ int AudioCodingModuleImpl::ResetEncoder() {
 ACMGenericCodec* AudioCodingModuleImpl::CreateCodec(const CodecInst& codec) {
   ACMGenericCodec* my_codec = NULL;
 
-  my_codec = ACMCodecDB::CreateCodecInstance(codec);
+  if (codec_pool_ != NULL) {
+    my_codec = codec_pool_->AcquireEncoder(codec);
+  } else {
+    my_codec = ACMCodecDB::CreateCodecInstance(codec);
+  }
   if (my_codec == NULL) {
     // Error, could not create the codec.
     WEBRTC_TRACE(VoIP::kTraceError, VoIP::kTraceAudioCoding, id_,
@@ -749,10 +759,19 @@ ACMGenericCodec* AudioCodingModuleImpl::CreateCodec(const CodecInst& codec) {
   }
   my_codec->SetUniqueID(id_);
   my_codec->SetNetEqDecodeLock(receiver_.DecodeLock());
+  my_codec->SetComplexityController(opus_complexity_controller_);
 
   return my_codec;
 }
 
+void AudioCodingModuleImpl::DeleteCodec(ACMGenericCodec* codec) {
+  if (codec_pool_ != NULL) {
+    codec_pool_->ReleaseEncoder(codec);
+  } else {
+    delete codec;
+  }
+}
+
 // Check if the given codec is a valid to be registered as send codec.
 static int IsValidSendCodec(const CodecInst& send_codec,
                             bool is_primary_encoder,
@@ -836,6 +855,9 @@ int AudioCodingModuleImpl::RegisterSecondarySendCodec(
     return -1;
   }
   ACMGenericCodec* encoder = CreateCodec(send_codec);
+  if (encoder == NULL) {
+    return -1;
+  }
   WebRtcACMCodecParams codec_params;
   // Initialize the codec before registering. For secondary codec VAD & DTX are
   // disabled.
@@ -846,9 +868,10 @@ int AudioCodingModuleImpl::RegisterSecondarySendCodec(
   // Force initialization.
   if (encoder->InitEncoder(&codec_params, true) < 0) {
     // Could not initialize, therefore cannot be registered.
-    delete encoder;
+    DeleteCodec(encoder);
     return -1;
   }
+  DeleteCodec(secondary_encoder_.release());
   secondary_encoder_.reset(encoder);
   memcpy(&secondary_send_codec_inst_, &send_codec, sizeof(send_codec));
 
@@ -868,7 +891,7 @@ void AudioCodingModuleImpl::UnregisterSecondarySendCodec() {
   if (secondary_encoder_.get() == NULL) {
     return;
   }
-  secondary_encoder_.reset();
+  DeleteCodec(secondary_encoder_.release());
   ResetFragmentation(0);
 }
 
@@ -978,7 +1001,7 @@ int AudioCodingModuleImpl::RegisterSendCodec(const CodecInst& send_codec) {
   // secondary codec.
   if (secondary_encoder_.get() != NULL &&
       secondary_send_codec_inst_.plfreq != send_codec.plfreq) {
-    secondary_encoder_.reset();
+    DeleteCodec(secondary_encoder_.release());
     ResetFragmentation(0);
   }
 
@@ -1197,6 +1220,11 @@ int AudioCodingModuleImpl::RegisterTransportCallback(
 // Add 10MS of raw (PCM) audio data to the encoder.
 int AudioCodingModuleImpl::Add10MsData(
     const AudioFrame& audio_frame) {
+  return Add10MsData(audio_frame, audio_frame.timestamp_);
+}
+
+int AudioCodingModuleImpl::Add10MsData(
+    const AudioFrame& audio_frame, uint32_t timestamp) {
   if (audio_frame.samples_per_channel_ <= 0) {
     assert(false);
     WEBRTC_TRACE(VoIP::kTraceError, VoIP::kTraceAudioCoding, id_,
@@ -1238,9 +1266,13 @@ int AudioCodingModuleImpl::Add10MsData(
   // performed before resampling (a down mix prior to resampling will take
   // place if both primary and secondary encoders are mono and input is in
   // stereo).
-  if (PreprocessToAddData(audio_frame, &ptr_frame) < 0) {
+  if (PreprocessToAddData(audio_frame, timestamp, &ptr_frame) < 0) {
     return -1;
   }
+  // Without pre-processing |ptr_frame| is |audio_frame|, whose |timestamp_|
+  // may differ from |timestamp|.
+  const uint32_t codec_timestamp =
+      (ptr_frame == &audio_frame) ? timestamp : ptr_frame->timestamp_;
 
   // Check whether we need an up-mix or down-mix?
   bool remix = ptr_frame->num_channels_ != send_codec_inst_.channels;
@@ -1271,7 +1303,7 @@ int AudioCodingModuleImpl::Add10MsData(
     ptr_audio = buffer;
 
   if (codecs_[current_send_codec_idx_]->Add10MsData(
-      ptr_frame->timestamp_, ptr_audio, ptr_frame->samples_per_channel_,
+      codec_timestamp, ptr_audio, ptr_frame->samples_per_channel_,
       send_codec_inst_.channels) < 0)
     return -1;
 
@@ -1282,7 +1314,7 @@ int AudioCodingModuleImpl::Add10MsData(
       ptr_audio = buffer;
 
     if (secondary_encoder_->Add10MsData(
-        ptr_frame->timestamp_, ptr_audio, ptr_frame->samples_per_channel_,
+        codec_timestamp, ptr_audio, ptr_frame->samples_per_channel_,
         secondary_send_codec_inst_.channels) < 0)
       return -1;
   }
@@ -1296,6 +1328,7 @@ int AudioCodingModuleImpl::Add10MsData(
 // |*ptr_out| will point to the pre-processed audio-frame. If no pre-processing
 // is required, |*ptr_out| points to |in_frame|.
 int AudioCodingModuleImpl::PreprocessToAddData(const AudioFrame& in_frame,
+                                               uint32_t in_timestamp,
                                                const AudioFrame** ptr_out) {
   // Primary and secondary (if exists) should have the same sampling rate.
   assert((secondary_encoder_.get() != NULL) ?
@@ -1316,15 +1349,15 @@ int AudioCodingModuleImpl::PreprocessToAddData(const AudioFrame& in_frame,
   }
 
   if (!first_10ms_data_) {
-    expected_in_ts_ = in_frame.timestamp_;
-    expected_codec_ts_ = in_frame.timestamp_;
+    expected_in_ts_ = in_timestamp;
+    expected_codec_ts_ = in_timestamp;
     first_10ms_data_ = true;
-  } else if (in_frame.timestamp_ != expected_in_ts_) {
+  } else if (in_timestamp != expected_in_ts_) {
     // TODO(turajs): Do we need a warning here.
-    expected_codec_ts_ += (in_frame.timestamp_ - expected_in_ts_) *
+    expected_codec_ts_ += (in_timestamp - expected_in_ts_) *
         static_cast<uint32_t>((static_cast<double>(send_codec_inst_.plfreq) /
                     static_cast<double>(in_frame.sample_rate_hz_)));
-    expected_in_ts_ = in_frame.timestamp_;
+    expected_in_ts_ = in_timestamp;
   }
 
 
@@ -1508,6 +1541,7 @@ int AudioCodingModuleImpl::InitializeReceiverSafe() {
     if (receiver_.RemoveAllCodecs() < 0)
       return -1;
   }
+  pending_receive_codecs_.clear();
   receiver_.set_id(id_);
   receiver_.ResetInitialDelay();
   receiver_.SetMinimumDelay(0);
@@ -1552,6 +1586,21 @@ int AudioCodingModuleImpl::ReceiveFrequency() const {
   else
     sample_rate_hz = ACMCodecDB::database_[codec_id].plfreq;
 
+  // Ask only for the rate that the received bandwidth needs. A mixer can then
+  // run below 32 kHz for narrowband and wideband Opus streams, which are
+  // decoded at the mixing rate without resampling.
+  int bandwidth_hz = receiver_.last_audio_bandwidth_hz();
+  if (bandwidth_hz > 0) {
+    if (bandwidth_hz <= 8000)
+      bandwidth_hz = 8000;
+    else if (bandwidth_hz <= 16000)
+      bandwidth_hz = 16000;
+    else
+      bandwidth_hz = 32000;
+    if (bandwidth_hz < sample_rate_hz)
+      sample_rate_hz = bandwidth_hz;
+  }
+
   // TODO(tlegrand): Remove this option when we have full 48 kHz support.
   return (sample_rate_hz > 32000) ? 32000 : sample_rate_hz;
 }
@@ -1603,6 +1652,33 @@ int AudioCodingModuleImpl::RegisterReceiveCodec(const CodecInst& codec) {
     return -1;
   }
 
+  // This registration replaces any pending one for the same payload type or
+  // the same codec.
+  uint8_t payload_type = static_cast<uint8_t>(codec.pltype);
+  PendingReceiveCodecs::iterator it = pending_receive_codecs_.begin();
+  while (it != pending_receive_codecs_.end()) {
+    int unused_mirror_id;
+    if (it->first == payload_type ||
+        ACMCodecDB::ReceiverCodecNumber(it->second, &unused_mirror_id) ==
+        codec_id) {
+      pending_receive_codecs_.erase(it++);
+    } else {
+      ++it;
+    }
+  }
+  if (ACMCodecDB::OwnsDecoder(codec_id) && codecs_[mirror_id] == NULL) {
+    // Defer creating the codec instance until a packet arrives. Until then,
+    // packets of |payload_type| must not reach a codec registered before.
+    if (receiver_.RemoveCodec(payload_type) < 0) {
+      WEBRTC_TRACE(VoIP::kTraceError, VoIP::kTraceAudioCoding, id_,
+                   "Cannot unregister payload-type %d before re-registering "
+                   "it.", payload_type);
+      return -1;
+    }
+    pending_receive_codecs_[payload_type] = codec;
+    return 0;
+  }
+
   AudioDecoder* decoder = NULL;
   // Get |decoder| associated with |codec|. |decoder| can be NULL if |codec|
   // does not own its decoder.
@@ -1611,7 +1687,6 @@ int AudioCodingModuleImpl::RegisterReceiveCodec(const CodecInst& codec) {
                  "Wrong codec params to be registered as receive codec");
     return -1;
   }
-  uint8_t payload_type = static_cast<uint8_t>(codec.pltype);
   return receiver_.AddCodec(codec_id, payload_type, codec.channels, decoder);
 }
 
@@ -1632,7 +1707,13 @@ int AudioCodingModuleImpl::IncomingPacket(const uint8_t* incoming_payload,
   int last_audio_pltype = receiver_.last_audio_payload_type();
   if (receiver_.InsertPacket(rtp_header, incoming_payload, payload_length) <
       0) {
-    return -1;
+    // Retry if the payload type was waiting for its first packet.
+    if (!RegisterPendingReceiveCodec(rtp_header, incoming_payload,
+                                     payload_length) ||
+        receiver_.InsertPacket(rtp_header, incoming_payload, payload_length) <
+        0) {
+      return -1;
+    }
   }
   if (receiver_.last_audio_payload_type() != last_audio_pltype) {
     int index = receiver_.last_audio_codec_id();
@@ -1873,6 +1954,10 @@ bool AudioCodingModuleImpl::HaveValidEncoder(const char* caller_name) const {
 }
 
 int AudioCodingModuleImpl::UnregisterReceiveCodec(uint8_t payload_type) {
+  {
+    CriticalSectionScoped lock(acm_crit_sect_);
+    pending_receive_codecs_.erase(payload_type);
+  }
   return receiver_.RemoveCodec(payload_type);
 }
 
@@ -1944,6 +2029,38 @@ int AudioCodingModuleImpl::GetAudioDecoder(const CodecInst& codec, int codec_id,
   return 0;
 }
 
+bool AudioCodingModuleImpl::RegisterPendingReceiveCodec(
+    const WebRtcRTPHeader& rtp_header,
+    const uint8_t* payload,
+    int payload_length) {
+  CriticalSectionScoped lock(acm_crit_sect_);
+  if (pending_receive_codecs_.empty())
+    return false;
+  PendingReceiveCodecs::iterator it =
+      pending_receive_codecs_.find(rtp_header.header.payloadType);
+  if (it == pending_receive_codecs_.end() && payload_length > 0) {
+    // Possibly RED.
+    it = pending_receive_codecs_.find(payload[0] & 0x7F);
+  }
+  if (it == pending_receive_codecs_.end())
+    return false;
+
+  const uint8_t payload_type = it->first;
+  const CodecInst codec = it->second;
+  pending_receive_codecs_.erase(it);
+  int mirror_id;
+  int codec_id = ACMCodecDB::ReceiverCodecNumber(codec, &mirror_id);
+  AudioDecoder* decoder = NULL;
+  if (GetAudioDecoder(codec, codec_id, mirror_id, &decoder) < 0 ||
+      receiver_.AddCodec(codec_id, payload_type, codec.channels, decoder) < 0) {
+    WEBRTC_TRACE(VoIP::kTraceError, VoIP::kTraceAudioCoding, id_,
+                 "Cannot register receive codec %s for payload-type %d.",
+                 codec.plname, payload_type);
+    return false;
+  }
+  return true;
+}
+
 int AudioCodingModuleImpl::SetInitialPlayoutDelay(int delay_ms) {
   {
     CriticalSectionScoped lock(acm_crit_sect_);
@@ -1981,6 +2098,63 @@ void AudioCodingModuleImpl::GetDecodingCallStatistics(
   receiver_.GetDecodingCallStatistics(call_stats);
 }
 
+int AudioCodingModuleImpl::SetIdleFastPath(bool enable) {
+  if (enable) {
+    receiver_.EnableIdleFastPath();
+  } else {
+    receiver_.DisableIdleFastPath();
+  }
+  return 0;
+}
+
+int AudioCodingModuleImpl::SetUnheard(bool unheard) {
+  if (unheard) {
+    receiver_.EnableUnheardMode();
+  } else {
+    receiver_.DisableUnheardMode();
+  }
+  return 0;
+}
+
+int AudioCodingModuleImpl::SetDecoderIdleTimeout(int timeout_ms) {
+  if (timeout_ms < 0) {
+    WEBRTC_TRACE(VoIP::kTraceError, VoIP::kTraceAudioCoding, id_,
+                 "Decoder idle timeout cannot be negative.");
+    return -1;
+  }
+  receiver_.SetDecoderIdleTimeout(timeout_ms);
+  return 0;
+}
+
+int AudioCodingModuleImpl::SetCodecPool(AudioCodecPool* pool) {
+  CriticalSectionScoped lock(acm_crit_sect_);
+  codec_pool_ = pool;
+  receiver_.SetDecoderPool(pool != NULL ? pool->decoder_pool() : NULL);
+  return 0;
+}
+
+int AudioCodingModuleImpl::SetOpusComplexityController(
+    OpusComplexityController* controller) {
+  CriticalSectionScoped lock(acm_crit_sect_);
+  opus_complexity_controller_ = controller;
+  // Mirrored codecs share an instance; setting it twice is harmless.
+  for (int i = 0; i < ACMCodecDB::kMaxNumCodecs; i++) {
+    if (codecs_[i] != NULL)
+      codecs_[i]->SetComplexityController(controller);
+  }
+  if (secondary_encoder_.get() != NULL)
+    secondary_encoder_->SetComplexityController(controller);
+  return 0;
+}
+
+void AudioCodingModuleImpl::GetEncodingStatistics(
+    AudioEncodingStats* stats) const {
+  CriticalSectionScoped lock(acm_crit_sect_);
+  if (!send_codec_registered_)
+    return;
+  codecs_[current_send_codec_idx_]->GetEncodingStatistics(stats);
+}
+
 }  // namespace acm2
 
 }  // namespace VoIP
@@ -11,6 +11,7 @@
 #ifndef WEBRTC_MODULES_AUDIO_CODING_MAIN_ACM2_AUDIO_CODING_MODULE_IMPL_H_
 #define WEBRTC_MODULES_AUDIO_CODING_MAIN_ACM2_AUDIO_CODING_MODULE_IMPL_H_
 
+#include <map>
 #include <vector>
 
 #include "audio_engine/include/common_types.h"
@@ -32,7 +33,7 @@ class ACMGenericCodec;
 
 class AudioCodingModuleImpl : public AudioCodingModule {
  public:
-  explicit AudioCodingModuleImpl(int id);
+  AudioCodingModuleImpl(int id, const NetEq::Config& neteq_config);
   ~AudioCodingModuleImpl();
 
   virtual const char* Version() const;
@@ -93,6 +94,9 @@ class AudioCodingModuleImpl : public AudioCodingModule {
   // Add 10 ms of raw (PCM) audio data to the encoder.
   int Add10MsData(const AudioFrame& audio_frame);
 
+  // Same as above, with |timestamp| in place of |audio_frame.timestamp_|.
+  int Add10MsData(const AudioFrame& audio_frame, uint32_t timestamp);
+
   /////////////////////////////////////////
   // (FEC) Forward Error Correction
   //
@@ -230,11 +234,26 @@ class AudioCodingModuleImpl : public AudioCodingModule {
 
   void GetDecodingCallStatistics(AudioDecodingCallStats* stats) const;
 
+  int SetIdleFastPath(bool enable);
+
+  int SetUnheard(bool unheard);
+
+  int SetDecoderIdleTimeout(int timeout_ms);
+
+  int SetCodecPool(AudioCodecPool* pool);
+
+  int SetOpusComplexityController(OpusComplexityController* controller);
+
+  void GetEncodingStatistics(AudioEncodingStats* stats) const;
+
  private:
   int UnregisterReceiveCodecSafe(int payload_type);
 
   ACMGenericCodec* CreateCodec(const CodecInst& codec);
 
+  // Deletes |codec|, or gives it back to |codec_pool_|.
+  void DeleteCodec(ACMGenericCodec* codec);
+
   int InitializeReceiverSafe();
 
   bool HaveValidEncoder(const char* caller_name) const;
@@ -255,6 +274,7 @@ class AudioCodingModuleImpl : public AudioCodingModule {
   // required, before pushing audio into encoder's buffer.
   //
   // in_frame: input audio-frame
+  // in_timestamp: timestamp of |in_frame|, used instead of its |timestamp_|.
   // ptr_out: pointer to output audio_frame. If no preprocessing is required
   //          |ptr_out| will be pointing to |in_frame|, otherwise pointing to
   //          |preprocess_frame_|.
@@ -263,6 +283,7 @@ class AudioCodingModuleImpl : public AudioCodingModule {
   //   -1: if encountering an error.
   //    0: otherwise.
   int PreprocessToAddData(const AudioFrame& in_frame,
+                          uint32_t in_timestamp,
                           const AudioFrame** ptr_out);
 
   // Change required states after starting to receive the codec corresponding
@@ -289,6 +310,14 @@ class AudioCodingModuleImpl : public AudioCodingModule {
   int GetAudioDecoder(const CodecInst& codec, int codec_id,
                       int mirror_id, AudioDecoder** decoder);
 
+  // Registers with |receiver_| the pending receive codec that |rtp_header|
+  // and |payload| belong to, if any; see |pending_receive_codecs_|. For RED,
+  // the payload type of the first block is used. Returns true if a codec was
+  // registered.
+  bool RegisterPendingReceiveCodec(const WebRtcRTPHeader& rtp_header,
+                                   const uint8_t* payload,
+                                   int payload_length);
+
   AudioPacketizationCallback* packetization_callback_;
 
   int id_;
@@ -344,6 +373,14 @@ class AudioCodingModuleImpl : public AudioCodingModule {
 
   bool receiver_initialized_;
 
+  // Receive codecs that own their decoder, e.g., iSAC, need a codec instance
+  // to be created. Unless that instance already exists, the registration with
+  // |receiver_| is deferred to the first packet with the payload type, so
+  // that instances are only created for payload types that are actually
+  // received. Indexed by payload type.
+  typedef std::map<uint8_t, CodecInst> PendingReceiveCodecs;
+  PendingReceiveCodecs pending_receive_codecs_;
+
   CriticalSectionWrapper* callback_crit_sect_;
 
   AudioFrame preprocess_frame_;
@@ -351,6 +388,12 @@ class AudioCodingModuleImpl : public AudioCodingModule {
   scoped_ptr<ACMGenericCodec> secondary_encoder_;
   uint32_t codec_timestamp_;
   bool first_10ms_data_;
+
+  // Given to every codec created, see SetOpusComplexityController().
+  OpusComplexityController* opus_complexity_controller_;
+
+  // Source of codec instances, see SetCodecPool().
+  AudioCodecPool* codec_pool_;
 };
 
 }  // namespace acm2
@@ -27,7 +27,8 @@ void CallStatistics::DecodedByNetEq(AudioFrame::SpeechType speech_type) {
       ++decoding_stat_.decoded_plc;
       break;
     }
-    case AudioFrame::kCNG: {
+    case AudioFrame::kCNG:
+    case AudioFrame::kIdle: {
       ++decoding_stat_.decoded_cng;
       break;
     }
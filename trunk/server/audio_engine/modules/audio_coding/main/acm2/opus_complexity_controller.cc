@@ -0,0 +1,205 @@
+/*
+ *  Copyright (c) 2014 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "audio_engine/modules/audio_coding/main/interface/opus_complexity_controller.h"
+
+#include <assert.h>
+
+#include <algorithm>
+
+#include "audio_engine/system_wrappers/interface/critical_section_wrapper.h"
+#include "audio_engine/system_wrappers/interface/tick_util.h"
+
+namespace VoIP {
+
+namespace {
+
+// Length of the window over which encode time is measured.
+const int kUpdateIntervalMs = 1000;
+
+// Lowering complexity is done in larger steps than raising it, so that an
+// overload is resolved within a few windows while recovery is cautious.
+const int kComplexityStepDown = 2;
+const int kComplexityStepUp = 1;
+
+// Complexity is only raised while the measured load is below this share of
+// the budget. Raising one step typically costs less than the margin, which
+// keeps the controller from oscillating around the budget.
+const int kRaiseThresholdPercent = 75;
+
+}  // namespace
+
+const int OpusComplexityController::kMaxComplexity;
+
+OpusComplexityController::OpusComplexityController()
+    : crit_sect_(CriticalSectionWrapper::CreateCriticalSection()),
+      budget_percent_(0),
+      mode_(kGlobal),
+      global_complexity_(kMaxComplexity),
+      complexity_cap_(kMaxComplexity),
+      window_start_ms_(-1),
+      next_stream_id_(0) {
+}
+
+OpusComplexityController::~OpusComplexityController() {}
+
+int OpusComplexityController::SetBudget(int budget_percent, Mode mode) {
+  if (budget_percent < 0)
+    return -1;
+  CriticalSectionScoped lock(crit_sect_.get());
+  budget_percent_ = budget_percent;
+  mode_ = mode;
+  // Start over from full quality; the next windows bring the load down if
+  // needed.
+  global_complexity_ = kMaxComplexity;
+  for (StreamMap::iterator it = streams_.begin(); it != streams_.end(); ++it)
+    SetComplexity(&it->second, it->second.max_complexity);
+  return 0;
+}
+
+int OpusComplexityController::budget_percent() const {
+  CriticalSectionScoped lock(crit_sect_.get());
+  return budget_percent_;
+}
+
+OpusComplexityController::Mode OpusComplexityController::mode() const {
+  CriticalSectionScoped lock(crit_sect_.get());
+  return mode_;
+}
+
+void OpusComplexityController::SetMaxComplexity(int max_complexity) {
+  assert(max_complexity >= 0 && max_complexity <= kMaxComplexity);
+  CriticalSectionScoped lock(crit_sect_.get());
+  complexity_cap_ = max_complexity;
+}
+
+int OpusComplexityController::AddStream(int max_complexity) {
+  assert(max_complexity >= 0 && max_complexity <= kMaxComplexity);
+  CriticalSectionScoped lock(crit_sect_.get());
+  Stream stream;
+  stream.max_complexity = max_complexity;
+  stream.complexity = max_complexity;
+  if (budget_percent_ > 0 && mode_ == kGlobal)
+    stream.complexity = std::min(max_complexity, global_complexity_);
+  stream.complexity_changes = 0;
+  stream.window_encode_time_us = 0;
+  stream.window_audio_ms = 0;
+  stream.encode_time_us = -1;
+  const int id = next_stream_id_++;
+  streams_[id] = stream;
+  return id;
+}
+
+void OpusComplexityController::RemoveStream(int stream_id) {
+  CriticalSectionScoped lock(crit_sect_.get());
+  streams_.erase(stream_id);
+}
+
+int OpusComplexityController::EncodeDone(int stream_id,
+                                         int encode_time_us,
+                                         int audio_ms) {
+  CriticalSectionScoped lock(crit_sect_.get());
+  StreamMap::iterator it = streams_.find(stream_id);
+  if (it == streams_.end())
+    return kMaxComplexity;
+  it->second.window_encode_time_us += encode_time_us;
+  it->second.window_audio_ms += audio_ms;
+
+  const int64_t now_ms = TickTime::MillisecondTimestamp();
+  if (window_start_ms_ < 0) {
+    window_start_ms_ = now_ms;
+  } else if (now_ms - window_start_ms_ >= kUpdateIntervalMs) {
+    Update(now_ms);
+  }
+  return std::min(it->second.complexity, complexity_cap_);
+}
+
+void OpusComplexityController::GetStatistics(int stream_id,
+                                             AudioEncodingStats* stats) const {
+  CriticalSectionScoped lock(crit_sect_.get());
+  StreamMap::const_iterator it = streams_.find(stream_id);
+  if (it == streams_.end())
+    return;
+  stats->complexity = std::min(it->second.complexity, complexity_cap_);
+  stats->max_complexity = it->second.max_complexity;
+  stats->complexity_changes = it->second.complexity_changes;
+  stats->encode_time_us = it->second.encode_time_us;
+}
+
+void OpusComplexityController::Update(int64_t now_ms) {
+  const int64_t window_us = (now_ms - window_start_ms_) * 1000;
+  window_start_ms_ = now_ms;
+
+  int64_t total_encode_time_us = 0;
+  int active_streams = 0;
+  int highest_complexity = 0;
+  for (StreamMap::iterator it = streams_.begin(); it != streams_.end(); ++it) {
+    Stream& stream = it->second;
+    highest_complexity = std::max(highest_complexity, stream.max_complexity);
+    if (stream.window_audio_ms > 0) {
+      stream.encode_time_us = static_cast<int>(
+          stream.window_encode_time_us * 10 / stream.window_audio_ms);
+      total_encode_time_us += stream.window_encode_time_us;
+      ++active_streams;
+    }
+  }
+
+  if (budget_percent_ > 0 && active_streams > 0) {
+    const int64_t budget_us = window_us * budget_percent_ / 100;
+    if (mode_ == kGlobal) {
+      // Levels above what any stream can use would only delay the reaction.
+      global_complexity_ = std::min(global_complexity_, highest_complexity);
+      if (total_encode_time_us > budget_us) {
+        global_complexity_ =
+            std::max(0, global_complexity_ - kComplexityStepDown);
+      } else if (total_encode_time_us * 100 <
+                 budget_us * kRaiseThresholdPercent) {
+        global_complexity_ =
+            std::min(kMaxComplexity, global_complexity_ + kComplexityStepUp);
+      }
+      for (StreamMap::iterator it = streams_.begin(); it != streams_.end();
+           ++it) {
+        SetComplexity(&it->second,
+                      std::min(it->second.max_complexity, global_complexity_));
+      }
+    } else {
+      const int64_t share_us = budget_us / active_streams;
+      for (StreamMap::iterator it = streams_.begin(); it != streams_.end();
+           ++it) {
+        Stream& stream = it->second;
+        if (stream.window_audio_ms == 0)
+          continue;
+        if (stream.window_encode_time_us > share_us) {
+          SetComplexity(&stream,
+                        std::max(0, stream.complexity - kComplexityStepDown));
+        } else if (stream.window_encode_time_us * 100 <
+                   share_us * kRaiseThresholdPercent) {
+          SetComplexity(&stream, std::min(stream.max_complexity,
+                                          stream.complexity +
+                                              kComplexityStepUp));
+        }
+      }
+    }
+  }
+
+  for (StreamMap::iterator it = streams_.begin(); it != streams_.end(); ++it) {
+    it->second.window_encode_time_us = 0;
+    it->second.window_audio_ms = 0;
+  }
+}
+
+void OpusComplexityController::SetComplexity(Stream* stream, int complexity) {
+  if (stream->complexity != complexity) {
+    stream->complexity = complexity;
+    ++stream->complexity_changes;
+  }
+}
+
+}  // namespace VoIP
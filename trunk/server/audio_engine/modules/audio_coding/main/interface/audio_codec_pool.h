@@ -0,0 +1,91 @@
+/*
+ *  Copyright (c) 2014 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_MODULES_AUDIO_CODING_MAIN_INTERFACE_AUDIO_CODEC_POOL_H_
+#define WEBRTC_MODULES_AUDIO_CODING_MAIN_INTERFACE_AUDIO_CODEC_POOL_H_
+
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "audio_engine/include/common_types.h"
+#include "audio_engine/modules/audio_coding/neteq4/interface/audio_decoder_pool.h"
+#include "audio_engine/system_wrappers/interface/constructor_magic.h"
+#include "audio_engine/system_wrappers/interface/scoped_ptr.h"
+#include "audio_engine/system_wrappers/interface/thread_annotations.h"
+#include "audio_engine/include/typedefs.h"
+
+namespace VoIP {
+
+class CriticalSectionWrapper;
+class RWLockWrapper;
+
+namespace acm2 {
+class ACMGenericCodec;
+}  // namespace acm2
+
+// Keeps encoder and decoder instances that audio coding modules no longer
+// need, so that registering a send codec or receiving a new payload type on
+// another module does not have to allocate and initialize codec state. One
+// pool is shared by all modules of an engine and must outlive them. Prewarm()
+// fills the pool ahead of a burst of channel setups. Codecs that decode with
+// their encoder instance (iSAC) are not pooled. The class is thread-safe.
+class AudioCodecPool {
+ public:
+  // Number of idle encoders kept per codec, unless raised by Prewarm().
+  static const int kDefaultMaxIdleEncoders = 8;
+
+  AudioCodecPool();
+  virtual ~AudioCodecPool();
+
+  // Creates |count| encoders and decoders for |codec| ahead of use, and keeps
+  // at least that many idle ones of each from then on. Returns -1 if |codec|
+  // is not a valid codec.
+  int Prewarm(const CodecInst& codec, int count);
+
+  // Returns the number of idle encoders for |codec|.
+  int NumIdleEncoders(const CodecInst& codec) const;
+
+  // The pool of NetEq decoders, see NetEq::SetDecoderPool().
+  AudioDecoderPool* decoder_pool() { return &decoder_pool_; }
+
+  // Used by the audio coding module. Acquire() returns an encoder instance
+  // for |codec|, reused if possible, or NULL if it cannot be created. The
+  // caller must initialize it with InitEncoder() before use, and give it back
+  // with Release(), which takes ownership.
+  acm2::ACMGenericCodec* AcquireEncoder(const CodecInst& codec);
+  void ReleaseEncoder(acm2::ACMGenericCodec* encoder);
+
+ private:
+  // Codec database index and number of channels.
+  typedef std::pair<int, int> Key;
+  struct Entry {
+    Entry() : max_idle(kDefaultMaxIdleEncoders) {}
+    std::vector<acm2::ACMGenericCodec*> idle;
+    int max_idle;
+  };
+  typedef std::map<Key, Entry> EntryMap;
+
+  // Returns false if |codec| cannot be pooled.
+  static bool GetKey(const CodecInst& codec, Key* key);
+
+  const scoped_ptr<CriticalSectionWrapper> crit_sect_;
+  // Replaces the NetEq decode lock of the module that released an encoder,
+  // which may be gone before the encoder is used again.
+  const scoped_ptr<RWLockWrapper> idle_decode_lock_;
+  EntryMap entries_ GUARDED_BY(crit_sect_);
+  AudioDecoderPool decoder_pool_;
+
+  DISALLOW_COPY_AND_ASSIGN(AudioCodecPool);
+};
+
+}  // namespace VoIP
+
+#endif  // WEBRTC_MODULES_AUDIO_CODING_MAIN_INTERFACE_AUDIO_CODEC_POOL_H_
@@ -23,7 +23,9 @@ namespace VoIP {
 // forward declarations
 struct CodecInst;
 struct WebRtcRTPHeader;
+class AudioCodecPool;
 class AudioFrame;
+class OpusComplexityController;
 class RTPFragmentationHeader;
 class Clock;
 
@@ -369,6 +371,22 @@ class AudioCodingModule: public Module {
   //
   virtual int32_t Add10MsData(const AudioFrame& audio_frame) = 0;
 
+  ///////////////////////////////////////////////////////////////////////////
+  // int32_t Add10MsData()
+  // Same as above, but the audio is encoded with |timestamp| and the
+  // |timestamp_| of |audio_frame| is ignored. This lets several ACMs encode
+  // one shared, read-only frame, each on its own timestamp line.
+  //
+  // Input:
+  //   -audio_frame        : the input audio frame.
+  //   -timestamp          : timestamp of |audio_frame| for this ACM.
+  //
+  // Return value:
+  //   Same as above.
+  //
+  virtual int32_t Add10MsData(const AudioFrame& audio_frame,
+                              uint32_t timestamp) = 0;
+
   ///////////////////////////////////////////////////////////////////////////
   // (FEC) Forward Error Correction
   //
@@ -934,6 +952,80 @@ class AudioCodingModule: public Module {
 
   virtual void GetDecodingCallStatistics(
       AudioDecodingCallStats* call_stats) const = 0;
+
+  //
+  // Enable or disable the idle fast path of the jitter buffer. When enabled,
+  // a stream that has been producing only comfort noise or faded-out packet
+  // loss concealment for about a second is played out as silence of type
+  // AudioFrame::kIdle, at a fraction of the cost. Intended for conference
+  // mixing, which skips such frames.
+  //
+  // Return value:
+  //   -1 if not supported by this implementation,
+  //    0 otherwise.
+  //
+  virtual int SetIdleFastPath(bool enable) = 0;
+
+  //
+  // Mark the received stream as heard or unheard. Set |unheard| while the
+  // decoded audio is not played out, e.g., when the stream is not mixed. Lost
+  // packets are then concealed with silence instead of by the full packet loss
+  // concealment, while jitter buffer state and statistics stay up to date.
+  // Clearing it restores full quality from the next call to
+  // PlayoutData10Ms().
+  //
+  // Return value:
+  //   -1 if not supported by this implementation,
+  //    0 otherwise.
+  //
+  virtual int SetUnheard(bool unheard) = 0;
+
+  //
+  // Set the time after which idle decoders are deleted to free their memory.
+  // A decoder is idle when no packet has been decoded for |timeout_ms|. It is
+  // created again by the next packet of its payload type.
+  //
+  // Input:
+  //   -timeout_ms         : idle time in milliseconds, 0 (default) to keep
+  //                         decoders.
+  //
+  // Return value:
+  //   -1 if not supported by this implementation or |timeout_ms| is negative,
+  //    0 otherwise.
+  //
+  virtual int SetDecoderIdleTimeout(int timeout_ms) = 0;
+
+  //
+  // Take encoder and decoder instances from |pool| and give them back to it
+  // when they are no longer needed, instead of allocating and deleting them.
+  // The pool is shared between modules and must outlive this module. Set it
+  // before registering codecs; instances that exist already are given to the
+  // pool when released. NULL (default) disables pooling.
+  //
+  // Return value:
+  //   -1 if not supported by this implementation,
+  //    0 otherwise.
+  //
+  virtual int SetCodecPool(AudioCodecPool* pool) = 0;
+
+  //
+  // Attach the Opus send encoder to a complexity controller, which lowers or
+  // raises its complexity to keep the encode time of all attached encoders
+  // within a CPU budget. The controller is shared between modules and must
+  // outlive this module or be detached first by passing NULL.
+  //
+  // Return value:
+  //   -1 if not supported by this implementation,
+  //    0 otherwise.
+  //
+  virtual int SetOpusComplexityController(
+      OpusComplexityController* controller) = 0;
+
+  //
+  // Get the complexity and encode time statistics of the send encoder. Fields
+  // that do not apply to the current send codec keep their default values.
+  //
+  virtual void GetEncodingStatistics(AudioEncodingStats* stats) const = 0;
 };
 
 struct AudioCodingModuleFactory {
@@ -944,10 +1036,14 @@ struct AudioCodingModuleFactory {
 };
 
 struct NewAudioCodingModuleFactory : AudioCodingModuleFactory {
-  NewAudioCodingModuleFactory() {}
+  NewAudioCodingModuleFactory() : decode_on_arrival(false) {}
   virtual ~NewAudioCodingModuleFactory() {}
 
   virtual AudioCodingModule* Create(int id) const;
+
+  // When true, IncomingPacket() decodes G.711 and PCM16B packets as they
+  // arrive, so that PlayoutData10Ms() does less work. Off by default.
+  bool decode_on_arrival;
 };
 
 }  // namespace VoIP
@@ -0,0 +1,97 @@
+/*
+ *  Copyright (c) 2014 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_MODULES_AUDIO_CODING_MAIN_INTERFACE_OPUS_COMPLEXITY_CONTROLLER_H_
+#define WEBRTC_MODULES_AUDIO_CODING_MAIN_INTERFACE_OPUS_COMPLEXITY_CONTROLLER_H_
+
+#include <map>
+
+#include "audio_engine/include/common_types.h"
+#include "audio_engine/system_wrappers/interface/constructor_magic.h"
+#include "audio_engine/system_wrappers/interface/scoped_ptr.h"
+#include "audio_engine/system_wrappers/interface/thread_annotations.h"
+#include "audio_engine/include/typedefs.h"
+
+namespace VoIP {
+
+class CriticalSectionWrapper;
+
+// Keeps the total encode time of a set of Opus encoders within a CPU budget by
+// lowering their complexity when the budget is exceeded and raising it again
+// when there is headroom. One instance is shared by all audio coding modules
+// of an engine; each Opus encoder registers itself as a stream and reports the
+// time spent in every encode call. Decisions are made once per second from
+// the encode time measured during that second. The class is thread-safe.
+class OpusComplexityController {
+ public:
+  enum Mode {
+    kGlobal,     // All streams use the same complexity.
+    kPerStream   // Each stream is held to an equal share of the budget.
+  };
+
+  static const int kMaxComplexity = 10;
+
+  OpusComplexityController();
+  virtual ~OpusComplexityController();
+
+  // Sets the share of one CPU core, in percent, that all registered encoders
+  // together may spend encoding. 0 (default) disables the controller and
+  // every stream runs at its maximum complexity. Returns -1 if
+  // |budget_percent| is negative.
+  int SetBudget(int budget_percent, Mode mode);
+  int budget_percent() const;
+  Mode mode() const;
+
+  // Caps the complexity of every stream at |max_complexity|, on top of the
+  // budget. kMaxComplexity (default) removes the cap.
+  void SetMaxComplexity(int max_complexity);
+
+  // Registers an encoder whose complexity may not exceed |max_complexity|.
+  // Returns the stream id to use in the calls below.
+  int AddStream(int max_complexity);
+  void RemoveStream(int stream_id);
+
+  // Reports that encoding |audio_ms| milliseconds of audio on |stream_id|
+  // took |encode_time_us|. Returns the complexity the stream should use.
+  int EncodeDone(int stream_id, int encode_time_us, int audio_ms);
+
+  // Fills in the complexity fields of |stats| for |stream_id|.
+  void GetStatistics(int stream_id, AudioEncodingStats* stats) const;
+
+ private:
+  struct Stream {
+    int max_complexity;
+    int complexity;
+    int complexity_changes;
+    int64_t window_encode_time_us;
+    int window_audio_ms;
+    int encode_time_us;  // Per 10 ms of audio over the last window.
+  };
+  typedef std::map<int, Stream> StreamMap;
+
+  // Ends the current measurement window and adjusts the complexities.
+  void Update(int64_t now_ms) EXCLUSIVE_LOCKS_REQUIRED(crit_sect_);
+  static void SetComplexity(Stream* stream, int complexity);
+
+  const scoped_ptr<CriticalSectionWrapper> crit_sect_;
+  int budget_percent_ GUARDED_BY(crit_sect_);
+  Mode mode_ GUARDED_BY(crit_sect_);
+  int global_complexity_ GUARDED_BY(crit_sect_);
+  int complexity_cap_ GUARDED_BY(crit_sect_);
+  int64_t window_start_ms_ GUARDED_BY(crit_sect_);
+  StreamMap streams_ GUARDED_BY(crit_sect_);
+  int next_stream_id_ GUARDED_BY(crit_sect_);
+
+  DISALLOW_COPY_AND_ASSIGN(OpusComplexityController);
+};
+
+}  // namespace VoIP
+
+#endif  // WEBRTC_MODULES_AUDIO_CODING_MAIN_INTERFACE_OPUS_COMPLEXITY_CONTROLLER_H_
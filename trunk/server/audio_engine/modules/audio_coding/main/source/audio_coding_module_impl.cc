@@ -1265,6 +1265,11 @@ int32_t AudioCodingModuleImpl::RegisterTransportCallback(
 // Add 10MS of raw (PCM) audio data to the encoder.
 int32_t AudioCodingModuleImpl::Add10MsData(
     const AudioFrame& audio_frame) {
+  return Add10MsData(audio_frame, audio_frame.timestamp_);
+}
+
+int32_t AudioCodingModuleImpl::Add10MsData(
+    const AudioFrame& audio_frame, uint32_t timestamp) {
   if (audio_frame.samples_per_channel_ <= 0) {
     assert(false);
     WEBRTC_TRACE(VoIP::kTraceError, VoIP::kTraceAudioCoding, id_,
@@ -1306,10 +1311,14 @@ int32_t AudioCodingModuleImpl::Add10MsData(
   // performed before resampling (a down mix prior to resampling will take
   // place if both primary and secondary encoders are mono and input is in
   // stereo).
-  if (PreprocessToAddData(audio_frame, &ptr_frame) < 0) {
+  if (PreprocessToAddData(audio_frame, timestamp, &ptr_frame) < 0) {
     return -1;
   }
-  TRACE_EVENT_ASYNC_BEGIN1("VoIP", "Audio", ptr_frame->timestamp_,
+  // Without pre-processing |ptr_frame| is |audio_frame|, whose |timestamp_|
+  // may differ from |timestamp|.
+  const uint32_t codec_timestamp =
+      (ptr_frame == &audio_frame) ? timestamp : ptr_frame->timestamp_;
+  TRACE_EVENT_ASYNC_BEGIN1("VoIP", "Audio", codec_timestamp,
                            "now", clock_->TimeInMilliseconds());
 
   // Check whether we need an up-mix or down-mix?
@@ -1341,7 +1350,7 @@ int32_t AudioCodingModuleImpl::Add10MsData(
     ptr_audio = buffer;
 
   if (codecs_[current_send_codec_idx_]->Add10MsData(
-      ptr_frame->timestamp_, ptr_audio, ptr_frame->samples_per_channel_,
+      codec_timestamp, ptr_audio, ptr_frame->samples_per_channel_,
       send_codec_inst_.channels) < 0)
     return -1;
 
@@ -1352,7 +1361,7 @@ int32_t AudioCodingModuleImpl::Add10MsData(
       ptr_audio = buffer;
 
     if (secondary_encoder_->Add10MsData(
-        ptr_frame->timestamp_, ptr_audio, ptr_frame->samples_per_channel_,
+        codec_timestamp, ptr_audio, ptr_frame->samples_per_channel_,
         secondary_send_codec_inst_.channels) < 0)
       return -1;
   }
@@ -1366,6 +1375,7 @@ int32_t AudioCodingModuleImpl::Add10MsData(
 // |*ptr_out| will point to the pre-processed audio-frame. If no pre-processing
 // is required, |*ptr_out| points to |in_frame|.
 int AudioCodingModuleImpl::PreprocessToAddData(const AudioFrame& in_frame,
+                                               uint32_t in_timestamp,
                                                const AudioFrame** ptr_out) {
   // Primary and secondary (if exists) should have the same sampling rate.
   assert((secondary_encoder_.get() != NULL) ?
@@ -1388,8 +1398,8 @@ int AudioCodingModuleImpl::PreprocessToAddData(const AudioFrame& in_frame,
 
   if (!down_mix && !resample) {
     // No pre-processing is required.
-    last_in_timestamp_ = in_frame.timestamp_;
-    last_timestamp_ = in_frame.timestamp_;
+    last_in_timestamp_ = in_timestamp;
+    last_timestamp_ = in_timestamp;
     *ptr_out = &in_frame;
     return 0;
   }
@@ -1411,7 +1421,7 @@ int AudioCodingModuleImpl::PreprocessToAddData(const AudioFrame& in_frame,
     src_ptr_audio = audio;
   }
 
-  preprocess_frame_.timestamp_ = in_frame.timestamp_;
+  preprocess_frame_.timestamp_ = in_timestamp;
   preprocess_frame_.samples_per_channel_ = in_frame.samples_per_channel_;
   preprocess_frame_.sample_rate_hz_ = in_frame.sample_rate_hz_;
   // If it is required, we have to do a resampling.
@@ -1422,12 +1432,12 @@ int AudioCodingModuleImpl::PreprocessToAddData(const AudioFrame& in_frame,
     uint32_t timestamp_diff;
 
     // Calculate the timestamp of this frame.
-    if (last_in_timestamp_ > in_frame.timestamp_) {
+    if (last_in_timestamp_ > in_timestamp) {
       // A wrap around has happened.
       timestamp_diff = (static_cast<uint32_t>(0xFFFFFFFF) - last_in_timestamp_)
-          + in_frame.timestamp_;
+          + in_timestamp;
     } else {
-      timestamp_diff = in_frame.timestamp_ - last_in_timestamp_;
+      timestamp_diff = in_timestamp - last_in_timestamp_;
     }
     preprocess_frame_.timestamp_ = last_timestamp_ +
         static_cast<uint32_t>(timestamp_diff *
@@ -1445,7 +1455,7 @@ int AudioCodingModuleImpl::PreprocessToAddData(const AudioFrame& in_frame,
     }
     preprocess_frame_.sample_rate_hz_ = send_codec_inst_.plfreq;
   }
-  last_in_timestamp_ = in_frame.timestamp_;
+  last_in_timestamp_ = in_timestamp;
   last_timestamp_ = preprocess_frame_.timestamp_;
 
   return 0;
@@ -3039,6 +3049,51 @@ void AudioCodingModuleImpl::GetDecodingCallStatistics(
   *call_stats = call_stats_.GetDecodingStatistics();
 }
 
+int AudioCodingModuleImpl::SetIdleFastPath(bool enable) {
+  if (!enable)
+    return 0;
+  WEBRTC_TRACE(VoIP::kTraceWarning, VoIP::kTraceAudioCoding, id_,
+               "Idle fast path not supported by the legacy NetEq.");
+  return -1;
+}
+
+int AudioCodingModuleImpl::SetUnheard(bool unheard) {
+  if (!unheard)
+    return 0;
+  WEBRTC_TRACE(VoIP::kTraceWarning, VoIP::kTraceAudioCoding, id_,
+               "Unheard mode not supported by the legacy NetEq.");
+  return -1;
+}
+
+int AudioCodingModuleImpl::SetDecoderIdleTimeout(int timeout_ms) {
+  if (timeout_ms == 0)
+    return 0;
+  WEBRTC_TRACE(VoIP::kTraceWarning, VoIP::kTraceAudioCoding, id_,
+               "Decoder idle timeout not supported by the legacy NetEq.");
+  return -1;
+}
+
+int AudioCodingModuleImpl::SetCodecPool(AudioCodecPool* pool) {
+  if (pool == NULL)
+    return 0;
+  WEBRTC_TRACE(VoIP::kTraceWarning, VoIP::kTraceAudioCoding, id_,
+               "Codec pooling not supported by this ACM.");
+  return -1;
+}
+
+int AudioCodingModuleImpl::SetOpusComplexityController(
+    OpusComplexityController* controller) {
+  if (controller == NULL)
+    return 0;
+  WEBRTC_TRACE(VoIP::kTraceWarning, VoIP::kTraceAudioCoding, id_,
+               "Opus complexity control not supported by this ACM.");
+  return -1;
+}
+
+void AudioCodingModuleImpl::GetEncodingStatistics(
+    AudioEncodingStats* /* stats */) const {
+}
+
 }  // namespace acm1
 
 }  // namespace VoIP
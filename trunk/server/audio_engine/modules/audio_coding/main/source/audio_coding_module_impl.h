@@ -102,6 +102,9 @@ class AudioCodingModuleImpl : public AudioCodingModule {
   // Add 10 ms of raw (PCM) audio data to the encoder.
   int32_t Add10MsData(const AudioFrame& audio_frame);
 
+  // Same as above, with |timestamp| in place of |audio_frame.timestamp_|.
+  int32_t Add10MsData(const AudioFrame& audio_frame, uint32_t timestamp);
+
   /////////////////////////////////////////
   // (FEC) Forward Error Correction
   //
@@ -280,6 +283,7 @@ class AudioCodingModuleImpl : public AudioCodingModule {
   // required, before pushing audio into encoder's buffer.
   //
   // in_frame: input audio-frame
+  // in_timestamp: timestamp of |in_frame|, used instead of its |timestamp_|.
   // ptr_out: pointer to output audio_frame. If no preprocessing is required
   //          |ptr_out| will be pointing to |in_frame|, otherwise pointing to
   //          |preprocess_frame_|.
@@ -288,6 +292,7 @@ class AudioCodingModuleImpl : public AudioCodingModule {
   //   -1: if encountering an error.
   //    0: otherwise.
   int PreprocessToAddData(const AudioFrame& in_frame,
+                          uint32_t in_timestamp,
                           const AudioFrame** ptr_out);
 
   // Set initial playout delay.
@@ -306,6 +311,14 @@ class AudioCodingModuleImpl : public AudioCodingModule {
 
   void GetDecodingCallStatistics(AudioDecodingCallStats* call_stats) const;
 
+  // Not supported by the legacy jitter buffer.
+  int SetIdleFastPath(bool enable);
+  int SetUnheard(bool unheard);
+  int SetDecoderIdleTimeout(int timeout_ms);
+  int SetCodecPool(AudioCodecPool* pool);
+  int SetOpusComplexityController(OpusComplexityController* controller);
+  void GetEncodingStatistics(AudioEncodingStats* stats) const;
+
  private:
   // Change required states after starting to receive the codec corresponding
   // to |index|.
@@ -51,6 +51,10 @@ bool AudioDecoder::PacketHasFec(const uint8_t* encoded,
   return false;
 }
 
+bool AudioDecoder::SetSampleRate(int fs_hz) {
+  return fs_hz == CodecSampleRateHz(codec_type_);
+}
+
 NetEqDecoder AudioDecoder::codec_type() const { return codec_type_; }
 
 bool AudioDecoder::CodecSupported(NetEqDecoder codec_type) {
@@ -175,6 +179,45 @@ int AudioDecoder::CodecSampleRateHz(NetEqDecoder codec_type) {
   }
 }
 
+bool AudioDecoder::CodecSupportsSampleRate(NetEqDecoder codec_type,
+                                           int fs_hz) {
+  switch (codec_type) {
+#ifdef WEBRTC_CODEC_OPUS
+    case kDecoderOpus:
+    case kDecoderOpus_2ch: {
+      return fs_hz == 8000 || fs_hz == 16000 || fs_hz == 32000 ||
+          fs_hz == 48000;
+    }
+#endif
+    default: {
+      return fs_hz == CodecSampleRateHz(codec_type);
+    }
+  }
+}
+
+bool AudioDecoder::CodecIsStateless(NetEqDecoder codec_type) {
+  switch (codec_type) {
+    case kDecoderPCMu:
+    case kDecoderPCMa:
+    case kDecoderPCMu_2ch:
+    case kDecoderPCMa_2ch:
+    case kDecoderPCM16B:
+    case kDecoderPCM16Bwb:
+    case kDecoderPCM16Bswb32kHz:
+    case kDecoderPCM16Bswb48kHz:
+    case kDecoderPCM16B_2ch:
+    case kDecoderPCM16Bwb_2ch:
+    case kDecoderPCM16Bswb32kHz_2ch:
+    case kDecoderPCM16Bswb48kHz_2ch:
+    case kDecoderPCM16B_5ch: {
+      return true;
+    }
+    default: {
+      return false;
+    }
+  }
+}
+
 AudioDecoder* AudioDecoder::CreateAudioDecoder(NetEqDecoder codec_type) {
   if (!CodecSupported(codec_type)) {
     return NULL;
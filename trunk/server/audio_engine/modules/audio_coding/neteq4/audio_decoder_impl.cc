@@ -483,7 +483,11 @@ int AudioDecoderOpus::PacketDuration(const uint8_t* encoded,
 
 int AudioDecoderOpus::PacketDurationRedundant(const uint8_t* encoded,
                                               size_t encoded_len) const {
-  return WebRtcOpus_FecDurationEst(encoded, static_cast<int>(encoded_len));
+  int duration = WebRtcOpus_FecDurationEst(encoded,
+                                           static_cast<int>(encoded_len));
+  // The estimate is given at 32 kHz; convert it to the decoder's rate.
+  return duration * WebRtcOpus_DecoderSampleRate(
+      static_cast<OpusDecInst*>(state_)) / 32000;
 }
 
 bool AudioDecoderOpus::PacketHasFec(const uint8_t* encoded,
@@ -492,6 +496,11 @@ bool AudioDecoderOpus::PacketHasFec(const uint8_t* encoded,
   fec = WebRtcOpus_PacketHasFec(encoded, static_cast<int>(encoded_len));
   return (fec == 1);
 }
+
+bool AudioDecoderOpus::SetSampleRate(int fs_hz) {
+  return WebRtcOpus_DecoderSetSampleRate(static_cast<OpusDecInst*>(state_),
+                                         fs_hz) == 0;
+}
 #endif
 
 AudioDecoderCng::AudioDecoderCng(enum NetEqDecoder type)
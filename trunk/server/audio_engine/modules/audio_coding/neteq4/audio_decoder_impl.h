@@ -243,6 +243,7 @@ class AudioDecoderOpus : public AudioDecoder {
   virtual int PacketDurationRedundant(const uint8_t* encoded,
                                       size_t encoded_len) const;
   virtual bool PacketHasFec(const uint8_t* encoded, size_t encoded_len) const;
+  virtual bool SetSampleRate(int fs_hz);
 
  private:
   DISALLOW_COPY_AND_ASSIGN(AudioDecoderOpus);
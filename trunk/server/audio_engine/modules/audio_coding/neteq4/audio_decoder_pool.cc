@@ -0,0 +1,106 @@
+/*
+ *  Copyright (c) 2014 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "audio_engine/modules/audio_coding/neteq4/interface/audio_decoder_pool.h"
+
+#include "audio_engine/system_wrappers/interface/critical_section_wrapper.h"
+
+namespace VoIP {
+
+const int AudioDecoderPool::kDefaultMaxIdlePerType;
+
+AudioDecoderPool::AudioDecoderPool()
+    : crit_sect_(CriticalSectionWrapper::CreateCriticalSection()) {
+}
+
+AudioDecoderPool::~AudioDecoderPool() {
+  for (EntryMap::iterator it = entries_.begin(); it != entries_.end(); ++it) {
+    for (size_t i = 0; i < it->second.idle.size(); ++i)
+      delete it->second.idle[i];
+  }
+}
+
+AudioDecoder* AudioDecoderPool::Acquire(NetEqDecoder codec_type) {
+  {
+    CriticalSectionScoped lock(crit_sect_.get());
+    EntryMap::iterator it = entries_.find(codec_type);
+    if (it != entries_.end() && !it->second.idle.empty()) {
+      AudioDecoder* decoder = it->second.idle.back();
+      it->second.idle.pop_back();
+      return decoder;
+    }
+  }
+  AudioDecoder* decoder = AudioDecoder::CreateAudioDecoder(codec_type);
+  if (decoder)
+    decoder->Init();
+  return decoder;
+}
+
+void AudioDecoderPool::Release(AudioDecoder* decoder) {
+  if (!decoder)
+    return;
+  // Reset outside the lock; idle decoders are ready to be handed out as is.
+  const NetEqDecoder codec_type = decoder->codec_type();
+  if (!decoder->SetSampleRate(AudioDecoder::CodecSampleRateHz(codec_type))) {
+    delete decoder;
+    return;
+  }
+  decoder->Init();
+  {
+    CriticalSectionScoped lock(crit_sect_.get());
+    Entry& entry = entries_[codec_type];
+    if (static_cast<int>(entry.idle.size()) < entry.max_idle) {
+      entry.idle.push_back(decoder);
+      return;
+    }
+  }
+  delete decoder;
+}
+
+int AudioDecoderPool::Prewarm(NetEqDecoder codec_type, int count) {
+  if (!AudioDecoder::CodecSupported(codec_type))
+    return -1;
+  int missing;
+  {
+    CriticalSectionScoped lock(crit_sect_.get());
+    Entry& entry = entries_[codec_type];
+    if (count > entry.max_idle)
+      entry.max_idle = count;
+    missing = count - static_cast<int>(entry.idle.size());
+  }
+  // Allocate outside the lock, so that channels taking decoders meanwhile are
+  // not held up.
+  std::vector<AudioDecoder*> created;
+  for (int i = 0; i < missing; ++i) {
+    AudioDecoder* decoder = AudioDecoder::CreateAudioDecoder(codec_type);
+    if (!decoder)
+      break;
+    decoder->Init();
+    created.push_back(decoder);
+  }
+  CriticalSectionScoped lock(crit_sect_.get());
+  Entry& entry = entries_[codec_type];
+  for (size_t i = 0; i < created.size(); ++i) {
+    if (static_cast<int>(entry.idle.size()) < entry.max_idle) {
+      entry.idle.push_back(created[i]);
+    } else {
+      delete created[i];
+    }
+  }
+  return static_cast<int>(entry.idle.size());
+}
+
+int AudioDecoderPool::NumIdle(NetEqDecoder codec_type) const {
+  CriticalSectionScoped lock(crit_sect_.get());
+  EntryMap::const_iterator it = entries_.find(codec_type);
+  return (it == entries_.end()) ? 0 : static_cast<int>(it->second.idle.size());
+}
+
+}  // namespace VoIP
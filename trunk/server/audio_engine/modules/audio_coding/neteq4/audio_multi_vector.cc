@@ -16,8 +16,75 @@
 
 #include "audio_engine/include/typedefs.h"
 
+// SSE2 is part of the x86-64 baseline; on 32-bit x86 it is only used when the
+// compiler is allowed to assume it.
+#if defined(VOIP_ARCH_X86_64) || defined(__SSE2__) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define NETEQ_STEREO_SSE2
+#include <emmintrin.h>
+#endif
+
 namespace VoIP {
 
+namespace {
+
+// Splits |length_per_channel| stereo sample pairs from |interleaved| into
+// |left| and |right|.
+void DeinterleaveStereo(const int16_t* interleaved,
+                        size_t length_per_channel,
+                        int16_t* left,
+                        int16_t* right) {
+  size_t i = 0;
+#if defined(NETEQ_STEREO_SSE2)
+  for (; i + 8 <= length_per_channel; i += 8) {
+    const __m128i a = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(&interleaved[2 * i]));
+    const __m128i b = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(&interleaved[2 * i + 8]));
+    // Sign extend the low (left) and high (right) half of each 32-bit pair.
+    // The values fit in 16 bits, so the saturating pack is lossless.
+    const __m128i left_a = _mm_srai_epi32(_mm_slli_epi32(a, 16), 16);
+    const __m128i left_b = _mm_srai_epi32(_mm_slli_epi32(b, 16), 16);
+    const __m128i right_a = _mm_srai_epi32(a, 16);
+    const __m128i right_b = _mm_srai_epi32(b, 16);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&left[i]),
+                     _mm_packs_epi32(left_a, left_b));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&right[i]),
+                     _mm_packs_epi32(right_a, right_b));
+  }
+#endif
+  for (; i < length_per_channel; ++i) {
+    left[i] = interleaved[2 * i];
+    right[i] = interleaved[2 * i + 1];
+  }
+}
+
+// Inverse of DeinterleaveStereo().
+void InterleaveStereo(const int16_t* left,
+                      const int16_t* right,
+                      size_t length_per_channel,
+                      int16_t* interleaved) {
+  size_t i = 0;
+#if defined(NETEQ_STEREO_SSE2)
+  for (; i + 8 <= length_per_channel; i += 8) {
+    const __m128i l =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(&left[i]));
+    const __m128i r =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(&right[i]));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&interleaved[2 * i]),
+                     _mm_unpacklo_epi16(l, r));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&interleaved[2 * i + 8]),
+                     _mm_unpackhi_epi16(l, r));
+  }
+#endif
+  for (; i < length_per_channel; ++i) {
+    interleaved[2 * i] = left[i];
+    interleaved[2 * i + 1] = right[i];
+  }
+}
+
+}  // namespace
+
 AudioMultiVector::AudioMultiVector(size_t N) {
   assert(N > 0);
   if (N < 1) N = 1;
@@ -74,18 +141,24 @@ void AudioMultiVector::PushBackInterleaved(const int16_t* append_this,
     return;
   }
   size_t length_per_channel = length / num_channels_;
-  int16_t* temp_array = new int16_t[length_per_channel];  // Temporary storage.
+  if (num_channels_ == 2) {
+    // Special case to split both channels in one pass.
+    int16_t* left = channels_[0]->ExtendUninitialized(length_per_channel);
+    int16_t* right = channels_[1]->ExtendUninitialized(length_per_channel);
+    DeinterleaveStereo(append_this, length_per_channel, left, right);
+    return;
+  }
   for (size_t channel = 0; channel < num_channels_; ++channel) {
-    // Copy elements to |temp_array|.
+    // Write the elements directly to the end of the channel.
+    int16_t* destination_ptr =
+        channels_[channel]->ExtendUninitialized(length_per_channel);
     // Set |source_ptr| to first element of this channel.
     const int16_t* source_ptr = &append_this[channel];
     for (size_t i = 0; i < length_per_channel; ++i) {
-      temp_array[i] = *source_ptr;
+      destination_ptr[i] = *source_ptr;
       source_ptr += num_channels_;  // Jump to next element of this channel.
     }
-    channels_[channel]->PushBack(temp_array, length_per_channel);
   }
-  delete [] temp_array;
 }
 
 void AudioMultiVector::PushBack(const AudioMultiVector& append_this) {
@@ -144,6 +217,12 @@ size_t AudioMultiVector::ReadInterleavedFromIndex(size_t start_index,
     memcpy(destination, &(*this)[0][start_index], length * sizeof(int16_t));
     return length;
   }
+  if (num_channels_ == 2) {
+    // Special case to merge both channels in one pass.
+    InterleaveStereo(&(*this)[0][start_index], &(*this)[1][start_index],
+                     length, destination);
+    return 2 * length;
+  }
   for (size_t i = 0; i < length; ++i) {
     for (size_t channel = 0; channel < num_channels_; ++channel) {
       destination[index] = (*this)[channel][i + start_index];
@@ -19,24 +19,23 @@
 namespace VoIP {
 
 void AudioVector::Clear() {
+  begin_ix_ = 0;
   first_free_ix_ = 0;
 }
 
 void AudioVector::CopyFrom(AudioVector* copy_to) const {
   if (copy_to) {
+    copy_to->Clear();
     copy_to->Reserve(Size());
     assert(copy_to->capacity_ >= Size());
-    memcpy(copy_to->array_.get(), array_.get(), Size() * sizeof(int16_t));
-    copy_to->first_free_ix_ = first_free_ix_;
+    memcpy(copy_to->array_.get(), &array_[begin_ix_],
+           Size() * sizeof(int16_t));
+    copy_to->first_free_ix_ = Size();
   }
 }
 
 void AudioVector::PushFront(const AudioVector& prepend_this) {
-  size_t insert_length = prepend_this.Size();
-  Reserve(Size() + insert_length);
-  memmove(&array_[insert_length], &array_[0], Size() * sizeof(int16_t));
-  memcpy(&array_[0], &prepend_this.array_[0], insert_length * sizeof(int16_t));
-  first_free_ix_ += insert_length;
+  PushFront(&prepend_this.array_[prepend_this.begin_ix_], prepend_this.Size());
 }
 
 void AudioVector::PushFront(const int16_t* prepend_this, size_t length) {
@@ -45,7 +44,7 @@ void AudioVector::PushFront(const int16_t* prepend_this, size_t length) {
 }
 
 void AudioVector::PushBack(const AudioVector& append_this) {
-  PushBack(append_this.array_.get(), append_this.Size());
+  PushBack(&append_this.array_[append_this.begin_ix_], append_this.Size());
 }
 
 void AudioVector::PushBack(const int16_t* append_this, size_t length) {
@@ -59,9 +58,8 @@ void AudioVector::PopFront(size_t length) {
     // Remove all elements.
     Clear();
   } else {
-    size_t remaining_samples = Size() - length;
-    memmove(&array_[0], &array_[length], remaining_samples * sizeof(int16_t));
-    first_free_ix_ -= length;
+    // The samples are left in place; the space is reclaimed by Reserve().
+    begin_ix_ += length;
   }
 }
 
@@ -72,19 +70,30 @@ void AudioVector::PopBack(size_t length) {
 }
 
 void AudioVector::Extend(size_t extra_length) {
+  memset(ExtendUninitialized(extra_length), 0, extra_length * sizeof(int16_t));
+}
+
+int16_t* AudioVector::ExtendUninitialized(size_t extra_length) {
   Reserve(Size() + extra_length);
-  memset(&array_[first_free_ix_], 0, extra_length * sizeof(int16_t));
+  int16_t* extension = &array_[first_free_ix_];
   first_free_ix_ += extra_length;
+  return extension;
 }
 
 void AudioVector::InsertAt(const int16_t* insert_this,
                            size_t length,
                            size_t position) {
-  Reserve(Size() + length);
   // Cap the position at the current vector length, to be sure the iterator
   // does not extend beyond the end of the vector.
   position = std::min(Size(), position);
-  int16_t* insert_position_ptr = &array_[position];
+  if (position == 0 && begin_ix_ >= length) {
+    // Prepend into the free space in front of the samples.
+    begin_ix_ -= length;
+    memcpy(&array_[begin_ix_], insert_this, length * sizeof(int16_t));
+    return;
+  }
+  Reserve(Size() + length);
+  int16_t* insert_position_ptr = &array_[begin_ix_ + position];
   size_t samples_to_move = Size() - position;
   memmove(insert_position_ptr + length, insert_position_ptr,
           samples_to_move * sizeof(int16_t));
@@ -94,11 +103,11 @@ void AudioVector::InsertAt(const int16_t* insert_this,
 
 void AudioVector::InsertZerosAt(size_t length,
                                 size_t position) {
-  Reserve(Size() + length);
   // Cap the position at the current vector length, to be sure the iterator
   // does not extend beyond the end of the vector.
-  position = std::min(capacity_, position);
-  int16_t* insert_position_ptr = &array_[position];
+  position = std::min(Size(), position);
+  Reserve(Size() + length);
+  int16_t* insert_position_ptr = &array_[begin_ix_ + position];
   size_t samples_to_move = Size() - position;
   memmove(insert_position_ptr + length, insert_position_ptr,
           samples_to_move * sizeof(int16_t));
@@ -111,11 +120,12 @@ void AudioVector::OverwriteAt(const int16_t* insert_this,
                               size_t position) {
   // Cap the insert position at the current array length.
   position = std::min(Size(), position);
-  Reserve(position + length);
-  memcpy(&array_[position], insert_this, length * sizeof(int16_t));
+  Reserve(std::max(Size(), position + length));
+  memcpy(&array_[begin_ix_ + position], insert_this,
+         length * sizeof(int16_t));
   if (position + length > Size()) {
     // Array was expanded.
-    first_free_ix_ += position + length - Size();
+    first_free_ix_ = begin_ix_ + position + length;
   }
 }
 
@@ -126,7 +136,8 @@ void AudioVector::CrossFade(const AudioVector& append_this,
   assert(fade_length <= append_this.Size());
   fade_length = std::min(fade_length, Size());
   fade_length = std::min(fade_length, append_this.Size());
-  size_t position = Size() - fade_length;
+  int16_t* faded = &array_[first_free_ix_ - fade_length];
+  const int16_t* appended = &append_this.array_[append_this.begin_ix_];
   // Cross fade the overlapping regions.
   // |alpha| is the mixing factor in Q14.
   // TODO(hlundin): Consider skipping +1 in the denominator to produce a
@@ -135,31 +146,45 @@ void AudioVector::CrossFade(const AudioVector& append_this,
   int alpha = 16384;
   for (size_t i = 0; i < fade_length; ++i) {
     alpha -= alpha_step;
-    array_[position + i] = (alpha * array_[position + i] +
-        (16384 - alpha) * append_this[i] + 8192) >> 14;
+    faded[i] = (alpha * faded[i] + (16384 - alpha) * appended[i] + 8192) >> 14;
   }
   assert(alpha >= 0);  // Verify that the slope was correct.
   // Append what is left of |append_this|.
   size_t samples_to_push_back = append_this.Size() - fade_length;
   if (samples_to_push_back > 0)
-    PushBack(&append_this[fade_length], samples_to_push_back);
+    PushBack(&appended[fade_length], samples_to_push_back);
 }
 
 const int16_t& AudioVector::operator[](size_t index) const {
-  return array_[index];
+  return array_[begin_ix_ + index];
 }
 
 int16_t& AudioVector::operator[](size_t index) {
-  return array_[index];
+  return array_[begin_ix_ + index];
 }
 
 void AudioVector::Reserve(size_t n) {
-  if (capacity_ < n) {
-    scoped_ptr<int16_t[]> temp_array(new int16_t[n]);
-    memcpy(temp_array.get(), array_.get(), Size() * sizeof(int16_t));
+  if (begin_ix_ + n <= capacity_) {
+    // Fits after the current samples.
+    return;
+  }
+  size_t size = Size();
+  if (n <= capacity_) {
+    // Reclaim the space freed by PopFront(). Since the reallocation below
+    // doubles the capacity, this happens only once every few PushBack() calls
+    // in the steady state.
+    memmove(array_.get(), &array_[begin_ix_], size * sizeof(int16_t));
+  } else {
+    // Grow by a factor two, to amortize the cost of repeated appends.
+    size_t new_capacity = 2 * n;
+    scoped_ptr<int16_t[], AlignedFreeDeleter> temp_array(
+        AllocateArray(new_capacity));
+    memcpy(temp_array.get(), &array_[begin_ix_], size * sizeof(int16_t));
     array_.swap(temp_array);
-    capacity_ = n;
+    capacity_ = new_capacity;
   }
+  begin_ix_ = 0;
+  first_free_ix_ = size;
 }
 
 }  // namespace VoIP
@@ -13,25 +13,33 @@
 
 #include <string.h>  // Access to size_t.
 
+#include "audio_engine/system_wrappers/interface/aligned_malloc.h"
 #include "audio_engine/system_wrappers/interface/constructor_magic.h"
 #include "audio_engine/system_wrappers/interface/scoped_ptr.h"
 #include "audio_engine/include/typedefs.h"
 
 namespace VoIP {
 
+// The samples are stored contiguously in a 16-byte aligned array, starting
+// at |begin_ix_|. Removing samples from the front only moves |begin_ix_|; the
+// samples are moved back to the start of the array first when the free space
+// at the end is exhausted. This makes the PushBack()/PopFront() pattern used
+// by SyncBuffer amortized O(length) instead of O(Size()).
 class AudioVector {
  public:
   // Creates an empty AudioVector.
   AudioVector()
-      : array_(new int16_t[kDefaultInitialSize]),
+      : array_(AllocateArray(kDefaultInitialSize)),
+        begin_ix_(0),
         first_free_ix_(0),
         capacity_(kDefaultInitialSize) {}
 
   // Creates an AudioVector with an initial size.
   explicit AudioVector(size_t initial_size)
-      : array_(new int16_t[initial_size]),
+      : array_(AllocateArray(InitialCapacity(initial_size))),
+        begin_ix_(0),
         first_free_ix_(initial_size),
-        capacity_(initial_size) {
+        capacity_(InitialCapacity(initial_size)) {
     memset(array_.get(), 0, initial_size * sizeof(int16_t));
   }
 
@@ -93,22 +101,41 @@ class AudioVector {
   // region.
   virtual void CrossFade(const AudioVector& append_this, size_t fade_length);
 
+  // Extends this object with |extra_length| elements at the end, without
+  // initializing them, and returns a pointer to the first new element. The
+  // caller must write all |extra_length| elements.
+  int16_t* ExtendUninitialized(size_t extra_length);
+
   // Returns the number of elements in this AudioVector.
-  virtual size_t Size() const { return first_free_ix_; }
+  virtual size_t Size() const { return first_free_ix_ - begin_ix_; }
 
   // Returns true if this AudioVector is empty.
-  virtual bool Empty() const { return (first_free_ix_ == 0); }
+  virtual bool Empty() const { return (first_free_ix_ == begin_ix_); }
 
   // Accesses and modifies an element of AudioVector.
   const int16_t& operator[](size_t index) const;
   int16_t& operator[](size_t index);
 
  private:
-  static const size_t kDefaultInitialSize = 10;
+  static const size_t kDefaultInitialSize = 16;
+  static const size_t kAlignment = 16;  // Bytes.
+
+  static size_t InitialCapacity(size_t initial_size) {
+    if (initial_size > kDefaultInitialSize)
+      return initial_size;
+    return kDefaultInitialSize;
+  }
+
+  static int16_t* AllocateArray(size_t n) {
+    return AlignedMalloc<int16_t>(n * sizeof(int16_t), kAlignment);
+  }
 
+  // Makes sure that |n| elements fit in the array counting from |begin_ix_|.
+  // May move the current samples, and thereby change |begin_ix_|.
   void Reserve(size_t n);
 
-  scoped_ptr<int16_t[]> array_;
+  scoped_ptr<int16_t[], AlignedFreeDeleter> array_;
+  size_t begin_ix_;  // The index of the first sample in array_.
   size_t first_free_ix_;  // The first index after the last sample in array_.
                           // Note that this index may point outside of array_.
   size_t capacity_;  // Allocated number of samples in the array.
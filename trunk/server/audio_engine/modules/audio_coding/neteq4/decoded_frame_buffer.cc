@@ -0,0 +1,101 @@
+/*
+ *  Copyright (c) 2014 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "audio_engine/modules/audio_coding/neteq4/decoded_frame_buffer.h"
+
+#include <assert.h>
+#include <string.h>  // memcpy
+
+#include "audio_engine/system_wrappers/interface/critical_section_wrapper.h"
+
+namespace VoIP {
+
+DecodedFrameBuffer::DecodedFrameBuffer()
+    : crit_sect_(CriticalSectionWrapper::CreateCriticalSection()),
+      begin_(0),
+      size_(0) {
+}
+
+DecodedFrameBuffer::~DecodedFrameBuffer() {}
+
+bool DecodedFrameBuffer::Push(uint32_t timestamp,
+                              uint8_t payload_type,
+                              const int16_t* audio,
+                              int length,
+                              AudioDecoder::SpeechType speech_type) {
+  assert(length >= 0);
+  CriticalSectionScoped lock(crit_sect_.get());
+  if (size_ >= kMaxFrames) {
+    return false;
+  }
+  Frame& frame = frames_[(begin_ + size_) % kMaxFrames];
+  frame.timestamp = timestamp;
+  frame.payload_type = payload_type;
+  frame.length = length;
+  frame.speech_type = speech_type;
+  // The vector only grows, so steady-state pushes do not allocate.
+  if (frame.audio.size() < static_cast<size_t>(length)) {
+    frame.audio.resize(length);
+  }
+  if (length > 0) {
+    memcpy(&frame.audio[0], audio, length * sizeof(int16_t));
+  }
+  ++size_;
+  return true;
+}
+
+int DecodedFrameBuffer::Pop(uint32_t timestamp,
+                            uint8_t payload_type,
+                            int16_t* audio,
+                            size_t max_length,
+                            AudioDecoder::SpeechType* speech_type) {
+  CriticalSectionScoped lock(crit_sect_.get());
+  while (size_ > 0) {
+    const Frame& frame = frames_[begin_];
+    if (frame.timestamp != timestamp &&
+        static_cast<uint32_t>(timestamp - frame.timestamp) >= 0x80000000) {
+      // The first frame is newer than |timestamp|; keep it for later.
+      return -1;
+    }
+    begin_ = (begin_ + 1) % kMaxFrames;
+    --size_;
+    if (frame.timestamp == timestamp) {
+      if (frame.payload_type != payload_type ||
+          static_cast<size_t>(frame.length) > max_length) {
+        return -1;
+      }
+      if (frame.length > 0) {
+        memcpy(audio, &frame.audio[0], frame.length * sizeof(int16_t));
+      }
+      *speech_type = frame.speech_type;
+      return frame.length;
+    }
+    // Older than |timestamp|; the packet was never played. Drop the frame.
+  }
+  return -1;
+}
+
+bool DecodedFrameBuffer::Full() const {
+  CriticalSectionScoped lock(crit_sect_.get());
+  return size_ >= kMaxFrames;
+}
+
+size_t DecodedFrameBuffer::NumFrames() const {
+  CriticalSectionScoped lock(crit_sect_.get());
+  return size_;
+}
+
+void DecodedFrameBuffer::Flush() {
+  CriticalSectionScoped lock(crit_sect_.get());
+  begin_ = 0;
+  size_ = 0;
+}
+
+}  // namespace VoIP
@@ -0,0 +1,84 @@
+/*
+ *  Copyright (c) 2014 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_MODULES_AUDIO_CODING_NETEQ4_DECODED_FRAME_BUFFER_H_
+#define WEBRTC_MODULES_AUDIO_CODING_NETEQ4_DECODED_FRAME_BUFFER_H_
+
+#include <vector>
+
+#include "audio_engine/modules/audio_coding/neteq4/interface/audio_decoder.h"
+#include "audio_engine/system_wrappers/interface/constructor_magic.h"
+#include "audio_engine/system_wrappers/interface/scoped_ptr.h"
+#include "audio_engine/system_wrappers/interface/thread_annotations.h"
+#include "audio_engine/include/typedefs.h"
+
+namespace VoIP {
+
+class CriticalSectionWrapper;
+
+// Small bounded FIFO of frames that were decoded when their packets arrived,
+// before GetAudio() asked for them. Frames are pushed in timestamp order by
+// the thread inserting packets and popped by the thread pulling audio, so the
+// class is thread-safe. Timestamps are internal (scaled) NetEq timestamps.
+class DecodedFrameBuffer {
+ public:
+  static const size_t kMaxFrames = 4;
+
+  DecodedFrameBuffer();
+  virtual ~DecodedFrameBuffer();
+
+  // Appends |length| interleaved samples decoded from the packet with
+  // |timestamp| and |payload_type|. Returns false if the buffer is full.
+  virtual bool Push(uint32_t timestamp,
+                    uint8_t payload_type,
+                    const int16_t* audio,
+                    int length,
+                    AudioDecoder::SpeechType speech_type);
+
+  // Looks for the frame decoded from the packet with |timestamp| and
+  // |payload_type|. Frames older than |timestamp| belong to packets that were
+  // discarded without being played and are deleted. If the frame is found, it
+  // is removed from the buffer, its samples are written to |audio| (which can
+  // hold |max_length| elements), its speech type to |speech_type|, and the
+  // number of samples is returned. Otherwise -1 is returned.
+  virtual int Pop(uint32_t timestamp,
+                  uint8_t payload_type,
+                  int16_t* audio,
+                  size_t max_length,
+                  AudioDecoder::SpeechType* speech_type);
+
+  // Returns true if no more frames can be pushed.
+  virtual bool Full() const;
+
+  // Returns the number of frames in the buffer.
+  virtual size_t NumFrames() const;
+
+  // Deletes all frames.
+  virtual void Flush();
+
+ private:
+  struct Frame {
+    uint32_t timestamp;
+    uint8_t payload_type;
+    int length;
+    AudioDecoder::SpeechType speech_type;
+    std::vector<int16_t> audio;
+  };
+
+  const scoped_ptr<CriticalSectionWrapper> crit_sect_;
+  Frame frames_[kMaxFrames] GUARDED_BY(crit_sect_);
+  size_t begin_ GUARDED_BY(crit_sect_);
+  size_t size_ GUARDED_BY(crit_sect_);
+
+  DISALLOW_COPY_AND_ASSIGN(DecodedFrameBuffer);
+};
+
+}  // namespace VoIP
+#endif  // WEBRTC_MODULES_AUDIO_CODING_NETEQ4_DECODED_FRAME_BUFFER_H_
@@ -14,13 +14,14 @@
 #include <utility>  // pair
 
 #include "audio_engine/modules/audio_coding/neteq4/interface/audio_decoder.h"
+#include "audio_engine/modules/audio_coding/neteq4/interface/audio_decoder_pool.h"
 
 namespace VoIP {
 
 DecoderDatabase::DecoderDatabase()
-    : active_decoder_(-1), active_cng_decoder_(-1) {}
+    : pool_(NULL), active_decoder_(-1), active_cng_decoder_(-1) {}
 
-DecoderDatabase::~DecoderDatabase() {}
+DecoderDatabase::~DecoderDatabase() { Reset(); }
 
 DecoderDatabase::DecoderInfo::~DecoderInfo() {
   if (!external) delete decoder;
@@ -31,6 +32,10 @@ bool DecoderDatabase::Empty() const { return decoders_.empty(); }
 int DecoderDatabase::Size() const { return static_cast<int>(decoders_.size()); }
 
 void DecoderDatabase::Reset() {
+  for (DecoderMap::iterator it = decoders_.begin(); it != decoders_.end();
+       ++it) {
+    FreeDecoder(&(*it).second);
+  }
   decoders_.clear();
   active_decoder_ = -1;
   active_cng_decoder_ = -1;
@@ -84,10 +89,13 @@ int DecoderDatabase::InsertExternal(uint8_t rtp_payload_type,
 }
 
 int DecoderDatabase::Remove(uint8_t rtp_payload_type) {
-  if (decoders_.erase(rtp_payload_type) == 0) {
+  DecoderMap::iterator it = decoders_.find(rtp_payload_type);
+  if (it == decoders_.end()) {
     // No decoder with that |rtp_payload_type|.
     return kDecoderNotFound;
   }
+  FreeDecoder(&(*it).second);
+  decoders_.erase(it);
   if (active_decoder_ == rtp_payload_type) {
     active_decoder_ = -1;  // No active decoder.
   }
@@ -132,11 +140,21 @@ AudioDecoder* DecoderDatabase::GetDecoder(uint8_t rtp_payload_type) {
   }
   DecoderInfo* info = &(*it).second;
   if (!info->decoder) {
-    // Create the decoder object.
-    AudioDecoder* decoder = AudioDecoder::CreateAudioDecoder(info->codec_type);
+    // Create the decoder object, or take an initialized one from the pool.
+    AudioDecoder* decoder;
+    if (pool_) {
+      decoder = pool_->Acquire(info->codec_type);
+    } else {
+      decoder = AudioDecoder::CreateAudioDecoder(info->codec_type);
+      if (decoder)
+        decoder->Init();
+    }
     assert(decoder);  // Should not be able to have an unsupported codec here.
     info->decoder = decoder;
-    info->decoder->Init();
+    if (info->fs_hz != AudioDecoder::CodecSampleRateHz(info->codec_type)) {
+      // Set by SetSampleRate().
+      info->decoder->SetSampleRate(info->fs_hz);
+    }
   }
   return info->decoder;
 }
@@ -191,12 +209,9 @@ int DecoderDatabase::SetActiveDecoder(uint8_t rtp_payload_type,
       assert(false);
       return kDecoderNotFound;
     }
-    if (!(*it).second.external) {
-      // Delete the AudioDecoder object, unless it is an externally created
-      // decoder.
-      delete (*it).second.decoder;
-      (*it).second.decoder = NULL;
-    }
+    // Free the AudioDecoder object, unless it is an externally created
+    // decoder.
+    FreeDecoder(&(*it).second);
     *new_decoder = true;
   }
   active_decoder_ = rtp_payload_type;
@@ -226,12 +241,9 @@ int DecoderDatabase::SetActiveCngDecoder(uint8_t rtp_payload_type) {
       assert(false);
       return kDecoderNotFound;
     }
-    if (!(*it).second.external) {
-      // Delete the AudioDecoder object, unless it is an externally created
-      // decoder.
-      delete (*it).second.decoder;
-      (*it).second.decoder = NULL;
-    }
+    // Free the AudioDecoder object, unless it is an externally created
+    // decoder.
+    FreeDecoder(&(*it).second);
   }
   active_cng_decoder_ = rtp_payload_type;
   return kOK;
@@ -256,5 +268,63 @@ int DecoderDatabase::CheckPayloadTypes(const PacketList& packet_list) const {
   return kOK;
 }
 
+int DecoderDatabase::ReleaseDecoders() {
+  int num_released = 0;
+  DecoderMap::iterator it;
+  for (it = decoders_.begin(); it != decoders_.end(); ++it) {
+    DecoderInfo* info = &(*it).second;
+    if (info->external || !info->decoder ||
+        static_cast<int>((*it).first) == active_cng_decoder_) {
+      continue;
+    }
+    FreeDecoder(info);
+    ++num_released;
+  }
+  return num_released;
+}
+
+bool DecoderDatabase::SetSampleRate(int fs_hz) {
+  bool active_changed = false;
+  DecoderMap::iterator it;
+  for (it = decoders_.begin(); it != decoders_.end(); ++it) {
+    DecoderInfo* info = &(*it).second;
+    if (info->external) {
+      continue;
+    }
+    int new_fs_hz = AudioDecoder::CodecSampleRateHz(info->codec_type);
+    if (fs_hz != 0 &&
+        AudioDecoder::CodecSupportsSampleRate(info->codec_type, fs_hz)) {
+      new_fs_hz = fs_hz;
+    }
+    if (new_fs_hz == info->fs_hz) {
+      continue;
+    }
+    if (info->decoder && !info->decoder->SetSampleRate(new_fs_hz)) {
+      // Should not happen. Create the decoder again on next use.
+      FreeDecoder(info);
+    }
+    info->fs_hz = new_fs_hz;
+    if (static_cast<int>((*it).first) == active_decoder_) {
+      active_changed = true;
+    }
+  }
+  return active_changed;
+}
+
+void DecoderDatabase::SetDecoderPool(AudioDecoderPool* pool) {
+  pool_ = pool;
+}
+
+void DecoderDatabase::FreeDecoder(DecoderInfo* info) {
+  if (info->external || !info->decoder) {
+    return;
+  }
+  if (pool_) {
+    pool_->Release(info->decoder);
+  } else {
+    delete info->decoder;
+  }
+  info->decoder = NULL;
+}
 
 }  // namespace VoIP
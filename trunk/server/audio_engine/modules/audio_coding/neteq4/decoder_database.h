@@ -23,6 +23,7 @@ namespace VoIP {
 
 // Forward declaration.
 class AudioDecoder;
+class AudioDecoderPool;
 
 class DecoderDatabase {
  public:
@@ -144,10 +145,33 @@ class DecoderDatabase {
   // registered in the database. Otherwise, returns kDecoderNotFound.
   virtual int CheckPayloadTypes(const PacketList& packet_list) const;
 
+  // Deletes all AudioDecoder objects that were not externally created, except
+  // the active comfort noise decoder. The payload types stay registered, and
+  // GetDecoder() creates the objects again when needed. Returns the number of
+  // objects deleted.
+  virtual int ReleaseDecoders();
+
+  // Makes the decoders that were not externally created and can decode at
+  // |fs_hz| produce audio at that rate; the others keep their default rate.
+  // A value of 0 restores the default rate of all decoders. Decoder objects
+  // that exist are reset, and objects created later start at the new rate.
+  // Returns true if the rate of the active decoder changed.
+  virtual bool SetSampleRate(int fs_hz);
+
+  // Makes GetDecoder() take decoder objects from |pool|, and the methods that
+  // delete them give them back to it instead. NULL (default) allocates and
+  // deletes the objects directly. The pool must outlive the database.
+  virtual void SetDecoderPool(AudioDecoderPool* pool);
+
  private:
   typedef std::map<uint8_t, DecoderInfo> DecoderMap;
 
+  // Deletes the decoder object of |info|, or gives it back to |pool_|, unless
+  // it was externally created.
+  void FreeDecoder(DecoderInfo* info);
+
   DecoderMap decoders_;
+  AudioDecoderPool* pool_;
   int active_decoder_;
   int active_cng_decoder_;
 
@@ -27,6 +27,7 @@ enum Operations {
   kAlternativePlcIncreaseTimestamp,
   kAudioRepetition,
   kAudioRepetitionIncreaseTimestamp,
+  kIdle,
   kUndefined = -1
 };
 
@@ -119,6 +119,11 @@ class AudioDecoder {
   // Returns true if the packet has FEC and false otherwise.
   virtual bool PacketHasFec(const uint8_t* encoded, size_t encoded_len) const;
 
+  // Makes the decoder produce audio sampled at |fs_hz| and resets its state.
+  // Returns false if the decoder cannot decode at |fs_hz|. The default
+  // implementation only accepts the rate given by CodecSampleRateHz().
+  virtual bool SetSampleRate(int fs_hz);
+
   virtual NetEqDecoder codec_type() const;
 
   // Returns the underlying decoder state.
@@ -130,6 +135,15 @@ class AudioDecoder {
   // Returns the sample rate for |codec_type|.
   static int CodecSampleRateHz(NetEqDecoder codec_type);
 
+  // Returns true if decoders of type |codec_type| can produce audio sampled at
+  // |fs_hz|, either natively or after SetSampleRate().
+  static bool CodecSupportsSampleRate(NetEqDecoder codec_type, int fs_hz);
+
+  // Returns true if decoders of type |codec_type| keep no state between
+  // packets, so that decoding a packet gives the same audio whatever was
+  // decoded before it.
+  static bool CodecIsStateless(NetEqDecoder codec_type);
+
   // Creates an AudioDecoder object of type |codec_type|. Returns NULL for
   // for unsupported codecs, and when creating an AudioDecoder is not
   // applicable (e.g., for RED and DTMF/AVT types).
@@ -0,0 +1,74 @@
+/*
+ *  Copyright (c) 2014 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_MODULES_AUDIO_CODING_NETEQ4_INTERFACE_AUDIO_DECODER_POOL_H_
+#define WEBRTC_MODULES_AUDIO_CODING_NETEQ4_INTERFACE_AUDIO_DECODER_POOL_H_
+
+#include <map>
+#include <vector>
+
+#include "audio_engine/modules/audio_coding/neteq4/interface/audio_decoder.h"
+#include "audio_engine/system_wrappers/interface/constructor_magic.h"
+#include "audio_engine/system_wrappers/interface/scoped_ptr.h"
+#include "audio_engine/system_wrappers/interface/thread_annotations.h"
+#include "audio_engine/include/typedefs.h"
+
+namespace VoIP {
+
+class CriticalSectionWrapper;
+
+// Keeps AudioDecoder objects that a NetEq instance no longer needs, so that
+// the next instance needing a decoder of the same type can take one instead
+// of allocating and initializing a new one. One pool is shared by all NetEq
+// instances of an engine, and must outlive them. Idle decoders are kept per
+// type up to a limit; decoders returned beyond it are deleted. The class is
+// thread-safe.
+class AudioDecoderPool {
+ public:
+  // Number of idle decoders kept per type, unless raised by Prewarm().
+  static const int kDefaultMaxIdlePerType = 8;
+
+  AudioDecoderPool();
+  virtual ~AudioDecoderPool();
+
+  // Returns an initialized decoder of |codec_type|, producing audio at the
+  // default rate of the type. The caller owns the object until it is given
+  // back through Release(). Returns NULL if |codec_type| is not supported.
+  AudioDecoder* Acquire(NetEqDecoder codec_type);
+
+  // Takes ownership of |decoder|, which must have been created by
+  // AudioDecoder::CreateAudioDecoder() or Acquire().
+  void Release(AudioDecoder* decoder);
+
+  // Makes sure that at least |count| idle decoders of |codec_type| are
+  // available, and keeps at least that many from then on. Returns the number
+  // of idle decoders of the type, or -1 if |codec_type| is not supported.
+  int Prewarm(NetEqDecoder codec_type, int count);
+
+  // Returns the number of idle decoders of |codec_type|.
+  int NumIdle(NetEqDecoder codec_type) const;
+
+ private:
+  struct Entry {
+    Entry() : max_idle(kDefaultMaxIdlePerType) {}
+    std::vector<AudioDecoder*> idle;
+    int max_idle;
+  };
+  typedef std::map<NetEqDecoder, Entry> EntryMap;
+
+  const scoped_ptr<CriticalSectionWrapper> crit_sect_;
+  EntryMap entries_ GUARDED_BY(crit_sect_);
+
+  DISALLOW_COPY_AND_ASSIGN(AudioDecoderPool);
+};
+
+}  // namespace VoIP
+
+#endif  // WEBRTC_MODULES_AUDIO_CODING_NETEQ4_INTERFACE_AUDIO_DECODER_POOL_H_
@@ -23,6 +23,7 @@
 namespace VoIP {
 
 // Forward declarations.
+class AudioDecoderPool;
 struct WebRtcRTPHeader;
 
 struct NetEqNetworkStatistics {
@@ -43,12 +44,26 @@ struct NetEqNetworkStatistics {
   int added_zero_samples;  // Number of zero samples added in "off" mode.
 };
 
+// Number of 10 ms output blocks produced by each signal processing operation
+// since the last call to NetEq::OperationStatistics().
+struct NetEqOperationStatistics {
+  uint32_t normal;  // Decoded audio passed straight through.
+  uint32_t merge;  // Decoded audio merged with preceding expansion.
+  uint32_t expand;  // Packet loss concealment.
+  uint32_t accelerate;  // Time-compression of decoded audio.
+  uint32_t preemptive_expand;  // Time-stretching of decoded audio.
+  uint32_t comfort_noise;  // RFC 3389 or codec-internal CNG.
+  uint32_t other;  // DTMF, alternative PLC and audio repetition.
+  uint32_t idle;  // Silence from the idle fast path; see EnableIdleFastPath().
+};
+
 enum NetEqOutputType {
   kOutputNormal,
   kOutputPLC,
   kOutputCNG,
   kOutputPLCtoCNG,
-  kOutputVADPassive
+  kOutputVADPassive,
+  kOutputIdle  // Silence from a long idle stream; see EnableIdleFastPath().
 };
 
 enum NetEqPlayoutMode {
@@ -70,10 +85,17 @@ class NetEq {
   struct Config {
     Config()
         : sample_rate_hz(16000),
-          enable_audio_classifier(false) {}
+          enable_audio_classifier(false),
+          decode_on_arrival(false) {}
 
     int sample_rate_hz;  // Initial vale. Will change with input data.
     bool enable_audio_classifier;
+    // When true, InsertPacket() decodes packets that continue the current
+    // decoder stream as soon as they arrive, on the calling thread, and
+    // GetAudio() uses the already decoded audio. This moves the decoding cost
+    // off the thread that pulls audio. Only stateless codecs (G.711 and
+    // PCM16B) are decoded ahead; other codecs are decoded by GetAudio().
+    bool decode_on_arrival;
   };
 
   enum ReturnCodes {
@@ -207,6 +229,10 @@ class NetEq {
   // after the call.
   virtual int NetworkStatistics(NetEqNetworkStatistics* stats) = 0;
 
+  // Writes the number of output blocks produced by each operation since the
+  // last call to |stats|. The counters are reset after the call.
+  virtual void OperationStatistics(NetEqOperationStatistics* stats) = 0;
+
   // Writes the last packet waiting times (in ms) to |waiting_times|. The number
   // of values written is no more than 100, but may be smaller if the interface
   // is polled again before 100 packets has arrived.
@@ -226,6 +252,52 @@ class NetEq {
   // Disables post-decode VAD.
   virtual void DisableVad() = 0;
 
+  // Enables the idle fast path. When a stream has produced nothing but
+  // comfort noise, or expansion faded down to background noise, for about a
+  // second, GetAudio() returns silence of type kOutputIdle instead of
+  // synthesizing the noise. Decisions and timing are kept up to date, so the
+  // stream resumes normally when packets arrive again. Meant for servers
+  // mixing many mostly silent streams.
+  virtual void EnableIdleFastPath() = 0;
+
+  // Disables the idle fast path. This is the default.
+  virtual void DisableIdleFastPath() = 0;
+
+  // Puts NetEq in unheard mode, for a stream whose output is currently not
+  // played out, e.g., not selected for mixing. Packet loss is then concealed
+  // with silence rather than by Expand. Buffering, timing and statistics are
+  // maintained as usual, so the stream is back at full quality on the first
+  // GetAudio() call after DisableUnheardMode().
+  virtual void EnableUnheardMode() = 0;
+
+  // Leaves unheard mode. This is the default.
+  virtual void DisableUnheardMode() = 0;
+
+  // Deletes the decoder objects that NetEq has created once no packet has
+  // been decoded for |timeout_ms| and the packet buffer is empty. The payload
+  // types stay registered, and a decoder is created again, in its initial
+  // state, by the next packet that needs it. The comfort noise decoder in use
+  // is kept. Externally created decoders are never deleted. A |timeout_ms| of
+  // 0, the default, keeps decoders until the payload type changes.
+  virtual void SetDecoderIdleTimeout(int timeout_ms) = 0;
+
+  // Takes the decoder objects that NetEq creates from |pool|, and gives them
+  // back to it instead of deleting them. The pool can be shared between NetEq
+  // instances and must outlive this one. NULL, the default, allocates the
+  // objects for this instance only. Externally created decoders are never
+  // pooled.
+  virtual void SetDecoderPool(AudioDecoderPool* pool) = 0;
+
+  // Asks decoders that can produce several sample rates (currently Opus) to
+  // decode at |fs_hz|, so that output at that rate needs no resampling.
+  // Supported rates are 8000, 16000, 32000 and 48000 Hz; 0 restores the
+  // default rate of each decoder. 12000 and 24000 Hz are rejected, since the
+  // signal processing of NetEq only runs at the supported rates. Buffered
+  // packets are kept: the new rate takes effect when the stream restarts
+  // (first packet, SSRC change or FlushBuffers()), and the output stays at
+  // the old rate until then. Returns kOK, or kFail for an invalid rate.
+  virtual int SetPreferredSampleRate(int fs_hz) = 0;
+
   // Returns the RTP timestamp for the last sample delivered by GetAudio().
   virtual uint32_t PlayoutTimestamp() = 0;
 
@@ -56,7 +56,9 @@ NetEq* NetEq::Create(const NetEq::Config& config) {
                        timestamp_scaler,
                        accelerate_factory,
                        expand_factory,
-                       preemptive_expand_factory);
+                       preemptive_expand_factory,
+                       true,
+                       config.decode_on_arrival);
 }
 
 }  // namespace VoIP
@@ -21,6 +21,7 @@
 #include "audio_engine/modules/audio_coding/neteq4/buffer_level_filter.h"
 #include "audio_engine/modules/audio_coding/neteq4/comfort_noise.h"
 #include "audio_engine/modules/audio_coding/neteq4/decision_logic.h"
+#include "audio_engine/modules/audio_coding/neteq4/decoded_frame_buffer.h"
 #include "audio_engine/modules/audio_coding/neteq4/decoder_database.h"
 #include "audio_engine/modules/audio_coding/neteq4/defines.h"
 #include "audio_engine/modules/audio_coding/neteq4/delay_manager.h"
@@ -62,7 +63,8 @@ NetEqImpl::NetEqImpl(int fs,
                      AccelerateFactory* accelerate_factory,
                      ExpandFactory* expand_factory,
                      PreemptiveExpandFactory* preemptive_expand_factory,
-                     bool create_components)
+                     bool create_components,
+                     bool decode_on_arrival)
     : buffer_level_filter_(buffer_level_filter),
       decoder_database_(decoder_database),
       delay_manager_(delay_manager),
@@ -90,7 +92,20 @@ NetEqImpl::NetEqImpl(int fs,
       first_packet_(true),
       error_code_(0),
       decoder_error_code_(0),
+      idle_fast_path_enabled_(false),
+      idle_samples_(0),
+      idle_output_(false),
+      unheard_(false),
+      decoder_idle_timeout_ms_(0),
+      decoder_idle_samples_(0),
+      preferred_fs_hz_(0),
       crit_sect_(CriticalSectionWrapper::CreateCriticalSection()),
+      decoder_crit_sect_(CriticalSectionWrapper::CreateCriticalSection()),
+      decode_on_arrival_(decode_on_arrival),
+      decoded_frames_(decode_on_arrival ? new DecodedFrameBuffer : NULL),
+      decode_ahead_synced_(false),
+      decode_ahead_timestamp_(0),
+      decode_ahead_payload_type_(0xFF),
       decoded_packet_sequence_number_(-1),
       decoded_packet_timestamp_(0) {
   if (fs != 8000 && fs != 16000 && fs != 32000 && fs != 48000) {
@@ -117,18 +132,23 @@ int NetEqImpl::InsertPacket(const WebRtcRTPHeader& rtp_header,
                             const uint8_t* payload,
                             int length_bytes,
                             uint32_t receive_timestamp) {
-  CriticalSectionScoped lock(crit_sect_.get());
-  LOG(LS_VERBOSE) << "InsertPacket: ts=" << rtp_header.header.timestamp <<
-      ", sn=" << rtp_header.header.sequenceNumber <<
-      ", pt=" << static_cast<int>(rtp_header.header.payloadType) <<
-      ", ssrc=" << rtp_header.header.ssrc <<
-      ", len=" << length_bytes;
-  int error = InsertPacketInternal(rtp_header, payload, length_bytes,
-                                   receive_timestamp, false);
-  if (error != 0) {
-    LOG_FERR1(LS_WARNING, InsertPacketInternal, error);
-    error_code_ = error;
-    return kFail;
+  {
+    CriticalSectionScoped lock(crit_sect_.get());
+    LOG(LS_VERBOSE) << "InsertPacket: ts=" << rtp_header.header.timestamp <<
+        ", sn=" << rtp_header.header.sequenceNumber <<
+        ", pt=" << static_cast<int>(rtp_header.header.payloadType) <<
+        ", ssrc=" << rtp_header.header.ssrc <<
+        ", len=" << length_bytes;
+    int error = InsertPacketInternal(rtp_header, payload, length_bytes,
+                                     receive_timestamp, false);
+    if (error != 0) {
+      LOG_FERR1(LS_WARNING, InsertPacketInternal, error);
+      error_code_ = error;
+      return kFail;
+    }
+  }
+  if (decode_on_arrival_) {
+    DecodeAhead();
   }
   return kOK;
 }
@@ -241,6 +261,8 @@ int NetEqImpl::RegisterExternalDecoder(AudioDecoder* decoder,
 int NetEqImpl::RemovePayloadType(uint8_t rtp_payload_type) {
   CriticalSectionScoped lock(crit_sect_.get());
   LOG_API1(static_cast<int>(rtp_payload_type));
+  CriticalSectionScoped decoder_lock(decoder_crit_sect_.get());
+  InvalidateDecodeAhead();
   int ret = decoder_database_->Remove(rtp_payload_type);
   if (ret == DecoderDatabase::kOK) {
     return kOK;
@@ -305,6 +327,11 @@ int NetEqImpl::NetworkStatistics(NetEqNetworkStatistics* stats) {
   return 0;
 }
 
+void NetEqImpl::OperationStatistics(NetEqOperationStatistics* stats) {
+  CriticalSectionScoped lock(crit_sect_.get());
+  stats_.GetOperationStatistics(stats);
+}
+
 void NetEqImpl::WaitingTimes(std::vector<int>* waiting_times) {
   CriticalSectionScoped lock(crit_sect_.get());
   stats_.WaitingTimes(waiting_times);
@@ -336,6 +363,60 @@ void NetEqImpl::DisableVad() {
   vad_->Disable();
 }
 
+void NetEqImpl::EnableIdleFastPath() {
+  CriticalSectionScoped lock(crit_sect_.get());
+  idle_fast_path_enabled_ = true;
+}
+
+void NetEqImpl::DisableIdleFastPath() {
+  CriticalSectionScoped lock(crit_sect_.get());
+  idle_fast_path_enabled_ = false;
+  idle_samples_ = 0;
+}
+
+void NetEqImpl::EnableUnheardMode() {
+  CriticalSectionScoped lock(crit_sect_.get());
+  unheard_ = true;
+}
+
+void NetEqImpl::DisableUnheardMode() {
+  CriticalSectionScoped lock(crit_sect_.get());
+  if (unheard_ && expand_.get()) {
+    // Expansions made while unheard wrote silence. Start the concealment
+    // over from that silence, rather than continuing the one never played.
+    expand_->Reset();
+  }
+  unheard_ = false;
+}
+
+void NetEqImpl::SetDecoderIdleTimeout(int timeout_ms) {
+  CriticalSectionScoped lock(crit_sect_.get());
+  LOG_API1(timeout_ms);
+  decoder_idle_timeout_ms_ = std::max(timeout_ms, 0);
+  decoder_idle_samples_ = 0;
+}
+
+void NetEqImpl::SetDecoderPool(AudioDecoderPool* pool) {
+  CriticalSectionScoped lock(crit_sect_.get());
+  CriticalSectionScoped decoder_lock(decoder_crit_sect_.get());
+  decoder_database_->SetDecoderPool(pool);
+}
+
+int NetEqImpl::SetPreferredSampleRate(int fs_hz) {
+  CriticalSectionScoped lock(crit_sect_.get());
+  LOG_API1(fs_hz);
+  if (fs_hz != 0 && fs_hz != 8000 && fs_hz != 16000 && fs_hz != 32000 &&
+      fs_hz != 48000) {
+    error_code_ = kInvalidSampleRate;
+    return kFail;
+  }
+  // The buffered packets are scaled to the current decoder rate, so the rate
+  // only changes when the stream restarts; see InsertPacketInternal(). Until
+  // then the caller resamples.
+  preferred_fs_hz_ = fs_hz;
+  return kOK;
+}
+
 uint32_t NetEqImpl::PlayoutTimestamp() {
   CriticalSectionScoped lock(crit_sect_.get());
   return timestamp_scaler_->ToExternal(playout_timestamp_);
@@ -355,6 +436,10 @@ void NetEqImpl::FlushBuffers() {
   CriticalSectionScoped lock(crit_sect_.get());
   LOG_API0();
   packet_buffer_->Flush();
+  {
+    CriticalSectionScoped decoder_lock(decoder_crit_sect_.get());
+    InvalidateDecodeAhead();
+  }
   assert(sync_buffer_.get());
   assert(expand_.get());
   sync_buffer_->Flush();
@@ -468,6 +553,13 @@ int NetEqImpl::InsertPacketInternal(const WebRtcRTPHeader& rtp_header,
     // Flush the packet buffer and DTMF buffer.
     packet_buffer_->Flush();
     dtmf_buffer_->Flush();
+    {
+      CriticalSectionScoped decoder_lock(decoder_crit_sect_.get());
+      InvalidateDecodeAhead();
+      // No packets are buffered and the timestamp scaling restarts below, so
+      // the decoders can switch to the preferred rate here.
+      decoder_database_->SetSampleRate(preferred_fs_hz_);
+    }
 
     // Store new SSRC.
     ssrc_ = main_header.ssrc;
@@ -592,6 +684,7 @@ int NetEqImpl::InsertPacketInternal(const WebRtcRTPHeader& rtp_header,
         decoder_database_->GetDecoder(main_header.payloadType);
     assert(decoder);  // Should always get a valid object, since we have
                       // already checked that the payload types are known.
+    CriticalSectionScoped decoder_lock(decoder_crit_sect_.get());
     decoder->IncomingPacket(packet_list.front()->payload,
                             packet_list.front()->payload_length,
                             packet_list.front()->header.sequenceNumber,
@@ -608,6 +701,10 @@ int NetEqImpl::InsertPacketInternal(const WebRtcRTPHeader& rtp_header,
       &current_cng_rtp_payload_type_);
   if (ret == PacketBuffer::kFlushed) {
     // Reset DSP timestamp etc. if packet buffer flushed.
+    {
+      CriticalSectionScoped decoder_lock(decoder_crit_sect_.get());
+      InvalidateDecodeAhead();
+    }
     new_codec_ = true;
     update_sample_rate_and_channels = true;
     LOG_F(LS_WARNING) << "Packet buffer flushed";
@@ -697,7 +794,19 @@ int NetEqImpl::GetAudioInternal(size_t max_length, int16_t* output,
   }
   LOG(LS_VERBOSE) << "GetDecision returned operation=" << operation <<
       " and " << packet_list.size() << " packet(s)";
+  if (UseIdleFastPath(operation, packet_list, play_dtmf)) {
+    operation = kIdle;
+  }
+  idle_output_ = (operation == kIdle);
+  if (unheard_ && last_mode_ == kModeExpand && !packet_list.empty() &&
+      (operation == kMerge || operation == kNormal)) {
+    // The expansion was silent, so there is nothing to merge or cross-fade
+    // with. Play out the new data as it is, without running Expand again.
+    operation = kNormal;
+    last_mode_ = kModeNormal;
+  }
 
+  const bool packets_decoded = !packet_list.empty();
   AudioDecoder::SpeechType speech_type;
   int length = 0;
   int decode_return_value = Decode(&packet_list, &operation,
@@ -720,7 +829,11 @@ int NetEqImpl::GetAudioInternal(size_t max_length, int16_t* output,
       break;
     }
     case kExpand: {
-      return_value = DoExpand(play_dtmf);
+      if (unheard_) {
+        return_value = DoSilentExpand(play_dtmf);
+      } else {
+        return_value = DoExpand(play_dtmf);
+      }
       break;
     }
     case kAccelerate: {
@@ -775,6 +888,10 @@ int NetEqImpl::GetAudioInternal(size_t max_length, int16_t* output,
       expand_->Reset();
       break;
     }
+    case kIdle: {
+      DoIdle();
+      break;
+    }
     case kUndefined: {
       LOG_F(LS_ERROR) << "Invalid operation kUndefined.";
       assert(false);  // This should not happen.
@@ -785,6 +902,7 @@ int NetEqImpl::GetAudioInternal(size_t max_length, int16_t* output,
   if (return_value < 0) {
     return return_value;
   }
+  stats_.OperationPerformed(operation);
 
   if (last_mode_ != kModeRfc3389Cng) {
     comfort_noise_->Reset();
@@ -829,14 +947,18 @@ int NetEqImpl::GetAudioInternal(size_t max_length, int16_t* output,
   // Update the background noise parameters if last operation wrote data
   // straight from the decoder to the |sync_buffer_|. That is, none of the
   // operations that modify the signal can be followed by a parameter update.
-  if ((last_mode_ == kModeNormal) ||
-      (last_mode_ == kModeAccelerateFail) ||
-      (last_mode_ == kModePreemptiveExpandFail) ||
-      (last_mode_ == kModeRfc3389Cng) ||
-      (last_mode_ == kModeCodecInternalCng)) {
+  // The silence written by kIdle is not noise to learn from.
+  if (operation != kIdle &&
+      ((last_mode_ == kModeNormal) ||
+       (last_mode_ == kModeAccelerateFail) ||
+       (last_mode_ == kModePreemptiveExpandFail) ||
+       (last_mode_ == kModeRfc3389Cng) ||
+       (last_mode_ == kModeCodecInternalCng))) {
     background_noise_->Update(*sync_buffer_, *vad_.get());
   }
 
+  ReleaseIdleDecoders(packets_decoded);
+
   if (operation == kDtmf) {
     // DTMF data was written the end of |sync_buffer_|.
     // Update index to end of DTMF data in |sync_buffer_|.
@@ -1136,7 +1258,14 @@ int NetEqImpl::Decode(PacketList* packet_list, Operations* operation,
         return kDecoderNotFound;
       }
       bool decoder_changed;
-      decoder_database_->SetActiveDecoder(payload_type, &decoder_changed);
+      {
+        // Switching decoder may delete the previous one.
+        CriticalSectionScoped decoder_lock(decoder_crit_sect_.get());
+        decoder_database_->SetActiveDecoder(payload_type, &decoder_changed);
+        if (decoder_changed) {
+          InvalidateDecodeAhead();
+        }
+      }
       if (decoder_changed) {
         // We have a new decoder. Re-init some values.
         const DecoderDatabase::DecoderInfo* decoder_info = decoder_database_
@@ -1164,6 +1293,8 @@ int NetEqImpl::Decode(PacketList* packet_list, Operations* operation,
     // TODO(hlundin): Write test for this.
     // Reset decoder.
     if (decoder) {
+      CriticalSectionScoped decoder_lock(decoder_crit_sect_.get());
+      InvalidateDecodeAhead();
       decoder->Init();
     }
     // Reset comfort noise decoder.
@@ -1187,6 +1318,8 @@ int NetEqImpl::Decode(PacketList* packet_list, Operations* operation,
   *decoded_length = 0;
   // Update codec-internal PLC state.
   if ((*operation == kMerge) && decoder && decoder->HasDecodePlc()) {
+    CriticalSectionScoped decoder_lock(decoder_crit_sect_.get());
+    InvalidateDecodeAhead();
     decoder->DecodePlc(1, &decoded_buffer_[*decoded_length]);
   }
 
@@ -1198,8 +1331,10 @@ int NetEqImpl::Decode(PacketList* packet_list, Operations* operation,
     *decoded_length = 0;
     sync_buffer_->IncreaseEndTimestamp(decoder_frame_length_);
     int error_code = 0;
-    if (decoder)
+    if (decoder) {
+      CriticalSectionScoped decoder_lock(decoder_crit_sect_.get());
       error_code = decoder->ErrorCode();
+    }
     if (error_code != 0) {
       // Got some error code from the decoder.
       decoder_error_code_ = error_code;
@@ -1242,39 +1377,86 @@ int NetEqImpl::DecodeLoop(PacketList* packet_list, Operations* operation,
            *operation == kMerge || *operation == kPreemptiveExpand);
     packet_list->pop_front();
     int payload_length = packet->payload_length;
-    int16_t decode_length;
-    if (packet->sync_packet) {
-      // Decode to silence with the same frame size as the last decode.
-      LOG(LS_VERBOSE) << "Decoding sync-packet: " <<
-          " ts=" << packet->header.timestamp <<
-          ", sn=" << packet->header.sequenceNumber <<
-          ", pt=" << static_cast<int>(packet->header.payloadType) <<
-          ", ssrc=" << packet->header.ssrc <<
-          ", len=" << packet->payload_length;
-      memset(&decoded_buffer_[*decoded_length], 0, decoder_frame_length_ *
-             decoder->channels() * sizeof(decoded_buffer_[0]));
-      decode_length = decoder_frame_length_;
-    } else if (!packet->primary) {
-      // This is a redundant payload; call the special decoder method.
-      LOG(LS_VERBOSE) << "Decoding packet (redundant):" <<
-          " ts=" << packet->header.timestamp <<
-          ", sn=" << packet->header.sequenceNumber <<
-          ", pt=" << static_cast<int>(packet->header.payloadType) <<
-          ", ssrc=" << packet->header.ssrc <<
-          ", len=" << packet->payload_length;
-      decode_length = decoder->DecodeRedundant(
-          packet->payload, packet->payload_length,
-          &decoded_buffer_[*decoded_length], speech_type);
+    int16_t decode_length = -1;
+    const bool may_be_decoded_ahead =
+        decode_on_arrival_ && packet->primary && !packet->sync_packet;
+    if (may_be_decoded_ahead) {
+      // Use the audio decoded when the packet arrived, if any. This does not
+      // wait for a DecodeAhead() call in progress.
+      decode_length = decoded_frames_->Pop(
+          packet->header.timestamp, packet->header.payloadType,
+          &decoded_buffer_[*decoded_length],
+          decoded_buffer_length_ - *decoded_length, speech_type);
+    }
+    if (decode_length < 0) {
+      CriticalSectionScoped decoder_lock(decoder_crit_sect_.get());
+      if (may_be_decoded_ahead) {
+        // DecodeAhead() may have finished this packet while we were waiting
+        // for the lock.
+        decode_length = decoded_frames_->Pop(
+            packet->header.timestamp, packet->header.payloadType,
+            &decoded_buffer_[*decoded_length],
+            decoded_buffer_length_ - *decoded_length, speech_type);
+      }
+      if (decode_length >= 0) {
+        // Already decoded; nothing more to do.
+      } else if (packet->sync_packet) {
+        InvalidateDecodeAhead();
+        // Decode to silence with the same frame size as the last decode.
+        LOG(LS_VERBOSE) << "Decoding sync-packet: " <<
+            " ts=" << packet->header.timestamp <<
+            ", sn=" << packet->header.sequenceNumber <<
+            ", pt=" << static_cast<int>(packet->header.payloadType) <<
+            ", ssrc=" << packet->header.ssrc <<
+            ", len=" << packet->payload_length;
+        memset(&decoded_buffer_[*decoded_length], 0, decoder_frame_length_ *
+               decoder->channels() * sizeof(decoded_buffer_[0]));
+        decode_length = decoder_frame_length_;
+      } else if (!packet->primary) {
+        // This is a redundant payload; call the special decoder method.
+        LOG(LS_VERBOSE) << "Decoding packet (redundant):" <<
+            " ts=" << packet->header.timestamp <<
+            ", sn=" << packet->header.sequenceNumber <<
+            ", pt=" << static_cast<int>(packet->header.payloadType) <<
+            ", ssrc=" << packet->header.ssrc <<
+            ", len=" << packet->payload_length;
+        InvalidateDecodeAhead();
+        decode_length = decoder->DecodeRedundant(
+            packet->payload, packet->payload_length,
+            &decoded_buffer_[*decoded_length], speech_type);
+      } else {
+        LOG(LS_VERBOSE) << "Decoding packet: ts=" <<
+            packet->header.timestamp <<
+            ", sn=" << packet->header.sequenceNumber <<
+            ", pt=" << static_cast<int>(packet->header.payloadType) <<
+            ", ssrc=" << packet->header.ssrc <<
+            ", len=" << packet->payload_length;
+        decode_length = decoder->Decode(packet->payload,
+                                        packet->payload_length,
+                                        &decoded_buffer_[*decoded_length],
+                                        speech_type);
+        if (decode_on_arrival_) {
+          // Anything decoded ahead is now out of sequence. Continue decoding
+          // ahead from the packet following this one. Audio that a stateful
+          // decoder produced ahead would not match what it produces if the
+          // packet has to be decoded again, so those are only decoded here.
+          InvalidateDecodeAhead();
+          if (decode_length > 0 &&
+              AudioDecoder::CodecIsStateless(decoder->codec_type())) {
+            decode_ahead_synced_ = true;
+            decode_ahead_timestamp_ = packet->header.timestamp +
+                decode_length / static_cast<int>(decoder->channels());
+            decode_ahead_payload_type_ = packet->header.payloadType;
+          }
+        }
+      }
     } else {
-      LOG(LS_VERBOSE) << "Decoding packet: ts=" << packet->header.timestamp <<
+      LOG(LS_VERBOSE) << "Decoded packet on arrival: ts=" <<
+          packet->header.timestamp <<
           ", sn=" << packet->header.sequenceNumber <<
           ", pt=" << static_cast<int>(packet->header.payloadType) <<
           ", ssrc=" << packet->header.ssrc <<
           ", len=" << packet->payload_length;
-      decode_length = decoder->Decode(packet->payload,
-                                      packet->payload_length,
-                                      &decoded_buffer_[*decoded_length],
-                                      speech_type);
     }
 
     delete[] packet->payload;
@@ -1316,6 +1498,65 @@ int NetEqImpl::DecodeLoop(PacketList* packet_list, Operations* operation,
   return 0;
 }
 
+void NetEqImpl::DecodeAhead() {
+  assert(decoded_frames_.get());
+  while (true) {
+    // Pick the packet while holding both locks, but keep only
+    // |decoder_crit_sect_| while decoding. This prevents GetAudio() from using
+    // or deleting the decoder meanwhile, without blocking it otherwise.
+    crit_sect_->Enter();
+    decoder_crit_sect_->Enter();
+    AudioDecoder* decoder = NULL;
+    if (decode_ahead_synced_ && !decoded_frames_->Full()) {
+      const Packet* packet =
+          packet_buffer_->FindPacket(decode_ahead_timestamp_);
+      if (packet && packet->payload_length > 0 &&
+          packet->header.payloadType == decode_ahead_payload_type_) {
+        decoder = decoder_database_->GetActiveDecoder();
+        decode_ahead_payload_.assign(packet->payload,
+                                     packet->payload + packet->payload_length);
+      }
+    }
+    crit_sect_->Leave();
+    if (!decoder) {
+      decoder_crit_sect_->Leave();
+      return;
+    }
+
+    if (decode_ahead_audio_.size() < kMaxFrameSize * decoder->channels()) {
+      decode_ahead_audio_.resize(kMaxFrameSize * decoder->channels());
+    }
+    AudioDecoder::SpeechType speech_type = AudioDecoder::kSpeech;
+    int decode_length = decoder->Decode(&decode_ahead_payload_[0],
+                                        decode_ahead_payload_.size(),
+                                        &decode_ahead_audio_[0],
+                                        &speech_type);
+    LOG(LS_VERBOSE) << "Decoded ahead: ts=" << decode_ahead_timestamp_ <<
+        ", pt=" << static_cast<int>(decode_ahead_payload_type_) <<
+        ", len=" << decode_ahead_payload_.size() << " -> " << decode_length;
+    if (decode_length > 0 &&
+        decoded_frames_->Push(decode_ahead_timestamp_,
+                              decode_ahead_payload_type_,
+                              &decode_ahead_audio_[0], decode_length,
+                              speech_type)) {
+      decode_ahead_timestamp_ +=
+          decode_length / static_cast<int>(decoder->channels());
+    } else {
+      // Leave errors, and anything else unusual, to GetAudio(). It will decode
+      // the packet again and restart the sequence.
+      InvalidateDecodeAhead();
+    }
+    decoder_crit_sect_->Leave();
+  }
+}
+
+void NetEqImpl::InvalidateDecodeAhead() {
+  decode_ahead_synced_ = false;
+  if (decoded_frames_.get()) {
+    decoded_frames_->Flush();
+  }
+}
+
 void NetEqImpl::DoNormal(const int16_t* decoded_buffer, size_t decoded_length,
                          AudioDecoder::SpeechType speech_type, bool play_dtmf) {
   assert(normal_.get());
@@ -1398,6 +1639,68 @@ int NetEqImpl::DoExpand(bool play_dtmf) {
   return 0;
 }
 
+int NetEqImpl::DoSilentExpand(bool play_dtmf) {
+  if (last_mode_ != kModeExpand) {
+    // A new expansion period starts at full voice, as in
+    // Expand::InitializeForAnExpandPeriod().
+    for (size_t channel = 0; channel < sync_buffer_->Channels(); ++channel) {
+      expand_->SetMuteFactor(16384, channel);  // 1.0 in Q14.
+    }
+  }
+  const size_t future_length =
+      sync_buffer_->FutureLength() - expand_->overlap_length();
+  if (future_length < static_cast<size_t>(output_size_samples_)) {
+    const int length = output_size_samples_ - static_cast<int>(future_length);
+    algorithm_buffer_->Zeros(length);
+    if (expand_->MuteFactor(0) == 0) {
+      stats_.ExpandedNoiseSamples(length);
+    } else {
+      stats_.ExpandedVoiceSamples(length);
+    }
+    sync_buffer_->PushBack(*algorithm_buffer_);
+    algorithm_buffer_->Clear();
+    // Fade the mute factor as Expand would, so that the statistics and the
+    // idle fast path see the expansion turn into noise.
+    const int fade_samples = kSilentExpandFadeMs * fs_hz_ / 1000;
+    const int step = (16384 * length + fade_samples - 1) / fade_samples;
+    for (size_t channel = 0; channel < sync_buffer_->Channels(); ++channel) {
+      const int mute_factor = expand_->MuteFactor(channel);
+      expand_->SetMuteFactor(
+          static_cast<int16_t>(std::max(mute_factor - step, 0)), channel);
+    }
+  }
+  last_mode_ = kModeExpand;
+  if (!play_dtmf) {
+    dtmf_tone_generator_->Reset();
+  }
+  return 0;
+}
+
+void NetEqImpl::ReleaseIdleDecoders(bool packets_decoded) {
+  if (packets_decoded || decoder_idle_timeout_ms_ == 0) {
+    decoder_idle_samples_ = 0;
+    return;
+  }
+  const int timeout_samples = decoder_idle_timeout_ms_ * (fs_hz_ / 1000);
+  if (decoder_idle_samples_ >= timeout_samples) {
+    // Already released.
+    return;
+  }
+  decoder_idle_samples_ += output_size_samples_;
+  if (decoder_idle_samples_ < timeout_samples) {
+    return;
+  }
+  if (!packet_buffer_->Empty() || last_mode_ == kModeCodecInternalCng) {
+    // A decoder is about to be used, or is producing the comfort noise.
+    decoder_idle_samples_ = 0;
+    return;
+  }
+  CriticalSectionScoped decoder_lock(decoder_crit_sect_.get());
+  InvalidateDecodeAhead();
+  int num_released = decoder_database_->ReleaseDecoders();
+  LOG(LS_VERBOSE) << "Released " << num_released << " idle decoder(s)";
+}
+
 int NetEqImpl::DoAccelerate(int16_t* decoded_buffer, size_t decoded_length,
                             AudioDecoder::SpeechType speech_type,
                             bool play_dtmf) {
@@ -1602,6 +1905,8 @@ void NetEqImpl::DoCodecInternalCng() {
   if (decoder) {
     const uint8_t* dummy_payload = NULL;
     AudioDecoder::SpeechType speech_type;
+    CriticalSectionScoped decoder_lock(decoder_crit_sect_.get());
+    InvalidateDecodeAhead();
     length = decoder->Decode(dummy_payload, 0, decoded_buffer, &speech_type);
   }
   assert(mute_factor_array_.get());
@@ -1611,6 +1916,58 @@ void NetEqImpl::DoCodecInternalCng() {
   expand_->Reset();
 }
 
+bool NetEqImpl::UseIdleFastPath(Operations operation,
+                                const PacketList& packet_list,
+                                bool play_dtmf) {
+  // Idle means continuing expansion that has faded down to background noise,
+  // or comfort noise, with no packet at hand. A kNormal decision here only
+  // plays out samples left over from the previous call.
+  bool idle = false;
+  if (packet_list.empty() && packet_buffer_->Empty() && !play_dtmf) {
+    switch (last_mode_) {
+      case kModeExpand:
+        idle = (operation == kExpand || operation == kNormal) &&
+            expand_->MuteFactor(0) == 0;
+        break;
+      case kModeRfc3389Cng:
+        idle = (operation == kRfc3389CngNoPacket || operation == kNormal);
+        break;
+      case kModeCodecInternalCng:
+        idle = (operation == kCodecInternalCng || operation == kNormal);
+        break;
+      default:
+        break;
+    }
+  }
+  if (!idle) {
+    idle_samples_ = 0;
+    return false;
+  }
+  const int delay_samples = kIdleFastPathDelayMs * fs_hz_ / 1000;
+  if (idle_samples_ <= delay_samples) {
+    idle_samples_ += output_size_samples_;
+  }
+  return idle_fast_path_enabled_ && idle_samples_ > delay_samples;
+}
+
+void NetEqImpl::DoIdle() {
+  // Produce as much as DoExpand() would, which for comfort noise is exactly
+  // one output block. |last_mode_| is left unchanged.
+  const size_t future_length =
+      sync_buffer_->FutureLength() - expand_->overlap_length();
+  if (future_length < static_cast<size_t>(output_size_samples_)) {
+    const size_t length = output_size_samples_ - future_length;
+    algorithm_buffer_->Zeros(length);
+    if (last_mode_ == kModeExpand) {
+      stats_.ExpandedNoiseSamples(static_cast<int>(length));
+    }
+  }
+  if (last_mode_ != kModeExpand) {
+    expand_->Reset();
+  }
+  dtmf_tone_generator_->Reset();
+}
+
 int NetEqImpl::DoDtmf(const DtmfEvent& dtmf_event, bool* play_dtmf) {
   // This block of the code and the block further down, handling |dtmf_switch|
   // are commented out. Otherwise playing out-of-band DTMF would fail in VoE
@@ -1697,7 +2054,11 @@ void NetEqImpl::DoAlternativePlc(bool increase_timestamp) {
     // Use the decoder's packet-loss concealment.
     // TODO(hlundin): Will probably need a longer buffer for multi-channel.
     int16_t decoded_buffer[kMaxFrameSize];
-    length = decoder->DecodePlc(1, decoded_buffer);
+    {
+      CriticalSectionScoped decoder_lock(decoder_crit_sect_.get());
+      InvalidateDecodeAhead();
+      length = decoder->DecodePlc(1, decoded_buffer);
+    }
     if (length > 0) {
       algorithm_buffer_->PushBackInterleaved(decoded_buffer, length);
     } else {
@@ -1923,7 +2284,10 @@ void NetEqImpl::SetSampleRateAndChannels(int fs_hz, size_t channels) {
 NetEqOutputType NetEqImpl::LastOutputType() {
   assert(vad_.get());
   assert(expand_.get());
-  if (last_mode_ == kModeCodecInternalCng || last_mode_ == kModeRfc3389Cng) {
+  if (idle_output_) {
+    return kOutputIdle;
+  } else if (last_mode_ == kModeCodecInternalCng ||
+             last_mode_ == kModeRfc3389Cng) {
     return kOutputCNG;
   } else if (last_mode_ == kModeExpand && expand_->MuteFactor(0) == 0) {
     // Expand mode has faded down to background noise only (very long expand).
@@ -34,6 +34,7 @@ class BufferLevelFilter;
 class ComfortNoise;
 class CriticalSectionWrapper;
 class DecisionLogic;
+class DecodedFrameBuffer;
 class DecoderDatabase;
 class DelayManager;
 class DelayPeakDetector;
@@ -57,7 +58,9 @@ struct PreemptiveExpandFactory;
 class NetEqImpl : public VoIP::NetEq {
  public:
   // Creates a new NetEqImpl object. The object will assume ownership of all
-  // injected dependencies, and will delete them when done.
+  // injected dependencies, and will delete them when done. If
+  // |decode_on_arrival| is true, packets are decoded by InsertPacket() when
+  // possible; see NetEq::Config.
   NetEqImpl(int fs,
             BufferLevelFilter* buffer_level_filter,
             DecoderDatabase* decoder_database,
@@ -71,7 +74,8 @@ class NetEqImpl : public VoIP::NetEq {
             AccelerateFactory* accelerate_factory,
             ExpandFactory* expand_factory,
             PreemptiveExpandFactory* preemptive_expand_factory,
-            bool create_components = true);
+            bool create_components = true,
+            bool decode_on_arrival = false);
 
   virtual ~NetEqImpl();
 
@@ -147,6 +151,10 @@ class NetEqImpl : public VoIP::NetEq {
   // after the call.
   virtual int NetworkStatistics(NetEqNetworkStatistics* stats);
 
+  // Writes the number of output blocks produced by each operation since the
+  // last call to |stats|. The counters are reset after the call.
+  virtual void OperationStatistics(NetEqOperationStatistics* stats);
+
   // Writes the last packet waiting times (in ms) to |waiting_times|. The number
   // of values written is no more than 100, but may be smaller if the interface
   // is polled again before 100 packets has arrived.
@@ -166,6 +174,27 @@ class NetEqImpl : public VoIP::NetEq {
   // Disables post-decode VAD.
   virtual void DisableVad();
 
+  // Enables the idle fast path; see NetEq::EnableIdleFastPath().
+  virtual void EnableIdleFastPath();
+
+  // Disables the idle fast path.
+  virtual void DisableIdleFastPath();
+
+  // Enables unheard mode; see NetEq::EnableUnheardMode().
+  virtual void EnableUnheardMode();
+
+  // Disables unheard mode.
+  virtual void DisableUnheardMode();
+
+  // Sets the decoder idle timeout; see NetEq::SetDecoderIdleTimeout().
+  virtual void SetDecoderIdleTimeout(int timeout_ms);
+
+  // Sets the decoder pool; see NetEq::SetDecoderPool().
+  virtual void SetDecoderPool(AudioDecoderPool* pool);
+
+  // Sets the decoder output rate; see NetEq::SetPreferredSampleRate().
+  virtual int SetPreferredSampleRate(int fs_hz);
+
   // Returns the RTP timestamp for the last sample delivered by GetAudio().
   virtual uint32_t PlayoutTimestamp();
 
@@ -208,6 +237,12 @@ class NetEqImpl : public VoIP::NetEq {
   static const int kMaxFrameSize = 2880;  // 60 ms @ 48 kHz.
   // TODO(hlundin): Provide a better value for kSyncBufferSize.
   static const int kSyncBufferSize = 2 * kMaxFrameSize;
+  // Time without packets, producing only comfort noise or faded expansion,
+  // before the idle fast path takes over.
+  static const int kIdleFastPathDelayMs = 1000;
+  // Time over which DoSilentExpand() fades the mute factor of |expand_| from
+  // full voice to noise only.
+  static const int kSilentExpandFadeMs = 60;
 
   // Inserts a new packet into NetEq. This is used by the InsertPacket method
   // above. Returns 0 on success, otherwise an error code.
@@ -219,6 +254,17 @@ class NetEqImpl : public VoIP::NetEq {
                            bool is_sync_packet)
       EXCLUSIVE_LOCKS_REQUIRED(crit_sect_);
 
+  // Decodes the packets in |packet_buffer_| that directly follow the last
+  // packet given to the active decoder, and stores the result in
+  // |decoded_frames_|. Runs on the thread calling InsertPacket(), without
+  // holding |crit_sect_| while decoding.
+  void DecodeAhead() LOCKS_EXCLUDED(crit_sect_);
+
+  // Stops decoding ahead and deletes the frames decoded so far. Must be called
+  // whenever the active decoder is used other than for decoding the next
+  // packet in sequence, or is replaced.
+  void InvalidateDecodeAhead() EXCLUSIVE_LOCKS_REQUIRED(decoder_crit_sect_);
+
   // Delivers 10 ms of audio data. The data is written to |output|, which can
   // hold (at least) |max_length| elements. The number of channels that were
   // written to the output is provided in the output variable |num_channels|,
@@ -300,6 +346,28 @@ class NetEqImpl : public VoIP::NetEq {
   // no packet was received.
   void DoCodecInternalCng() EXCLUSIVE_LOCKS_REQUIRED(crit_sect_);
 
+  // Returns true if |operation|, decided by GetDecision(), can be replaced by
+  // kIdle. Also keeps track of how long the stream has been idle.
+  bool UseIdleFastPath(Operations operation,
+                       const PacketList& packet_list,
+                       bool play_dtmf) EXCLUSIVE_LOCKS_REQUIRED(crit_sect_);
+
+  // Writes silence to |algorithm_buffer_| in place of the expansion or comfort
+  // noise that |last_mode_| would otherwise produce.
+  void DoIdle() EXCLUSIVE_LOCKS_REQUIRED(crit_sect_);
+
+  // Replaces DoExpand() in unheard mode. Writes silence to |sync_buffer_| and
+  // updates statistics as if the expansion had been made, including the fading
+  // of its mute factor. The packet that ends the loss is then played out with
+  // kNormal instead of kMerge.
+  int DoSilentExpand(bool play_dtmf) EXCLUSIVE_LOCKS_REQUIRED(crit_sect_);
+
+  // Keeps track of the time since a packet was last decoded, and deletes the
+  // decoder objects when it exceeds the decoder idle timeout. Called once
+  // per GetAudio(), with |packets_decoded| true if packets were decoded.
+  void ReleaseIdleDecoders(bool packets_decoded)
+      EXCLUSIVE_LOCKS_REQUIRED(crit_sect_);
+
   // Calls the DtmfToneGenerator class to generate DTMF tones.
   int DoDtmf(const DtmfEvent& dtmf_event, bool* play_dtmf)
       EXCLUSIVE_LOCKS_REQUIRED(crit_sect_);
@@ -384,8 +452,32 @@ class NetEqImpl : public VoIP::NetEq {
   bool first_packet_ GUARDED_BY(crit_sect_);
   int error_code_ GUARDED_BY(crit_sect_);  // Store last error code.
   int decoder_error_code_ GUARDED_BY(crit_sect_);
+  bool idle_fast_path_enabled_ GUARDED_BY(crit_sect_);
+  int idle_samples_ GUARDED_BY(crit_sect_);  // Samples per channel.
+  bool idle_output_ GUARDED_BY(crit_sect_);  // Last output was from kIdle.
+  bool unheard_ GUARDED_BY(crit_sect_);
+  int decoder_idle_timeout_ms_ GUARDED_BY(crit_sect_);
+  int decoder_idle_samples_ GUARDED_BY(crit_sect_);  // Samples per channel.
+  // Decoder rate set by SetPreferredSampleRate(), applied at the next restart
+  // of the stream.
+  int preferred_fs_hz_ GUARDED_BY(crit_sect_);
   const scoped_ptr<CriticalSectionWrapper> crit_sect_;
 
+  // Protects all calls into audio decoders, and the deletion of decoders, so
+  // that DecodeAhead() can decode without holding |crit_sect_|. When both
+  // locks are needed, |crit_sect_| must be taken first.
+  const scoped_ptr<CriticalSectionWrapper> decoder_crit_sect_;
+  const bool decode_on_arrival_;
+  const scoped_ptr<DecodedFrameBuffer> decoded_frames_;
+  // The next packet DecodeAhead() may decode has timestamp
+  // |decode_ahead_timestamp_| and payload type |decode_ahead_payload_type_|.
+  // Only valid when |decode_ahead_synced_| is true.
+  bool decode_ahead_synced_ GUARDED_BY(decoder_crit_sect_);
+  uint32_t decode_ahead_timestamp_ GUARDED_BY(decoder_crit_sect_);
+  uint8_t decode_ahead_payload_type_ GUARDED_BY(decoder_crit_sect_);
+  std::vector<uint8_t> decode_ahead_payload_ GUARDED_BY(decoder_crit_sect_);
+  std::vector<int16_t> decode_ahead_audio_ GUARDED_BY(decoder_crit_sect_);
+
   // These values are used by NACK module to estimate time-to-play of
   // a missing packet. Occasionally, NetEq might decide to decode more
   // than one packet. Therefore, these values store sequence number and
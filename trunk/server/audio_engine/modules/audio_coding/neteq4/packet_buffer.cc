@@ -173,6 +173,18 @@ const AudioPacketHeader* PacketBuffer::NextRtpHeader() const {
   return const_cast<const AudioPacketHeader*>(&(buffer_.front()->header));
 }
 
+const Packet* PacketBuffer::FindPacket(uint32_t timestamp) const {
+  for (PacketList::const_iterator it = buffer_.begin(); it != buffer_.end();
+       ++it) {
+    const Packet* packet = *it;
+    if (packet->header.timestamp == timestamp && packet->primary &&
+        !packet->sync_packet) {
+      return packet;
+    }
+  }
+  return NULL;
+}
+
 Packet* PacketBuffer::GetNextPacket(int* discard_count) {
   if (Empty()) {
     // Buffer is empty.
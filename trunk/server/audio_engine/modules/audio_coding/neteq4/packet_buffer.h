@@ -84,6 +84,11 @@ class PacketBuffer {
   // buffer. Returns NULL if the buffer is empty.
   virtual const AudioPacketHeader* NextRtpHeader() const;
 
+  // Returns a (constant) pointer to the primary, non-sync packet with
+  // timestamp |timestamp|, or NULL if no such packet is in the buffer. The
+  // packet stays in the buffer and is owned by it.
+  virtual const Packet* FindPacket(uint32_t timestamp) const;
+
   // Extracts the first packet in the buffer and returns a pointer to it.
   // Returns NULL if the buffer is empty. The caller is responsible for deleting
   // the packet.
@@ -30,6 +30,7 @@ StatisticsCalculator::StatisticsCalculator()
       len_waiting_times_(0),
       next_waiting_time_index_(0) {
   memset(waiting_times_, 0, kLenWaitingTimes * sizeof(waiting_times_[0]));
+  memset(&operation_stats_, 0, sizeof(operation_stats_));
 }
 
 void StatisticsCalculator::Reset() {
@@ -76,6 +77,44 @@ void StatisticsCalculator::PacketsDiscarded(int num_packets) {
   discarded_packets_ += num_packets;
 }
 
+void StatisticsCalculator::OperationPerformed(Operations operation) {
+  switch (operation) {
+    case kNormal:
+      ++operation_stats_.normal;
+      break;
+    case kMerge:
+      ++operation_stats_.merge;
+      break;
+    case kExpand:
+      ++operation_stats_.expand;
+      break;
+    case kAccelerate:
+      ++operation_stats_.accelerate;
+      break;
+    case kPreemptiveExpand:
+      ++operation_stats_.preemptive_expand;
+      break;
+    case kRfc3389Cng:
+    case kRfc3389CngNoPacket:
+    case kCodecInternalCng:
+      ++operation_stats_.comfort_noise;
+      break;
+    case kIdle:
+      ++operation_stats_.idle;
+      break;
+    default:
+      ++operation_stats_.other;
+      break;
+  }
+}
+
+void StatisticsCalculator::GetOperationStatistics(
+    NetEqOperationStatistics* stats) {
+  assert(stats);
+  *stats = operation_stats_;
+  memset(&operation_stats_, 0, sizeof(operation_stats_));
+}
+
 void StatisticsCalculator::LostSamples(int num_samples) {
   lost_timestamps_ += num_samples;
 }
@@ -13,6 +13,7 @@
 
 #include <vector>
 
+#include "audio_engine/modules/audio_coding/neteq4/defines.h"
 #include "audio_engine/modules/audio_coding/neteq4/interface/neteq.h"
 #include "audio_engine/system_wrappers/interface/constructor_magic.h"
 #include "audio_engine/include/typedefs.h"
@@ -67,6 +68,12 @@ class StatisticsCalculator {
   // of |fs_hz|.
   void IncreaseCounter(int num_samples, int fs_hz);
 
+  // Reports that one output block was produced through |operation|.
+  void OperationPerformed(Operations operation);
+
+  // Writes the operation counters to |stats| and resets them.
+  void GetOperationStatistics(NetEqOperationStatistics* stats);
+
   // Stores new packet waiting time in waiting time statistics.
   void StoreWaitingTime(int waiting_time_ms);
 
@@ -101,6 +108,7 @@ class StatisticsCalculator {
   int waiting_times_[kLenWaitingTimes];  // Used as a circular buffer.
   int len_waiting_times_;
   int next_waiting_time_index_;
+  NetEqOperationStatistics operation_stats_;
 
   DISALLOW_COPY_AND_ASSIGN(StatisticsCalculator);
 };
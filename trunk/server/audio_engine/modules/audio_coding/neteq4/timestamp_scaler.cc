@@ -49,7 +49,29 @@ uint32_t TimestampScaler::ToInternal(uint32_t external_timestamp,
       break;
     }
     case kDecoderOpus:
-    case kDecoderOpus_2ch:
+    case kDecoderOpus_2ch: {
+      // RTP timestamps run on 48 kHz. Scale them to the rate the decoder is
+      // set to produce, which is 32 kHz by default.
+      switch (info->fs_hz) {
+        case 8000:
+          numerator_ = 1;
+          denominator_ = 6;
+          break;
+        case 16000:
+          numerator_ = 1;
+          denominator_ = 3;
+          break;
+        case 48000:
+          numerator_ = 1;
+          denominator_ = 1;
+          break;
+        default:
+          numerator_ = 2;
+          denominator_ = 3;
+          break;
+      }
+      break;
+    }
     case kDecoderISACfb:
     case kDecoderCNGswb48kHz: {
       // Use timestamp scaling with factor 2/3 (32 kHz sample rate, but RTP
@@ -0,0 +1,308 @@
+/*
+ *  Copyright (c) 2014 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Reports the heap memory per voice engine channel used by the receive side
+// of its audio coding module when only one payload type is received. Each
+// channel's ACM is created by an AudioCodingModuleFactory and driven with the
+// calls voe::Channel makes: Channel::Init() initializes the ACM, registers the
+// PCMU send codec and the CN, RED and telephone-event receive codecs, and
+// Channel::OnInitializeDecoder() registers the received codec on its first
+// packet. Three configurations are compared:
+//  - acm1: the legacy ACM and NetEq, used by the voice engine before;
+//  - acm2: the ACM the voice engine uses now, where NetEq creates decoders on
+//    the first packet of their payload type;
+//  - acm2_idle_timeout: acm2 with AoECodec::SetDecoderIdleTimeout(), which
+//    also deletes decoders once the stream has been silent for the timeout.
+// Heap usage is sampled after Channel::Init(), after receiving packets, and
+// after the stream has been silent for longer than the idle timeout.
+//
+// Usage: decoder_memory_report [--channels=N] [--codec=pcmu|opus]
+//                              [--idle_timeout_ms=N] [--output=FILE]
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#include <malloc.h>
+#elif defined(WEBRTC_MAC)
+#include <malloc/malloc.h>
+#else
+#include <malloc.h>
+#endif
+
+#include "audio_engine/include/common_types.h"
+#include "audio_engine/modules/audio_coding/codecs/g711/include/g711_interface.h"
+#include "audio_engine/modules/audio_coding/codecs/opus/interface/opus_interface.h"
+#include "audio_engine/modules/audio_coding/main/interface/audio_coding_module.h"
+#include "audio_engine/modules/interface/module_common_types.h"
+#include "audio_engine/include/typedefs.h"
+
+namespace VoIP {
+namespace test {
+namespace {
+
+const int kDefaultChannels = 5000;
+const int kDefaultIdleTimeoutMs = 1000;
+const int kStreamMs = 500;
+const int kFrameSizeMs = 20;
+const int kOutputBlockSizeMs = 10;
+const int kMaxPayloadBytes = 1500;
+
+enum Mode {
+  kAcm1,
+  kAcm2,
+  kAcm2IdleTimeout
+};
+
+struct ModeResult {
+  int64_t registered_bytes;
+  int64_t streaming_bytes;
+  int64_t idle_bytes;
+};
+
+// Returns the number of bytes currently allocated on the heap.
+int64_t HeapBytesInUse() {
+#if defined(_WIN32)
+  _HEAPINFO info;
+  info._pentry = NULL;
+  int64_t total = 0;
+  while (_heapwalk(&info) == _HEAPOK) {
+    if (info._useflag == _USEDENTRY)
+      total += info._size;
+  }
+  return total;
+#elif defined(WEBRTC_MAC)
+  malloc_statistics_t stats;
+  malloc_zone_statistics(NULL, &stats);
+  return static_cast<int64_t>(stats.size_in_use);
+#elif defined(__GLIBC__) && \
+    (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+  struct mallinfo2 info = mallinfo2();
+  return static_cast<int64_t>(info.uordblks + info.hblkhd);
+#else
+  // The counters wrap at 4 GB.
+  struct mallinfo info = mallinfo();
+  return static_cast<int64_t>(static_cast<unsigned int>(info.uordblks)) +
+      static_cast<unsigned int>(info.hblkhd);
+#endif
+}
+
+// Encodes one frame of a tone with the codec of |payload_type|.
+bool EncodeFrame(uint8_t payload_type, int sample_rate_hz,
+                 std::vector<uint8_t>* payload) {
+  const int frame_samples = kFrameSizeMs * sample_rate_hz / 1000;
+  std::vector<int16_t> audio(frame_samples);
+  for (int n = 0; n < frame_samples; ++n)
+    audio[n] = static_cast<int16_t>(((n * 440 * 2 / (sample_rate_hz / 100)) %
+                                     200 - 100) * 40);
+  uint8_t encoded[kMaxPayloadBytes];
+  int length = -1;
+  if (payload_type == 120) {
+    OpusEncInst* opus = NULL;
+    if (WebRtcOpus_EncoderCreate(&opus, 1) != 0)
+      return false;
+    length = WebRtcOpus_Encode(opus, &audio[0], frame_samples,
+                               kMaxPayloadBytes, encoded);
+    WebRtcOpus_EncoderFree(opus);
+  } else {
+    length = WebRtcG711_EncodeU(NULL, &audio[0], frame_samples,
+                                reinterpret_cast<int16_t*>(encoded));
+  }
+  if (length <= 0)
+    return false;
+  payload->assign(encoded, encoded + length);
+  return true;
+}
+
+// Channel::Init(), as far as the ACM is concerned. Like there, failing to
+// register a codec is not fatal.
+bool InitChannel(AudioCodingModule* acm) {
+  if (acm->InitializeReceiver() == -1 || acm->InitializeSender() == -1)
+    return false;
+  CodecInst codec;
+  for (int idx = 0; idx < AudioCodingModule::NumberOfCodecs(); ++idx) {
+    if (acm->Codec(idx, &codec) == -1)
+      return false;
+    if (!STR_CASE_CMP(codec.plname, "PCMU") && codec.channels == 1)
+      acm->RegisterSendCodec(codec);
+    if (!STR_CASE_CMP(codec.plname, "telephone-event"))
+      acm->RegisterReceiveCodec(codec);
+    if (!STR_CASE_CMP(codec.plname, "CN")) {
+      acm->RegisterSendCodec(codec);
+      acm->RegisterReceiveCodec(codec);
+    }
+    if (!STR_CASE_CMP(codec.plname, "RED"))
+      acm->RegisterReceiveCodec(codec);
+  }
+  return true;
+}
+
+bool RunMode(Mode mode, int num_channels, const CodecInst& receive_codec,
+             int idle_timeout_ms, ModeResult* result) {
+  std::vector<uint8_t> payload;
+  if (!EncodeFrame(static_cast<uint8_t>(receive_codec.pltype),
+                   receive_codec.plfreq, &payload))
+    return false;
+
+  const AudioCodingModuleFactory acm1_factory;
+  const NewAudioCodingModuleFactory acm2_factory;
+  const AudioCodingModuleFactory& factory =
+      mode == kAcm1 ? acm1_factory : acm2_factory;
+
+  const int64_t baseline = HeapBytesInUse();
+  std::vector<AudioCodingModule*> acms(num_channels);
+  bool ok = true;
+  for (int ch = 0; ch < num_channels && ok; ++ch) {
+    acms[ch] = factory.Create(ch);
+    ok = InitChannel(acms[ch]);
+    if (ok && mode == kAcm2IdleTimeout)
+      ok = acms[ch]->SetDecoderIdleTimeout(idle_timeout_ms) == 0;
+  }
+  result->registered_bytes = HeapBytesInUse() - baseline;
+
+  // Receive |kStreamMs| of packets on every channel, then nothing for longer
+  // than the idle timeout. Audio is played out at the codec rate, which is
+  // the rate the mixer asks for when all participants use that codec.
+  const int timestamps_per_frame = kFrameSizeMs * receive_codec.plfreq / 1000;
+  const int silent_ms = idle_timeout_ms + kStreamMs;
+  AudioFrame audio_frame;
+  for (int t = 0; t < kStreamMs + silent_ms && ok;
+       t += kOutputBlockSizeMs) {
+    if (t == kStreamMs)
+      result->streaming_bytes = HeapBytesInUse() - baseline;
+    for (int ch = 0; ch < num_channels && ok; ++ch) {
+      if (t == 0) {
+        // Channel::OnInitializeDecoder().
+        ok = acms[ch]->RegisterReceiveCodec(receive_codec) == 0;
+      }
+      if (ok && t < kStreamMs && t % kFrameSizeMs == 0) {
+        WebRtcRTPHeader header;
+        memset(&header, 0, sizeof(header));
+        header.header.payloadType =
+            static_cast<uint8_t>(receive_codec.pltype);
+        header.header.sequenceNumber = static_cast<uint16_t>(t / kFrameSizeMs);
+        header.header.timestamp = t / kFrameSizeMs * timestamps_per_frame;
+        header.header.ssrc = ch;
+        header.type.Audio.channel = 1;
+        ok = acms[ch]->IncomingPacket(&payload[0],
+                                      static_cast<int32_t>(payload.size()),
+                                      header) == 0;
+      }
+      ok = ok && acms[ch]->PlayoutData10Ms(receive_codec.plfreq,
+                                           &audio_frame) == 0;
+    }
+  }
+  result->idle_bytes = HeapBytesInUse() - baseline;
+
+  for (int ch = 0; ch < num_channels; ++ch)
+    delete acms[ch];
+  return ok;
+}
+
+void PrintMode(FILE* out, const char* name, int num_channels,
+               const ModeResult& result, bool last) {
+  fprintf(out, "    {\n");
+  fprintf(out, "      \"mode\": \"%s\",\n", name);
+  fprintf(out, "      \"registered_bytes_per_channel\": %lld,\n",
+          static_cast<long long>(result.registered_bytes / num_channels));
+  fprintf(out, "      \"streaming_bytes_per_channel\": %lld,\n",
+          static_cast<long long>(result.streaming_bytes / num_channels));
+  fprintf(out, "      \"idle_bytes_per_channel\": %lld,\n",
+          static_cast<long long>(result.idle_bytes / num_channels));
+  fprintf(out, "      \"streaming_total_kb\": %lld,\n",
+          static_cast<long long>(result.streaming_bytes / 1024));
+  fprintf(out, "      \"idle_total_kb\": %lld\n",
+          static_cast<long long>(result.idle_bytes / 1024));
+  fprintf(out, "    }%s\n", last ? "" : ",");
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace VoIP
+
+int main(int argc, char* argv[]) {
+  int num_channels = VoIP::test::kDefaultChannels;
+  int idle_timeout_ms = VoIP::test::kDefaultIdleTimeoutMs;
+  std::string codec = "opus";
+  std::string output_file;
+  for (int i = 1; i < argc; ++i) {
+    if (strncmp(argv[i], "--channels=", 11) == 0) {
+      num_channels = atoi(argv[i] + 11);
+    } else if (strncmp(argv[i], "--codec=", 8) == 0) {
+      codec = argv[i] + 8;
+    } else if (strncmp(argv[i], "--idle_timeout_ms=", 18) == 0) {
+      idle_timeout_ms = atoi(argv[i] + 18);
+    } else if (strncmp(argv[i], "--output=", 9) == 0) {
+      output_file = argv[i] + 9;
+    } else {
+      fprintf(stderr, "Usage: %s [--channels=N] [--codec=pcmu|opus] "
+              "[--idle_timeout_ms=N] [--output=FILE]\n", argv[0]);
+      return 1;
+    }
+  }
+  if (num_channels <= 0 || idle_timeout_ms <= 0) {
+    fprintf(stderr, "Channels and idle timeout must be positive.\n");
+    return 1;
+  }
+  // The receive codec as Channel::OnInitializeDecoder() registers it.
+  VoIP::CodecInst receive_codec;
+  if ((codec != "pcmu" && codec != "opus") ||
+      VoIP::AudioCodingModule::Codec(codec == "pcmu" ? "PCMU" : "opus",
+                                     &receive_codec,
+                                     codec == "pcmu" ? 8000 : 48000,
+                                     codec == "pcmu" ? 1 : 2) < 0) {
+    fprintf(stderr, "Codec %s not supported.\n", codec.c_str());
+    return 1;
+  }
+
+  // The modes run in order of decreasing expected usage, so that their
+  // numbers do not benefit from heap fragments left by a previous run.
+  const VoIP::test::Mode kModes[] = {
+    VoIP::test::kAcm1, VoIP::test::kAcm2, VoIP::test::kAcm2IdleTimeout
+  };
+  const char* kModeNames[] = { "acm1", "acm2", "acm2_idle_timeout" };
+  const int kNumModes = sizeof(kModes) / sizeof(kModes[0]);
+  VoIP::test::ModeResult results[kNumModes];
+  for (int i = 0; i < kNumModes; ++i) {
+    if (!VoIP::test::RunMode(kModes[i], num_channels, receive_codec,
+                             idle_timeout_ms, &results[i])) {
+      fprintf(stderr, "Mode %s failed.\n", kModeNames[i]);
+      return 1;
+    }
+  }
+
+  FILE* out = stdout;
+  if (!output_file.empty()) {
+    out = fopen(output_file.c_str(), "w");
+    if (!out) {
+      fprintf(stderr, "Cannot open %s.\n", output_file.c_str());
+      return 1;
+    }
+  }
+  fprintf(out, "{\n");
+  fprintf(out, "  \"channels\": %d,\n", num_channels);
+  fprintf(out, "  \"codec\": \"%s\",\n", codec.c_str());
+  fprintf(out, "  \"idle_timeout_ms\": %d,\n", idle_timeout_ms);
+  fprintf(out, "  \"modes\": [\n");
+  for (int i = 0; i < kNumModes; ++i) {
+    VoIP::test::PrintMode(out, kModeNames[i], num_channels, results[i],
+                          i == kNumModes - 1);
+  }
+  fprintf(out, "  ]\n");
+  fprintf(out, "}\n");
+  if (out != stdout)
+    fclose(out);
+  return 0;
+}
@@ -0,0 +1,591 @@
+/*
+ *  Copyright (c) 2014 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Runs NetEq over a matrix of codecs, loss patterns, jitter profiles and
+// channel counts, and writes the per-scenario cost of InsertPacket() and
+// GetAudio(), the operation mix and the peak memory as JSON. Where
+// NetEqPerformanceTest::Run() times a single PCM16B stream, this covers the
+// codecs and network conditions seen in production, so that the output can be
+// compared release over release.
+//
+// Usage: neteq_benchmark [--runtime_ms=N] [--codec=NAME] [--output=FILE]
+//                        [--decode_on_arrival]
+//
+// With --decode_on_arrival, packets are decoded by InsertPacket() (see
+// NetEq::Config::decode_on_arrival), which shows up as decoding time moving
+// from GetAudio() to InsertPacket() for the stateless codecs (pcmu).
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include "audio_engine/modules/audio_coding/codecs/g711/include/g711_interface.h"
+#include "audio_engine/modules/audio_coding/codecs/g722/include/g722_interface.h"
+#include "audio_engine/modules/audio_coding/codecs/isac/main/interface/isac.h"
+#include "audio_engine/modules/audio_coding/codecs/opus/interface/opus_interface.h"
+#include "audio_engine/modules/audio_coding/neteq4/interface/neteq.h"
+#include "audio_engine/modules/audio_coding/neteq4/tools/rtp_generator.h"
+#include "audio_engine/modules/interface/module_common_types.h"
+#include "audio_engine/system_wrappers/interface/scoped_ptr.h"
+#include "audio_engine/system_wrappers/interface/tick_util.h"
+#include "audio_engine/include/typedefs.h"
+
+namespace VoIP {
+namespace test {
+namespace {
+
+const int kOutputBlockSizeMs = 10;
+const int kMaxChannels = 2;
+const int kMaxSamplesPerMs = 48000 / 1000;
+const int kOutDataLen = kOutputBlockSizeMs * kMaxSamplesPerMs * kMaxChannels;
+const int kMaxPayloadBytes = 1500;
+const int kDefaultRuntimeMs = 10000;
+
+struct CodecConfig {
+  const char* name;
+  NetEqDecoder mono_decoder;
+  NetEqDecoder stereo_decoder;
+  bool stereo_supported;
+  uint8_t payload_type;
+  int sample_rate_hz;  // Sample rate of the encoder input.
+  int rtp_clock_hz;  // RTP timestamp rate; differs from the above for G.722.
+  int frame_size_ms;
+};
+
+const CodecConfig kCodecs[] = {
+  { "pcmu", kDecoderPCMu, kDecoderPCMu_2ch, true, 0, 8000, 8000, 20 },
+  { "g722", kDecoderG722, kDecoderG722_2ch, true, 9, 16000, 8000, 20 },
+  { "isac", kDecoderISAC, kDecoderISAC, false, 103, 16000, 16000, 30 },
+  { "opus", kDecoderOpus, kDecoderOpus_2ch, true, 120, 48000, 48000, 20 }
+};
+
+enum LossPattern {
+  kLossNone,
+  kLossRandom,  // Independent losses, 5 %.
+  kLossBursty   // Gilbert-Elliott model, about 6 % in bursts of ~3 packets.
+};
+
+enum JitterProfile {
+  kJitterNone,
+  kJitterModerate,  // Uniform 0-40 ms delay; packets may be reordered.
+  kJitterSpiky      // Low jitter with occasional 150-400 ms delay spikes.
+};
+
+const char* LossPatternName(LossPattern loss) {
+  switch (loss) {
+    case kLossNone: return "none";
+    case kLossRandom: return "random";
+    case kLossBursty: return "bursty";
+  }
+  return "unknown";
+}
+
+const char* JitterProfileName(JitterProfile jitter) {
+  switch (jitter) {
+    case kJitterNone: return "none";
+    case kJitterModerate: return "moderate";
+    case kJitterSpiky: return "spiky";
+  }
+  return "unknown";
+}
+
+struct Scenario {
+  const CodecConfig* codec;
+  int channels;
+  LossPattern loss;
+  JitterProfile jitter;
+};
+
+struct ScenarioResult {
+  int packets_sent;
+  int packets_lost;
+  int64_t insert_calls;
+  int64_t insert_us;
+  int64_t get_audio_calls;
+  int64_t get_audio_us;
+  int64_t get_audio_max_us;
+  NetEqOperationStatistics operations;
+  NetEqNetworkStatistics network;
+  int64_t peak_memory_kb;
+  int64_t peak_memory_growth_kb;
+};
+
+struct Packet {
+  WebRtcRTPHeader header;
+  size_t offset;  // Position of the payload in the payload buffer.
+  size_t length;
+  int32_t arrival_time_ms;
+};
+
+bool EarlierArrival(const Packet& a, const Packet& b) {
+  return a.arrival_time_ms < b.arrival_time_ms;
+}
+
+// Deterministic pseudo-random numbers, so that every run of the benchmark
+// feeds NetEq with exactly the same packet stream.
+class Random {
+ public:
+  explicit Random(uint32_t seed) : state_(seed) {}
+
+  // Returns a value uniformly distributed in [0, 1).
+  double Rand() {
+    state_ = state_ * 1664525u + 1013904223u;
+    return (state_ >> 8) * (1.0 / 16777216.0);
+  }
+
+ private:
+  uint32_t state_;
+};
+
+// Returns the peak resident memory of the process in kB.
+int64_t PeakMemoryKb() {
+#if defined(_WIN32)
+  PROCESS_MEMORY_COUNTERS counters;
+  if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    return -1;
+  return static_cast<int64_t>(counters.PeakWorkingSetSize / 1024);
+#else
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+    return -1;
+#if defined(WEBRTC_MAC)
+  return static_cast<int64_t>(usage.ru_maxrss / 1024);  // Bytes on Mac.
+#else
+  return static_cast<int64_t>(usage.ru_maxrss);
+#endif
+#endif
+}
+
+// Generates |samples_per_channel| samples of speech-like audio: talk spurts of
+// a harmonic signal with gliding pitch, separated by low-level noise. The
+// right channel, if any, is a delayed and attenuated copy of the left.
+void GenerateAudio(int sample_rate_hz, int channels,
+                   size_t samples_per_channel, std::vector<int16_t>* audio) {
+  const double kPi = 3.14159265358979323846;
+  const size_t kSpurtSamples = 3 * sample_rate_hz / 2;  // 1.5 s.
+  const size_t kPauseSamples = sample_rate_hz / 2;  // 0.5 s.
+  const size_t kStereoDelay = sample_rate_hz / 1000;  // 1 ms.
+  Random random(4711);
+  std::vector<int16_t> mono(samples_per_channel);
+  double phase = 0.0;
+  for (size_t n = 0; n < samples_per_channel; ++n) {
+    const size_t pos = n % (kSpurtSamples + kPauseSamples);
+    double value = 300.0 * (random.Rand() - 0.5);
+    if (pos < kSpurtSamples) {
+      const double t = static_cast<double>(pos) / sample_rate_hz;
+      const double pitch_hz = 140.0 + 40.0 * sin(2.0 * kPi * 0.7 * t);
+      const double envelope = sin(kPi * pos / kSpurtSamples);
+      phase += 2.0 * kPi * pitch_hz / sample_rate_hz;
+      for (int harmonic = 1; harmonic <= 8; ++harmonic) {
+        if (harmonic * pitch_hz >= sample_rate_hz / 2)
+          break;
+        value += envelope * 6000.0 / harmonic * sin(harmonic * phase);
+      }
+    }
+    mono[n] = static_cast<int16_t>(std::max(-32768.0, std::min(32767.0,
+                                                                value)));
+  }
+  audio->resize(samples_per_channel * channels);
+  for (size_t n = 0; n < samples_per_channel; ++n) {
+    (*audio)[n * channels] = mono[n];
+    if (channels == 2) {
+      (*audio)[n * channels + 1] = (n < kStereoDelay) ? 0 :
+          static_cast<int16_t>(mono[n - kStereoDelay] / 2);
+    }
+  }
+}
+
+// Encodes |audio| (interleaved) into |payloads| with one entry per packet in
+// |packets|. Returns false on encoder failure.
+bool EncodeAudio(const Scenario& scenario, const std::vector<int16_t>& audio,
+                 std::vector<uint8_t>* payloads,
+                 std::vector<Packet>* packets) {
+  const CodecConfig& codec = *scenario.codec;
+  const int channels = scenario.channels;
+  const int frame_samples = codec.frame_size_ms * codec.sample_rate_hz / 1000;
+  const int block_10ms = codec.sample_rate_hz / 100;
+  const size_t num_frames = audio.size() / channels / frame_samples;
+
+  OpusEncInst* opus = NULL;
+  G722EncInst* g722[kMaxChannels] = { NULL, NULL };
+  ISACStruct* isac = NULL;
+  bool ok = true;
+  if (strcmp(codec.name, "opus") == 0) {
+    ok = WebRtcOpus_EncoderCreate(&opus, channels) == 0 &&
+        WebRtcOpus_SetBitRate(opus, 32000 * channels) == 0;
+  } else if (strcmp(codec.name, "g722") == 0) {
+    for (int c = 0; c < channels && ok; ++c) {
+      ok = WebRtcG722_CreateEncoder(&g722[c]) == 0 &&
+          WebRtcG722_EncoderInit(g722[c]) == 0;
+    }
+  } else if (strcmp(codec.name, "isac") == 0) {
+    // Instantaneous mode, so that the rate does not depend on feedback.
+    ok = WebRtcIsac_Create(&isac) == 0 &&
+        WebRtcIsac_EncoderInit(isac, 1) == 0 &&
+        WebRtcIsac_Control(isac, 32000, codec.frame_size_ms) == 0;
+  }
+
+  RtpGenerator rtp_gen(codec.rtp_clock_hz / 1000);
+  std::vector<int16_t> channel_audio(frame_samples * kMaxChannels);
+  uint8_t encoded[kMaxPayloadBytes];
+  uint8_t encoded_left[kMaxPayloadBytes];
+  uint8_t encoded_right[kMaxPayloadBytes];
+  payloads->clear();
+  packets->clear();
+  for (size_t frame = 0; frame < num_frames && ok; ++frame) {
+    const int16_t* in = &audio[frame * frame_samples * channels];
+    int length = -1;
+    if (opus) {
+      length = WebRtcOpus_Encode(opus, const_cast<int16_t*>(in),
+                                 frame_samples, kMaxPayloadBytes, encoded);
+    } else if (g722[0]) {
+      // Each channel is encoded separately, then the 4-bit codewords of left
+      // and right are interleaved the way ACMG722 does it.
+      for (int c = 0; c < channels; ++c) {
+        for (int n = 0; n < frame_samples; ++n)
+          channel_audio[c * frame_samples + n] = in[n * channels + c];
+      }
+      uint8_t* left = (channels == 2) ? encoded_left : encoded;
+      length = WebRtcG722_Encode(g722[0], &channel_audio[0], frame_samples,
+                                 reinterpret_cast<int16_t*>(left));
+      if (channels == 2) {
+        length += WebRtcG722_Encode(g722[1], &channel_audio[frame_samples],
+                                    frame_samples,
+                                    reinterpret_cast<int16_t*>(encoded_right));
+        for (int i = 0, j = 0; i < length; i += 2, ++j) {
+          encoded[i] = (left[j] & 0xF0) + (encoded_right[j] >> 4);
+          encoded[i + 1] = ((left[j] & 0x0F) << 4) + (encoded_right[j] & 0x0F);
+        }
+      }
+    } else if (isac) {
+      // The encoder buffers 10 ms blocks and returns 0 until a frame is done.
+      length = 0;
+      for (int n = 0; n < frame_samples && length == 0; n += block_10ms) {
+        length = WebRtcIsac_Encode(isac, &in[n],
+                                   reinterpret_cast<int16_t*>(encoded));
+      }
+    } else {
+      length = WebRtcG711_EncodeU(NULL, const_cast<int16_t*>(in),
+                                  frame_samples * channels,
+                                  reinterpret_cast<int16_t*>(encoded));
+    }
+    if (length <= 0) {
+      ok = false;
+      break;
+    }
+    Packet packet;
+    packet.arrival_time_ms = static_cast<int32_t>(rtp_gen.GetRtpHeader(
+        codec.payload_type, frame_samples * codec.rtp_clock_hz /
+        codec.sample_rate_hz, &packet.header));
+    packet.offset = payloads->size();
+    packet.length = length;
+    packets->push_back(packet);
+    payloads->insert(payloads->end(), encoded, encoded + length);
+  }
+
+  if (opus)
+    WebRtcOpus_EncoderFree(opus);
+  for (int c = 0; c < kMaxChannels; ++c) {
+    if (g722[c])
+      WebRtcG722_FreeEncoder(g722[c]);
+  }
+  if (isac)
+    WebRtcIsac_Free(isac);
+  return ok;
+}
+
+// Drops packets according to |loss| and sets the arrival time of the rest
+// according to |jitter|. On return, |packets| is sorted in arrival order.
+// Returns the number of dropped packets.
+int ApplyNetworkModel(LossPattern loss, JitterProfile jitter,
+                      std::vector<Packet>* packets) {
+  Random random(17 + 31 * loss + 7 * jitter);
+  std::vector<Packet> received;
+  received.reserve(packets->size());
+  bool bad_state = false;
+  int32_t last_arrival_ms = 0;
+  for (size_t i = 0; i < packets->size(); ++i) {
+    Packet packet = (*packets)[i];
+    bool lost = false;
+    if (loss == kLossRandom) {
+      lost = random.Rand() < 0.05;
+    } else if (loss == kLossBursty) {
+      bad_state = bad_state ? (random.Rand() >= 0.3) : (random.Rand() < 0.02);
+      lost = bad_state;
+    }
+    if (jitter == kJitterModerate) {
+      packet.arrival_time_ms += static_cast<int32_t>(40 * random.Rand());
+    } else if (jitter == kJitterSpiky) {
+      packet.arrival_time_ms += static_cast<int32_t>(10 * random.Rand());
+      if (random.Rand() < 0.01)
+        packet.arrival_time_ms += 150 + static_cast<int32_t>(
+            250 * random.Rand());
+      // Packets queued behind a spike are delivered back-to-back.
+      packet.arrival_time_ms = std::max(packet.arrival_time_ms,
+                                        last_arrival_ms);
+      last_arrival_ms = packet.arrival_time_ms;
+    }
+    if (!lost)
+      received.push_back(packet);
+  }
+  std::stable_sort(received.begin(), received.end(), EarlierArrival);
+  const int num_lost = static_cast<int>(packets->size() - received.size());
+  packets->swap(received);
+  return num_lost;
+}
+
+bool RunScenario(const Scenario& scenario, int runtime_ms,
+                 bool decode_on_arrival, ScenarioResult* result) {
+  const CodecConfig& codec = *scenario.codec;
+  memset(result, 0, sizeof(*result));
+
+  // Everything that is not NetEq's own work is done before the timed loop.
+  std::vector<int16_t> audio;
+  GenerateAudio(codec.sample_rate_hz, scenario.channels,
+                static_cast<size_t>(runtime_ms) * codec.sample_rate_hz / 1000,
+                &audio);
+  std::vector<uint8_t> payloads;
+  std::vector<Packet> packets;
+  if (!EncodeAudio(scenario, audio, &payloads, &packets)) {
+    fprintf(stderr, "Failed to encode %s.\n", codec.name);
+    return false;
+  }
+  result->packets_sent = static_cast<int>(packets.size());
+  result->packets_lost = ApplyNetworkModel(scenario.loss, scenario.jitter,
+                                           &packets);
+
+  const int64_t memory_before_kb = PeakMemoryKb();
+  NetEq::Config config;
+  config.sample_rate_hz = codec.sample_rate_hz;
+  config.decode_on_arrival = decode_on_arrival;
+  scoped_ptr<NetEq> neteq(NetEq::Create(config));
+  const NetEqDecoder decoder = (scenario.channels == 2) ?
+      codec.stereo_decoder : codec.mono_decoder;
+  if (neteq->RegisterPayloadType(decoder, codec.payload_type) != NetEq::kOK) {
+    fprintf(stderr, "Failed to register %s.\n", codec.name);
+    return false;
+  }
+
+  TickInterval insert_time;
+  TickInterval get_audio_time;
+  TickInterval get_audio_max;
+  int16_t out_data[kOutDataLen];
+  size_t next_packet = 0;
+  for (int32_t time_now_ms = 0; time_now_ms < runtime_ms;
+       time_now_ms += kOutputBlockSizeMs) {
+    while (next_packet < packets.size() &&
+           packets[next_packet].arrival_time_ms <= time_now_ms) {
+      const Packet& packet = packets[next_packet++];
+      const uint32_t receive_timestamp = static_cast<uint32_t>(
+          packet.arrival_time_ms) * (codec.rtp_clock_hz / 1000);
+      TickTime start = TickTime::Now();
+      int error = neteq->InsertPacket(packet.header, &payloads[packet.offset],
+                                      static_cast<int>(packet.length),
+                                      receive_timestamp);
+      insert_time += TickTime::Now() - start;
+      ++result->insert_calls;
+      if (error != NetEq::kOK && neteq->LastError() != NetEq::kOversizePacket)
+        return false;
+    }
+
+    int num_channels;
+    int samples_per_channel;
+    TickTime start = TickTime::Now();
+    int error = neteq->GetAudio(kOutDataLen, out_data, &samples_per_channel,
+                                &num_channels, NULL);
+    TickInterval elapsed = TickTime::Now() - start;
+    get_audio_time += elapsed;
+    if (elapsed > get_audio_max)
+      get_audio_max = elapsed;
+    ++result->get_audio_calls;
+    if (error != NetEq::kOK)
+      return false;
+  }
+
+  result->insert_us = insert_time.Microseconds();
+  result->get_audio_us = get_audio_time.Microseconds();
+  result->get_audio_max_us = get_audio_max.Microseconds();
+  neteq->OperationStatistics(&result->operations);
+  neteq->NetworkStatistics(&result->network);
+  result->peak_memory_kb = PeakMemoryKb();
+  result->peak_memory_growth_kb = result->peak_memory_kb - memory_before_kb;
+  return true;
+}
+
+// Returns true if NetEq was built with a decoder for |codec|. Not all codecs
+// are enabled in every build configuration.
+bool CodecAvailable(const CodecConfig& codec) {
+  scoped_ptr<NetEq> neteq(NetEq::Create(NetEq::Config()));
+  return neteq->RegisterPayloadType(codec.mono_decoder,
+                                    codec.payload_type) == NetEq::kOK;
+}
+
+double NsPerCall(int64_t total_us, int64_t calls) {
+  return calls > 0 ? 1000.0 * total_us / calls : 0.0;
+}
+
+double Q14ToFraction(uint16_t value) {
+  return value / 16384.0;
+}
+
+void WriteResult(FILE* out, const Scenario& scenario, bool success,
+                 const ScenarioResult& result, bool last) {
+  const NetEqOperationStatistics& ops = result.operations;
+  fprintf(out, "    {\n");
+  fprintf(out, "      \"success\": %s,\n", success ? "true" : "false");
+  fprintf(out, "      \"codec\": \"%s\",\n", scenario.codec->name);
+  fprintf(out, "      \"sample_rate_hz\": %d,\n",
+          scenario.codec->sample_rate_hz);
+  fprintf(out, "      \"channels\": %d,\n", scenario.channels);
+  fprintf(out, "      \"loss\": \"%s\",\n", LossPatternName(scenario.loss));
+  fprintf(out, "      \"jitter\": \"%s\",\n",
+          JitterProfileName(scenario.jitter));
+  fprintf(out, "      \"packets_sent\": %d,\n", result.packets_sent);
+  fprintf(out, "      \"packets_lost\": %d,\n", result.packets_lost);
+  fprintf(out, "      \"insert_packet_calls\": %lld,\n",
+          static_cast<long long>(result.insert_calls));
+  fprintf(out, "      \"insert_packet_ns\": %.1f,\n",
+          NsPerCall(result.insert_us, result.insert_calls));
+  fprintf(out, "      \"get_audio_calls\": %lld,\n",
+          static_cast<long long>(result.get_audio_calls));
+  fprintf(out, "      \"get_audio_ns\": %.1f,\n",
+          NsPerCall(result.get_audio_us, result.get_audio_calls));
+  fprintf(out, "      \"get_audio_max_ns\": %lld,\n",
+          static_cast<long long>(result.get_audio_max_us * 1000));
+  fprintf(out, "      \"operations\": {\"normal\": %u, \"merge\": %u, "
+          "\"expand\": %u, \"accelerate\": %u, \"preemptive_expand\": %u, "
+          "\"comfort_noise\": %u, \"other\": %u, \"idle\": %u},\n",
+          ops.normal, ops.merge, ops.expand, ops.accelerate,
+          ops.preemptive_expand, ops.comfort_noise, ops.other, ops.idle);
+  fprintf(out, "      \"expand_rate\": %.4f,\n",
+          Q14ToFraction(result.network.expand_rate));
+  fprintf(out, "      \"accelerate_rate\": %.4f,\n",
+          Q14ToFraction(result.network.accelerate_rate));
+  fprintf(out, "      \"preemptive_rate\": %.4f,\n",
+          Q14ToFraction(result.network.preemptive_rate));
+  fprintf(out, "      \"peak_memory_kb\": %lld,\n",
+          static_cast<long long>(result.peak_memory_kb));
+  fprintf(out, "      \"peak_memory_growth_kb\": %lld\n",
+          static_cast<long long>(result.peak_memory_growth_kb));
+  fprintf(out, "    }%s\n", last ? "" : ",");
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace VoIP
+
+int main(int argc, char* argv[]) {
+  using VoIP::test::Scenario;
+  using VoIP::test::ScenarioResult;
+  using VoIP::test::kCodecs;
+
+  int runtime_ms = VoIP::test::kDefaultRuntimeMs;
+  std::string codec_filter;
+  std::string output_file;
+  bool decode_on_arrival = false;
+  for (int i = 1; i < argc; ++i) {
+    if (strncmp(argv[i], "--runtime_ms=", 13) == 0) {
+      runtime_ms = atoi(argv[i] + 13);
+    } else if (strncmp(argv[i], "--codec=", 8) == 0) {
+      codec_filter = argv[i] + 8;
+    } else if (strncmp(argv[i], "--output=", 9) == 0) {
+      output_file = argv[i] + 9;
+    } else if (strcmp(argv[i], "--decode_on_arrival") == 0) {
+      decode_on_arrival = true;
+    } else {
+      fprintf(stderr, "Usage: %s [--runtime_ms=N] [--codec=NAME] "
+              "[--output=FILE] [--decode_on_arrival]\n", argv[0]);
+      return 1;
+    }
+  }
+  if (runtime_ms <= 0) {
+    fprintf(stderr, "Invalid runtime: %d ms.\n", runtime_ms);
+    return 1;
+  }
+
+  const VoIP::test::LossPattern kLossPatterns[] = {
+    VoIP::test::kLossNone, VoIP::test::kLossRandom, VoIP::test::kLossBursty
+  };
+  const VoIP::test::JitterProfile kJitterProfiles[] = {
+    VoIP::test::kJitterNone, VoIP::test::kJitterModerate,
+    VoIP::test::kJitterSpiky
+  };
+  std::vector<Scenario> scenarios;
+  for (size_t c = 0; c < sizeof(kCodecs) / sizeof(kCodecs[0]); ++c) {
+    if (!codec_filter.empty() && codec_filter != kCodecs[c].name)
+      continue;
+    if (!VoIP::test::CodecAvailable(kCodecs[c])) {
+      fprintf(stderr, "Skipping %s, not supported by this build.\n",
+              kCodecs[c].name);
+      continue;
+    }
+    for (int channels = 1; channels <= VoIP::test::kMaxChannels; ++channels) {
+      if (channels == 2 && !kCodecs[c].stereo_supported)
+        continue;
+      for (size_t l = 0; l < sizeof(kLossPatterns) / sizeof(kLossPatterns[0]);
+           ++l) {
+        for (size_t j = 0;
+             j < sizeof(kJitterProfiles) / sizeof(kJitterProfiles[0]); ++j) {
+          Scenario scenario = { &kCodecs[c], channels, kLossPatterns[l],
+                                kJitterProfiles[j] };
+          scenarios.push_back(scenario);
+        }
+      }
+    }
+  }
+  if (scenarios.empty()) {
+    fprintf(stderr, "No scenarios to run.\n");
+    return 1;
+  }
+
+  FILE* out = stdout;
+  if (!output_file.empty()) {
+    out = fopen(output_file.c_str(), "w");
+    if (!out) {
+      fprintf(stderr, "Cannot open %s.\n", output_file.c_str());
+      return 1;
+    }
+  }
+  fprintf(out, "{\n  \"runtime_ms\": %d,\n  \"decode_on_arrival\": %s,\n"
+          "  \"scenarios\": [\n", runtime_ms,
+          decode_on_arrival ? "true" : "false");
+  int failures = 0;
+  for (size_t i = 0; i < scenarios.size(); ++i) {
+    ScenarioResult result;
+    const bool success = VoIP::test::RunScenario(scenarios[i], runtime_ms,
+                                                 decode_on_arrival, &result);
+    if (!success) {
+      fprintf(stderr, "Scenario %s/%d ch/%s loss/%s jitter failed.\n",
+              scenarios[i].codec->name, scenarios[i].channels,
+              VoIP::test::LossPatternName(scenarios[i].loss),
+              VoIP::test::JitterProfileName(scenarios[i].jitter));
+      ++failures;
+    }
+    VoIP::test::WriteResult(out, scenarios[i], success, result,
+                            i + 1 == scenarios.size());
+  }
+  fprintf(out, "  ]\n}\n");
+  if (out != stdout)
+    fclose(out);
+  return failures == 0 ? 0 : 1;
+}
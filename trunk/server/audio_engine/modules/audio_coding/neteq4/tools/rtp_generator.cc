@@ -12,7 +12,7 @@
 
 #include "audio_engine/modules/audio_coding/neteq4/tools/rtp_generator.h"
 
-namespace webrtc {
+namespace VoIP {
 namespace test {
 
 uint32_t RtpGenerator::GetRtpHeader(uint8_t payload_type,
@@ -45,4 +45,4 @@ void RtpGenerator::set_drift_factor(double factor) {
 }
 
 }  // namespace test
-}  // namespace webrtc
+}  // namespace VoIP
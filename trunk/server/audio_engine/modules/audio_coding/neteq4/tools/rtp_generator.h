@@ -13,9 +13,9 @@
 
 #include "audio_engine/modules/interface/module_common_types.h"
 #include "audio_engine/system_wrappers/interface/constructor_magic.h"
-#include "audio_engine/typedefs.h"
+#include "audio_engine/include/typedefs.h"
 
-namespace webrtc {
+namespace VoIP {
 namespace test {
 
 // Class for generating RTP headers.
@@ -53,5 +53,5 @@ class RtpGenerator {
 };
 
 }  // namespace test
-}  // namespace webrtc
+}  // namespace VoIP
 #endif  // WEBRTC_MODULES_AUDIO_CODING_NETEQ4_TOOLS_RTP_GENERATOR_H_
@@ -77,6 +77,11 @@ public:
     // downsampling of audio contributing to the mixed audio.
     virtual int32_t SetMinimumMixingFrequency(Frequency freq) = 0;
 
+    // Limit the number of participants that are mixed non-anonymously in
+    // each iteration. Must be between 1 and kMaximumAmountOfMixedParticipants,
+    // which is also the default.
+    virtual int32_t SetMaximumMixedParticipants(int maxParticipants) = 0;
+
 protected:
     AudioConferenceMixer() {}
 };
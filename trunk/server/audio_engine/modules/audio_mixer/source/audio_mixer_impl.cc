@@ -131,6 +131,7 @@ AudioConferenceMixerImpl::AudioConferenceMixerImpl(int id)
       _participantList(),
       _additionalParticipantList(),
       _numMixedParticipants(0),
+      _maxMixedParticipants(kMaximumAmountOfMixedParticipants),
       _timeStamp(0),
       _timeScheduler(kProcessPeriodicityInMs),
       _mixedAudioLevel(),
@@ -207,8 +208,7 @@ int32_t AudioConferenceMixerImpl::TimeUntilNextProcess() {
 }
 
 int32_t AudioConferenceMixerImpl::Process() {
-    size_t remainingParticipantsAllowedToMix =
-        kMaximumAmountOfMixedParticipants;
+    size_t remainingParticipantsAllowedToMix = 0;
     {
         CriticalSectionScoped cs(_crit.get());
         assert(_processCalls == 0);
@@ -271,6 +271,7 @@ int32_t AudioConferenceMixerImpl::Process() {
             }
         }
 
+        remainingParticipantsAllowedToMix = _maxMixedParticipants;
         UpdateToMix(&mixList, &rampOutList, &mixedParticipantsMap,
                     remainingParticipantsAllowedToMix);
 
@@ -489,12 +490,7 @@ int32_t AudioConferenceMixerImpl::SetMixabilityStatus(
             return -1;
         }
 
-        size_t numMixedNonAnonymous = _participantList.size();
-        if (numMixedNonAnonymous > kMaximumAmountOfMixedParticipants) {
-            numMixedNonAnonymous = kMaximumAmountOfMixedParticipants;
-        }
-        numMixedParticipants =
-            numMixedNonAnonymous + _additionalParticipantList.size();
+        numMixedParticipants = NumMixedParticipants();
     }
     // A MixerParticipant was added or removed. Make sure the scratch
     // buffer is updated if necessary.
@@ -577,6 +573,32 @@ int32_t AudioConferenceMixerImpl::SetMinimumMixingFrequency(
     }
 }
 
+int32_t AudioConferenceMixerImpl::SetMaximumMixedParticipants(
+    int maxParticipants) {
+    if(maxParticipants < 1 ||
+       maxParticipants > kMaximumAmountOfMixedParticipants) {
+        WEBRTC_TRACE(kTraceError, kTraceAudioMixerServer, _id,
+                     "SetMaximumMixedParticipants incorrect number: %i",
+                     maxParticipants);
+        return -1;
+    }
+    size_t numMixedParticipants;
+    {
+        CriticalSectionScoped cs(_cbCrit.get());
+        _maxMixedParticipants = static_cast<size_t>(maxParticipants);
+        numMixedParticipants = NumMixedParticipants();
+    }
+    CriticalSectionScoped cs(_crit.get());
+    _numMixedParticipants = numMixedParticipants;
+    return 0;
+}
+
+size_t AudioConferenceMixerImpl::NumMixedParticipants() const {
+    const size_t numMixedNonAnonymous =
+        std::min(_participantList.size(), _maxMixedParticipants);
+    return numMixedNonAnonymous + _additionalParticipantList.size();
+}
+
 // Check all AudioFrames that are to be mixed. The highest sampling frequency
 // found is the lowest that can be used without losing information.
 int32_t AudioConferenceMixerImpl::GetLowestMixingFrequency() {
@@ -728,6 +750,17 @@ void AudioConferenceMixerImpl::UpdateToMix(
                 assert(mixParticipantList->size() <=
                        kMaximumAmountOfMixedParticipants);
             }
+        } else if(audioFrame->speech_type_ == AudioFrame::kIdle) {
+            // Silence from NetEq's idle fast path, which is only produced
+            // when the participant's receiver enabled it. Not worth mixing.
+            if(wasMixed) {
+                RampOut(*audioFrame);
+                rampOutList->push_back(audioFrame);
+                assert(rampOutList->size() <=
+                       kMaximumAmountOfMixedParticipants);
+            } else {
+                _audioFramePool->PushMemory(audioFrame);
+            }
         } else {
             if(wasMixed) {
                 ParticipantFramePair* pair = new ParticipantFramePair;
@@ -81,6 +81,7 @@ public:
     virtual int32_t MixabilityStatus(MixerParticipant& participant,
                                      bool& mixable);
     virtual int32_t SetMinimumMixingFrequency(Frequency freq);
+    virtual int32_t SetMaximumMixedParticipants(int maxParticipants);
     virtual int32_t SetAnonymousMixabilityStatus(
         MixerParticipant& participant, const bool mixable);
     virtual int32_t AnonymousMixabilityStatus(
@@ -114,6 +115,10 @@ private:
     // Return the AudioFrames that should be mixed anonymously.
     void GetAdditionalAudio(AudioFrameList* additionalFramesList);
 
+    // Return the number of participants that will be mixed with the current
+    // participant lists.
+    size_t NumMixedParticipants() const;
+
     // Update the MixHistory of all MixerParticipants. mixedParticipantsList
     // should contain a map of MixerParticipants that have been mixed.
     void UpdateMixedStatus(
@@ -192,6 +197,8 @@ private:
     MixerParticipantList _additionalParticipantList;
 
     size_t _numMixedParticipants;
+    // Upper limit for the number of non-anonymous participants to mix.
+    size_t _maxMixedParticipants;
 
     uint32_t _timeStamp;
 
@@ -0,0 +1,342 @@
+/*
+ *  Copyright (c) 2014 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+/*
+ * The core AEC algorithm, AVX2/FMA version of speed-critical functions.
+ * The vector loops handle eight bins at once; PART_LEN1 is 65, so the last
+ * bin is done in scalar code.
+ */
+
+#include "audio_engine/modules/audio_processing/aec/aec_core.h"
+
+#include <immintrin.h>
+#include <math.h>
+#include <string.h>  // memset
+
+#include "audio_engine/modules/audio_processing/aec/aec_core_internal.h"
+#include "audio_engine/modules/audio_processing/aec/aec_rdft.h"
+
+__inline static float MulRe(float aRe, float aIm, float bRe, float bIm) {
+  return aRe * bRe - aIm * bIm;
+}
+
+__inline static float MulIm(float aRe, float aIm, float bRe, float bIm) {
+  return aRe * bIm + aIm * bRe;
+}
+
+static void FilterFarAVX2(AecCore* aec, float yf[2][PART_LEN1]) {
+  const int num_partitions = aec->num_partitions;
+  int i, j;
+
+  // Unlike the SSE2 version, the partitions are the inner loop, so that the
+  // eight output bins stay in registers. The partitions are still summed in
+  // the same order.
+  for (j = 0; j + 7 < PART_LEN1; j += 8) {
+    __m256 yf_re = _mm256_loadu_ps(&yf[0][j]);
+    __m256 yf_im = _mm256_loadu_ps(&yf[1][j]);
+    for (i = 0; i < num_partitions; i++) {
+      int xPos = (i + aec->xfBufBlockPos) * PART_LEN1;
+      const int pos = i * PART_LEN1;
+      // Check for wrap
+      if (i + aec->xfBufBlockPos >= num_partitions) {
+        xPos -= num_partitions * (PART_LEN1);
+      }
+      {
+        const __m256 xfBuf_re = _mm256_loadu_ps(&aec->xfBuf[0][xPos + j]);
+        const __m256 xfBuf_im = _mm256_loadu_ps(&aec->xfBuf[1][xPos + j]);
+        const __m256 wfBuf_re = _mm256_loadu_ps(&aec->wfBuf[0][pos + j]);
+        const __m256 wfBuf_im = _mm256_loadu_ps(&aec->wfBuf[1][pos + j]);
+        const __m256 e = _mm256_fmsub_ps(xfBuf_re, wfBuf_re,
+                                         _mm256_mul_ps(xfBuf_im, wfBuf_im));
+        const __m256 f = _mm256_fmadd_ps(xfBuf_re, wfBuf_im,
+                                         _mm256_mul_ps(xfBuf_im, wfBuf_re));
+        yf_re = _mm256_add_ps(yf_re, e);
+        yf_im = _mm256_add_ps(yf_im, f);
+      }
+    }
+    _mm256_storeu_ps(&yf[0][j], yf_re);
+    _mm256_storeu_ps(&yf[1][j], yf_im);
+  }
+  // scalar code for the remaining items.
+  for (; j < PART_LEN1; j++) {
+    for (i = 0; i < num_partitions; i++) {
+      int xPos = (i + aec->xfBufBlockPos) * PART_LEN1;
+      const int pos = i * PART_LEN1;
+      if (i + aec->xfBufBlockPos >= num_partitions) {
+        xPos -= num_partitions * (PART_LEN1);
+      }
+      yf[0][j] += MulRe(aec->xfBuf[0][xPos + j],
+                        aec->xfBuf[1][xPos + j],
+                        aec->wfBuf[0][pos + j],
+                        aec->wfBuf[1][pos + j]);
+      yf[1][j] += MulIm(aec->xfBuf[0][xPos + j],
+                        aec->xfBuf[1][xPos + j],
+                        aec->wfBuf[0][pos + j],
+                        aec->wfBuf[1][pos + j]);
+    }
+  }
+}
+
+static void ScaleErrorSignalAVX2(AecCore* aec, float ef[2][PART_LEN1]) {
+  const float mu = aec->extended_filter_enabled ? kExtendedMu : aec->normal_mu;
+  const float error_threshold = aec->extended_filter_enabled
+                                    ? kExtendedErrorThreshold
+                                    : aec->normal_error_threshold;
+  const __m256 k1e_10f = _mm256_set1_ps(1e-10f);
+  const __m256 kMu = _mm256_set1_ps(mu);
+  const __m256 kThresh = _mm256_set1_ps(error_threshold);
+  int i;
+
+  // vectorized code (eight at once)
+  for (i = 0; i + 7 < PART_LEN1; i += 8) {
+    const __m256 xPowPlus =
+        _mm256_add_ps(_mm256_loadu_ps(&aec->xPow[i]), k1e_10f);
+    __m256 ef_re = _mm256_div_ps(_mm256_loadu_ps(&ef[0][i]), xPowPlus);
+    __m256 ef_im = _mm256_div_ps(_mm256_loadu_ps(&ef[1][i]), xPowPlus);
+    const __m256 absEf = _mm256_sqrt_ps(
+        _mm256_fmadd_ps(ef_re, ef_re, _mm256_mul_ps(ef_im, ef_im)));
+    const __m256 bigger = _mm256_cmp_ps(absEf, kThresh, _CMP_GT_OQ);
+    const __m256 absEfInv =
+        _mm256_div_ps(kThresh, _mm256_add_ps(absEf, k1e_10f));
+    ef_re = _mm256_blendv_ps(ef_re, _mm256_mul_ps(ef_re, absEfInv), bigger);
+    ef_im = _mm256_blendv_ps(ef_im, _mm256_mul_ps(ef_im, absEfInv), bigger);
+    _mm256_storeu_ps(&ef[0][i], _mm256_mul_ps(ef_re, kMu));
+    _mm256_storeu_ps(&ef[1][i], _mm256_mul_ps(ef_im, kMu));
+  }
+  // scalar code for the remaining items.
+  for (; i < (PART_LEN1); i++) {
+    float abs_ef;
+    ef[0][i] /= (aec->xPow[i] + 1e-10f);
+    ef[1][i] /= (aec->xPow[i] + 1e-10f);
+    abs_ef = sqrtf(ef[0][i] * ef[0][i] + ef[1][i] * ef[1][i]);
+
+    if (abs_ef > error_threshold) {
+      abs_ef = error_threshold / (abs_ef + 1e-10f);
+      ef[0][i] *= abs_ef;
+      ef[1][i] *= abs_ef;
+    }
+
+    // Stepsize factor
+    ef[0][i] *= mu;
+    ef[1][i] *= mu;
+  }
+}
+
+static void FilterAdaptationAVX2(AecCore* aec,
+                                 float* fft,
+                                 float ef[2][PART_LEN1]) {
+  const __m256 scale = _mm256_set1_ps(2.0f / PART_LEN2);
+  const int num_partitions = aec->num_partitions;
+  int i, j;
+  for (i = 0; i < num_partitions; i++) {
+    int xPos = (i + aec->xfBufBlockPos) * (PART_LEN1);
+    int pos = i * PART_LEN1;
+    // Check for wrap
+    if (i + aec->xfBufBlockPos >= num_partitions) {
+      xPos -= num_partitions * PART_LEN1;
+    }
+
+    // Process the whole array...
+    for (j = 0; j < PART_LEN; j += 8) {
+      const __m256 xfBuf_re = _mm256_loadu_ps(&aec->xfBuf[0][xPos + j]);
+      const __m256 xfBuf_im = _mm256_loadu_ps(&aec->xfBuf[1][xPos + j]);
+      const __m256 ef_re = _mm256_loadu_ps(&ef[0][j]);
+      const __m256 ef_im = _mm256_loadu_ps(&ef[1][j]);
+      // Calculate the product of conjugate(xfBuf) by ef.
+      //   re(conjugate(a) * b) = aRe * bRe + aIm * bIm
+      //   im(conjugate(a) * b)=  aRe * bIm - aIm * bRe
+      const __m256 e =
+          _mm256_fmadd_ps(xfBuf_re, ef_re, _mm256_mul_ps(xfBuf_im, ef_im));
+      const __m256 f =
+          _mm256_fmsub_ps(xfBuf_re, ef_im, _mm256_mul_ps(xfBuf_im, ef_re));
+      // Interleave real and imaginary parts. The unpacks work within each
+      // 128-bit lane, so the lanes are put back in order afterwards.
+      const __m256 g = _mm256_unpacklo_ps(e, f);
+      const __m256 h = _mm256_unpackhi_ps(e, f);
+      _mm256_storeu_ps(&fft[2 * j + 0], _mm256_permute2f128_ps(g, h, 0x20));
+      _mm256_storeu_ps(&fft[2 * j + 8], _mm256_permute2f128_ps(g, h, 0x31));
+    }
+    // ... and fixup the first imaginary entry.
+    fft[1] = MulRe(aec->xfBuf[0][xPos + PART_LEN],
+                   -aec->xfBuf[1][xPos + PART_LEN],
+                   ef[0][PART_LEN],
+                   ef[1][PART_LEN]);
+
+    aec_rdft_inverse_128(fft);
+    memset(fft + PART_LEN, 0, sizeof(float) * PART_LEN);
+
+    // fft scaling
+    for (j = 0; j < PART_LEN; j += 8) {
+      _mm256_storeu_ps(&fft[j], _mm256_mul_ps(_mm256_loadu_ps(&fft[j]), scale));
+    }
+    aec_rdft_forward_128(fft);
+
+    {
+      float wt1 = aec->wfBuf[1][pos];
+      aec->wfBuf[0][pos + PART_LEN] += fft[1];
+      for (j = 0; j < PART_LEN; j += 8) {
+        const __m256 fft0 = _mm256_loadu_ps(&fft[2 * j + 0]);
+        const __m256 fft8 = _mm256_loadu_ps(&fft[2 * j + 8]);
+        // {0, 2, 8, 10 | 4, 6, 12, 14} -> {0, 2, 4, ..., 14}, likewise odd.
+        const __m256 fft_re = _mm256_castpd_ps(_mm256_permute4x64_pd(
+            _mm256_castps_pd(
+                _mm256_shuffle_ps(fft0, fft8, _MM_SHUFFLE(2, 0, 2, 0))),
+            _MM_SHUFFLE(3, 1, 2, 0)));
+        const __m256 fft_im = _mm256_castpd_ps(_mm256_permute4x64_pd(
+            _mm256_castps_pd(
+                _mm256_shuffle_ps(fft0, fft8, _MM_SHUFFLE(3, 1, 3, 1))),
+            _MM_SHUFFLE(3, 1, 2, 0)));
+        const __m256 wtBuf_re = _mm256_add_ps(
+            _mm256_loadu_ps(&aec->wfBuf[0][pos + j]), fft_re);
+        const __m256 wtBuf_im = _mm256_add_ps(
+            _mm256_loadu_ps(&aec->wfBuf[1][pos + j]), fft_im);
+        _mm256_storeu_ps(&aec->wfBuf[0][pos + j], wtBuf_re);
+        _mm256_storeu_ps(&aec->wfBuf[1][pos + j], wtBuf_im);
+      }
+      aec->wfBuf[1][pos] = wt1;
+    }
+  }
+}
+
+// Eight-wide version of mm_pow_ps() in aec_core_sse2.c: a^b = exp2(b *
+// log2(a)), with the same polynomial approximations evaluated with FMA.
+static __m256 mm256_pow_ps(__m256 a, __m256 b) {
+  __m256 log2_a, b_log2_a, a_exp_b;
+
+  // Calculate log2(x), x = a, as log2(y) + n with x = y * 2^n and y in
+  // [1.0, 2.0). See mm_pow_ps() for how n is extracted from the exponent.
+  {
+    const __m256 float_exponent_mask =
+        _mm256_castsi256_ps(_mm256_set1_epi32(0x7F800000));
+    const __m256 eight_biased_exponent =
+        _mm256_castsi256_ps(_mm256_set1_epi32(0x43800000));
+    const __m256 implicit_leading_one =
+        _mm256_castsi256_ps(_mm256_set1_epi32(0x43BF8000));
+    const __m256 mantissa_mask =
+        _mm256_castsi256_ps(_mm256_set1_epi32(0x007FFFFF));
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const int shift_exponent_into_top_mantissa = 8;
+    const __m256 two_n = _mm256_and_ps(a, float_exponent_mask);
+    const __m256 n_1 = _mm256_castsi256_ps(_mm256_srli_epi32(
+        _mm256_castps_si256(two_n), shift_exponent_into_top_mantissa));
+    const __m256 n = _mm256_sub_ps(_mm256_or_ps(n_1, eight_biased_exponent),
+                                   implicit_leading_one);
+
+    // Compute y.
+    const __m256 y = _mm256_or_ps(_mm256_and_ps(a, mantissa_mask), one);
+
+    // Approximate log2(y) ~= (y - 1) * pol5(y).
+    //    pol5(y) = C5 * y^5 + C4 * y^4 + C3 * y^3 + C2 * y^2 + C1 * y + C0
+    __m256 pol5_y = _mm256_fmadd_ps(y, _mm256_set1_ps(-3.4436006e-2f),
+                                    _mm256_set1_ps(3.1821337e-1f));
+    pol5_y = _mm256_fmadd_ps(pol5_y, y, _mm256_set1_ps(-1.2315303f));
+    pol5_y = _mm256_fmadd_ps(pol5_y, y, _mm256_set1_ps(2.5988452f));
+    pol5_y = _mm256_fmadd_ps(pol5_y, y, _mm256_set1_ps(-3.3241990f));
+    pol5_y = _mm256_fmadd_ps(pol5_y, y, _mm256_set1_ps(3.1157899f));
+
+    // Combine parts.
+    log2_a = _mm256_fmadd_ps(_mm256_sub_ps(y, one), pol5_y, n);
+  }
+
+  // b * log2(a)
+  b_log2_a = _mm256_mul_ps(b, log2_a);
+
+  // Calculate exp2(x), x = b * log2(a), as 2^n * 2^y with n the integer
+  // nearest to x - 0.5 and y in the [0.5, 1.5) range.
+  {
+    // To avoid over/underflow, we reduce the range of input to ]-127, 129].
+    const __m256 x_max = _mm256_max_ps(
+        _mm256_min_ps(b_log2_a, _mm256_set1_ps(129.f)),
+        _mm256_set1_ps(-126.99999f));
+    // Compute n.
+    const __m256i x_minus_half_floor =
+        _mm256_cvtps_epi32(_mm256_sub_ps(x_max, _mm256_set1_ps(0.5f)));
+    // Compute 2^n.
+    const int float_exponent_shift = 23;
+    const __m256 two_n = _mm256_castsi256_ps(_mm256_slli_epi32(
+        _mm256_add_epi32(x_minus_half_floor, _mm256_set1_epi32(127)),
+        float_exponent_shift));
+    // Compute y.
+    const __m256 y =
+        _mm256_sub_ps(x_max, _mm256_cvtepi32_ps(x_minus_half_floor));
+    // Approximate 2^y ~= C2 * y^2 + C1 * y + C0.
+    __m256 exp2_y = _mm256_fmadd_ps(y, _mm256_set1_ps(3.3718944e-1f),
+                                    _mm256_set1_ps(6.5763628e-1f));
+    exp2_y = _mm256_fmadd_ps(exp2_y, y, _mm256_set1_ps(1.0017247f));
+
+    // Combine parts.
+    a_exp_b = _mm256_mul_ps(exp2_y, two_n);
+  }
+  return a_exp_b;
+}
+
+extern const float WebRtcAec_weightCurve[65];
+extern const float WebRtcAec_overDriveCurve[65];
+
+static void OverdriveAndSuppressAVX2(AecCore* aec,
+                                     float hNl[PART_LEN1],
+                                     const float hNlFb,
+                                     float efw[2][PART_LEN1]) {
+  const __m256 vec_hNlFb = _mm256_set1_ps(hNlFb);
+  const __m256 vec_one = _mm256_set1_ps(1.0f);
+  const __m256 vec_minus_one = _mm256_set1_ps(-1.0f);
+  const __m256 vec_overDriveSm = _mm256_set1_ps(aec->overDriveSm);
+  int i;
+  // vectorized code (eight at once)
+  for (i = 0; i + 7 < PART_LEN1; i += 8) {
+    // Weight subbands
+    __m256 vec_hNl = _mm256_loadu_ps(&hNl[i]);
+    const __m256 vec_weightCurve = _mm256_loadu_ps(&WebRtcAec_weightCurve[i]);
+    const __m256 bigger = _mm256_cmp_ps(vec_hNl, vec_hNlFb, _CMP_GT_OQ);
+    const __m256 vec_weighted = _mm256_fmadd_ps(
+        vec_weightCurve, vec_hNlFb,
+        _mm256_mul_ps(_mm256_sub_ps(vec_one, vec_weightCurve), vec_hNl));
+    vec_hNl = _mm256_blendv_ps(vec_hNl, vec_weighted, bigger);
+
+    vec_hNl = mm256_pow_ps(
+        vec_hNl,
+        _mm256_mul_ps(vec_overDriveSm,
+                      _mm256_loadu_ps(&WebRtcAec_overDriveCurve[i])));
+    _mm256_storeu_ps(&hNl[i], vec_hNl);
+
+    // Suppress error signal. The imaginary part also has its sign flipped,
+    // see OverdriveAndSuppress() in aec_core.c.
+    _mm256_storeu_ps(&efw[0][i],
+                     _mm256_mul_ps(_mm256_loadu_ps(&efw[0][i]), vec_hNl));
+    _mm256_storeu_ps(
+        &efw[1][i],
+        _mm256_mul_ps(_mm256_mul_ps(_mm256_loadu_ps(&efw[1][i]), vec_hNl),
+                      vec_minus_one));
+  }
+  // scalar code for the remaining items.
+  for (; i < PART_LEN1; i++) {
+    // Weight subbands
+    if (hNl[i] > hNlFb) {
+      hNl[i] = WebRtcAec_weightCurve[i] * hNlFb +
+               (1 - WebRtcAec_weightCurve[i]) * hNl[i];
+    }
+    hNl[i] = powf(hNl[i], aec->overDriveSm * WebRtcAec_overDriveCurve[i]);
+
+    // Suppress error signal
+    efw[0][i] *= hNl[i];
+    efw[1][i] *= hNl[i];
+
+    // Ooura fft returns incorrect sign on imaginary component. It matters
+    // here because we are making an additive change with comfort noise.
+    efw[1][i] *= -1;
+  }
+}
+
+void WebRtcAec_InitAec_AVX2(void) {
+  WebRtcAec_FilterFar = FilterFarAVX2;
+  WebRtcAec_ScaleErrorSignal = ScaleErrorSignalAVX2;
+  WebRtcAec_FilterAdaptation = FilterAdaptationAVX2;
+  WebRtcAec_OverdriveAndSuppress = OverdriveAndSuppressAVX2;
+}
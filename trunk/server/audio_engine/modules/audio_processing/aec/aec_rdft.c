@@ -31,7 +31,7 @@ float rdft_w[64];
 // constants used by the C path.
 float rdft_wk3ri_first[32];
 float rdft_wk3ri_second[32];
-// constants used by SSE2 but initialized in C path.
+// constants used by SSE2 and AVX2 but initialized in C path.
 ALIGN16_BEG float ALIGN16_END rdft_wk1r[32];
 ALIGN16_BEG float ALIGN16_END rdft_wk2r[32];
 ALIGN16_BEG float ALIGN16_END rdft_wk3r[32];
@@ -656,6 +656,9 @@ void aec_rdft_init(void) {
   if (WebRtc_GetCPUInfo(kSSE2)) {
     aec_rdft_init_sse2();
   }
+  if (WebRtc_GetCPUInfo(kAVX2)) {
+    aec_rdft_init_avx2();
+  }
 #endif
 #if defined(MIPS_FPU_LE)
   aec_rdft_init_mips();
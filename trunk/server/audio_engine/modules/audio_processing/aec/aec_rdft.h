@@ -32,7 +32,7 @@ extern float rdft_w[64];
 // constants used by the C path.
 extern float rdft_wk3ri_first[32];
 extern float rdft_wk3ri_second[32];
-// constants used by SSE2 but initialized in C path.
+// constants used by SSE2 and AVX2 but initialized in C path.
 extern ALIGN16_BEG float ALIGN16_END rdft_wk1r[32];
 extern ALIGN16_BEG float ALIGN16_END rdft_wk2r[32];
 extern ALIGN16_BEG float ALIGN16_END rdft_wk3r[32];
@@ -54,6 +54,7 @@ extern rft_sub_128_t bitrv2_128;
 // entry points
 void aec_rdft_init(void);
 void aec_rdft_init_sse2(void);
+void aec_rdft_init_avx2(void);
 void aec_rdft_forward_128(float* a);
 void aec_rdft_inverse_128(float* a);
 
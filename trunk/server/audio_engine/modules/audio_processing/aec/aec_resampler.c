@@ -26,7 +26,7 @@ enum {
 };
 
 typedef struct {
-  short buffer[kResamplerBufferSize];
+  float buffer[kResamplerBufferSize];
   float position;
 
   int deviceSampleRateHz;
@@ -71,14 +71,14 @@ int WebRtcAec_FreeResampler(void* resampInst) {
 }
 
 void WebRtcAec_ResampleLinear(void* resampInst,
-                              const short* inspeech,
+                              const float* inspeech,
                               int size,
                               float skew,
-                              short* outspeech,
+                              float* outspeech,
                               int* size_out) {
   resampler_t* obj = (resampler_t*)resampInst;
 
-  short* y;
+  float* y;
   float be, tnew, interp;
   int tn, mm;
 
@@ -91,7 +91,7 @@ void WebRtcAec_ResampleLinear(void* resampInst,
   // Add new frame data in lookahead
   memcpy(&obj->buffer[FRAME_LEN + kResamplingDelay],
          inspeech,
-         size * sizeof(short));
+         size * sizeof(float));
 
   // Sample rate ratio
   be = 1 + skew;
@@ -114,7 +114,7 @@ void WebRtcAec_ResampleLinear(void* resampInst,
       interp = -32768;
     }
 
-    outspeech[mm] = (short)interp;
+    outspeech[mm] = interp;
     mm++;
 
     tnew = be * mm + obj->position;
@@ -127,7 +127,7 @@ void WebRtcAec_ResampleLinear(void* resampInst,
   // Shift buffer
   memmove(obj->buffer,
           &obj->buffer[size],
-          (kResamplerBufferSize - size) * sizeof(short));
+          (kResamplerBufferSize - size) * sizeof(float));
 }
 
 int WebRtcAec_GetSkew(void* resampInst, int rawSkew, float* skewEst) {
@@ -104,18 +104,18 @@ int webrtc_aec_instance_count = 0;
 static void EstBufDelayNormal(aecpc_t* aecInst);
 static void EstBufDelayExtended(aecpc_t* aecInst);
 static int ProcessNormal(aecpc_t* self,
-                         const int16_t* near,
-                         const int16_t* near_high,
-                         int16_t* out,
-                         int16_t* out_high,
+                         const float* near,
+                         const float* near_high,
+                         float* out,
+                         float* out_high,
                          int16_t num_samples,
                          int16_t reported_delay_ms,
                          int32_t skew);
 static void ProcessExtended(aecpc_t* self,
-                            const int16_t* near,
-                            const int16_t* near_high,
-                            int16_t* out,
-                            int16_t* out_high,
+                            const float* near,
+                            const float* near_high,
+                            float* out,
+                            float* out_high,
                             int16_t num_samples,
                             int16_t reported_delay_ms,
                             int32_t skew);
@@ -296,15 +296,40 @@ int32_t WebRtcAec_Init(void* aecInst, int32_t sampFreq, int32_t scSampFreq) {
 int32_t WebRtcAec_BufferFarend(void* aecInst,
                                const int16_t* farend,
                                int16_t nrOfSamples) {
+  float farend_float[2 * FRAME_LEN];
+  int i = 0;
+
+  if (farend == NULL) {
+    ((aecpc_t*)aecInst)->lastError = AEC_NULL_POINTER_ERROR;
+    return -1;
+  }
+  if (nrOfSamples < 0 || nrOfSamples > 2 * FRAME_LEN) {
+    ((aecpc_t*)aecInst)->lastError = AEC_BAD_PARAMETER_ERROR;
+    return -1;
+  }
+
+  for (i = 0; i < nrOfSamples; i++) {
+    farend_float[i] = (float)farend[i];
+  }
+  return WebRtcAec_BufferFarendFloat(aecInst, farend_float, nrOfSamples);
+}
+
+int32_t WebRtcAec_BufferFarendFloat(void* aecInst,
+                                    const float* farend,
+                                    int16_t nrOfSamples) {
   aecpc_t* aecpc = aecInst;
   int32_t retVal = 0;
   int newNrOfSamples = (int)nrOfSamples;
-  short newFarend[MAX_RESAMP_LEN];
-  const int16_t* farend_ptr = farend;
-  float tmp_farend[MAX_RESAMP_LEN];
-  const float* farend_float = tmp_farend;
+  float newFarend[MAX_RESAMP_LEN];
+  const float* farend_ptr = farend;
+  float tmp_farend[PART_LEN2];
+  float* farend_float = tmp_farend;
   float skew;
+#ifdef WEBRTC_AEC_DEBUG_DUMP
+  int16_t farend_s16[MAX_RESAMP_LEN];
+  int16_t* farend_s16_ptr = NULL;
   int i = 0;
+#endif
 
   if (farend == NULL) {
     aecpc->lastError = AEC_NULL_POINTER_ERROR;
@@ -332,7 +357,7 @@ int32_t WebRtcAec_BufferFarend(void* aecInst,
                              skew,
                              newFarend,
                              &newNrOfSamples);
-    farend_ptr = (const int16_t*)newFarend;
+    farend_ptr = newFarend;
   }
 
   aecpc->farend_started = 1;
@@ -340,14 +365,15 @@ int32_t WebRtcAec_BufferFarend(void* aecInst,
                            WebRtcAec_system_delay(aecpc->aec) + newNrOfSamples);
 
 #ifdef WEBRTC_AEC_DEBUG_DUMP
-  WebRtc_WriteBuffer(
-      aecpc->far_pre_buf_s16, farend_ptr, (size_t)newNrOfSamples);
-#endif
-  // Cast to float and write the time-domain data to |far_pre_buf|.
   for (i = 0; i < newNrOfSamples; i++) {
-    tmp_farend[i] = (float)farend_ptr[i];
+    farend_s16[i] = (int16_t)WEBRTC_SPL_SAT(
+        WEBRTC_SPL_WORD16_MAX, farend_ptr[i], WEBRTC_SPL_WORD16_MIN);
   }
-  WebRtc_WriteBuffer(aecpc->far_pre_buf, farend_float, (size_t)newNrOfSamples);
+  WebRtc_WriteBuffer(
+      aecpc->far_pre_buf_s16, farend_s16, (size_t)newNrOfSamples);
+#endif
+  // Write the time-domain data to |far_pre_buf|.
+  WebRtc_WriteBuffer(aecpc->far_pre_buf, farend_ptr, (size_t)newNrOfSamples);
 
   // Transform to frequency domain if we have enough data.
   while (WebRtc_available_read(aecpc->far_pre_buf) >= PART_LEN2) {
@@ -361,9 +387,9 @@ int32_t WebRtcAec_BufferFarend(void* aecInst,
     WebRtc_MoveReadPtr(aecpc->far_pre_buf, -PART_LEN);
 #ifdef WEBRTC_AEC_DEBUG_DUMP
     WebRtc_ReadBuffer(
-        aecpc->far_pre_buf_s16, (void**)&farend_ptr, newFarend, PART_LEN2);
+        aecpc->far_pre_buf_s16, (void**)&farend_s16_ptr, farend_s16, PART_LEN2);
     WebRtc_WriteBuffer(
-        WebRtcAec_far_time_buf(aecpc->aec), &farend_ptr[PART_LEN], 1);
+        WebRtcAec_far_time_buf(aecpc->aec), &farend_s16_ptr[PART_LEN], 1);
     WebRtc_MoveReadPtr(aecpc->far_pre_buf_s16, -PART_LEN);
 #endif
   }
@@ -380,6 +406,65 @@ int32_t WebRtcAec_Process(void* aecInst,
                           int16_t msInSndCardBuf,
                           int32_t skew) {
   aecpc_t* aecpc = aecInst;
+  // Zeroed, since the compiler cannot tell that only the first
+  // |nrOfSamples| are read.
+  float near_float[2 * FRAME_LEN] = { 0 };
+  float near_high_float[2 * FRAME_LEN];
+  float* near_high_ptr = NULL;
+  int32_t retVal = 0;
+  int i = 0;
+
+  if (nearend == NULL || out == NULL) {
+    aecpc->lastError = AEC_NULL_POINTER_ERROR;
+    return -1;
+  }
+  if (nrOfSamples < 0 || nrOfSamples > 2 * FRAME_LEN) {
+    aecpc->lastError = AEC_BAD_PARAMETER_ERROR;
+    return -1;
+  }
+
+  for (i = 0; i < nrOfSamples; i++) {
+    near_float[i] = (float)nearend[i];
+  }
+  if (nearendH != NULL) {
+    for (i = 0; i < nrOfSamples; i++) {
+      near_high_float[i] = (float)nearendH[i];
+    }
+    near_high_ptr = near_high_float;
+  }
+
+  retVal = WebRtcAec_ProcessFloat(aecInst,
+                                  near_float,
+                                  near_high_ptr,
+                                  near_float,
+                                  near_high_ptr,
+                                  nrOfSamples,
+                                  msInSndCardBuf,
+                                  skew);
+
+  // The output is limited to the int16 range; truncate it as the core used
+  // to.
+  for (i = 0; i < nrOfSamples; i++) {
+    out[i] = (int16_t)near_float[i];
+  }
+  if (nearendH != NULL && outH != NULL) {
+    for (i = 0; i < nrOfSamples; i++) {
+      outH[i] = (int16_t)near_high_float[i];
+    }
+  }
+
+  return retVal;
+}
+
+int32_t WebRtcAec_ProcessFloat(void* aecInst,
+                               const float* nearend,
+                               const float* nearendH,
+                               float* out,
+                               float* outH,
+                               int16_t nrOfSamples,
+                               int16_t msInSndCardBuf,
+                               int32_t skew) {
+  aecpc_t* aecpc = aecInst;
   int32_t retVal = 0;
   if (nearend == NULL) {
     aecpc->lastError = AEC_NULL_POINTER_ERROR;
@@ -632,10 +717,10 @@ AecCore* WebRtcAec_aec_core(void* handle) {
 }
 
 static int ProcessNormal(aecpc_t* aecpc,
-                         const int16_t* nearend,
-                         const int16_t* nearendH,
-                         int16_t* out,
-                         int16_t* outH,
+                         const float* nearend,
+                         const float* nearendH,
+                         float* out,
+                         float* outH,
                          int16_t nrOfSamples,
                          int16_t msInSndCardBuf,
                          int32_t skew) {
@@ -689,10 +774,10 @@ static int ProcessNormal(aecpc_t* aecpc,
   if (aecpc->startup_phase) {
     // Only needed if they don't already point to the same place.
     if (nearend != out) {
-      memcpy(out, nearend, sizeof(short) * nrOfSamples);
+      memcpy(out, nearend, sizeof(float) * nrOfSamples);
     }
     if (nearendH != outH) {
-      memcpy(outH, nearendH, sizeof(short) * nrOfSamples);
+      memcpy(outH, nearendH, sizeof(float) * nrOfSamples);
     }
 
     // The AEC is in the start up mode
@@ -787,10 +872,10 @@ static int ProcessNormal(aecpc_t* aecpc,
 }
 
 static void ProcessExtended(aecpc_t* self,
-                            const int16_t* near,
-                            const int16_t* near_high,
-                            int16_t* out,
-                            int16_t* out_high,
+                            const float* near,
+                            const float* near_high,
+                            float* out,
+                            float* out_high,
                             int16_t num_samples,
                             int16_t reported_delay_ms,
                             int32_t skew) {
@@ -821,10 +906,10 @@ static void ProcessExtended(aecpc_t* self,
   if (!self->farend_started) {
     // Only needed if they don't already point to the same place.
     if (near != out) {
-      memcpy(out, near, sizeof(short) * num_samples);
+      memcpy(out, near, sizeof(float) * num_samples);
     }
     if (near_high != out_high) {
-      memcpy(out_high, near_high, sizeof(short) * num_samples);
+      memcpy(out_high, near_high, sizeof(float) * num_samples);
     }
     return;
   }
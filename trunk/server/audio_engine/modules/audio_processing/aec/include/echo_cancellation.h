@@ -127,6 +127,13 @@ int32_t WebRtcAec_BufferFarend(void* aecInst,
                                const int16_t* farend,
                                int16_t nrOfSamples);
 
+/*
+ * Same as WebRtcAec_BufferFarend(), but for float samples in the int16 range.
+ */
+int32_t WebRtcAec_BufferFarendFloat(void* aecInst,
+                                    const float* farend,
+                                    int16_t nrOfSamples);
+
 /*
  * Runs the echo canceller on an 80 or 160 sample blocks of data.
  *
@@ -162,6 +169,20 @@ int32_t WebRtcAec_Process(void* aecInst,
                           int16_t msInSndCardBuf,
                           int32_t skew);
 
+/*
+ * Same as WebRtcAec_Process(), but for float samples in the int16 range. The
+ * output is limited to the int16 range but not rounded, so it can be passed
+ * on to other float components without loss of precision.
+ */
+int32_t WebRtcAec_ProcessFloat(void* aecInst,
+                               const float* nearend,
+                               const float* nearendH,
+                               float* out,
+                               float* outH,
+                               int16_t nrOfSamples,
+                               int16_t msInSndCardBuf,
+                               int32_t skew);
+
 /*
  * This function enables the user to set certain parameters on-the-fly.
  *
@@ -1249,26 +1249,13 @@ int32_t WebRtcAgc_ProcessAnalog(void *state, int32_t inMicLevel,
     return 0;
 }
 
-int WebRtcAgc_Process(void *agcInst, const int16_t *in_near,
-                      const int16_t *in_near_H, int16_t samples,
-                      int16_t *out, int16_t *out_H, int32_t inMicLevel,
-                      int32_t *outMicLevel, int16_t echo,
-                      uint8_t *saturationWarning)
+// Checks the frame length and the band pointers passed to WebRtcAgc_Process()
+// or WebRtcAgc_ProcessFloat(). Returns the number of samples per 10 ms, or -1
+// on error.
+static int16_t CheckProcessInput(Agc_t *stt, const void *in_near,
+                                 const void *in_near_H, int16_t samples)
 {
-    Agc_t *stt;
-    int32_t inMicLevelTmp;
-    int16_t subFrames, i;
-    uint8_t satWarningTmp = 0;
-
-    stt = (Agc_t *)agcInst;
-
-    //
-    if (stt == NULL)
-    {
-        return -1;
-    }
-    //
-
+    int16_t subFrames;
 
     if (stt->fs == 8000)
     {
@@ -1323,6 +1310,83 @@ int WebRtcAgc_Process(void *agcInst, const int16_t *in_near,
         return -1;
     }
 
+    return subFrames;
+}
+
+// Runs the analog AGC on a 10 ms frame that the digital AGC has processed and
+// updates the queue.
+static int ProcessAnalogSubFrame(void *agcInst, int32_t *inMicLevelTmp,
+                                 int32_t *outMicLevel, int16_t echo,
+                                 uint8_t *saturationWarning,
+                                 uint8_t *satWarningTmp)
+{
+    Agc_t *stt = (Agc_t *)agcInst;
+
+    if ((stt->agcMode < kAgcModeFixedDigital) && ((stt->lowLevelSignal == 0)
+            || (stt->agcMode != kAgcModeAdaptiveDigital)))
+    {
+        if (WebRtcAgc_ProcessAnalog(agcInst, *inMicLevelTmp, outMicLevel,
+                                      stt->vadMic.logRatio, echo, saturationWarning) == -1)
+        {
+            return -1;
+        }
+    }
+#ifdef AGC_DEBUG//test log
+    fprintf(stt->agcLog, "%5d\t%d\t%d\t%d\n", stt->fcount, *inMicLevelTmp, *outMicLevel, stt->maxLevel, stt->micVol);
+#endif
+
+    /* update queue */
+    if (stt->inQueue > 1)
+    {
+        memcpy(stt->env[0], stt->env[1], 10 * sizeof(int32_t));
+        memcpy(stt->Rxx16w32_array[0], stt->Rxx16w32_array[1], 5 * sizeof(int32_t));
+    }
+
+    if (stt->inQueue > 0)
+    {
+        stt->inQueue--;
+    }
+
+    /* If 20ms frames are used the input mic level must be updated so that
+     * the analog AGC does not think that there has been a manual volume
+     * change. */
+    *inMicLevelTmp = *outMicLevel;
+
+    /* Store a positive saturation warning. */
+    if (*saturationWarning == 1)
+    {
+        *satWarningTmp = 1;
+    }
+
+    return 0;
+}
+
+int WebRtcAgc_Process(void *agcInst, const int16_t *in_near,
+                      const int16_t *in_near_H, int16_t samples,
+                      int16_t *out, int16_t *out_H, int32_t inMicLevel,
+                      int32_t *outMicLevel, int16_t echo,
+                      uint8_t *saturationWarning)
+{
+    Agc_t *stt;
+    int32_t inMicLevelTmp;
+    int16_t subFrames, i;
+    uint8_t satWarningTmp = 0;
+
+    stt = (Agc_t *)agcInst;
+
+    //
+    if (stt == NULL)
+    {
+        return -1;
+    }
+    //
+
+    subFrames = CheckProcessInput(stt, in_near, in_near_H, samples);
+    if (subFrames == -1)
+    {
+        return -1;
+    }
+
     *saturationWarning = 0;
     //TODO: PUT IN RANGE CHECKING FOR INPUT LEVELS
     *outMicLevel = inMicLevel;
@@ -1357,40 +1421,67 @@ int WebRtcAgc_Process(void *agcInst, const int16_t *in_near,
 #endif
             return -1;
         }
-        if ((stt->agcMode < kAgcModeFixedDigital) && ((stt->lowLevelSignal == 0)
-                || (stt->agcMode != kAgcModeAdaptiveDigital)))
+        if (ProcessAnalogSubFrame(agcInst, &inMicLevelTmp, outMicLevel, echo,
+                                  saturationWarning, &satWarningTmp) == -1)
         {
-            if (WebRtcAgc_ProcessAnalog(agcInst, inMicLevelTmp, outMicLevel,
-                                          stt->vadMic.logRatio, echo, saturationWarning) == -1)
-            {
-                return -1;
-            }
+            return -1;
         }
+    }
+
+    /* Trigger the saturation warning if displayed by any of the frames. */
+    *saturationWarning = satWarningTmp;
+
+    return 0;
+}
+
+int WebRtcAgc_ProcessFloat(void *agcInst, const float *in_near,
+                           const float *in_near_H, int16_t samples,
+                           float *out, float *out_H, int32_t inMicLevel,
+                           int32_t *outMicLevel, int16_t echo,
+                           uint8_t *saturationWarning)
+{
+    Agc_t *stt;
+    int32_t inMicLevelTmp;
+    int16_t subFrames, i;
+    uint8_t satWarningTmp = 0;
+
+    stt = (Agc_t *)agcInst;
+    if (stt == NULL)
+    {
+        return -1;
+    }
+
+    subFrames = CheckProcessInput(stt, in_near, in_near_H, samples);
+    if (subFrames == -1)
+    {
+        return -1;
+    }
+
+    *saturationWarning = 0;
+    *outMicLevel = inMicLevel;
+    inMicLevelTmp = inMicLevel;
+
 #ifdef AGC_DEBUG//test log
-        fprintf(stt->agcLog, "%5d\t%d\t%d\t%d\n", stt->fcount, inMicLevelTmp, *outMicLevel, stt->maxLevel, stt->micVol);
+    stt->fcount++;
 #endif
 
-        /* update queue */
-        if (stt->inQueue > 1)
-        {
-            memcpy(stt->env[0], stt->env[1], 10 * sizeof(int32_t));
-            memcpy(stt->Rxx16w32_array[0], stt->Rxx16w32_array[1], 5 * sizeof(int32_t));
-        }
-
-        if (stt->inQueue > 0)
+    for (i = 0; i < samples; i += subFrames)
+    {
+        if (WebRtcAgc_ProcessDigitalFloat(&stt->digitalAgc, &in_near[i],
+                                          stt->fs == 32000 ? &in_near_H[i] : NULL,
+                                          &out[i],
+                                          stt->fs == 32000 ? &out_H[i] : NULL,
+                                          stt->fs, stt->lowLevelSignal) == -1)
         {
-            stt->inQueue--;
+#ifdef AGC_DEBUG//test log
+            fprintf(stt->fpt, "AGC->Process, frame %d: Error from DigAGC\n\n", stt->fcount);
+#endif
+            return -1;
         }
-
-        /* If 20ms frames are used the input mic level must be updated so that
-         * the analog AGC does not think that there has been a manual volume
-         * change. */
-        inMicLevelTmp = *outMicLevel;
-
-        /* Store a positive saturation warning. */
-        if (*saturationWarning == 1)
+        if (ProcessAnalogSubFrame(agcInst, &inMicLevelTmp, outMicLevel, echo,
+                                  saturationWarning, &satWarningTmp) == -1)
         {
-            satWarningTmp = 1;
+            return -1;
         }
     }
 
@@ -21,6 +21,7 @@
 #endif
 
 #include "audio_engine/modules/audio_processing/agc/include/gain_control.h"
+#include "audio_engine/system_wrappers/interface/cpu_features_wrapper.h"
 
 // To generate the gaintable, copy&paste the following lines to a Matlab window:
 // MaxGain = 6; MinGain = 0; CompRatio = 3; Knee = 1;
@@ -58,6 +59,11 @@ static const uint16_t kGenFuncTable[kGenFuncTableSize] = {
 
 static const int16_t kAvgDecayTime = 250; // frames; < 3000
 
+WebRtcAgc_CalculateEnvelope_t WebRtcAgc_CalculateEnvelope;
+WebRtcAgc_ApplyDigitalGains_t WebRtcAgc_ApplyDigitalGains;
+WebRtcAgc_ApplyDigitalGainsFloat_t WebRtcAgc_ApplyDigitalGainsFloat;
+WebRtcAgc_RoundToInt16_t WebRtcAgc_RoundToInt16;
+
 int32_t WebRtcAgc_CalculateGainTable(int32_t *gainTable, // Q16
                                      int16_t digCompGaindB, // Q0
                                      int16_t targetLevelDbfs,// Q0
@@ -258,6 +264,97 @@ int32_t WebRtcAgc_CalculateGainTable(int32_t *gainTable, // Q16
     return 0;
 }
 
+static void CalculateEnvelope(const int16_t *in, int16_t L, int32_t *env)
+{
+    int32_t nrg, max_nrg;
+    int16_t k, n;
+
+    // iterate over sub frames
+    for (k = 0; k < 10; k++)
+    {
+        // iterate over samples
+        max_nrg = 0;
+        for (n = 0; n < L; n++)
+        {
+            nrg = WEBRTC_SPL_MUL_16_16(in[k * L + n], in[k * L + n]);
+            if (nrg > max_nrg)
+            {
+                max_nrg = nrg;
+            }
+        }
+        env[k] = max_nrg;
+    }
+}
+
+static void ApplyDigitalGains(const int32_t *gains, int16_t L, int16_t L2,
+                              int16_t *out)
+{
+    int32_t gain32, delta, tmp32;
+    int16_t k, n;
+
+    // iterate over subframes
+    for (k = 1; k < 10; k++)
+    {
+        delta = WEBRTC_SPL_LSHIFT_W32(gains[k+1] - gains[k], (4 - L2));
+        gain32 = WEBRTC_SPL_LSHIFT_W32(gains[k], 4);
+        // iterate over samples
+        for (n = 0; n < L; n++)
+        {
+            tmp32 = WEBRTC_SPL_MUL((int32_t)out[k * L + n],
+                                   WEBRTC_SPL_RSHIFT_W32(gain32, 4));
+            out[k * L + n] = (int16_t)WEBRTC_SPL_RSHIFT_W32(tmp32 , 16);
+            gain32 += delta;
+        }
+    }
+}
+
+static void ApplyDigitalGainsFloat(const int32_t *gains, int16_t L, float *out)
+{
+    const float kScale = 1.0f / 65536.0f; // Q16 -> float
+    float gain, step, tmp;
+    int16_t k, n;
+
+    for (k = 0; k < 10; k++)
+    {
+        gain = (float)gains[k] * kScale;
+        step = (float)(gains[k + 1] - gains[k]) * kScale / L;
+        for (n = 0; n < L; n++)
+        {
+            tmp = out[k * L + n] * (gain + (float)n * step);
+            if (tmp > 32767.0f)
+            {
+                tmp = 32767.0f;
+            } else if (tmp < -32768.0f)
+            {
+                tmp = -32768.0f;
+            }
+            out[k * L + n] = tmp;
+        }
+    }
+}
+
+static void RoundToInt16(const float *in, int16_t length, int16_t *out)
+{
+    int16_t n;
+
+    for (n = 0; n < length; n++)
+    {
+        if (in[n] >= 32766.5f)
+        {
+            out[n] = 32767;
+        } else if (in[n] <= -32767.5f)
+        {
+            out[n] = -32768;
+        } else if (in[n] > 0)
+        {
+            out[n] = (int16_t)(in[n] + 0.5f);
+        } else
+        {
+            out[n] = (int16_t)(in[n] - 0.5f);
+        }
+    }
+}
+
 int32_t WebRtcAgc_InitDigital(DigitalAgc_t *stt, int16_t agcMode)
 {
 
@@ -282,6 +379,17 @@ int32_t WebRtcAgc_InitDigital(DigitalAgc_t *stt, int16_t agcMode)
     WebRtcAgc_InitVad(&stt->vadNearend);
     WebRtcAgc_InitVad(&stt->vadFarend);
 
+    WebRtcAgc_CalculateEnvelope = CalculateEnvelope;
+    WebRtcAgc_ApplyDigitalGains = ApplyDigitalGains;
+    WebRtcAgc_ApplyDigitalGainsFloat = ApplyDigitalGainsFloat;
+    WebRtcAgc_RoundToInt16 = RoundToInt16;
+#if defined(VOIP_ARCH_X86_FAMILY)
+    if (WebRtc_GetCPUInfo(kSSE2))
+    {
+        WebRtcAgc_InitDigital_SSE2();
+    }
+#endif
+
     return 0;
 }
 
@@ -295,60 +403,25 @@ int32_t WebRtcAgc_AddFarendToDigital(DigitalAgc_t *stt, const int16_t *in_far,
     return 0;
 }
 
-int32_t WebRtcAgc_ProcessDigital(DigitalAgc_t *stt, const int16_t *in_near,
-                                 const int16_t *in_near_H, int16_t *out,
-                                 int16_t *out_H, uint32_t FS,
-                                 int16_t lowlevelSignal)
+// Runs the VAD and the envelope followers on the 10 ms low band |in_near| and
+// computes the gains at the subframe boundaries. Returns the gains in |gains|.
+static void ComputeDigitalGains(DigitalAgc_t *stt, const int16_t *in_near,
+                                int16_t L, int16_t lowlevelSignal,
+                                int32_t *gains)
 {
-    // array for gains (one value per ms, incl start & end)
-    int32_t gains[11];
-
-    int32_t out_tmp, tmp32;
+    int32_t tmp32;
     int32_t env[10];
-    int32_t nrg, max_nrg;
+    int32_t gain32;
     int32_t cur_level;
-    int32_t gain32, delta;
     int16_t logratio;
     int16_t lower_thr, upper_thr;
     int16_t zeros, zeros_fast, frac;
     int16_t decay;
     int16_t gate, gain_adj;
-    int16_t k, n;
-    int16_t L, L2; // samples/subframe
-
-    // determine number of samples per ms
-    if (FS == 8000)
-    {
-        L = 8;
-        L2 = 3;
-    } else if (FS == 16000)
-    {
-        L = 16;
-        L2 = 4;
-    } else if (FS == 32000)
-    {
-        L = 16;
-        L2 = 4;
-    } else
-    {
-        return -1;
-    }
+    int16_t k;
 
-    // TODO(andrew): again, we don't need input and output pointers...
-    if (in_near != out)
-    {
-        // Only needed if they don't already point to the same place.
-        memcpy(out, in_near, 10 * L * sizeof(int16_t));
-    }
-    if (FS == 32000)
-    {
-        if (in_near_H != out_H)
-        {
-            memcpy(out_H, in_near_H, 10 * L * sizeof(int16_t));
-        }
-    }
     // VAD for near end
-    logratio = WebRtcAgc_ProcessVad(&stt->vadNearend, out, L * 10);
+    logratio = WebRtcAgc_ProcessVad(&stt->vadNearend, in_near, L * 10);
 
     // Account for far end VAD
     if (stt->vadFarend.counter > 10)
@@ -402,21 +475,7 @@ int32_t WebRtcAgc_ProcessDigital(DigitalAgc_t *stt, const int16_t *in_near,
     fprintf(stt->logFile, "%5.2f\t%d\t%d\t%d\t", (float)(stt->frameCounter) / 100, logratio, decay, stt->vadNearend.stdLongTerm);
 #endif
     // Find max amplitude per sub frame
-    // iterate over sub frames
-    for (k = 0; k < 10; k++)
-    {
-        // iterate over samples
-        max_nrg = 0;
-        for (n = 0; n < L; n++)
-        {
-            nrg = WEBRTC_SPL_MUL_16_16(out[k * L + n], out[k * L + n]);
-            if (nrg > max_nrg)
-            {
-                max_nrg = nrg;
-            }
-        }
-        env[k] = max_nrg;
-    }
+    WebRtcAgc_CalculateEnvelope(in_near, L, env);
 
     // Calculate gain per sub frame
     gains[0] = stt->gain;
@@ -557,6 +616,54 @@ int32_t WebRtcAgc_ProcessDigital(DigitalAgc_t *stt, const int16_t *in_near,
     }
     // save start gain for next frame
     stt->gain = gains[10];
+}
+
+int32_t WebRtcAgc_ProcessDigital(DigitalAgc_t *stt, const int16_t *in_near,
+                                 const int16_t *in_near_H, int16_t *out,
+                                 int16_t *out_H, uint32_t FS,
+                                 int16_t lowlevelSignal)
+{
+    // array for gains (one value per ms, incl start & end)
+    int32_t gains[11];
+
+    int32_t out_tmp, tmp32;
+    int32_t gain32, delta;
+    int16_t n;
+    int16_t L, L2; // samples/subframe
+
+    // determine number of samples per ms
+    if (FS == 8000)
+    {
+        L = 8;
+        L2 = 3;
+    } else if (FS == 16000)
+    {
+        L = 16;
+        L2 = 4;
+    } else if (FS == 32000)
+    {
+        L = 16;
+        L2 = 4;
+    } else
+    {
+        return -1;
+    }
+
+    // TODO(andrew): again, we don't need input and output pointers...
+    if (in_near != out)
+    {
+        // Only needed if they don't already point to the same place.
+        memcpy(out, in_near, 10 * L * sizeof(int16_t));
+    }
+    if (FS == 32000)
+    {
+        if (in_near_H != out_H)
+        {
+            memcpy(out_H, in_near_H, 10 * L * sizeof(int16_t));
+        }
+    }
+
+    ComputeDigitalGains(stt, out, L, lowlevelSignal, gains);
 
     // Apply gain
     // handle first sub frame separately
@@ -602,29 +709,59 @@ int32_t WebRtcAgc_ProcessDigital(DigitalAgc_t *stt, const int16_t *in_near,
 
         gain32 += delta;
     }
-    // iterate over subframes
-    for (k = 1; k < 10; k++)
+    // iterate over the remaining subframes
+    WebRtcAgc_ApplyDigitalGains(gains, L, L2, out);
+    if (FS == 32000)
     {
-        delta = WEBRTC_SPL_LSHIFT_W32(gains[k+1] - gains[k], (4 - L2));
-        gain32 = WEBRTC_SPL_LSHIFT_W32(gains[k], 4);
-        // iterate over samples
-        for (n = 0; n < L; n++)
+        WebRtcAgc_ApplyDigitalGains(gains, L, L2, out_H);
+    }
+
+    return 0;
+}
+
+int32_t WebRtcAgc_ProcessDigitalFloat(DigitalAgc_t *stt, const float *in_near,
+                                      const float *in_near_H, float *out,
+                                      float *out_H, uint32_t FS,
+                                      int16_t lowlevelSignal)
+{
+    // array for gains (one value per ms, incl start & end)
+    int32_t gains[11];
+    int16_t out16[160];
+    int16_t L; // samples/subframe
+
+    // determine number of samples per ms
+    if (FS == 8000)
+    {
+        L = 8;
+    } else if (FS == 16000 || FS == 32000)
+    {
+        L = 16;
+    } else
+    {
+        return -1;
+    }
+
+    if (in_near != out)
+    {
+        memcpy(out, in_near, 10 * L * sizeof(float));
+    }
+    if (FS == 32000)
+    {
+        if (in_near_H != out_H)
         {
-            // For lower band
-            tmp32 = WEBRTC_SPL_MUL((int32_t)out[k * L + n],
-                                   WEBRTC_SPL_RSHIFT_W32(gain32, 4));
-            out[k * L + n] = (int16_t)WEBRTC_SPL_RSHIFT_W32(tmp32 , 16);
-            // For higher band
-            if (FS == 32000)
-            {
-                tmp32 = WEBRTC_SPL_MUL((int32_t)out_H[k * L + n],
-                                       WEBRTC_SPL_RSHIFT_W32(gain32, 4));
-                out_H[k * L + n] = (int16_t)WEBRTC_SPL_RSHIFT_W32(tmp32 , 16);
-            }
-            gain32 += delta;
+            memcpy(out_H, in_near_H, 10 * L * sizeof(float));
         }
     }
 
+    WebRtcAgc_RoundToInt16(out, 10 * L, out16);
+    ComputeDigitalGains(stt, out16, L, lowlevelSignal, gains);
+
+    WebRtcAgc_ApplyDigitalGainsFloat(gains, L, out);
+    if (FS == 32000)
+    {
+        WebRtcAgc_ApplyDigitalGainsFloat(gains, L, out_H);
+    }
+
     return 0;
 }
 
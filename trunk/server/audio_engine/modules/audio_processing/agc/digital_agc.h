@@ -59,6 +59,15 @@ int32_t WebRtcAgc_ProcessDigital(DigitalAgc_t *digitalAgcInst,
                                  int16_t *out, int16_t *out_H, uint32_t FS,
                                  int16_t lowLevelSignal);
 
+// Same as WebRtcAgc_ProcessDigital(), but for float frames with samples in the
+// int16 range. The level analysis runs on the low band rounded to int16, so
+// the gains match the int16 version for integral input. The output is limited
+// to the int16 range but not rounded.
+int32_t WebRtcAgc_ProcessDigitalFloat(DigitalAgc_t *digitalAgcInst,
+                                      const float *inNear, const float *inNear_H,
+                                      float *out, float *out_H, uint32_t FS,
+                                      int16_t lowLevelSignal);
+
 int32_t WebRtcAgc_AddFarendToDigital(DigitalAgc_t *digitalAgcInst,
                                      const int16_t *inFar,
                                      int16_t nrSamples);
@@ -75,4 +84,30 @@ int32_t WebRtcAgc_CalculateGainTable(int32_t *gainTable, // Q16
                                      uint8_t limiterEnable,
                                      int16_t analogTarget);
 
+// Kernels of WebRtcAgc_ProcessDigital(), set up by WebRtcAgc_InitDigital().
+// |gains| holds the 11 gains (Q16) at the subframe boundaries, and |L| and
+// |L2| are the subframe length and its base-2 logarithm.
+
+// Writes the maximum energy of each of the 10 subframes of |in| to |env|.
+typedef void (*WebRtcAgc_CalculateEnvelope_t)(const int16_t *in, int16_t L,
+                                              int32_t *env);
+extern WebRtcAgc_CalculateEnvelope_t WebRtcAgc_CalculateEnvelope;
+// Applies the interpolated gains to subframes 1 to 9 of |out|. The first
+// subframe also needs limiting and is left to the caller.
+typedef void (*WebRtcAgc_ApplyDigitalGains_t)(const int32_t *gains, int16_t L,
+                                              int16_t L2, int16_t *out);
+extern WebRtcAgc_ApplyDigitalGains_t WebRtcAgc_ApplyDigitalGains;
+// Applies the interpolated gains to all 10 subframes of the float frame |out|
+// and limits the result to the int16 range.
+typedef void (*WebRtcAgc_ApplyDigitalGainsFloat_t)(const int32_t *gains,
+                                                   int16_t L, float *out);
+extern WebRtcAgc_ApplyDigitalGainsFloat_t WebRtcAgc_ApplyDigitalGainsFloat;
+// Rounds |length| float samples to int16, half away from zero, with
+// saturation.
+typedef void (*WebRtcAgc_RoundToInt16_t)(const float *in, int16_t length,
+                                         int16_t *out);
+extern WebRtcAgc_RoundToInt16_t WebRtcAgc_RoundToInt16;
+
+void WebRtcAgc_InitDigital_SSE2(void);
+
 #endif // WEBRTC_MODULES_AUDIO_PROCESSING_AGC_MAIN_SOURCE_ANALOG_AGC_H_
@@ -0,0 +1,174 @@
+/*
+ *  Copyright (c) 2014 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+/*
+ * SSE2 versions of the digital AGC kernels. The int16 kernels are bit-exact
+ * with the C versions in digital_agc.c.
+ */
+
+#include <emmintrin.h>
+
+#include "audio_engine/modules/audio_processing/agc/digital_agc.h"
+
+static void CalculateEnvelopeSSE2(const int16_t *in, int16_t L, int32_t *env)
+{
+    // The energy is the square of the largest magnitude. Magnitudes are taken
+    // as unsigned, so that |-32768| is 32768, and are offset by 0x8000 to
+    // compare them with _mm_max_epi16().
+    const __m128i offset = _mm_set1_epi16((int16_t)0x8000);
+    __m128i max_abs;
+    uint16_t max_abs_k;
+    int16_t k, n;
+
+    for (k = 0; k < 10; k++)
+    {
+        max_abs = offset;
+        for (n = 0; n < L; n += 8)
+        {
+            const __m128i x = _mm_loadu_si128((const __m128i *)&in[k * L + n]);
+            const __m128i sign = _mm_srai_epi16(x, 15);
+            const __m128i abs_x = _mm_sub_epi16(_mm_xor_si128(x, sign), sign);
+            max_abs = _mm_max_epi16(max_abs, _mm_xor_si128(abs_x, offset));
+        }
+        max_abs = _mm_max_epi16(max_abs,
+                                _mm_shuffle_epi32(max_abs, _MM_SHUFFLE(1, 0, 3, 2)));
+        max_abs = _mm_max_epi16(max_abs,
+                                _mm_shuffle_epi32(max_abs, _MM_SHUFFLE(2, 3, 0, 1)));
+        max_abs = _mm_max_epi16(max_abs, _mm_srli_epi32(max_abs, 16));
+        max_abs_k = (uint16_t)(_mm_cvtsi128_si32(max_abs) ^ 0x8000);
+        env[k] = (int32_t)max_abs_k * max_abs_k;
+    }
+}
+
+static void ApplyDigitalGainsSSE2(const int32_t *gains, int16_t L, int16_t L2,
+                                  int16_t *out)
+{
+    int32_t gain32, delta;
+    int16_t k, n;
+
+    for (k = 1; k < 10; k++)
+    {
+        int16_t *out_k = &out[k * L];
+        __m128i gain_lo, gain_hi, step;
+
+        delta = WEBRTC_SPL_LSHIFT_W32(gains[k+1] - gains[k], (4 - L2));
+        gain32 = WEBRTC_SPL_LSHIFT_W32(gains[k], 4);
+        // gain32 for samples n..n+3 and n+4..n+7, wrapping like the C version.
+        gain_lo = _mm_add_epi32(_mm_set1_epi32(gain32),
+                                _mm_setr_epi32(0, delta,
+                                               (int32_t)((uint32_t)delta * 2),
+                                               (int32_t)((uint32_t)delta * 3)));
+        step = _mm_set1_epi32((int32_t)((uint32_t)delta * 4));
+        gain_hi = _mm_add_epi32(gain_lo, step);
+        step = _mm_add_epi32(step, step);
+
+        for (n = 0; n < L; n += 8)
+        {
+            // The output is the low 16 bits of (x * g) >> 16, with g the Q16
+            // gain. Split g into its high half and its low half, taken as
+            // signed, and form x * g_high + ((x * g_low) >> 16) mod 2^16. The
+            // low half is fixed up for its sign by adding x.
+            const __m128i x = _mm_loadu_si128((const __m128i *)&out_k[n]);
+            const __m128i g_lo = _mm_srai_epi32(gain_lo, 4);
+            const __m128i g_hi = _mm_srai_epi32(gain_hi, 4);
+            const __m128i g_high = _mm_packs_epi32(_mm_srai_epi32(g_lo, 16),
+                                                   _mm_srai_epi32(g_hi, 16));
+            const __m128i g_low = _mm_packs_epi32(
+                _mm_srai_epi32(_mm_slli_epi32(g_lo, 16), 16),
+                _mm_srai_epi32(_mm_slli_epi32(g_hi, 16), 16));
+            const __m128i y_high = _mm_mullo_epi16(x, g_high);
+            const __m128i y_low = _mm_add_epi16(
+                _mm_mulhi_epi16(x, g_low),
+                _mm_and_si128(x, _mm_srai_epi16(g_low, 15)));
+            _mm_storeu_si128((__m128i *)&out_k[n], _mm_add_epi16(y_high, y_low));
+            gain_lo = _mm_add_epi32(gain_lo, step);
+            gain_hi = _mm_add_epi32(gain_hi, step);
+        }
+    }
+}
+
+static void ApplyDigitalGainsFloatSSE2(const int32_t *gains, int16_t L,
+                                       float *out)
+{
+    const float kScale = 1.0f / 65536.0f; // Q16 -> float
+    const __m128 max_value = _mm_set1_ps(32767.0f);
+    const __m128 min_value = _mm_set1_ps(-32768.0f);
+    const __m128 four = _mm_set1_ps(4.0f);
+    float gain, step;
+    int16_t k, n;
+
+    for (k = 0; k < 10; k++)
+    {
+        __m128 gain_v, step_v, index;
+
+        gain = (float)gains[k] * kScale;
+        step = (float)(gains[k + 1] - gains[k]) * kScale / L;
+        gain_v = _mm_set1_ps(gain);
+        step_v = _mm_set1_ps(step);
+        index = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+        for (n = 0; n < L; n += 4)
+        {
+            const __m128 g = _mm_add_ps(gain_v, _mm_mul_ps(index, step_v));
+            __m128 y = _mm_mul_ps(_mm_loadu_ps(&out[k * L + n]), g);
+            y = _mm_max_ps(_mm_min_ps(y, max_value), min_value);
+            _mm_storeu_ps(&out[k * L + n], y);
+            index = _mm_add_ps(index, four);
+        }
+    }
+}
+
+static void RoundToInt16SSE2(const float *in, int16_t length, int16_t *out)
+{
+    // Limiting first gives the same saturation as the C version, and adding
+    // +-0.5 before truncation matches its rounding bit for bit.
+    const __m128 max_value = _mm_set1_ps(32767.0f);
+    const __m128 min_value = _mm_set1_ps(-32768.0f);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 sign_mask = _mm_set1_ps(-0.0f);
+    int16_t n;
+
+    for (n = 0; n + 7 < length; n += 8)
+    {
+        __m128 x_lo = _mm_loadu_ps(&in[n]);
+        __m128 x_hi = _mm_loadu_ps(&in[n + 4]);
+        x_lo = _mm_max_ps(_mm_min_ps(x_lo, max_value), min_value);
+        x_hi = _mm_max_ps(_mm_min_ps(x_hi, max_value), min_value);
+        // Zero takes the negative branch in C, which also gives zero.
+        x_lo = _mm_add_ps(x_lo, _mm_or_ps(half, _mm_and_ps(x_lo, sign_mask)));
+        x_hi = _mm_add_ps(x_hi, _mm_or_ps(half, _mm_and_ps(x_hi, sign_mask)));
+        _mm_storeu_si128((__m128i *)&out[n],
+                         _mm_packs_epi32(_mm_cvttps_epi32(x_lo),
+                                         _mm_cvttps_epi32(x_hi)));
+    }
+    for (; n < length; n++)
+    {
+        if (in[n] >= 32766.5f)
+        {
+            out[n] = 32767;
+        } else if (in[n] <= -32767.5f)
+        {
+            out[n] = -32768;
+        } else if (in[n] > 0)
+        {
+            out[n] = (int16_t)(in[n] + 0.5f);
+        } else
+        {
+            out[n] = (int16_t)(in[n] - 0.5f);
+        }
+    }
+}
+
+void WebRtcAgc_InitDigital_SSE2(void)
+{
+    WebRtcAgc_CalculateEnvelope = CalculateEnvelopeSSE2;
+    WebRtcAgc_ApplyDigitalGains = ApplyDigitalGainsSSE2;
+    WebRtcAgc_ApplyDigitalGainsFloat = ApplyDigitalGainsFloatSSE2;
+    WebRtcAgc_RoundToInt16 = RoundToInt16SSE2;
+}
@@ -178,6 +178,22 @@ int WebRtcAgc_Process(void* agcInst,
                       int16_t echo,
                       uint8_t* saturationWarning);
 
+/*
+ * Same as WebRtcAgc_Process(), but for float frames with samples in the int16
+ * range. The gains are computed from the low band rounded to int16 and are
+ * applied in float. The output is limited to the int16 range but not rounded.
+ */
+int WebRtcAgc_ProcessFloat(void* agcInst,
+                           const float* inNear,
+                           const float* inNear_H,
+                           int16_t samples,
+                           float* out,
+                           float* out_H,
+                           int32_t inMicLevel,
+                           int32_t* outMicLevel,
+                           int16_t echo,
+                           uint8_t* saturationWarning);
+
 /*
  * This function sets the config parameters (targetLevelDbfs,
  * compressionGaindB and limiterEnable).
@@ -22,6 +22,11 @@ enum {
   kSamplesPer32kHzChannel = 320
 };
 
+enum {
+  kInt16Valid = 1,
+  kFloatValid = 2
+};
+
 void StereoToMono(const int16_t* left, const int16_t* right,
                   int16_t* out, int samples_per_channel) {
   assert(left != NULL && right != NULL && out != NULL);
@@ -29,20 +34,31 @@ void StereoToMono(const int16_t* left, const int16_t* right,
     out[i] = (static_cast<int32_t>(left[i]) +
               static_cast<int32_t>(right[i])) >> 1;
 }
+
+void StereoToMono(const float* left, const float* right,
+                  float* out, int samples_per_channel) {
+  assert(left != NULL && right != NULL && out != NULL);
+  for (int i = 0; i < samples_per_channel; i++)
+    out[i] = (left[i] + right[i]) * 0.5f;
+}
 }  // namespace
 
 struct AudioChannel {
   AudioChannel() {
     memset(data, 0, sizeof(data));
+    memset(data_f, 0, sizeof(data_f));
   }
 
   int16_t data[kSamplesPer32kHzChannel];
+  float data_f[kSamplesPer32kHzChannel];
 };
 
 struct SplitAudioChannel {
   SplitAudioChannel() {
     memset(low_pass_data, 0, sizeof(low_pass_data));
     memset(high_pass_data, 0, sizeof(high_pass_data));
+    memset(low_pass_data_f, 0, sizeof(low_pass_data_f));
+    memset(high_pass_data_f, 0, sizeof(high_pass_data_f));
     memset(analysis_filter_state1, 0, sizeof(analysis_filter_state1));
     memset(analysis_filter_state2, 0, sizeof(analysis_filter_state2));
     memset(synthesis_filter_state1, 0, sizeof(synthesis_filter_state1));
@@ -51,6 +67,8 @@ struct SplitAudioChannel {
 
   int16_t low_pass_data[kSamplesPer16kHzChannel];
   int16_t high_pass_data[kSamplesPer16kHzChannel];
+  float low_pass_data_f[kSamplesPer16kHzChannel];
+  float high_pass_data_f[kSamplesPer16kHzChannel];
 
   int32_t analysis_filter_state1[6];
   int32_t analysis_filter_state2[6];
@@ -77,6 +95,9 @@ AudioBuffer::AudioBuffer(int max_num_channels,
     mixed_channels_(NULL),
     mixed_low_pass_channels_(NULL),
     low_pass_reference_channels_(NULL) {
+  for (int i = 0; i < kNumBands; i++) {
+    valid_formats_[i] = kInt16Valid;
+  }
   channels_.reset(new AudioChannel[max_num_channels_]);
   mixed_channels_.reset(new AudioChannel[max_num_channels_]);
   mixed_low_pass_channels_.reset(new AudioChannel[max_num_channels_]);
@@ -99,15 +120,82 @@ void AudioBuffer::InitForNewData(int num_channels) {
   reference_copied_ = false;
   activity_ = AudioFrame::kVadUnknown;
   is_muted_ = false;
+  // The split bands are overwritten by the analysis filter before use.
+  valid_formats_[kFullBand] = kInt16Valid;
+  valid_formats_[kLowBand] = kInt16Valid;
+  valid_formats_[kHighBand] = kInt16Valid;
+}
+
+AudioBuffer::Band AudioBuffer::low_band() const {
+  return split_channels_.get() == NULL ? kFullBand : kLowBand;
+}
+
+int16_t* AudioBuffer::band_data(Band band, int channel) const {
+  switch (band) {
+    case kFullBand:
+      return data_ != NULL ? data_ : channels_[channel].data;
+    case kLowBand:
+      return split_channels_[channel].low_pass_data;
+    case kHighBand:
+      return split_channels_[channel].high_pass_data;
+    default:
+      assert(false);
+      return NULL;
+  }
+}
+
+float* AudioBuffer::band_data_f(Band band, int channel) const {
+  switch (band) {
+    case kFullBand:
+      return channels_[channel].data_f;
+    case kLowBand:
+      return split_channels_[channel].low_pass_data_f;
+    case kHighBand:
+      return split_channels_[channel].high_pass_data_f;
+    default:
+      assert(false);
+      return NULL;
+  }
+}
+
+int AudioBuffer::samples_per_band(Band band) const {
+  return band == kFullBand ? samples_per_channel_ : samples_per_split_channel_;
+}
+
+void AudioBuffer::RefreshInt16(Band band) const {
+  if (valid_formats_[band] & kInt16Valid) {
+    return;
+  }
+  assert(valid_formats_[band] & kFloatValid);
+  for (int i = 0; i < num_channels_; i++) {
+    RoundToInt16(band_data_f(band, i), samples_per_band(band),
+                 band_data(band, i));
+  }
+  valid_formats_[band] |= kInt16Valid;
+}
+
+void AudioBuffer::RefreshFloat(Band band) const {
+  if (valid_formats_[band] & kFloatValid) {
+    return;
+  }
+  assert(valid_formats_[band] & kInt16Valid);
+  const int length = samples_per_band(band);
+  for (int i = 0; i < num_channels_; i++) {
+    const int16_t* in = band_data(band, i);
+    float* out = band_data_f(band, i);
+    for (int j = 0; j < length; j++) {
+      out[j] = in[j];
+    }
+  }
+  valid_formats_[band] |= kFloatValid;
 }
 
 int16_t* AudioBuffer::data(int channel) const {
   assert(channel >= 0 && channel < num_channels_);
-  if (data_ != NULL) {
-    return data_;
-  }
+  RefreshInt16(kFullBand);
+  valid_formats_[kFullBand] = kInt16Valid;
 
-  return channels_[channel].data;
+  return band_data(kFullBand, channel);
 }
 
 int16_t* AudioBuffer::low_pass_split_data(int channel) const {
@@ -116,6 +204,8 @@ int16_t* AudioBuffer::low_pass_split_data(int channel) const {
     return data(channel);
   }
 
+  RefreshInt16(kLowBand);
+  valid_formats_[kLowBand] = kInt16Valid;
   return split_channels_[channel].low_pass_data;
 }
 
@@ -125,13 +215,72 @@ int16_t* AudioBuffer::high_pass_split_data(int channel) const {
     return NULL;
   }
 
+  RefreshInt16(kHighBand);
+  valid_formats_[kHighBand] = kInt16Valid;
   return split_channels_[channel].high_pass_data;
 }
 
-int16_t* AudioBuffer::mixed_data(int channel) const {
+float* AudioBuffer::data_f(int channel) const {
+  assert(channel >= 0 && channel < num_channels_);
+  RefreshFloat(kFullBand);
+  valid_formats_[kFullBand] = kFloatValid;
+
+  return channels_[channel].data_f;
+}
+
+const float* AudioBuffer::data_const_f(int channel) const {
+  assert(channel >= 0 && channel < num_channels_);
+  RefreshFloat(kFullBand);
+
+  return channels_[channel].data_f;
+}
+
+float* AudioBuffer::low_pass_split_data_f(int channel) const {
+  assert(channel >= 0 && channel < num_channels_);
+  const Band band = low_band();
+  RefreshFloat(band);
+  valid_formats_[band] = kFloatValid;
+
+  return band_data_f(band, channel);
+}
+
+const float* AudioBuffer::low_pass_split_data_const_f(int channel) const {
+  assert(channel >= 0 && channel < num_channels_);
+  const Band band = low_band();
+  RefreshFloat(band);
+
+  return band_data_f(band, channel);
+}
+
+float* AudioBuffer::high_pass_split_data_f(int channel) const {
+  assert(channel >= 0 && channel < num_channels_);
+  if (split_channels_.get() == NULL) {
+    return NULL;
+  }
+
+  RefreshFloat(kHighBand);
+  valid_formats_[kHighBand] = kFloatValid;
+  return split_channels_[channel].high_pass_data_f;
+}
+
+const float* AudioBuffer::high_pass_split_data_const_f(int channel) const {
+  assert(channel >= 0 && channel < num_channels_);
+  if (split_channels_.get() == NULL) {
+    return NULL;
+  }
+
+  RefreshFloat(kHighBand);
+  return split_channels_[channel].high_pass_data_f;
+}
+
+bool AudioBuffer::low_pass_split_data_is_float() const {
+  return !(valid_formats_[low_band()] & kInt16Valid);
+}
+
+const float* AudioBuffer::mixed_data_f(int channel) const {
   assert(channel >= 0 && channel < num_mixed_channels_);
 
-  return mixed_channels_[channel].data;
+  return mixed_channels_[channel].data_f;
 }
 
 int16_t* AudioBuffer::mixed_low_pass_data(int channel) const {
@@ -230,6 +379,7 @@ void AudioBuffer::InterleaveTo(AudioFrame* frame, bool data_changed) const {
     return;
   }
 
+  RefreshInt16(kFullBand);
   if (num_channels_ == 1) {
     if (data_was_mixed_) {
       memcpy(frame->data_,
@@ -261,16 +411,18 @@ void AudioBuffer::CopyFrom(const float* const* data, int samples_per_channel,
 
   InitForNewData(num_channels);
   for (int i = 0; i < num_channels_; ++i) {
-    ScaleAndRoundToInt16(data[i], samples_per_channel, channels_[i].data);
+    FloatToFloatS16(data[i], samples_per_channel, channels_[i].data_f);
   }
+  valid_formats_[kFullBand] = kFloatValid;
 }
 
 void AudioBuffer::CopyTo(int samples_per_channel, int num_channels,
                          float* const* data) const {
   assert(num_channels == num_channels_);
   assert(samples_per_channel == samples_per_channel_);
+  RefreshFloat(kFullBand);
   for (int i = 0; i < num_channels_; ++i) {
-    ScaleToFloat(channels_[i].data, samples_per_channel, data[i]);
+    FloatS16ToFloat(channels_[i].data_f, samples_per_channel, data[i]);
   }
 }
 
@@ -282,8 +434,8 @@ void AudioBuffer::Mix(int num_mixed_channels) {
   assert(num_channels_ == 2);
   assert(num_mixed_channels == 1);
 
-  StereoToMono(channels_[0].data,
-               channels_[1].data,
+  StereoToMono(data(0),
+               data(1),
                channels_[0].data,
                samples_per_channel_);
 
@@ -296,9 +448,9 @@ void AudioBuffer::CopyAndMix(int num_mixed_channels) {
   assert(num_channels_ == 2);
   assert(num_mixed_channels == 1);
 
-  StereoToMono(channels_[0].data,
-               channels_[1].data,
-               mixed_channels_[0].data,
+  StereoToMono(data_const_f(0),
+               data_const_f(1),
+               mixed_channels_[0].data_f,
                samples_per_channel_);
 
   num_mixed_channels_ = num_mixed_channels;
@@ -319,9 +471,12 @@ void AudioBuffer::CopyAndMixLowPass(int num_mixed_channels) {
 
 void AudioBuffer::CopyLowPassToReference() {
   reference_copied_ = true;
+  // This only reads the low band, so any float samples stay valid.
+  const Band band = low_band();
+  RefreshInt16(band);
   for (int i = 0; i < num_channels_; i++) {
     memcpy(low_pass_reference_channels_[i].data,
-           low_pass_split_data(i),
+           band_data(band, i),
            sizeof(int16_t) * samples_per_split_channel_);
   }
 }
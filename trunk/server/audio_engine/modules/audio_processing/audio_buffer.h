@@ -29,13 +29,30 @@ class AudioBuffer {
   int samples_per_channel() const;
   int samples_per_split_channel() const;
 
+  // The audio is held both as int16 and as float samples in the int16 range,
+  // with the float samples not rounded. Each band is converted lazily when
+  // the other format is asked for; the accessors returning writable pointers
+  // mark the other format of that band as stale, while the *_const_f()
+  // accessors leave it valid. A component should therefore stick to one
+  // format per band while it holds on to the pointers.
   int16_t* data(int channel) const;
   int16_t* low_pass_split_data(int channel) const;
   int16_t* high_pass_split_data(int channel) const;
-  int16_t* mixed_data(int channel) const;
   int16_t* mixed_low_pass_data(int channel) const;
   int16_t* low_pass_reference(int channel) const;
 
+  float* data_f(int channel) const;
+  const float* data_const_f(int channel) const;
+  float* low_pass_split_data_f(int channel) const;
+  const float* low_pass_split_data_const_f(int channel) const;
+  float* high_pass_split_data_f(int channel) const;
+  const float* high_pass_split_data_const_f(int channel) const;
+  const float* mixed_data_f(int channel) const;
+  // True when the low band is held only as float, i.e. a float component
+  // wrote it last. Components with both an int16 and a float path can use
+  // this to avoid a conversion.
+  bool low_pass_split_data_is_float() const;
+
   int32_t* analysis_filter_state1(int channel) const;
   int32_t* analysis_filter_state2(int channel) const;
   int32_t* synthesis_filter_state1(int channel) const;
@@ -65,9 +82,25 @@ class AudioBuffer {
   void CopyLowPassToReference();
 
  private:
+  enum Band {
+    kFullBand = 0,
+    kLowBand,
+    kHighBand,
+    kNumBands
+  };
+
   // Called from DeinterleaveFrom() and CopyFrom().
   void InitForNewData(int num_channels);
 
+  // The low band is the full band when the signal is not split.
+  Band low_band() const;
+  int16_t* band_data(Band band, int channel) const;
+  float* band_data_f(Band band, int channel) const;
+  int samples_per_band(Band band) const;
+  // Bring the int16 or float samples of all channels of |band| up to date.
+  void RefreshInt16(Band band) const;
+  void RefreshFloat(Band band) const;
+
   const int max_num_channels_;
   int num_channels_;
   int num_mixed_channels_;
@@ -79,6 +112,8 @@ class AudioBuffer {
   bool reference_copied_;
   AudioFrame::VADActivity activity_;
   bool is_muted_;
+  // Which formats of each band hold the current samples.
+  mutable int valid_formats_[kNumBands];
 
   int16_t* data_;
   scoped_array<AudioChannel> channels_;
@@ -87,9 +87,9 @@ int EchoCancellationImpl::ProcessRenderAudio(const AudioBuffer* audio) {
   for (int i = 0; i < apm_->num_output_channels(); i++) {
     for (int j = 0; j < audio->num_channels(); j++) {
       Handle* my_handle = static_cast<Handle*>(handle(handle_index));
-      err = WebRtcAec_BufferFarend(
+      err = WebRtcAec_BufferFarendFloat(
           my_handle,
-          audio->low_pass_split_data(j),
+          audio->low_pass_split_data_const_f(j),
           static_cast<int16_t>(audio->samples_per_split_channel()));
 
       if (err != apm_->kNoError) {
@@ -127,12 +127,12 @@ int EchoCancellationImpl::ProcessCaptureAudio(AudioBuffer* audio) {
   for (int i = 0; i < audio->num_channels(); i++) {
     for (int j = 0; j < apm_->num_reverse_channels(); j++) {
       Handle* my_handle = handle(handle_index);
-      err = WebRtcAec_Process(
+      err = WebRtcAec_ProcessFloat(
           my_handle,
-          audio->low_pass_split_data(i),
-          audio->high_pass_split_data(i),
-          audio->low_pass_split_data(i),
-          audio->high_pass_split_data(i),
+          audio->low_pass_split_data_f(i),
+          audio->high_pass_split_data_f(i),
+          audio->low_pass_split_data_f(i),
+          audio->high_pass_split_data_f(i),
           static_cast<int16_t>(audio->samples_per_split_channel()),
           apm_->stream_delay_ms(),
           stream_drift_samples_);
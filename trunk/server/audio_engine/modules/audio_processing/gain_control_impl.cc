@@ -143,22 +143,41 @@ int GainControlImpl::ProcessCaptureAudio(AudioBuffer* audio) {
   assert(audio->num_channels() == num_handles());
 
   stream_is_saturated_ = false;
+  // Process the bands in the format they are held in. After the float
+  // components this avoids rounding to int16, while an int16 chain (such as
+  // the conference mixer's limiter) stays bit-exact.
+  const bool use_float = audio->low_pass_split_data_is_float();
   for (int i = 0; i < num_handles(); i++) {
     Handle* my_handle = static_cast<Handle*>(handle(i));
     int32_t capture_level_out = 0;
     uint8_t saturation_warning = 0;
 
-    int err = WebRtcAgc_Process(
-        my_handle,
-        audio->low_pass_split_data(i),
-        audio->high_pass_split_data(i),
-        static_cast<int16_t>(audio->samples_per_split_channel()),
-        audio->low_pass_split_data(i),
-        audio->high_pass_split_data(i),
-        capture_levels_[i],
-        &capture_level_out,
-        apm_->echo_cancellation()->stream_has_echo(),
-        &saturation_warning);
+    int err;
+    if (use_float) {
+      err = WebRtcAgc_ProcessFloat(
+          my_handle,
+          audio->low_pass_split_data_f(i),
+          audio->high_pass_split_data_f(i),
+          static_cast<int16_t>(audio->samples_per_split_channel()),
+          audio->low_pass_split_data_f(i),
+          audio->high_pass_split_data_f(i),
+          capture_levels_[i],
+          &capture_level_out,
+          apm_->echo_cancellation()->stream_has_echo(),
+          &saturation_warning);
+    } else {
+      err = WebRtcAgc_Process(
+          my_handle,
+          audio->low_pass_split_data(i),
+          audio->high_pass_split_data(i),
+          static_cast<int16_t>(audio->samples_per_split_channel()),
+          audio->low_pass_split_data(i),
+          audio->high_pass_split_data(i),
+          capture_levels_[i],
+          &capture_level_out,
+          apm_->echo_cancellation()->stream_has_echo(),
+          &saturation_warning);
+    }
 
     if (err != apm_->kNoError) {
       return GetHandleError(my_handle);
@@ -11,6 +11,7 @@
 #include "audio_engine/modules/audio_processing/high_pass_filter_impl.h"
 
 #include <assert.h>
+#include <math.h>
 
 #include "audio_engine/common_audio/signal_processing/include/signal_processing_library.h"
 #include "audio_engine/modules/audio_processing/audio_buffer.h"
@@ -27,75 +28,57 @@ const int16_t kFilterCoefficients[5] =
     {4012, -8024, 4012, 8002, -3913};
 
 struct FilterState {
-  int16_t y[4];
-  int16_t x[2];
-  const int16_t* ba;
+  float y[2];
+  float x[2];
+  // b[0], b[1], b[2], -a[1], -a[2], from the Q12 coefficients above.
+  float ba[5];
 };
 
 int InitializeFilter(FilterState* hpf, int sample_rate_hz) {
   assert(hpf != NULL);
 
+  const int16_t* ba = kFilterCoefficients;
   if (sample_rate_hz == AudioProcessing::kSampleRate8kHz) {
-    hpf->ba = kFilterCoefficients8kHz;
-  } else {
-    hpf->ba = kFilterCoefficients;
+    ba = kFilterCoefficients8kHz;
+  }
+  for (int i = 0; i < 5; i++) {
+    hpf->ba[i] = ba[i] / 4096.0f;
   }
 
-  WebRtcSpl_MemSetW16(hpf->x, 0, 2);
-  WebRtcSpl_MemSetW16(hpf->y, 0, 4);
+  hpf->x[0] = hpf->x[1] = 0.0f;
+  hpf->y[0] = hpf->y[1] = 0.0f;
 
   return AudioProcessing::kNoError;
 }
 
-int Filter(FilterState* hpf, int16_t* data, int length) {
+int Filter(FilterState* hpf, float* data, int length) {
   assert(hpf != NULL);
 
-  int32_t tmp_int32 = 0;
-  int16_t* y = hpf->y;
-  int16_t* x = hpf->x;
-  const int16_t* ba = hpf->ba;
+  // Below this the filter state is inaudible in the int16 range. Flushing it
+  // keeps a decaying state from ending up in denormals on digital silence.
+  const float kMinState = 1e-10f;
+  float* y = hpf->y;
+  float* x = hpf->x;
+  const float* ba = hpf->ba;
 
   for (int i = 0; i < length; i++) {
     //  y[i] = b[0] * x[i] + b[1] * x[i-1] + b[2] * x[i-2]
     //         + -a[1] * y[i-1] + -a[2] * y[i-2];
+    const float out = ba[0] * data[i] + ba[1] * x[0] + ba[2] * x[1] +
+        ba[3] * y[0] + ba[4] * y[1];
 
-    tmp_int32 =
-        WEBRTC_SPL_MUL_16_16(y[1], ba[3]); // -a[1] * y[i-1] (low part)
-    tmp_int32 +=
-        WEBRTC_SPL_MUL_16_16(y[3], ba[4]); // -a[2] * y[i-2] (low part)
-    tmp_int32 = (tmp_int32 >> 15);
-    tmp_int32 +=
-        WEBRTC_SPL_MUL_16_16(y[0], ba[3]); // -a[1] * y[i-1] (high part)
-    tmp_int32 +=
-        WEBRTC_SPL_MUL_16_16(y[2], ba[4]); // -a[2] * y[i-2] (high part)
-    tmp_int32 = (tmp_int32 << 1);
-
-    tmp_int32 += WEBRTC_SPL_MUL_16_16(data[i], ba[0]); // b[0]*x[0]
-    tmp_int32 += WEBRTC_SPL_MUL_16_16(x[0], ba[1]);    // b[1]*x[i-1]
-    tmp_int32 += WEBRTC_SPL_MUL_16_16(x[1], ba[2]);    // b[2]*x[i-2]
-
-    // Update state (input part)
+    // Update state
     x[1] = x[0];
     x[0] = data[i];
+    y[1] = y[0];
+    y[0] = out;
 
-    // Update state (filtered part)
-    y[2] = y[0];
-    y[3] = y[1];
-    y[0] = static_cast<int16_t>(tmp_int32 >> 13);
-    y[1] = static_cast<int16_t>((tmp_int32 -
-        WEBRTC_SPL_LSHIFT_W32(static_cast<int32_t>(y[0]), 13)) << 2);
-
-    // Rounding in Q12, i.e. add 2^11
-    tmp_int32 += 2048;
-
-    // Saturate (to 2^27) so that the HP filtered signal does not overflow
-    tmp_int32 = WEBRTC_SPL_SAT(static_cast<int32_t>(134217727),
-                               tmp_int32,
-                               static_cast<int32_t>(-134217728));
-
-    // Convert back to Q0 and use rounding
-    data[i] = (int16_t)WEBRTC_SPL_RSHIFT_W32(tmp_int32, 12);
+    // Saturate so that the HP filtered signal does not overflow
+    data[i] = WEBRTC_SPL_SAT(32767.0f, out, -32768.0f);
+  }
 
+  if (fabsf(y[0]) < kMinState && fabsf(y[1]) < kMinState) {
+    y[0] = y[1] = 0.0f;
   }
 
   return AudioProcessing::kNoError;
@@ -124,7 +107,7 @@ int HighPassFilterImpl::ProcessCaptureAudio(AudioBuffer* audio) {
   for (int i = 0; i < num_handles(); i++) {
     Handle* my_handle = static_cast<Handle*>(handle(i));
     err = Filter(my_handle,
-                 audio->low_pass_split_data(i),
+                 audio->low_pass_split_data_f(i),
                  audio->samples_per_split_channel());
 
     if (err != apm_->kNoError) {
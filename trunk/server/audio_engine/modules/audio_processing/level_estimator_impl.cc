@@ -36,7 +36,7 @@ class Level {
     sample_count_ = 0;
   }
 
-  void Process(int16_t* data, int length) {
+  void Process(const float* data, int length) {
     assert(data != NULL);
     assert(length > 0);
     sum_square_ += SumSquare(data, length);
@@ -69,7 +69,7 @@ class Level {
   }
 
  private:
-  static double SumSquare(int16_t* data, int length) {
+  static double SumSquare(const float* data, int length) {
     double sum_square = 0.0;
     for (int i = 0; i < length; ++i) {
       double data_d = static_cast<double>(data[i]);
@@ -102,10 +102,10 @@ int LevelEstimatorImpl::ProcessStream(AudioBuffer* audio) {
     return apm_->kNoError;
   }
 
-  int16_t* mixed_data = audio->data(0);
+  const float* mixed_data = audio->data_const_f(0);
   if (audio->num_channels() > 1) {
     audio->CopyAndMix(1);
-    mixed_data = audio->mixed_data(0);
+    mixed_data = audio->mixed_data_f(0);
   }
 
   level->Process(mixed_data, audio->samples_per_channel());
@@ -104,6 +104,18 @@ int WebRtcNs_Process(NsHandle* NS_inst,
                      short* outframe,
                      short* outframe_H);
 
+/*
+ * Same as WebRtcNs_Process(), but for float frames with samples in the int16
+ * range. The output is limited to the int16 range but not rounded, so no
+ * precision is lost between the float components of the audio processing
+ * module.
+ */
+int WebRtcNs_ProcessFloat(NsHandle* NS_inst,
+                          const float* spframe,
+                          const float* spframe_H,
+                          float* outframe,
+                          float* outframe_H);
+
 /* Returns the internally used prior speech probability of the current frame.
  * There is a frequency bin based one as well, with which this should not be
  * confused.
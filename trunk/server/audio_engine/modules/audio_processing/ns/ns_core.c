@@ -17,6 +17,48 @@
 #include "audio_engine/modules/audio_processing/ns/ns_core.h"
 #include "audio_engine/modules/audio_processing/ns/windows_private.h"
 #include "audio_engine/modules/audio_processing/utility/fft4g.h"
+#include "audio_engine/system_wrappers/interface/cpu_features_wrapper.h"
+
+WebRtcNs_ComputeMagnitude_t WebRtcNs_ComputeMagnitude;
+WebRtcNs_ComputeSpectralFlatness_t WebRtcNs_ComputeSpectralFlatness;
+WebRtcNs_NoiseEstimation_t WebRtcNs_NoiseEstimation;
+WebRtcNs_ComputeSnr_t WebRtcNs_ComputeSnr;
+WebRtcNs_UpdateLogLrt_t WebRtcNs_UpdateLogLrt;
+WebRtcNs_SpeechProbability_t WebRtcNs_SpeechProbability;
+WebRtcNs_UpdateNoise_t WebRtcNs_UpdateNoise;
+WebRtcNs_ComputeWienerFilter_t WebRtcNs_ComputeWienerFilter;
+
+// C versions of the per-bin kernels, defined below.
+static void ComputeMagnitude(const float* winData,
+                             int magnLen,
+                             float* real,
+                             float* imag,
+                             float* magn,
+                             float* signalEnergy,
+                             float* sumMagn);
+static void ComputeSpectralFlatness(NSinst_t* inst, float* magnIn);
+static void NoiseEstimation(NSinst_t* inst, float* magn, float* noise);
+static void ComputeSnr(const NSinst_t* inst,
+                       const float* magn,
+                       const float* noise,
+                       float* snrLocPrior,
+                       float* snrLocPost,
+                       float* previousEstimateStsa);
+static float UpdateLogLrt(NSinst_t* inst,
+                          const float* snrLocPrior,
+                          const float* snrLocPost);
+static void SpeechProbability(const NSinst_t* inst,
+                              float gainPrior,
+                              float* probSpeechFinal);
+static void UpdateNoise(NSinst_t* inst,
+                        const float* magn,
+                        const float* probSpeechFinal,
+                        float* noise);
+static void ComputeWienerFilter(const NSinst_t* inst,
+                                const float* magn,
+                                const float* noise,
+                                const float* previousEstimateStsa,
+                                float* theFilter);
 
 // Set Feature Extraction Parameters
 void WebRtcNs_set_feature_extraction_parameters(NSinst_t* inst) {
@@ -202,6 +244,22 @@ int WebRtcNs_InitCore(NSinst_t* inst, uint32_t fs) {
 
   memset(inst->outBuf, 0, sizeof(float) * 3 * BLOCKL_MAX);
 
+  // Per-bin kernels
+  WebRtcNs_ComputeMagnitude = ComputeMagnitude;
+  WebRtcNs_ComputeSpectralFlatness = ComputeSpectralFlatness;
+  WebRtcNs_NoiseEstimation = NoiseEstimation;
+  WebRtcNs_ComputeSnr = ComputeSnr;
+  WebRtcNs_UpdateLogLrt = UpdateLogLrt;
+  WebRtcNs_SpeechProbability = SpeechProbability;
+  WebRtcNs_UpdateNoise = UpdateNoise;
+  WebRtcNs_ComputeWienerFilter = ComputeWienerFilter;
+
+#if defined(VOIP_ARCH_X86_FAMILY)
+  if (WebRtc_GetCPUInfo(kSSE2)) {
+    WebRtcNs_InitCore_SSE2();
+  }
+#endif
+
   inst->initFlag = 1;
   return 0;
 }
@@ -237,7 +295,7 @@ int WebRtcNs_set_policy_core(NSinst_t* inst, int mode) {
 }
 
 // Estimate noise
-void WebRtcNs_NoiseEstimation(NSinst_t* inst, float* magn, float* noise) {
+static void NoiseEstimation(NSinst_t* inst, float* magn, float* noise) {
   int i, s, offset;
   float lmagn[HALF_ANAL_BLOCKL], delta;
 
@@ -528,7 +586,7 @@ void WebRtcNs_FeatureParameterExtraction(NSinst_t* inst, int flag) {
 // Compute spectral flatness on input spectrum
 // magnIn is the magnitude spectrum
 // spectral flatness is returned in inst->featureData[0]
-void WebRtcNs_ComputeSpectralFlatness(NSinst_t* inst, float* magnIn) {
+static void ComputeSpectralFlatness(NSinst_t* inst, float* magnIn) {
   int i;
   int shiftLP = 1; //option to remove first bin(s) from spectral measures
   float avgSpectralFlatnessNum, avgSpectralFlatnessDen, spectralTmp;
@@ -601,6 +659,39 @@ void WebRtcNs_ComputeSpectralDifference(NSinst_t* inst, float* magnIn) {
   inst->featureData[4] += SPECT_DIFF_TAVG * (avgDiffNormMagn - inst->featureData[4]);
 }
 
+// Update the smoothed log likelihood ratio of each bin from the prior and post
+// snr, and return the sum over all bins.
+static float UpdateLogLrt(NSinst_t* inst,
+                          const float* snrLocPrior,
+                          const float* snrLocPost) {
+  int i;
+  float tmpFloat1, tmpFloat2, besselTmp;
+  float logLrtTimeAvgKsum = 0.0;
+  for (i = 0; i < inst->magnLen; i++) {
+    tmpFloat1 = (float)1.0 + (float)2.0 * snrLocPrior[i];
+    tmpFloat2 = (float)2.0 * snrLocPrior[i] / (tmpFloat1 + (float)0.0001);
+    besselTmp = (snrLocPost[i] + (float)1.0) * tmpFloat2;
+    inst->logLrtTimeAvg[i] += LRT_TAVG * (besselTmp - (float)log(tmpFloat1)
+                                          - inst->logLrtTimeAvg[i]);
+    logLrtTimeAvgKsum += inst->logLrtTimeAvg[i];
+  }
+  return logLrtTimeAvgKsum;
+}
+
+// Final speech probability of each bin: combine the prior model, given as
+// gainPrior = (1 - prior) / prior, with the LR factor.
+static void SpeechProbability(const NSinst_t* inst,
+                              float gainPrior,
+                              float* probSpeechFinal) {
+  int i;
+  float invLrt;
+  for (i = 0; i < inst->magnLen; i++) {
+    invLrt = (float)exp(-inst->logLrtTimeAvg[i]);
+    invLrt = (float)gainPrior * invLrt;
+    probSpeechFinal[i] = (float)1.0 / ((float)1.0 + invLrt);
+  }
+}
+
 // Compute speech/noise probability
 // speech/noise probability is returned in: probSpeechFinal
 //magn is the input magnitude spectrum
@@ -609,11 +700,11 @@ void WebRtcNs_ComputeSpectralDifference(NSinst_t* inst, float* magnIn) {
 //snr loc_post is the post snr for each freq.
 void WebRtcNs_SpeechNoiseProb(NSinst_t* inst, float* probSpeechFinal, float* snrLocPrior,
                               float* snrLocPost) {
-  int i, sgnMap;
-  float invLrt, gainPrior, indPrior;
-  float logLrtTimeAvgKsum, besselTmp;
+  int sgnMap;
+  float gainPrior, indPrior;
+  float logLrtTimeAvgKsum;
   float indicator0, indicator1, indicator2;
-  float tmpFloat1, tmpFloat2;
+  float tmpFloat1;
   float weightIndPrior0, weightIndPrior1, weightIndPrior2;
   float threshPrior0, threshPrior1, threshPrior2;
   float widthPrior, widthPrior0, widthPrior1, widthPrior2;
@@ -638,15 +729,7 @@ void WebRtcNs_SpeechNoiseProb(NSinst_t* inst, float* probSpeechFinal, float* snr
 
   // compute feature based on average LR factor
   // this is the average over all frequencies of the smooth log lrt
-  logLrtTimeAvgKsum = 0.0;
-  for (i = 0; i < inst->magnLen; i++) {
-    tmpFloat1 = (float)1.0 + (float)2.0 * snrLocPrior[i];
-    tmpFloat2 = (float)2.0 * snrLocPrior[i] / (tmpFloat1 + (float)0.0001);
-    besselTmp = (snrLocPost[i] + (float)1.0) * tmpFloat2;
-    inst->logLrtTimeAvg[i] += LRT_TAVG * (besselTmp - (float)log(tmpFloat1)
-                                          - inst->logLrtTimeAvg[i]);
-    logLrtTimeAvgKsum += inst->logLrtTimeAvg[i];
-  }
+  logLrtTimeAvgKsum = WebRtcNs_UpdateLogLrt(inst, snrLocPrior, snrLocPost);
   logLrtTimeAvgKsum = (float)logLrtTimeAvgKsum / (inst->magnLen);
   inst->featureData[3] = logLrtTimeAvgKsum;
   // done with computation of LR factor
@@ -707,18 +790,135 @@ void WebRtcNs_SpeechNoiseProb(NSinst_t* inst, float* probSpeechFinal, float* snr
 
   //final speech probability: combine prior model with LR factor:
   gainPrior = ((float)1.0 - inst->priorSpeechProb) / (inst->priorSpeechProb + (float)0.0001);
-  for (i = 0; i < inst->magnLen; i++) {
-    invLrt = (float)exp(-inst->logLrtTimeAvg[i]);
-    invLrt = (float)gainPrior * invLrt;
-    probSpeechFinal[i] = (float)1.0 / ((float)1.0 + invLrt);
+  WebRtcNs_SpeechProbability(inst, gainPrior, probSpeechFinal);
+}
+
+static void ComputeMagnitude(const float* winData,
+                             int magnLen,
+                             float* real,
+                             float* imag,
+                             float* magn,
+                             float* signalEnergy,
+                             float* sumMagn) {
+  int i;
+  float fTmp;
+  for (i = 1; i < magnLen - 1; i++) {
+    real[i] = winData[2 * i];
+    imag[i] = winData[2 * i + 1];
+    // magnitude spectrum
+    fTmp = real[i] * real[i];
+    fTmp += imag[i] * imag[i];
+    *signalEnergy += fTmp;
+    magn[i] = ((float)sqrt(fTmp)) + 1.0f;
+    *sumMagn += magn[i];
   }
 }
 
+// Post snr and directed decision (DD) estimate of the prior snr of each bin,
+// based on the quantile noise estimate.
+static void ComputeSnr(const NSinst_t* inst,
+                       const float* magn,
+                       const float* noise,
+                       float* snrLocPrior,
+                       float* snrLocPost,
+                       float* previousEstimateStsa) {
+  int i;
+  for (i = 0; i < inst->magnLen; i++) {
+    // post snr
+    snrLocPost[i] = (float)0.0;
+    if (magn[i] > noise[i]) {
+      snrLocPost[i] = magn[i] / (noise[i] + (float)0.0001) - (float)1.0;
+    }
+    // previous post snr
+    // previous estimate: based on previous frame with gain filter
+    previousEstimateStsa[i] = inst->magnPrev[i] / (inst->noisePrev[i] + (float)0.0001)
+                              * (inst->smooth[i]);
+    // DD estimate is sum of two terms: current estimate and previous estimate
+    // directed decision update of snrPrior
+    snrLocPrior[i] = DD_PR_SNR * previousEstimateStsa[i] + ((float)1.0 - DD_PR_SNR)
+                     * snrLocPost[i];
+    // post and prior snr needed for step 2
+  }  // end of loop over freqs
+}
+
+// Update the noise estimate with the speech probability of each bin. The time
+// constant of a bin depends on the speech probability of the previous bin.
+static void UpdateNoise(NSinst_t* inst,
+                        const float* magn,
+                        const float* probSpeechFinal,
+                        float* noise) {
+  int i;
+  float probSpeech, probNonSpeech;
+  float gammaNoiseTmp, gammaNoiseOld;
+  float noiseUpdateTmp;
+  // time-avg parameter for noise update
+  gammaNoiseTmp = NOISE_UPDATE;
+  for (i = 0; i < inst->magnLen; i++) {
+    probSpeech = probSpeechFinal[i];
+    probNonSpeech = (float)1.0 - probSpeech;
+    // temporary noise update:
+    // use it for speech frames if update value is less than previous
+    noiseUpdateTmp = gammaNoiseTmp * inst->noisePrev[i] + ((float)1.0 - gammaNoiseTmp)
+                     * (probNonSpeech * magn[i] + probSpeech * inst->noisePrev[i]);
+    //
+    // time-constant based on speech/noise state
+    gammaNoiseOld = gammaNoiseTmp;
+    gammaNoiseTmp = NOISE_UPDATE;
+    // increase gamma (i.e., less noise update) for frame likely to be speech
+    if (probSpeech > PROB_RANGE) {
+      gammaNoiseTmp = SPEECH_UPDATE;
+    }
+    // conservative noise update
+    if (probSpeech < PROB_RANGE) {
+      inst->magnAvgPause[i] += GAMMA_PAUSE * (magn[i] - inst->magnAvgPause[i]);
+    }
+    // noise update
+    if (gammaNoiseTmp == gammaNoiseOld) {
+      noise[i] = noiseUpdateTmp;
+    } else {
+      noise[i] = gammaNoiseTmp * inst->noisePrev[i] + ((float)1.0 - gammaNoiseTmp)
+                 * (probNonSpeech * magn[i] + probSpeech * inst->noisePrev[i]);
+      // allow for noise update downwards:
+      //  if noise update decreases the noise, it is safe, so allow it to happen
+      if (noiseUpdateTmp < noise[i]) {
+        noise[i] = noiseUpdateTmp;
+      }
+    }
+  }  // end of freq loop
+}
+
+// DD update of the prior snr with the updated noise estimate, and the Wiener
+// gain filter of each bin.
+static void ComputeWienerFilter(const NSinst_t* inst,
+                                const float* magn,
+                                const float* noise,
+                                const float* previousEstimateStsa,
+                                float* theFilter) {
+  int i;
+  float snrPrior, currentEstimateStsa;
+  float tmpFloat1, tmpFloat2;
+  for (i = 0; i < inst->magnLen; i++) {
+    // post and prior snr
+    currentEstimateStsa = (float)0.0;
+    if (magn[i] > noise[i]) {
+      currentEstimateStsa = magn[i] / (noise[i] + (float)0.0001) - (float)1.0;
+    }
+    // DD estimate is sume of two terms: current estimate and previous estimate
+    // directed decision update of snrPrior
+    snrPrior = DD_PR_SNR * previousEstimateStsa[i] + ((float)1.0 - DD_PR_SNR)
+               * currentEstimateStsa;
+    // gain filter
+    tmpFloat1 = inst->overdrive + snrPrior;
+    tmpFloat2 = (float)snrPrior / tmpFloat1;
+    theFilter[i] = (float)tmpFloat2;
+  }  // end of loop over freqs
+}
+
 int WebRtcNs_ProcessCore(NSinst_t* inst,
-                         short* speechFrame,
-                         short* speechFrameHB,
-                         short* outFrame,
-                         short* outFrameHB) {
+                         const float* speechFrame,
+                         const float* speechFrameHB,
+                         float* outFrame,
+                         float* outFrameHB) {
   // main routine for noise reduction
 
   int     flagHB = 0;
@@ -728,11 +928,9 @@ int WebRtcNs_ProcessCore(NSinst_t* inst,
 
   float   energy1, energy2, gain, factor, factor1, factor2;
   float   signalEnergy, sumMagn;
-  float   snrPrior, currentEstimateStsa;
-  float   tmpFloat1, tmpFloat2, tmpFloat3, probSpeech, probNonSpeech;
-  float   gammaNoiseTmp, gammaNoiseOld;
-  float   noiseUpdateTmp, fTmp, dTmp;
-  float   fin[BLOCKL_MAX], fout[BLOCKL_MAX];
+  float   tmpFloat1, tmpFloat2, tmpFloat3;
+  float   dTmp;
+  float   fout[BLOCKL_MAX];
   float   winData[ANAL_BLOCKL_MAX];
   float   magn[HALF_ANAL_BLOCKL], noise[HALF_ANAL_BLOCKL];
   float   theFilter[HALF_ANAL_BLOCKL], theFilterTmp[HALF_ANAL_BLOCKL];
@@ -776,25 +974,17 @@ int WebRtcNs_ProcessCore(NSinst_t* inst,
   //
 
   //for LB do all processing
-  // convert to float
-  for (i = 0; i < inst->blockLen10ms; i++) {
-    fin[i] = (float)speechFrame[i];
-  }
   // update analysis buffer for L band
   memcpy(inst->dataBuf, inst->dataBuf + inst->blockLen10ms,
          sizeof(float) * (inst->anaLen - inst->blockLen10ms));
-  memcpy(inst->dataBuf + inst->anaLen - inst->blockLen10ms, fin,
+  memcpy(inst->dataBuf + inst->anaLen - inst->blockLen10ms, speechFrame,
          sizeof(float) * inst->blockLen10ms);
 
   if (flagHB == 1) {
-    // convert to float
-    for (i = 0; i < inst->blockLen10ms; i++) {
-      fin[i] = (float)speechFrameHB[i];
-    }
     // update analysis buffer for H band
     memcpy(inst->dataBufHB, inst->dataBufHB + inst->blockLen10ms,
            sizeof(float) * (inst->anaLen - inst->blockLen10ms));
-    memcpy(inst->dataBufHB + inst->anaLen - inst->blockLen10ms, fin,
+    memcpy(inst->dataBufHB + inst->anaLen - inst->blockLen10ms, speechFrameHB,
            sizeof(float) * inst->blockLen10ms);
   }
 
@@ -833,7 +1023,7 @@ int WebRtcNs_ProcessCore(NSinst_t* inst,
           inst->outBuf[i] = fout[i + inst->blockLen10ms];
         }
       }
-      // convert to short
+      // limit to the int16 range
       for (i = 0; i < inst->blockLen10ms; i++) {
         dTmp = fout[i];
         if (dTmp < WEBRTC_SPL_WORD16_MIN) {
@@ -841,7 +1031,7 @@ int WebRtcNs_ProcessCore(NSinst_t* inst,
         } else if (dTmp > WEBRTC_SPL_WORD16_MAX) {
           dTmp = WEBRTC_SPL_WORD16_MAX;
         }
-        outFrame[i] = (short)dTmp;
+        outFrame[i] = dTmp;
       }
 
       // for time-domain gain of HB
@@ -853,7 +1043,7 @@ int WebRtcNs_ProcessCore(NSinst_t* inst,
           } else if (dTmp > WEBRTC_SPL_WORD16_MAX) {
             dTmp = WEBRTC_SPL_WORD16_MAX;
           }
-          outFrameHB[i] = (short)dTmp;
+          outFrameHB[i] = dTmp;
         }
       }  // end of H band gain computation
       //
@@ -884,16 +1074,11 @@ int WebRtcNs_ProcessCore(NSinst_t* inst,
       sum_log_magn = tmpFloat1;
       sum_log_i_log_magn = tmpFloat2 * tmpFloat1;
     }
-    for (i = 1; i < inst->magnLen - 1; i++) {
-      real[i] = winData[2 * i];
-      imag[i] = winData[2 * i + 1];
-      // magnitude spectrum
-      fTmp = real[i] * real[i];
-      fTmp += imag[i] * imag[i];
-      signalEnergy += fTmp;
-      magn[i] = ((float)sqrt(fTmp)) + 1.0f;
-      sumMagn += magn[i];
-      if (inst->blockInd < END_STARTUP_SHORT) {
+    // magnitude spectrum
+    WebRtcNs_ComputeMagnitude(winData, inst->magnLen, real, imag, magn,
+                              &signalEnergy, &sumMagn);
+    if (inst->blockInd < END_STARTUP_SHORT) {
+      for (i = 1; i < inst->magnLen - 1; i++) {
         inst->initMagnEst[i] += magn[i];
         if (i >= kStartBand) {
           tmpFloat2 = log((float)i);
@@ -991,22 +1176,8 @@ int WebRtcNs_ProcessCore(NSinst_t* inst,
     //
 
     // compute DD estimate of prior SNR: needed for new method
-    for (i = 0; i < inst->magnLen; i++) {
-      // post snr
-      snrLocPost[i] = (float)0.0;
-      if (magn[i] > noise[i]) {
-        snrLocPost[i] = magn[i] / (noise[i] + (float)0.0001) - (float)1.0;
-      }
-      // previous post snr
-      // previous estimate: based on previous frame with gain filter
-      previousEstimateStsa[i] = inst->magnPrev[i] / (inst->noisePrev[i] + (float)0.0001)
-                                * (inst->smooth[i]);
-      // DD estimate is sum of two terms: current estimate and previous estimate
-      // directed decision update of snrPrior
-      snrLocPrior[i] = DD_PR_SNR * previousEstimateStsa[i] + ((float)1.0 - DD_PR_SNR)
-                       * snrLocPost[i];
-      // post and prior snr needed for step 2
-    }  // end of loop over freqs
+    WebRtcNs_ComputeSnr(inst, magn, noise, snrLocPrior, snrLocPost,
+                        previousEstimateStsa);
 #ifdef PROCESS_FLOW_1
     for (i = 0; i < inst->magnLen; i++) {
       // gain filter
@@ -1052,60 +1223,15 @@ int WebRtcNs_ProcessCore(NSinst_t* inst,
     }
     // compute speech/noise probability
     WebRtcNs_SpeechNoiseProb(inst, probSpeechFinal, snrLocPrior, snrLocPost);
-    // time-avg parameter for noise update
-    gammaNoiseTmp = NOISE_UPDATE;
-    for (i = 0; i < inst->magnLen; i++) {
-      probSpeech = probSpeechFinal[i];
-      probNonSpeech = (float)1.0 - probSpeech;
-      // temporary noise update:
-      // use it for speech frames if update value is less than previous
-      noiseUpdateTmp = gammaNoiseTmp * inst->noisePrev[i] + ((float)1.0 - gammaNoiseTmp)
-                       * (probNonSpeech * magn[i] + probSpeech * inst->noisePrev[i]);
-      //
-      // time-constant based on speech/noise state
-      gammaNoiseOld = gammaNoiseTmp;
-      gammaNoiseTmp = NOISE_UPDATE;
-      // increase gamma (i.e., less noise update) for frame likely to be speech
-      if (probSpeech > PROB_RANGE) {
-        gammaNoiseTmp = SPEECH_UPDATE;
-      }
-      // conservative noise update
-      if (probSpeech < PROB_RANGE) {
-        inst->magnAvgPause[i] += GAMMA_PAUSE * (magn[i] - inst->magnAvgPause[i]);
-      }
-      // noise update
-      if (gammaNoiseTmp == gammaNoiseOld) {
-        noise[i] = noiseUpdateTmp;
-      } else {
-        noise[i] = gammaNoiseTmp * inst->noisePrev[i] + ((float)1.0 - gammaNoiseTmp)
-                   * (probNonSpeech * magn[i] + probSpeech * inst->noisePrev[i]);
-        // allow for noise update downwards:
-        //  if noise update decreases the noise, it is safe, so allow it to happen
-        if (noiseUpdateTmp < noise[i]) {
-          noise[i] = noiseUpdateTmp;
-        }
-      }
-    }  // end of freq loop
+    // noise update
+    WebRtcNs_UpdateNoise(inst, magn, probSpeechFinal, noise);
     // done with step 2: noise update
 
     //
     // STEP 3: compute dd update of prior snr and post snr based on new noise estimate
     //
-    for (i = 0; i < inst->magnLen; i++) {
-      // post and prior snr
-      currentEstimateStsa = (float)0.0;
-      if (magn[i] > noise[i]) {
-        currentEstimateStsa = magn[i] / (noise[i] + (float)0.0001) - (float)1.0;
-      }
-      // DD estimate is sume of two terms: current estimate and previous estimate
-      // directed decision update of snrPrior
-      snrPrior = DD_PR_SNR * previousEstimateStsa[i] + ((float)1.0 - DD_PR_SNR)
-                 * currentEstimateStsa;
-      // gain filter
-      tmpFloat1 = inst->overdrive + snrPrior;
-      tmpFloat2 = (float)snrPrior / tmpFloat1;
-      theFilter[i] = (float)tmpFloat2;
-    }  // end of loop over freqs
+    WebRtcNs_ComputeWienerFilter(inst, magn, noise, previousEstimateStsa,
+                                 theFilter);
     // done with step3
 #endif
 #endif
@@ -1239,7 +1365,7 @@ int WebRtcNs_ProcessCore(NSinst_t* inst,
     inst->outLen -= inst->blockLen10ms;
   }
 
-  // convert to short
+  // limit to the int16 range
   for (i = 0; i < inst->blockLen10ms; i++) {
     dTmp = fout[i];
     if (dTmp < WEBRTC_SPL_WORD16_MIN) {
@@ -1247,7 +1373,7 @@ int WebRtcNs_ProcessCore(NSinst_t* inst,
     } else if (dTmp > WEBRTC_SPL_WORD16_MAX) {
       dTmp = WEBRTC_SPL_WORD16_MAX;
     }
-    outFrame[i] = (short)dTmp;
+    outFrame[i] = dTmp;
   }
 
   // for time-domain gain of HB
@@ -1295,7 +1421,7 @@ int WebRtcNs_ProcessCore(NSinst_t* inst,
       } else if (dTmp > WEBRTC_SPL_WORD16_MAX) {
         dTmp = WEBRTC_SPL_WORD16_MAX;
       }
-      outFrameHB[i] = (short)dTmp;
+      outFrameHB[i] = dTmp;
     }
   }  // end of H band gain computation
   //
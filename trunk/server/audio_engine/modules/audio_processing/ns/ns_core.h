@@ -149,7 +149,8 @@ int WebRtcNs_set_policy_core(NSinst_t* inst, int mode);
 /****************************************************************************
  * WebRtcNs_ProcessCore
  *
- * Do noise suppression.
+ * Do noise suppression. The frames hold samples in the int16 range, but are
+ * not rounded; the output is limited to the int16 range.
  *
  * Input:
  *      - inst          : Instance that should be initialized
@@ -167,10 +168,57 @@ int WebRtcNs_set_policy_core(NSinst_t* inst, int mode);
 
 
 int WebRtcNs_ProcessCore(NSinst_t* inst,
-                         short* inFrameLow,
-                         short* inFrameHigh,
-                         short* outFrameLow,
-                         short* outFrameHigh);
+                         const float* inFrameLow,
+                         const float* inFrameHigh,
+                         float* outFrameLow,
+                         float* outFrameHigh);
+
+// Per-bin kernels of WebRtcNs_ProcessCore(). They are set up by
+// WebRtcNs_InitCore(), which installs the SSE2 versions when the CPU supports
+// them.
+typedef void (*WebRtcNs_ComputeMagnitude_t)(const float* winData,
+                                            int magnLen,
+                                            float* real,
+                                            float* imag,
+                                            float* magn,
+                                            float* signalEnergy,
+                                            float* sumMagn);
+extern WebRtcNs_ComputeMagnitude_t WebRtcNs_ComputeMagnitude;
+typedef void (*WebRtcNs_ComputeSpectralFlatness_t)(NSinst_t* inst,
+                                                   float* magnIn);
+extern WebRtcNs_ComputeSpectralFlatness_t WebRtcNs_ComputeSpectralFlatness;
+typedef void (*WebRtcNs_NoiseEstimation_t)(NSinst_t* inst,
+                                           float* magn,
+                                           float* noise);
+extern WebRtcNs_NoiseEstimation_t WebRtcNs_NoiseEstimation;
+typedef void (*WebRtcNs_ComputeSnr_t)(const NSinst_t* inst,
+                                      const float* magn,
+                                      const float* noise,
+                                      float* snrLocPrior,
+                                      float* snrLocPost,
+                                      float* previousEstimateStsa);
+extern WebRtcNs_ComputeSnr_t WebRtcNs_ComputeSnr;
+typedef float (*WebRtcNs_UpdateLogLrt_t)(NSinst_t* inst,
+                                         const float* snrLocPrior,
+                                         const float* snrLocPost);
+extern WebRtcNs_UpdateLogLrt_t WebRtcNs_UpdateLogLrt;
+typedef void (*WebRtcNs_SpeechProbability_t)(const NSinst_t* inst,
+                                             float gainPrior,
+                                             float* probSpeechFinal);
+extern WebRtcNs_SpeechProbability_t WebRtcNs_SpeechProbability;
+typedef void (*WebRtcNs_UpdateNoise_t)(NSinst_t* inst,
+                                       const float* magn,
+                                       const float* probSpeechFinal,
+                                       float* noise);
+extern WebRtcNs_UpdateNoise_t WebRtcNs_UpdateNoise;
+typedef void (*WebRtcNs_ComputeWienerFilter_t)(const NSinst_t* inst,
+                                               const float* magn,
+                                               const float* noise,
+                                               const float* previousEstimateStsa,
+                                               float* theFilter);
+extern WebRtcNs_ComputeWienerFilter_t WebRtcNs_ComputeWienerFilter;
+
+void WebRtcNs_InitCore_SSE2(void);
 
 
 #ifdef __cplusplus
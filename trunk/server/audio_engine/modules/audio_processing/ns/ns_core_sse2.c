@@ -0,0 +1,516 @@
+/*
+ *  Copyright (c) 2014 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+/*
+ * SSE2 versions of the per-bin kernels of the noise suppression core. Four
+ * frequency bins are processed at once. The log() and exp() calls are
+ * replaced by the polynomial approximations below; the remaining kernels
+ * give the same result as the C code, except that sums are accumulated in
+ * a different order.
+ */
+
+#include <emmintrin.h>
+#include <math.h>
+#include <string.h>
+
+#include "audio_engine/include/typedefs.h"
+#include "audio_engine/modules/audio_processing/ns/ns_core.h"
+
+// Natural logarithm of four positive, normal floats. x = m * 2^e with m in
+// [sqrt(0.5), sqrt(2)), and log(m) is evaluated with the Cephes logf()
+// polynomial. The error is a few ulp.
+static __m128 LogSSE2(__m128 x) {
+  const __m128 one = _mm_set1_ps(1.0f);
+  const __m128 half = _mm_set1_ps(0.5f);
+  __m128 e, z, y, mask;
+  __m128i exponent = _mm_srli_epi32(_mm_castps_si128(x), 23);
+
+  // Mantissa in [0.5, 1).
+  x = _mm_and_ps(x, _mm_castsi128_ps(_mm_set1_epi32(~0x7F800000)));
+  x = _mm_or_ps(x, half);
+  exponent = _mm_sub_epi32(exponent, _mm_set1_epi32(0x7E));
+  e = _mm_cvtepi32_ps(exponent);
+
+  // Move m below sqrt(0.5) up an octave: m -> 2 * m - 1, e -> e - 1.
+  mask = _mm_cmplt_ps(x, _mm_set1_ps(0.707106781186547524f));
+  e = _mm_sub_ps(e, _mm_and_ps(one, mask));
+  x = _mm_add_ps(_mm_sub_ps(x, one), _mm_and_ps(x, mask));
+
+  z = _mm_mul_ps(x, x);
+  y = _mm_set1_ps(7.0376836292e-2f);
+  y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(-1.1514610310e-1f));
+  y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(1.1676998740e-1f));
+  y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(-1.2420140846e-1f));
+  y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(1.4249322787e-1f));
+  y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(-1.6668057665e-1f));
+  y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(2.0000714765e-1f));
+  y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(-2.4999993993e-1f));
+  y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(3.3333331174e-1f));
+  y = _mm_mul_ps(_mm_mul_ps(y, x), z);
+
+  // log(x) = log(m) + e * log(2), with log(2) split in two parts.
+  y = _mm_add_ps(y, _mm_mul_ps(e, _mm_set1_ps(-2.12194440e-4f)));
+  y = _mm_sub_ps(y, _mm_mul_ps(z, half));
+  x = _mm_add_ps(x, y);
+  return _mm_add_ps(x, _mm_mul_ps(e, _mm_set1_ps(0.693359375f)));
+}
+
+// exp() of four floats. x = n * log(2) + r with |r| <= log(2) / 2, and
+// exp(r) is evaluated with the Cephes expf() polynomial. The input is
+// limited to [-88, 88], so the result is always finite.
+static __m128 ExpSSE2(__m128 x) {
+  const __m128 one = _mm_set1_ps(1.0f);
+  __m128 fx, tmp, y, z;
+  __m128i n;
+
+  x = _mm_min_ps(x, _mm_set1_ps(88.0f));
+  x = _mm_max_ps(x, _mm_set1_ps(-88.0f));
+
+  // n = floor(x / log(2) + 0.5)
+  fx = _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(1.44269504088896341f)),
+                  _mm_set1_ps(0.5f));
+  tmp = _mm_cvtepi32_ps(_mm_cvttps_epi32(fx));
+  fx = _mm_sub_ps(tmp, _mm_and_ps(_mm_cmpgt_ps(tmp, fx), one));
+
+  x = _mm_sub_ps(x, _mm_mul_ps(fx, _mm_set1_ps(0.693359375f)));
+  x = _mm_sub_ps(x, _mm_mul_ps(fx, _mm_set1_ps(-2.12194440e-4f)));
+  z = _mm_mul_ps(x, x);
+
+  y = _mm_set1_ps(1.9875691500e-4f);
+  y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(1.3981999507e-3f));
+  y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(8.3334519073e-3f));
+  y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(4.1665795894e-2f));
+  y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(1.6666665459e-1f));
+  y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(5.0000001201e-1f));
+  y = _mm_add_ps(_mm_add_ps(_mm_mul_ps(y, z), x), one);
+
+  // Scale by 2^n.
+  n = _mm_add_epi32(_mm_cvttps_epi32(fx), _mm_set1_epi32(0x7F));
+  return _mm_mul_ps(y, _mm_castsi128_ps(_mm_slli_epi32(n, 23)));
+}
+
+static __inline float SumSSE2(__m128 v) {
+  v = _mm_add_ps(v, _mm_movehl_ps(v, v));
+  v = _mm_add_ss(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)));
+  return _mm_cvtss_f32(v);
+}
+
+// Returns |a| where |mask| is set and |b| elsewhere.
+static __inline __m128 SelectSSE2(__m128 mask, __m128 a, __m128 b) {
+  return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+static void ComputeMagnitudeSSE2(const float* winData,
+                                 int magnLen,
+                                 float* real,
+                                 float* imag,
+                                 float* magn,
+                                 float* signalEnergy,
+                                 float* sumMagn) {
+  const __m128 one = _mm_set1_ps(1.0f);
+  __m128 energy = _mm_setzero_ps();
+  __m128 sum = _mm_setzero_ps();
+  float fTmp;
+  int i;
+
+  for (i = 1; i + 3 < magnLen - 1; i += 4) {
+    const __m128 a = _mm_loadu_ps(&winData[2 * i]);
+    const __m128 b = _mm_loadu_ps(&winData[2 * i + 4]);
+    const __m128 re = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+    const __m128 im = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+    const __m128 power = _mm_add_ps(_mm_mul_ps(re, re), _mm_mul_ps(im, im));
+    const __m128 m = _mm_add_ps(_mm_sqrt_ps(power), one);
+    _mm_storeu_ps(&real[i], re);
+    _mm_storeu_ps(&imag[i], im);
+    _mm_storeu_ps(&magn[i], m);
+    energy = _mm_add_ps(energy, power);
+    sum = _mm_add_ps(sum, m);
+  }
+  *signalEnergy += SumSSE2(energy);
+  *sumMagn += SumSSE2(sum);
+  for (; i < magnLen - 1; i++) {
+    real[i] = winData[2 * i];
+    imag[i] = winData[2 * i + 1];
+    fTmp = real[i] * real[i];
+    fTmp += imag[i] * imag[i];
+    *signalEnergy += fTmp;
+    magn[i] = ((float)sqrt(fTmp)) + 1.0f;
+    *sumMagn += magn[i];
+  }
+}
+
+static void ComputeSpectralFlatnessSSE2(NSinst_t* inst, float* magnIn) {
+  const int shiftLP = 1;  // option to remove first bin(s) from spectral measures
+  __m128 nonPositive = _mm_setzero_ps();
+  __m128 sum = _mm_setzero_ps();
+  float avgSpectralFlatnessNum, avgSpectralFlatnessDen, spectralTmp;
+  int i;
+
+  avgSpectralFlatnessDen = inst->sumMagn;
+  for (i = 0; i < shiftLP; i++) {
+    avgSpectralFlatnessDen -= magnIn[i];
+  }
+  for (i = shiftLP; i + 3 < inst->magnLen; i += 4) {
+    const __m128 m = _mm_loadu_ps(&magnIn[i]);
+    nonPositive = _mm_or_ps(nonPositive, _mm_cmpngt_ps(m, _mm_setzero_ps()));
+    sum = _mm_add_ps(sum, LogSSE2(m));
+  }
+  avgSpectralFlatnessNum = SumSSE2(sum);
+  for (; i < inst->magnLen; i++) {
+    if (!(magnIn[i] > 0.0)) {
+      nonPositive = _mm_cmpeq_ps(_mm_setzero_ps(), _mm_setzero_ps());
+      break;
+    }
+    avgSpectralFlatnessNum += (float)log(magnIn[i]);
+  }
+  // check for log(0) case
+  if (_mm_movemask_ps(nonPositive)) {
+    inst->featureData[0] -= SPECT_FL_TAVG * inst->featureData[0];
+    return;
+  }
+  //normalize
+  avgSpectralFlatnessDen = avgSpectralFlatnessDen / inst->magnLen;
+  avgSpectralFlatnessNum = avgSpectralFlatnessNum / inst->magnLen;
+
+  //ratio and inverse log
+  spectralTmp = (float)exp(avgSpectralFlatnessNum) / avgSpectralFlatnessDen;
+
+  //time-avg update of spectral flatness feature
+  inst->featureData[0] += SPECT_FL_TAVG * (spectralTmp - inst->featureData[0]);
+}
+
+// Sets the quantile noise estimate from the log quantiles at |offset|.
+static void UpdateQuantileSSE2(NSinst_t* inst, int offset) {
+  int i;
+  for (i = 0; i + 3 < inst->magnLen; i += 4) {
+    _mm_storeu_ps(&inst->quantile[i],
+                  ExpSSE2(_mm_loadu_ps(&inst->lquantile[offset + i])));
+  }
+  for (; i < inst->magnLen; i++) {
+    inst->quantile[i] = (float)exp(inst->lquantile[offset + i]);
+  }
+}
+
+static void NoiseEstimationSSE2(NSinst_t* inst, float* magn, float* noise) {
+  const __m128 one = _mm_set1_ps(1.0f);
+  const __m128 factor = _mm_set1_ps(FACTOR);
+  const __m128 quantile = _mm_set1_ps(QUANTILE);
+  const __m128 one_minus_quantile = _mm_set1_ps((float)1.0 - QUANTILE);
+  const __m128 width = _mm_set1_ps(WIDTH);
+  const __m128 density_step = _mm_set1_ps((float)1.0 / ((float)2.0 * WIDTH));
+  const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+  float lmagn[HALF_ANAL_BLOCKL], delta;
+  int i, s, offset = 0;
+
+  if (inst->updates < END_STARTUP_LONG) {
+    inst->updates++;
+  }
+
+  for (i = 0; i + 3 < inst->magnLen; i += 4) {
+    _mm_storeu_ps(&lmagn[i], LogSSE2(_mm_loadu_ps(&magn[i])));
+  }
+  for (; i < inst->magnLen; i++) {
+    lmagn[i] = (float)log(magn[i]);
+  }
+
+  // loop over simultaneous estimates
+  for (s = 0; s < SIMULT; s++) {
+    const float counter = (float)inst->counter[s];
+    const float counter_plus_one = (float)(inst->counter[s] + 1);
+    const __m128 counter_v = _mm_set1_ps(counter);
+    const __m128 counter_plus_one_v = _mm_set1_ps(counter_plus_one);
+    offset = s * inst->magnLen;
+
+    // newquantest(...)
+    for (i = 0; i + 3 < inst->magnLen; i += 4) {
+      float* lquantile_ptr = &inst->lquantile[offset + i];
+      float* density_ptr = &inst->density[offset + i];
+      const __m128 lmagn_v = _mm_loadu_ps(&lmagn[i]);
+      __m128 lquantile_v = _mm_loadu_ps(lquantile_ptr);
+      const __m128 density_v = _mm_loadu_ps(density_ptr);
+      const __m128 delta_v = SelectSSE2(_mm_cmpgt_ps(density_v, one),
+                                        _mm_div_ps(factor, density_v), factor);
+      const __m128 step_up =
+          _mm_div_ps(_mm_mul_ps(quantile, delta_v), counter_plus_one_v);
+      const __m128 step_down = _mm_div_ps(
+          _mm_mul_ps(one_minus_quantile, delta_v), counter_plus_one_v);
+      __m128 near_v, new_density_v;
+
+      // update log quantile estimate
+      lquantile_v = SelectSSE2(_mm_cmpgt_ps(lmagn_v, lquantile_v),
+                               _mm_add_ps(lquantile_v, step_up),
+                               _mm_sub_ps(lquantile_v, step_down));
+      _mm_storeu_ps(lquantile_ptr, lquantile_v);
+
+      // update density estimate
+      near_v = _mm_cmplt_ps(
+          _mm_and_ps(_mm_sub_ps(lmagn_v, lquantile_v), abs_mask), width);
+      new_density_v = _mm_div_ps(
+          _mm_add_ps(_mm_mul_ps(counter_v, density_v), density_step),
+          counter_plus_one_v);
+      _mm_storeu_ps(density_ptr,
+                    SelectSSE2(near_v, new_density_v, density_v));
+    }
+    for (; i < inst->magnLen; i++) {
+      if (inst->density[offset + i] > 1.0) {
+        delta = FACTOR * (float)1.0 / inst->density[offset + i];
+      } else {
+        delta = FACTOR;
+      }
+      if (lmagn[i] > inst->lquantile[offset + i]) {
+        inst->lquantile[offset + i] += QUANTILE * delta / counter_plus_one;
+      } else {
+        inst->lquantile[offset + i] -=
+            ((float)1.0 - QUANTILE) * delta / counter_plus_one;
+      }
+      if (fabs(lmagn[i] - inst->lquantile[offset + i]) < WIDTH) {
+        inst->density[offset + i] =
+            (counter * inst->density[offset + i] +
+             (float)1.0 / ((float)2.0 * WIDTH)) / counter_plus_one;
+      }
+    }  // end loop over magnitude spectrum
+
+    if (inst->counter[s] >= END_STARTUP_LONG) {
+      inst->counter[s] = 0;
+      if (inst->updates >= END_STARTUP_LONG) {
+        UpdateQuantileSSE2(inst, offset);
+      }
+    }
+
+    inst->counter[s]++;
+  }  // end loop over simultaneous estimates
+
+  // Sequentially update the noise during startup
+  if (inst->updates < END_STARTUP_LONG) {
+    // Use the last "s" to get noise during startup that differ from zero.
+    UpdateQuantileSSE2(inst, offset);
+  }
+
+  memcpy(noise, inst->quantile, sizeof(float) * inst->magnLen);
+}
+
+static void ComputeSnrSSE2(const NSinst_t* inst,
+                           const float* magn,
+                           const float* noise,
+                           float* snrLocPrior,
+                           float* snrLocPost,
+                           float* previousEstimateStsa) {
+  const __m128 one = _mm_set1_ps(1.0f);
+  const __m128 k0001 = _mm_set1_ps(0.0001f);
+  const __m128 dd = _mm_set1_ps(DD_PR_SNR);
+  const __m128 one_minus_dd = _mm_set1_ps((float)1.0 - DD_PR_SNR);
+  int i;
+
+  for (i = 0; i + 3 < inst->magnLen; i += 4) {
+    const __m128 magn_v = _mm_loadu_ps(&magn[i]);
+    const __m128 noise_v = _mm_loadu_ps(&noise[i]);
+    const __m128 post = _mm_and_ps(
+        _mm_cmpgt_ps(magn_v, noise_v),
+        _mm_sub_ps(_mm_div_ps(magn_v, _mm_add_ps(noise_v, k0001)), one));
+    const __m128 previous = _mm_mul_ps(
+        _mm_div_ps(_mm_loadu_ps(&inst->magnPrev[i]),
+                   _mm_add_ps(_mm_loadu_ps(&inst->noisePrev[i]), k0001)),
+        _mm_loadu_ps(&inst->smooth[i]));
+    _mm_storeu_ps(&snrLocPost[i], post);
+    _mm_storeu_ps(&previousEstimateStsa[i], previous);
+    _mm_storeu_ps(&snrLocPrior[i], _mm_add_ps(_mm_mul_ps(dd, previous),
+                                              _mm_mul_ps(one_minus_dd, post)));
+  }
+  for (; i < inst->magnLen; i++) {
+    snrLocPost[i] = (float)0.0;
+    if (magn[i] > noise[i]) {
+      snrLocPost[i] = magn[i] / (noise[i] + (float)0.0001) - (float)1.0;
+    }
+    previousEstimateStsa[i] = inst->magnPrev[i] / (inst->noisePrev[i] + (float)0.0001)
+                              * (inst->smooth[i]);
+    snrLocPrior[i] = DD_PR_SNR * previousEstimateStsa[i] + ((float)1.0 - DD_PR_SNR)
+                     * snrLocPost[i];
+  }
+}
+
+static float UpdateLogLrtSSE2(NSinst_t* inst,
+                              const float* snrLocPrior,
+                              const float* snrLocPost) {
+  const __m128 one = _mm_set1_ps(1.0f);
+  const __m128 two = _mm_set1_ps(2.0f);
+  const __m128 k0001 = _mm_set1_ps(0.0001f);
+  const __m128 lrt_tavg = _mm_set1_ps(LRT_TAVG);
+  __m128 sum = _mm_setzero_ps();
+  float tmpFloat1, tmpFloat2, besselTmp, logLrtTimeAvgKsum;
+  int i;
+
+  for (i = 0; i + 3 < inst->magnLen; i += 4) {
+    const __m128 prior = _mm_loadu_ps(&snrLocPrior[i]);
+    const __m128 tmp1 = _mm_add_ps(one, _mm_mul_ps(two, prior));
+    const __m128 tmp2 =
+        _mm_div_ps(_mm_mul_ps(two, prior), _mm_add_ps(tmp1, k0001));
+    const __m128 bessel =
+        _mm_mul_ps(_mm_add_ps(_mm_loadu_ps(&snrLocPost[i]), one), tmp2);
+    __m128 lrt = _mm_loadu_ps(&inst->logLrtTimeAvg[i]);
+    lrt = _mm_add_ps(lrt, _mm_mul_ps(lrt_tavg,
+        _mm_sub_ps(_mm_sub_ps(bessel, LogSSE2(tmp1)), lrt)));
+    _mm_storeu_ps(&inst->logLrtTimeAvg[i], lrt);
+    sum = _mm_add_ps(sum, lrt);
+  }
+  logLrtTimeAvgKsum = SumSSE2(sum);
+  for (; i < inst->magnLen; i++) {
+    tmpFloat1 = (float)1.0 + (float)2.0 * snrLocPrior[i];
+    tmpFloat2 = (float)2.0 * snrLocPrior[i] / (tmpFloat1 + (float)0.0001);
+    besselTmp = (snrLocPost[i] + (float)1.0) * tmpFloat2;
+    inst->logLrtTimeAvg[i] += LRT_TAVG * (besselTmp - (float)log(tmpFloat1)
+                                          - inst->logLrtTimeAvg[i]);
+    logLrtTimeAvgKsum += inst->logLrtTimeAvg[i];
+  }
+  return logLrtTimeAvgKsum;
+}
+
+static void SpeechProbabilitySSE2(const NSinst_t* inst,
+                                  float gainPrior,
+                                  float* probSpeechFinal) {
+  const __m128 one = _mm_set1_ps(1.0f);
+  const __m128 gain_prior = _mm_set1_ps(gainPrior);
+  const __m128 sign_mask = _mm_set1_ps(-0.0f);
+  float invLrt;
+  int i;
+
+  for (i = 0; i + 3 < inst->magnLen; i += 4) {
+    const __m128 minus_lrt =
+        _mm_xor_ps(_mm_loadu_ps(&inst->logLrtTimeAvg[i]), sign_mask);
+    const __m128 inv_lrt = _mm_mul_ps(gain_prior, ExpSSE2(minus_lrt));
+    _mm_storeu_ps(&probSpeechFinal[i],
+                  _mm_div_ps(one, _mm_add_ps(one, inv_lrt)));
+  }
+  for (; i < inst->magnLen; i++) {
+    invLrt = (float)exp(-inst->logLrtTimeAvg[i]);
+    invLrt = (float)gainPrior * invLrt;
+    probSpeechFinal[i] = (float)1.0 / ((float)1.0 + invLrt);
+  }
+}
+
+static void UpdateNoiseSSE2(NSinst_t* inst,
+                            const float* magn,
+                            const float* probSpeechFinal,
+                            float* noise) {
+  const __m128 one = _mm_set1_ps(1.0f);
+  const __m128 prob_range = _mm_set1_ps(PROB_RANGE);
+  const __m128 noise_update = _mm_set1_ps(NOISE_UPDATE);
+  const __m128 speech_update = _mm_set1_ps(SPEECH_UPDATE);
+  const __m128 gamma_pause = _mm_set1_ps(GAMMA_PAUSE);
+  float probSpeech, probNonSpeech, gammaNoiseTmp, gammaNoiseOld;
+  float noiseUpdateTmp;
+  int i;
+
+  // The time constant of bin i is selected by the speech probability of bin
+  // i - 1, with NOISE_UPDATE for the first bin. Both updates are computed;
+  // they are equal when the time constants are, so the minimum gives the
+  // same result as the C version in all cases.
+  for (i = 0; i + 3 < inst->magnLen; i += 4) {
+    const __m128 prob = _mm_loadu_ps(&probSpeechFinal[i]);
+    const __m128 prob_prev = i == 0 ?
+        _mm_setr_ps(0.f, probSpeechFinal[0], probSpeechFinal[1],
+                    probSpeechFinal[2]) :
+        _mm_loadu_ps(&probSpeechFinal[i - 1]);
+    const __m128 magn_v = _mm_loadu_ps(&magn[i]);
+    const __m128 noise_prev = _mm_loadu_ps(&inst->noisePrev[i]);
+    const __m128 gamma_old = SelectSSE2(_mm_cmpgt_ps(prob_prev, prob_range),
+                                        speech_update, noise_update);
+    const __m128 gamma_new = SelectSSE2(_mm_cmpgt_ps(prob, prob_range),
+                                        speech_update, noise_update);
+    const __m128 mix = _mm_add_ps(_mm_mul_ps(_mm_sub_ps(one, prob), magn_v),
+                                  _mm_mul_ps(prob, noise_prev));
+    const __m128 update_old =
+        _mm_add_ps(_mm_mul_ps(gamma_old, noise_prev),
+                   _mm_mul_ps(_mm_sub_ps(one, gamma_old), mix));
+    const __m128 update_new =
+        _mm_add_ps(_mm_mul_ps(gamma_new, noise_prev),
+                   _mm_mul_ps(_mm_sub_ps(one, gamma_new), mix));
+    // conservative noise update
+    const __m128 pause = _mm_loadu_ps(&inst->magnAvgPause[i]);
+    const __m128 pause_new = _mm_add_ps(
+        pause, _mm_mul_ps(gamma_pause, _mm_sub_ps(magn_v, pause)));
+    _mm_storeu_ps(&inst->magnAvgPause[i],
+                  SelectSSE2(_mm_cmplt_ps(prob, prob_range), pause_new, pause));
+    _mm_storeu_ps(&noise[i], _mm_min_ps(update_old, update_new));
+  }
+  gammaNoiseTmp = NOISE_UPDATE;
+  if (i > 0 && probSpeechFinal[i - 1] > PROB_RANGE) {
+    gammaNoiseTmp = SPEECH_UPDATE;
+  }
+  for (; i < inst->magnLen; i++) {
+    probSpeech = probSpeechFinal[i];
+    probNonSpeech = (float)1.0 - probSpeech;
+    noiseUpdateTmp = gammaNoiseTmp * inst->noisePrev[i] + ((float)1.0 - gammaNoiseTmp)
+                     * (probNonSpeech * magn[i] + probSpeech * inst->noisePrev[i]);
+    gammaNoiseOld = gammaNoiseTmp;
+    gammaNoiseTmp = NOISE_UPDATE;
+    if (probSpeech > PROB_RANGE) {
+      gammaNoiseTmp = SPEECH_UPDATE;
+    }
+    if (probSpeech < PROB_RANGE) {
+      inst->magnAvgPause[i] += GAMMA_PAUSE * (magn[i] - inst->magnAvgPause[i]);
+    }
+    if (gammaNoiseTmp == gammaNoiseOld) {
+      noise[i] = noiseUpdateTmp;
+    } else {
+      noise[i] = gammaNoiseTmp * inst->noisePrev[i] + ((float)1.0 - gammaNoiseTmp)
+                 * (probNonSpeech * magn[i] + probSpeech * inst->noisePrev[i]);
+      if (noiseUpdateTmp < noise[i]) {
+        noise[i] = noiseUpdateTmp;
+      }
+    }
+  }
+}
+
+static void ComputeWienerFilterSSE2(const NSinst_t* inst,
+                                    const float* magn,
+                                    const float* noise,
+                                    const float* previousEstimateStsa,
+                                    float* theFilter) {
+  const __m128 one = _mm_set1_ps(1.0f);
+  const __m128 k0001 = _mm_set1_ps(0.0001f);
+  const __m128 dd = _mm_set1_ps(DD_PR_SNR);
+  const __m128 one_minus_dd = _mm_set1_ps((float)1.0 - DD_PR_SNR);
+  const __m128 overdrive = _mm_set1_ps(inst->overdrive);
+  float snrPrior, currentEstimateStsa;
+  int i;
+
+  for (i = 0; i + 3 < inst->magnLen; i += 4) {
+    const __m128 magn_v = _mm_loadu_ps(&magn[i]);
+    const __m128 noise_v = _mm_loadu_ps(&noise[i]);
+    const __m128 current = _mm_and_ps(
+        _mm_cmpgt_ps(magn_v, noise_v),
+        _mm_sub_ps(_mm_div_ps(magn_v, _mm_add_ps(noise_v, k0001)), one));
+    const __m128 snr_prior =
+        _mm_add_ps(_mm_mul_ps(dd, _mm_loadu_ps(&previousEstimateStsa[i])),
+                   _mm_mul_ps(one_minus_dd, current));
+    _mm_storeu_ps(&theFilter[i],
+                  _mm_div_ps(snr_prior, _mm_add_ps(overdrive, snr_prior)));
+  }
+  for (; i < inst->magnLen; i++) {
+    currentEstimateStsa = (float)0.0;
+    if (magn[i] > noise[i]) {
+      currentEstimateStsa = magn[i] / (noise[i] + (float)0.0001) - (float)1.0;
+    }
+    snrPrior = DD_PR_SNR * previousEstimateStsa[i] + ((float)1.0 - DD_PR_SNR)
+               * currentEstimateStsa;
+    theFilter[i] = snrPrior / (inst->overdrive + snrPrior);
+  }
+}
+
+void WebRtcNs_InitCore_SSE2(void) {
+  WebRtcNs_ComputeMagnitude = ComputeMagnitudeSSE2;
+  WebRtcNs_ComputeSpectralFlatness = ComputeSpectralFlatnessSSE2;
+  WebRtcNs_NoiseEstimation = NoiseEstimationSSE2;
+  WebRtcNs_ComputeSnr = ComputeSnrSSE2;
+  WebRtcNs_UpdateLogLrt = UpdateLogLrtSSE2;
+  WebRtcNs_SpeechProbability = SpeechProbabilitySSE2;
+  WebRtcNs_UpdateNoise = UpdateNoiseSSE2;
+  WebRtcNs_ComputeWienerFilter = ComputeWienerFilterSSE2;
+}
@@ -662,7 +662,8 @@ class AudioFrame {
     kPLC = 1,
     kCNG = 2,
     kPLCCNG = 3,
-    kUndefined = 4
+    kUndefined = 4,
+    kIdle = 5  // Silence from NetEq's idle fast path.
   };
 
   AudioFrame();
@@ -20,7 +20,8 @@ extern "C" {
 // List of features in x86.
 typedef enum {
   kSSE2,
-  kSSE3
+  kSSE3,
+  kAVX2  // AVX2 and FMA3, with the YMM state enabled by the OS.
 } CPUFeature;
 
 // List of features in ARM.
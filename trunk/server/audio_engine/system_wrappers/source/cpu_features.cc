@@ -28,23 +28,58 @@ int GetCPUInfoNoASM(CPUFeature feature) {
 #ifndef _MSC_VER
 // Intrinsic for "cpuid".
 #if defined(__pic__) && defined(__i386__)
-static inline void __cpuid(int cpu_info[4], int info_type) {
+static inline void __cpuidex(int cpu_info[4], int info_type, int sub_type) {
   __asm__ volatile(
     "mov %%ebx, %%edi\n"
     "cpuid\n"
     "xchg %%edi, %%ebx\n"
     : "=a"(cpu_info[0]), "=D"(cpu_info[1]), "=c"(cpu_info[2]), "=d"(cpu_info[3])
-    : "a"(info_type));
+    : "a"(info_type), "c"(sub_type));
 }
 #else
-static inline void __cpuid(int cpu_info[4], int info_type) {
+static inline void __cpuidex(int cpu_info[4], int info_type, int sub_type) {
   __asm__ volatile(
     "cpuid\n"
     : "=a"(cpu_info[0]), "=b"(cpu_info[1]), "=c"(cpu_info[2]), "=d"(cpu_info[3])
-    : "a"(info_type));
+    : "a"(info_type), "c"(sub_type));
 }
 #endif
+static inline void __cpuid(int cpu_info[4], int info_type) {
+  __cpuidex(cpu_info, info_type, 0);
+}
+
+// Intrinsic for "xgetbv". The instruction is emitted as bytes since older
+// assemblers do not know it.
+static inline uint64_t _xgetbv(unsigned int xcr) {
+  uint32_t eax, edx;
+  __asm__ volatile(
+    ".byte 0x0f, 0x01, 0xd0\n"
+    : "=a"(eax), "=d"(edx)
+    : "c"(xcr));
+  return ((uint64_t)edx << 32) | eax;
+}
 #endif  // _MSC_VER
+
+// Returns true if AVX2 and FMA3 are present and the OS saves the YMM
+// registers on context switches.
+static int HasAVX2(const int cpu_info[4]) {
+  int ext_info[4];
+  // FMA (bit 12), OSXSAVE (bit 27) and AVX (bit 28).
+  const int kAvxMask = 0x18001000;
+  if ((cpu_info[2] & kAvxMask) != kAvxMask) {
+    return 0;
+  }
+  // XCR0 must have both the XMM (bit 1) and the YMM (bit 2) state enabled.
+  if ((_xgetbv(0) & 6) != 6) {
+    return 0;
+  }
+  __cpuid(ext_info, 0);
+  if (ext_info[0] < 7) {
+    return 0;
+  }
+  __cpuidex(ext_info, 7, 0);
+  return 0 != (ext_info[1] & 0x00000020);
+}
 #endif  // VOIP_ARCH_X86_FAMILY
 
 #if defined(VOIP_ARCH_X86_FAMILY)
@@ -58,6 +93,9 @@ static int GetCPUInfo(CPUFeature feature) {
   if (feature == kSSE3) {
     return 0 != (cpu_info[2] & 0x00000001);
   }
+  if (feature == kAVX2) {
+    return HasAVX2(cpu_info);
+  }
   return 0;
 }
 #else
@@ -28,6 +28,7 @@
 #include "audio_engine/voice_engine/include/voe_base.h"
 #include "audio_engine/voice_engine/include/voe_external_media.h"
 #include "audio_engine/voice_engine/include/voe_rtp_rtcp.h"
+#include "audio_engine/voice_engine/load_governor.h"
 #include "audio_engine/voice_engine/output_mixer.h"
 #include "audio_engine/voice_engine/statistics.h"
 #include "audio_engine/voice_engine/transmit_mixer.h"
@@ -132,6 +133,21 @@ Channel::SendData(FrameType frameType,
     _lastLocalTimeStamp = timeStamp;
     _lastPayloadType = payloadType;
 
+    // SendData() is called from within EncodeAndSend(), so |_captureTimeUs|
+    // belongs to the frame that completed this packet.
+    if (_captureTimeUs > 0)
+    {
+        const int64_t latencyUs =
+            TickTime::MicrosecondTimestamp() - _captureTimeUs;
+        CriticalSectionScoped cs(send_latency_crit_sect_.get());
+        send_latency_sum_us_ += latencyUs;
+        if (latencyUs > send_latency_max_us_)
+        {
+            send_latency_max_us_ = latencyUs;
+        }
+        ++send_latency_packets_;
+    }
+
     return 0;
 }
 
@@ -564,6 +580,31 @@ int32_t Channel::GetAudioFrame(int32_t id, AudioFrame& audioFrame)
     WEBRTC_TRACE(kTraceStream, kTraceVoice, VoEId(_instanceId,_channelId),
                  "Channel::GetAudioFrame(id=%d)", id);
 
+    const LoadSheddingLevels loadShedding = _loadGovernorPtr ?
+        _loadGovernorPtr->Level() : kLoadSheddingOff;
+    ChannelState::State state = channel_state_.Get();
+
+    // Under overload, let NetEq conceal losses cheaply while the previous
+    // frame of this channel did not make it into the mix. Channels playing a
+    // file are mixed anonymously and never marked as mixed.
+    bool mixed = true;
+    if (loadShedding >= kLoadSheddingConcealment &&
+        !state.output_file_playing && _unheardSupported)
+    {
+        IsMixed(mixed);
+    }
+    if (_unheard == mixed)
+    {
+        if (audio_coding_->SetUnheard(!mixed) == 0)
+        {
+            _unheard = !mixed;
+        } else
+        {
+            // Not supported by the legacy ACM; don't ask again.
+            _unheardSupported = false;
+        }
+    }
+
     // Get 10ms raw PCM data from the ACM (mixer limits output frequency)
     if (audio_coding_->PlayoutData10Ms(audioFrame.sample_rate_hz_,
                                        &audioFrame) == -1)
@@ -588,9 +629,10 @@ int32_t Channel::GetAudioFrame(int32_t id, AudioFrame& audioFrame)
     // Store speech type for dead-or-alive detection
     _outputSpeechType = audioFrame.speech_type_;
 
-    ChannelState::State state = channel_state_.Get();
-
-    if (state.rx_apm_is_enabled) {
+    // Under overload, receive-side NS and AGC are only run on speech.
+    if (state.rx_apm_is_enabled &&
+        (loadShedding < kLoadSheddingRxProcessing ||
+         audioFrame.vad_activity_ != AudioFrame::kVadPassive)) {
       int err = rx_audioproc_->ProcessStream(&audioFrame);
       if (err) {
         LOG(LS_ERROR) << "ProcessStream() error: " << err;
@@ -818,6 +860,8 @@ Channel::Channel(int32_t channelId,
     _rtpDumpOut(*RtpDump::CreateRtpDump()),
     _outputAudioLevel(),
     _externalTransport(false),
+    _sendFrame(NULL),
+    _captureTimeUs(0),
     _audioLevel_dBov(0),
     _inputFilePlayerPtr(NULL),
     _outputFilePlayerPtr(NULL),
@@ -847,6 +891,7 @@ Channel::Channel(int32_t channelId,
     _audioDeviceModulePtr(NULL),
     _voiceEngineObserverPtr(NULL),
     _callbackCritSectPtr(NULL),
+    _loadGovernorPtr(NULL),
     _transportPtr(NULL),
     _rxVadObserverPtr(NULL),
     _oldVadDecision(-1),
@@ -868,6 +913,10 @@ Channel::Channel(int32_t channelId,
     _lastRemoteTimeStamp(0),
     _lastPayloadType(0),
     _includeAudioLevelIndication(false),
+    send_latency_crit_sect_(CriticalSectionWrapper::CreateCriticalSection()),
+    send_latency_sum_us_(0),
+    send_latency_max_us_(0),
+    send_latency_packets_(0),
     _rtpPacketTimedOut(false),
     _rtpPacketTimeOutIsEnabled(false),
     _rtpTimeOutSeconds(0),
@@ -883,6 +932,10 @@ Channel::Channel(int32_t channelId,
     _RxVadDetection(false),
     _rxAgcIsEnabled(false),
     _rxNsIsEnabled(false),
+    _unheard(false),
+    _unheardSupported(true),
+    _complexityControlled(false),
+    _loadSheddingLimited(false),
     restored_packet_in_use_(false)
 {
     WEBRTC_TRACE(kTraceMemory, kTraceVoice, VoEId(_instanceId,_channelId),
@@ -915,6 +968,7 @@ Channel::~Channel()
     WEBRTC_TRACE(kTraceMemory, kTraceVoice, VoEId(_instanceId,_channelId),
                  "Channel::~Channel() - dtor");
 
+    SetLoadGovernor(NULL);
     if (_outputExternalMedia)
     {
         DeRegisterExternalMediaProcessing(kPlaybackPerChannel);
@@ -1030,6 +1084,9 @@ Channel::Init()
             "Channel::Init() unable to initialize the ACM - 1");
         return -1;
     }
+    // Let the mixer skip this channel while its stream is idle. The legacy
+    // ACM does not support this and keeps producing comfort noise.
+    audio_coding_->SetIdleFastPath(true);
 
     // --- RTP/RTCP module initialization
 
@@ -1182,7 +1239,10 @@ int32_t
 Channel::UpdateLocalTimeStamp()
 {
 
-    _timeStamp += _audioFrame.samples_per_channel_;
+    if (_sendFrame != NULL)
+    {
+        _timeStamp += _sendFrame->samples_per_channel_;
+    }
     return 0;
 }
 
@@ -1427,6 +1487,27 @@ Channel::GetSendCodec(CodecInst& codec)
     return (audio_coding_->SendCodec(&codec));
 }
 
+void
+Channel::GetSendFormat(int* sampleRateHz, int* numChannels)
+{
+    *sampleRateHz = 0;
+    *numChannels = 0;
+    CodecInst codec;
+    if (audio_coding_->SendCodec(&codec) != 0)
+    {
+        return;
+    }
+    *sampleRateHz = codec.plfreq;
+    *numChannels = codec.channels;
+    // A secondary codec runs at the same rate but may need stereo.
+    CodecInst secondary;
+    if (audio_coding_->SecondarySendCodec(&secondary) == 0 &&
+        secondary.channels > *numChannels)
+    {
+        *numChannels = secondary.channels;
+    }
+}
+
 int32_t
 Channel::GetRecCodec(CodecInst& codec)
 {
@@ -3542,6 +3623,29 @@ Channel::GetRTPStatistics(CallStatistics& stats)
     return 0;
 }
 
+int
+Channel::GetCaptureToPacketLatency(int& averageUs, int& maxUs)
+{
+    CriticalSectionScoped cs(send_latency_crit_sect_.get());
+    if (send_latency_packets_ == 0)
+    {
+        averageUs = -1;
+        maxUs = -1;
+        return 0;
+    }
+    averageUs = static_cast<int>(send_latency_sum_us_ / send_latency_packets_);
+    maxUs = static_cast<int>(send_latency_max_us_);
+    send_latency_sum_us_ = 0;
+    send_latency_max_us_ = 0;
+    send_latency_packets_ = 0;
+
+    WEBRTC_TRACE(kTraceStateInfo, kTraceVoice,
+                 VoEId(_instanceId, _channelId),
+                 "GetCaptureToPacketLatency() => averageUs=%d, maxUs=%d",
+                 averageUs, maxUs);
+    return 0;
+}
+
 int Channel::SetFECStatus(bool enable, int redPayloadtype) {
   WEBRTC_TRACE(kTraceInfo, kTraceVoice, VoEId(_instanceId, _channelId),
                "Channel::SetFECStatus()");
@@ -3691,12 +3795,12 @@ Channel::RTPDumpIsActive(AudioPacketDirections direction)
 }
 
 uint32_t
-Channel::Demultiplex(const AudioFrame& audioFrame)
+Channel::Demultiplex(const AudioFrame& audioFrame, int64_t captureTimeUs)
 {
     WEBRTC_TRACE(kTraceStream, kTraceVoice, VoEId(_instanceId,_channelId),
                  "Channel::Demultiplex()");
-    _audioFrame.CopyFrom(audioFrame);
-    _audioFrame.id_ = _channelId;
+    _sendFrame = &audioFrame;
+    _captureTimeUs = captureTimeUs;
     return 0;
 }
 
@@ -3720,6 +3824,8 @@ void Channel::Demultiplex(const int16_t* audio_data,
                            mono_recording_audio_.get(),
                            &input_resampler_,
                            &_audioFrame);
+  _sendFrame = &_audioFrame;
+  _captureTimeUs = TickTime::MicrosecondTimestamp();
 }
 
 uint32_t
@@ -3728,24 +3834,37 @@ Channel::PrepareEncodeAndSend(int mixingFrequency)
     WEBRTC_TRACE(kTraceStream, kTraceVoice, VoEId(_instanceId,_channelId),
                  "Channel::PrepareEncodeAndSend()");
 
-    if (_audioFrame.samples_per_channel_ == 0)
+    if (_sendFrame == NULL || _sendFrame->samples_per_channel_ == 0)
     {
         WEBRTC_TRACE(kTraceWarning, kTraceVoice, VoEId(_instanceId,_channelId),
                      "Channel::PrepareEncodeAndSend() invalid audio frame");
         return -1;
     }
 
-    if (channel_state_.Get().input_file_playing)
+    const ChannelState::State state = channel_state_.Get();
+    const bool mute = Mute();
+    if (_sendFrame != &_audioFrame &&
+        (state.input_file_playing || mute || state.input_external_media ||
+         _includeAudioLevelIndication))
+    {
+        // The steps below write to the frame. Work on a copy rather than on
+        // the frame shared with the other channels.
+        _audioFrame.CopyFrom(*_sendFrame);
+        _audioFrame.id_ = _channelId;
+        _sendFrame = &_audioFrame;
+    }
+
+    if (state.input_file_playing)
     {
         MixOrReplaceAudioWithFile(mixingFrequency);
     }
 
-    if (Mute())
+    if (mute)
     {
         AudioFrameOperations::Mute(_audioFrame);
     }
 
-    if (channel_state_.Get().input_external_media)
+    if (state.input_external_media)
     {
         CriticalSectionScoped cs(&_callbackCritSect);
         const bool isStereo = (_audioFrame.num_channels_ == 2);
@@ -3780,28 +3899,26 @@ Channel::EncodeAndSend()
     WEBRTC_TRACE(kTraceStream, kTraceVoice, VoEId(_instanceId,_channelId),
                  "Channel::EncodeAndSend()");
 
-    assert(_audioFrame.num_channels_ <= 2);
-    if (_audioFrame.samples_per_channel_ == 0)
+    if (_sendFrame == NULL || _sendFrame->samples_per_channel_ == 0)
     {
         WEBRTC_TRACE(kTraceWarning, kTraceVoice, VoEId(_instanceId,_channelId),
                      "Channel::EncodeAndSend() invalid audio frame");
         return -1;
     }
-
-    _audioFrame.id_ = _channelId;
+    assert(_sendFrame->num_channels_ <= 2);
 
     // --- Add 10ms of raw (PCM) audio data to the encoder @ 32kHz.
 
-    // The ACM resamples internally.
-    _audioFrame.timestamp_ = _timeStamp;
-    if (audio_coding_->Add10MsData((AudioFrame&)_audioFrame) != 0)
+    // The ACM resamples internally. |_sendFrame| may be shared with other
+    // channels, so the channel's timestamp is passed on the side.
+    if (audio_coding_->Add10MsData(*_sendFrame, _timeStamp) != 0)
     {
         WEBRTC_TRACE(kTraceError, kTraceVoice, VoEId(_instanceId,_channelId),
                      "Channel::EncodeAndSend() ACM encoding failed");
         return -1;
     }
 
-    _timeStamp += _audioFrame.samples_per_channel_;
+    _timeStamp += _sendFrame->samples_per_channel_;
 
     // --- Encode if complete frame is ready
 
@@ -4398,6 +4515,48 @@ int Channel::GetSecondarySendCodec(CodecInst* codec) {
   return 0;
 }
 
+int Channel::SetCodecPool(AudioCodecPool* pool) {
+  if (audio_coding_->SetCodecPool(pool) != 0) {
+    WEBRTC_TRACE(kTraceWarning, kTraceVoice, VoEId(_instanceId, _channelId),
+                 "SetCodecPool() not supported by the ACM");
+    return -1;
+  }
+  return 0;
+}
+
+int Channel::SetDecoderIdleTimeout(int timeout_ms) {
+  return audio_coding_->SetDecoderIdleTimeout(timeout_ms);
+}
+
+int Channel::SetOpusComplexityController(
+    OpusComplexityController* controller) {
+  if (audio_coding_->SetOpusComplexityController(controller) != 0) {
+    WEBRTC_TRACE(kTraceWarning, kTraceVoice, VoEId(_instanceId, _channelId),
+                 "SetOpusComplexityController() not supported by the ACM");
+    _complexityControlled = false;
+    return -1;
+  }
+  _complexityControlled = (controller != NULL);
+  return 0;
+}
+
+void Channel::GetEncodingStatistics(AudioEncodingStats* stats) const {
+  audio_coding_->GetEncodingStatistics(stats);
+}
+
+void Channel::SetLoadGovernor(LoadGovernor* governor) {
+  if (_loadSheddingLimited) {
+    _loadGovernorPtr->RemoveLimitedChannel();
+  }
+  _loadGovernorPtr = governor;
+  // Without unheard mode and complexity control the concealment and encoder
+  // steps would do nothing for this channel.
+  _loadSheddingLimited = (governor != NULL) && !_complexityControlled;
+  if (_loadSheddingLimited) {
+    _loadGovernorPtr->AddLimitedChannel();
+  }
+}
+
 // Assuming this method is called with valid payload type.
 int Channel::SetRedPayloadType(int red_payload_type) {
   CodecInst codec;
@@ -31,10 +31,12 @@
 
 namespace VoIP {
 
+class AudioCodecPool;
 class AudioDeviceModule;
 class Config;
 class CriticalSectionWrapper;
 class FileWrapper;
+class OpusComplexityController;
 class ProcessThread;
 class ReceiveStatistics;
 class RtpDump;
@@ -58,6 +60,7 @@ class Statistics;
 class StatisticsProxy;
 class TransmitMixer;
 class OutputMixer;
+class LoadGovernor;
 
 // Helper class to simplify locking scheme for members that are accessed from
 // multiple threads.
@@ -186,6 +189,9 @@ public:
 
     // VoECodec
     int32_t GetSendCodec(CodecInst& codec);
+    // Gets the sample rate and the number of channels that the send codecs
+    // need from the captured audio. Both are 0 if no send codec is set.
+    void GetSendFormat(int* sampleRateHz, int* numChannels);
     int32_t GetRecCodec(CodecInst& codec);
     int32_t SetSendCodec(const CodecInst& codec);
     int32_t SetVADStatus(bool enableVAD, ACMVADMode mode, bool disableDTX);
@@ -199,6 +205,21 @@ public:
     void RemoveSecondarySendCodec();
     int GetSecondarySendCodec(CodecInst* codec);
 
+    // Codec instance pooling.
+    int SetCodecPool(AudioCodecPool* pool);
+
+    // Deletes idle decoders after |timeout_ms|; 0 keeps them.
+    int SetDecoderIdleTimeout(int timeout_ms);
+
+    // Opus complexity control.
+    int SetOpusComplexityController(OpusComplexityController* controller);
+    void GetEncodingStatistics(AudioEncodingStats* stats) const;
+
+    // Lets the channel shed receive-side load while |governor| asks for it.
+    // Call after SetOpusComplexityController(); a channel whose ACM rejected
+    // the controller is counted as limited by |governor|.
+    void SetLoadGovernor(LoadGovernor* governor);
+
     // VoENetwork
     int32_t RegisterExternalTransport(Transport& transport);
     int32_t DeRegisterExternalTransport();
@@ -328,6 +349,7 @@ public:
     int GetRemoteRTCPSenderInfo(SenderInfo* sender_info);
     int GetRemoteRTCPReportBlocks(std::vector<ReportBlock>* report_blocks);
     int GetRTPStatistics(CallStatistics& stats);
+    int GetCaptureToPacketLatency(int& averageUs, int& maxUs);
     int SetFECStatus(bool enable, int redPayloadtype);
     int GetFECStatus(bool& enabled, int& redPayloadtype);
     void SetNACKStatus(bool enable, int maxNumberOfPackets);
@@ -444,7 +466,10 @@ public:
     {
         return _outputAudioLevel.Level();
     }
-    uint32_t Demultiplex(const AudioFrame& audioFrame);
+    // |captureTimeUs| is the TickTime at which the ADM delivered the frame.
+    // The channel encodes from |audioFrame| without copying it, so it must
+    // stay valid and unchanged until EncodeAndSend() has returned.
+    uint32_t Demultiplex(const AudioFrame& audioFrame, int64_t captureTimeUs);
     // Demultiplex the data to the channel's |_audioFrame|. The difference
     // between this method and the overloaded method above is that |audio_data|
     // does not go through transmit_mixer and APM.
@@ -496,9 +521,14 @@ private:
     AudioLevel _outputAudioLevel;
     bool _externalTransport;
     AudioFrame _audioFrame;
+    // Frame to encode this tick: either the transmit mixer's shared frame or
+    // |_audioFrame|, when the channel had to make its own copy.
+    const AudioFrame* _sendFrame;
     scoped_ptr<int16_t[]> mono_recording_audio_;
     // Downsamples to the codec rate if necessary.
     PushResampler<int16_t> input_resampler_;
+    // Capture time of |_sendFrame|.
+    int64_t _captureTimeUs;
     uint8_t _audioLevel_dBov;
     FilePlayer* _inputFilePlayerPtr;
     FilePlayer* _outputFilePlayerPtr;
@@ -531,6 +561,7 @@ private:
     AudioDeviceModule* _audioDeviceModulePtr;
     AudioEngineObserver* _voiceEngineObserverPtr; // owned by base
     CriticalSectionWrapper* _callbackCritSectPtr; // owned by base
+    LoadGovernor* _loadGovernorPtr; // owned by base
     Transport* _transportPtr; // WebRtc socket or external transport
     scoped_ptr<AudioProcessing> rtp_audioproc_;
     scoped_ptr<AudioProcessing> rx_audioproc_; // far end AudioProcessing
@@ -558,6 +589,12 @@ private:
     uint32_t _lastRemoteTimeStamp;
     int8_t _lastPayloadType;
     bool _includeAudioLevelIndication;
+    // Capture-to-packet latency of the packets sent since the last call to
+    // GetCaptureToPacketLatency(). Written on the encoding thread.
+    scoped_ptr<CriticalSectionWrapper> send_latency_crit_sect_;
+    int64_t send_latency_sum_us_;
+    int64_t send_latency_max_us_;
+    int send_latency_packets_;
     // VoENetwork
     bool _rtpPacketTimedOut;
     bool _rtpPacketTimeOutIsEnabled;
@@ -576,6 +613,15 @@ private:
     bool _RxVadDetection;
     bool _rxAgcIsEnabled;
     bool _rxNsIsEnabled;
+    // True while NetEq runs in unheard mode because this channel was not
+    // mixed. Only accessed from the mixer thread.
+    bool _unheard;
+    bool _unheardSupported;
+    // The ACM took an Opus complexity controller. Only acm2 does, and only
+    // acm2 has unheard mode.
+    bool _complexityControlled;
+    // Registered with |_loadGovernorPtr| as a limited channel.
+    bool _loadSheddingLimited;
     bool restored_packet_in_use_;
 };
 
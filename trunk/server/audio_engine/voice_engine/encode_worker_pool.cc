@@ -0,0 +1,107 @@
+/*
+ *  Copyright (c) 2014 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "audio_engine/voice_engine/encode_worker_pool.h"
+
+#include <assert.h>
+
+#include "audio_engine/system_wrappers/interface/condition_variable_wrapper.h"
+#include "audio_engine/system_wrappers/interface/critical_section_wrapper.h"
+#include "audio_engine/system_wrappers/interface/thread_wrapper.h"
+#include "audio_engine/voice_engine/channel.h"
+
+namespace VoIP {
+namespace voe {
+
+EncodeWorkerPool::EncodeWorkerPool(int num_threads)
+    : num_threads_(num_threads),
+      crit_sect_(CriticalSectionWrapper::CreateCriticalSection()),
+      work_cond_(ConditionVariableWrapper::CreateConditionVariable()),
+      done_cond_(ConditionVariableWrapper::CreateConditionVariable()),
+      channels_(NULL),
+      num_channels_(0),
+      next_channel_(0),
+      pending_(0),
+      stop_(false) {
+  assert(num_threads > 0);
+}
+
+EncodeWorkerPool::~EncodeWorkerPool() {
+  {
+    CriticalSectionScoped cs(crit_sect_.get());
+    stop_ = true;
+    work_cond_->WakeAll();
+  }
+  for (size_t i = 0; i < threads_.size(); ++i) {
+    threads_[i]->Stop();
+    delete threads_[i];
+  }
+}
+
+bool EncodeWorkerPool::Start() {
+  for (int i = 0; i < num_threads_; ++i) {
+    ThreadWrapper* thread = ThreadWrapper::CreateThread(
+        Run, this, kHighPriority, "VoiceEncodeWorker");
+    if (!thread)
+      return false;
+    threads_.push_back(thread);
+    unsigned int id = 0;
+    if (!thread->Start(id))
+      return false;
+  }
+  return true;
+}
+
+void EncodeWorkerPool::EncodeAndSend(Channel* const* channels,
+                                     int num_channels) {
+  CriticalSectionScoped cs(crit_sect_.get());
+  assert(pending_ == 0);
+  channels_ = channels;
+  num_channels_ = num_channels;
+  next_channel_ = 0;
+  pending_ = num_channels;
+  work_cond_->WakeAll();
+
+  EncodePending();
+  while (pending_ > 0)
+    done_cond_->SleepCS(*crit_sect_);
+
+  channels_ = NULL;
+  num_channels_ = 0;
+  next_channel_ = 0;
+}
+
+bool EncodeWorkerPool::Run(void* obj) {
+  return static_cast<EncodeWorkerPool*>(obj)->Process();
+}
+
+bool EncodeWorkerPool::Process() {
+  CriticalSectionScoped cs(crit_sect_.get());
+  while (next_channel_ >= num_channels_ && !stop_)
+    work_cond_->SleepCS(*crit_sect_);
+  if (stop_)
+    return false;
+  EncodePending();
+  return true;
+}
+
+void EncodeWorkerPool::EncodePending() {
+  while (next_channel_ < num_channels_) {
+    Channel* channel = channels_[next_channel_++];
+    crit_sect_->Leave();
+    channel->EncodeAndSend();
+    crit_sect_->Enter();
+    if (--pending_ == 0)
+      done_cond_->WakeAll();
+  }
+}
+
+}  // namespace voe
+}  // namespace VoIP
@@ -0,0 +1,79 @@
+/*
+ *  Copyright (c) 2014 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_VOICE_ENGINE_ENCODE_WORKER_POOL_H
+#define WEBRTC_VOICE_ENGINE_ENCODE_WORKER_POOL_H
+
+#include <vector>
+
+#include "audio_engine/system_wrappers/interface/constructor_magic.h"
+#include "audio_engine/system_wrappers/interface/scoped_ptr.h"
+#include "audio_engine/system_wrappers/interface/thread_annotations.h"
+#include "audio_engine/include/typedefs.h"
+
+namespace VoIP {
+
+class ConditionVariableWrapper;
+class CriticalSectionWrapper;
+class ThreadWrapper;
+
+namespace voe {
+
+class Channel;
+
+// Fixed set of threads that run Channel::EncodeAndSend() for several channels
+// in parallel. EncodeAndSend() hands out one channel at a time from a shared
+// index; the calling thread takes part as well and the call returns only when
+// every channel has been encoded, so all packets of a 10 ms capture tick have
+// been sent before the next tick is delivered.
+class EncodeWorkerPool {
+ public:
+  explicit EncodeWorkerPool(int num_threads);
+  ~EncodeWorkerPool();
+
+  // Spawns the worker threads. Returns false if any thread fails to start, in
+  // which case the pool must be deleted.
+  bool Start();
+
+  // Returns the number of worker threads, not counting the calling thread.
+  int num_threads() const { return num_threads_; }
+
+  // Encodes and sends one 10 ms frame on each of the |num_channels| channels
+  // and blocks until all of them are done. The channels must stay alive for
+  // the duration of the call. Must not be called concurrently.
+  void EncodeAndSend(Channel* const* channels, int num_channels);
+
+ private:
+  static bool Run(void* obj);
+  bool Process();
+
+  // Encodes channels until none are left to hand out. Must be called with
+  // |crit_sect_| held; releases it while encoding.
+  void EncodePending() EXCLUSIVE_LOCKS_REQUIRED(crit_sect_);
+
+  const int num_threads_;
+  const scoped_ptr<CriticalSectionWrapper> crit_sect_;
+  const scoped_ptr<ConditionVariableWrapper> work_cond_;
+  const scoped_ptr<ConditionVariableWrapper> done_cond_;
+  std::vector<ThreadWrapper*> threads_;
+
+  Channel* const* channels_ GUARDED_BY(crit_sect_);
+  int num_channels_ GUARDED_BY(crit_sect_);
+  int next_channel_ GUARDED_BY(crit_sect_);
+  int pending_ GUARDED_BY(crit_sect_);
+  bool stop_ GUARDED_BY(crit_sect_);
+
+  DISALLOW_COPY_AND_ASSIGN(EncodeWorkerPool);
+};
+
+}  // namespace voe
+}  // namespace VoIP
+
+#endif  // WEBRTC_VOICE_ENGINE_ENCODE_WORKER_POOL_H
@@ -202,6 +202,13 @@ public:
     // Gets RTCP statistics for a specific |channel|.
     virtual int GetRTCPStatistics(int channel, CallStatistics& stats) = 0;
 
+    // Gets the time from capture of the 10 ms frame that completed a packet
+    // until the packet was handed to the transport, as average and maximum
+    // in microseconds over the packets sent on |channel| since the previous
+    // call. Both are -1 if no packet has been sent.
+    virtual int GetCaptureToPacketLatency(
+        int channel, int& averageUs, int& maxUs) = 0;
+
     // Gets the sender info part of the last received RTCP Sender Report (SR)
     // on a specified |channel|.
     virtual int GetRemoteRTCPSenderInfo(
@@ -0,0 +1,313 @@
+/*
+ *  Copyright (c) 2014 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "audio_engine/voice_engine/load_governor.h"
+
+#include <assert.h>
+
+#include <algorithm>
+
+#include "audio_engine/include/aoe_base.h"
+#include "audio_engine/include/aoe_errors.h"
+#include "audio_engine/modules/audio_coding/main/interface/opus_complexity_controller.h"
+#include "audio_engine/modules/utility/interface/process_thread.h"
+#include "audio_engine/system_wrappers/interface/critical_section_wrapper.h"
+#include "audio_engine/system_wrappers/interface/tick_util.h"
+#include "audio_engine/system_wrappers/interface/trace.h"
+#include "audio_engine/voice_engine/output_mixer.h"
+
+namespace VoIP {
+
+namespace voe {
+
+namespace {
+
+const int kTickUs = 10000;
+
+// Length of the window over which the tick load is measured.
+const int kWindowUs = 500000;
+
+// A window is overloaded if more than this share of the time was spent in
+// ticks of one type, or if more than |kMaxOverrunsPerWindow| ticks took
+// longer than 10 ms. A single overrun is tolerated since it is more likely
+// caused by preemption than by the engine itself.
+const int kRaiseLoadPercent = 80;
+const int kMaxOverrunsPerWindow = 1;
+
+// A step is undone after |kReleaseWindows| consecutive windows below this
+// load. The gap to |kRaiseLoadPercent| is larger than what a single step
+// saves, so that undoing a step does not cause an immediate overload.
+const int kReleaseLoadPercent = 50;
+const int kReleaseWindows = 4;
+
+const int kReducedMixedParticipants = 2;
+const int kReducedOpusComplexity = 2;
+
+}  // namespace
+
+LoadGovernor::LoadGovernor(uint32_t instanceId) :
+    _instanceId(instanceId),
+    _critSect(CriticalSectionWrapper::CreateCriticalSection()),
+    _applyCritSect(CriticalSectionWrapper::CreateCriticalSection()),
+    _callbackCritSect(CriticalSectionWrapper::CreateCriticalSection()),
+    _processThreadPtr(NULL),
+    _outputMixerPtr(NULL),
+    _complexityControllerPtr(NULL),
+    _voiceEngineObserverPtr(NULL),
+    _enabled(false),
+    _level(kLoadSheddingOff),
+    _appliedLevel(kLoadSheddingOff),
+    _notifiedLevel(kLoadSheddingOff),
+    _limitedChannels(0),
+    _windowStartUs(-1),
+    _overruns(0),
+    _calmWindows(0)
+{
+    for (int i = 0; i < kNumTickTypes; ++i)
+    {
+        _busyUs[i] = 0;
+    }
+}
+
+LoadGovernor::~LoadGovernor()
+{
+    _monitorModule.DeRegisterObserver();
+    if (_processThreadPtr)
+    {
+        _processThreadPtr->DeRegisterModule(&_monitorModule);
+    }
+}
+
+int32_t
+LoadGovernor::SetEngineInformation(
+    ProcessThread& processThread,
+    OutputMixer& outputMixer,
+    OpusComplexityController& complexityController)
+{
+    _outputMixerPtr = &outputMixer;
+    _complexityControllerPtr = &complexityController;
+    if (processThread.RegisterModule(&_monitorModule) == -1)
+    {
+        WEBRTC_TRACE(kTraceWarning, kTraceVoice, VoEId(_instanceId, -1),
+                     "LoadGovernor::SetEngineInformation() failed to "
+                     "register the monitor module");
+        return -1;
+    }
+    _processThreadPtr = &processThread;
+    _monitorModule.RegisterObserver(*this);
+    return 0;
+}
+
+int32_t
+LoadGovernor::RegisterVoiceEngineObserver(AudioEngineObserver& observer)
+{
+    CriticalSectionScoped cs(_callbackCritSect.get());
+    if (_voiceEngineObserverPtr)
+    {
+        return -1;
+    }
+    _voiceEngineObserverPtr = &observer;
+    return 0;
+}
+
+void
+LoadGovernor::DeRegisterVoiceEngineObserver()
+{
+    CriticalSectionScoped cs(_callbackCritSect.get());
+    _voiceEngineObserverPtr = NULL;
+}
+
+void
+LoadGovernor::SetEnabled(bool enable)
+{
+    {
+        CriticalSectionScoped cs(_critSect.get());
+        if (enable == _enabled)
+        {
+            return;
+        }
+        _enabled = enable;
+        if (!enable)
+        {
+            _level = kLoadSheddingOff;
+        }
+        _windowStartUs = -1;
+        for (int i = 0; i < kNumTickTypes; ++i)
+        {
+            _busyUs[i] = 0;
+        }
+        _overruns = 0;
+        _calmWindows = 0;
+    }
+    ApplyLevel();
+}
+
+bool
+LoadGovernor::Enabled() const
+{
+    CriticalSectionScoped cs(_critSect.get());
+    return _enabled;
+}
+
+LoadSheddingLevels
+LoadGovernor::Level() const
+{
+    CriticalSectionScoped cs(_critSect.get());
+    return static_cast<LoadSheddingLevels>(_level);
+}
+
+void
+LoadGovernor::AddLimitedChannel()
+{
+    {
+        CriticalSectionScoped cs(_critSect.get());
+        ++_limitedChannels;
+        _level = std::min(_level, MaxLevel());
+    }
+    ApplyLevel();
+}
+
+void
+LoadGovernor::RemoveLimitedChannel()
+{
+    CriticalSectionScoped cs(_critSect.get());
+    assert(_limitedChannels > 0);
+    --_limitedChannels;
+}
+
+void
+LoadGovernor::TickProcessed(TickType type, int processingTimeUs)
+{
+    {
+        CriticalSectionScoped cs(_critSect.get());
+        if (!_enabled)
+        {
+            return;
+        }
+        const int64_t nowUs = TickTime::MicrosecondTimestamp();
+        if (_windowStartUs < 0)
+        {
+            _windowStartUs = nowUs - processingTimeUs;
+        }
+        _busyUs[type] += processingTimeUs;
+        if (processingTimeUs > kTickUs)
+        {
+            ++_overruns;
+        }
+        if (nowUs - _windowStartUs < kWindowUs)
+        {
+            return;
+        }
+        EndWindow(nowUs);
+    }
+    ApplyLevel();
+}
+
+void
+LoadGovernor::OnPeriodicProcess()
+{
+    int warning = 0;
+    {
+        CriticalSectionScoped cs(_critSect.get());
+        if (_level == _notifiedLevel)
+        {
+            return;
+        }
+        warning = (_level > _notifiedLevel) ?
+            VE_LOAD_SHEDDING_WARNING : VE_LOAD_SHEDDING_REDUCED_WARNING;
+        _notifiedLevel = _level;
+    }
+
+    CriticalSectionScoped cs(_callbackCritSect.get());
+    if (_voiceEngineObserverPtr)
+    {
+        WEBRTC_TRACE(kTraceInfo, kTraceVoice, VoEId(_instanceId, -1),
+                     "LoadGovernor::OnPeriodicProcess() => "
+                     "CallbackOnError(%d)", warning);
+        _voiceEngineObserverPtr->CallbackOnError(-1, warning);
+    }
+}
+
+void
+LoadGovernor::EndWindow(int64_t nowUs)
+{
+    const int64_t windowUs = nowUs - _windowStartUs;
+    int64_t loadPercent = 0;
+    for (int i = 0; i < kNumTickTypes; ++i)
+    {
+        loadPercent = std::max(loadPercent, _busyUs[i] * 100 / windowUs);
+        _busyUs[i] = 0;
+    }
+
+    if (loadPercent >= kRaiseLoadPercent || _overruns > kMaxOverrunsPerWindow)
+    {
+        _calmWindows = 0;
+        if (_level < MaxLevel())
+        {
+            WEBRTC_TRACE(kTraceWarning, kTraceVoice, VoEId(_instanceId, -1),
+                         "LoadGovernor: overload (load=%d%%, overruns=%d), "
+                         "raising load shedding level to %d",
+                         static_cast<int>(loadPercent), _overruns,
+                         _level + 1);
+            ++_level;
+        }
+    } else if (loadPercent < kReleaseLoadPercent)
+    {
+        if (_level > kLoadSheddingOff && ++_calmWindows >= kReleaseWindows)
+        {
+            _calmWindows = 0;
+            WEBRTC_TRACE(kTraceStateInfo, kTraceVoice, VoEId(_instanceId, -1),
+                         "LoadGovernor: load=%d%%, lowering load shedding "
+                         "level to %d", static_cast<int>(loadPercent),
+                         _level - 1);
+            --_level;
+        }
+    } else
+    {
+        _calmWindows = 0;
+    }
+
+    _overruns = 0;
+    _windowStartUs = nowUs;
+}
+
+int
+LoadGovernor::MaxLevel() const
+{
+    return (_limitedChannels > 0) ? kLoadSheddingMixing : kLoadSheddingEncoder;
+}
+
+void
+LoadGovernor::ApplyLevel()
+{
+    CriticalSectionScoped cs(_applyCritSect.get());
+    const int level = Level();
+    if (level == _appliedLevel)
+    {
+        return;
+    }
+    if (_outputMixerPtr)
+    {
+        _outputMixerPtr->SetMaximumMixedParticipants(
+            (level >= kLoadSheddingMixing) ? kReducedMixedParticipants :
+            AudioConferenceMixer::kMaximumAmountOfMixedParticipants);
+    }
+    if (_complexityControllerPtr)
+    {
+        _complexityControllerPtr->SetMaxComplexity(
+            (level >= kLoadSheddingEncoder) ? kReducedOpusComplexity :
+            OpusComplexityController::kMaxComplexity);
+    }
+    _appliedLevel = level;
+}
+
+}  // namespace voe
+
+}  // namespace VoIP
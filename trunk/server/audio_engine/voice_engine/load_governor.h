@@ -0,0 +1,118 @@
+/*
+ *  Copyright (c) 2014 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_VOICE_ENGINE_LOAD_GOVERNOR_H
+#define WEBRTC_VOICE_ENGINE_LOAD_GOVERNOR_H
+
+#include "audio_engine/include/common_types.h"
+#include "audio_engine/system_wrappers/interface/constructor_magic.h"
+#include "audio_engine/system_wrappers/interface/scoped_ptr.h"
+#include "audio_engine/system_wrappers/interface/thread_annotations.h"
+#include "audio_engine/include/typedefs.h"
+#include "audio_engine/voice_engine/monitor_module.h"
+
+namespace VoIP {
+
+class AudioEngineObserver;
+class CriticalSectionWrapper;
+class OpusComplexityController;
+class ProcessThread;
+
+namespace voe {
+
+class OutputMixer;
+
+// Watches how long the engine spends on each 10 ms capture and playout tick
+// and, when the ticks come close to overrunning, takes graded quality
+// degradation steps (see LoadSheddingLevels) instead of letting the audio
+// device starve. One step is taken per measurement window while overloaded;
+// a step is only undone after the load has stayed well below the limit for
+// several windows, so the level does not toggle around the threshold.
+//
+// Engine-wide steps (mixing, encoder complexity) are applied here, after
+// the level has been decided and without holding the lock that Level()
+// takes, since the mixer calls Level() with its own locks held. Per channel
+// steps are applied by the channels themselves, which poll Level(). Level
+// changes are reported to the AudioEngineObserver from the process thread.
+class LoadGovernor : public MonitorObserver
+{
+public:
+    enum TickType
+    {
+        kCaptureTick = 0,
+        kPlayoutTick,
+        kNumTickTypes
+    };
+
+    LoadGovernor(uint32_t instanceId);
+    virtual ~LoadGovernor();
+
+    int32_t SetEngineInformation(ProcessThread& processThread,
+                                 OutputMixer& outputMixer,
+                                 OpusComplexityController& complexityController);
+
+    int32_t RegisterVoiceEngineObserver(AudioEngineObserver& observer);
+    void DeRegisterVoiceEngineObserver();
+
+    // Disabled by default. Disabling undoes all steps immediately.
+    void SetEnabled(bool enable);
+    bool Enabled() const;
+
+    LoadSheddingLevels Level() const;
+
+    // A channel whose audio coding module can apply neither the concealment
+    // nor the encoder step (the legacy ACM) is counted here. While there is
+    // one, the level stops at kLoadSheddingMixing so that the level reported
+    // is always in effect.
+    void AddLimitedChannel();
+    void RemoveLimitedChannel();
+
+    // Reports that a 10 ms tick of |type| took |processingTimeUs|.
+    void TickProcessed(TickType type, int processingTimeUs);
+
+    // MonitorObserver
+    virtual void OnPeriodicProcess();
+
+private:
+    void EndWindow(int64_t nowUs) EXCLUSIVE_LOCKS_REQUIRED(_critSect);
+    int MaxLevel() const EXCLUSIVE_LOCKS_REQUIRED(_critSect);
+    // Applies the engine-wide steps of the current level.
+    void ApplyLevel() LOCKS_EXCLUDED(_critSect);
+
+    const uint32_t _instanceId;
+    const scoped_ptr<CriticalSectionWrapper> _critSect;
+    // Serializes ApplyLevel(). Taken before |_critSect|, never after it.
+    const scoped_ptr<CriticalSectionWrapper> _applyCritSect;
+    const scoped_ptr<CriticalSectionWrapper> _callbackCritSect;
+    MonitorModule _monitorModule;
+    ProcessThread* _processThreadPtr;
+    OutputMixer* _outputMixerPtr;
+    OpusComplexityController* _complexityControllerPtr;
+    AudioEngineObserver* _voiceEngineObserverPtr
+        GUARDED_BY(_callbackCritSect);
+
+    bool _enabled GUARDED_BY(_critSect);
+    int _level GUARDED_BY(_critSect);
+    int _appliedLevel GUARDED_BY(_applyCritSect);
+    int _notifiedLevel GUARDED_BY(_critSect);
+    int _limitedChannels GUARDED_BY(_critSect);
+    int64_t _windowStartUs GUARDED_BY(_critSect);
+    int64_t _busyUs[kNumTickTypes] GUARDED_BY(_critSect);
+    int _overruns GUARDED_BY(_critSect);
+    int _calmWindows GUARDED_BY(_critSect);
+
+    DISALLOW_COPY_AND_ASSIGN(LoadGovernor);
+};
+
+}  // namespace voe
+
+}  // namespace VoIP
+
+#endif  // WEBRTC_VOICE_ENGINE_LOAD_GOVERNOR_H
@@ -236,6 +236,12 @@ OutputMixer::SetAnonymousMixabilityStatus(MixerParticipant& participant,
     return _mixerModule.SetAnonymousMixabilityStatus(participant,mixable);
 }
 
+int32_t
+OutputMixer::SetMaximumMixedParticipants(int maxParticipants)
+{
+    return _mixerModule.SetMaximumMixedParticipants(maxParticipants);
+}
+
 int32_t
 OutputMixer::MixActiveChannels()
 {
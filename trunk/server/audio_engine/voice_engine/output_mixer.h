@@ -62,6 +62,8 @@ public:
     int32_t SetAnonymousMixabilityStatus(MixerParticipant& participant,
                                          bool mixable);
 
+    int32_t SetMaximumMixedParticipants(int maxParticipants);
+
     int GetMixedAudio(int sample_rate_hz, int num_channels,
                       AudioFrame* audioFrame);
 
@@ -14,6 +14,7 @@
 #include "audio_engine/system_wrappers/interface/critical_section_wrapper.h"
 #include "audio_engine/system_wrappers/interface/trace.h"
 #include "audio_engine/voice_engine/channel.h"
+#include "audio_engine/voice_engine/load_governor.h"
 #include "audio_engine/voice_engine/output_mixer.h"
 #include "audio_engine/voice_engine/transmit_mixer.h"
 
@@ -44,11 +45,22 @@ SharedData::SharedData(const Config& config) :
                                                 _engineStatistics,
                                                 _channelManager);
     }
+    _loadGovernorPtr = new LoadGovernor(_gInstanceCounter);
+    if (_outputMixerPtr)
+    {
+        _loadGovernorPtr->SetEngineInformation(*_moduleProcessThreadPtr,
+                                               *_outputMixerPtr,
+                                               _opusComplexityController);
+    }
     _audioDeviceLayer = AudioDeviceModule::kDummyAudio;
 }
 
 SharedData::~SharedData()
 {
+    // Channels left by a missing Terminate() still refer to the load
+    // governor and the mixers; destroy them first.
+    _channelManager.DestroyAllChannels();
+    delete _loadGovernorPtr;
     OutputMixer::Destroy(_outputMixerPtr);
     TransmitMixer::Destroy(_transmitMixerPtr);
     if (_audioDevicePtr) {
@@ -11,6 +11,8 @@
 #ifndef WEBRTC_VOICE_ENGINE_SHARED_DATA_H
 #define WEBRTC_VOICE_ENGINE_SHARED_DATA_H
 
+#include "audio_engine/modules/audio_coding/main/interface/audio_codec_pool.h"
+#include "audio_engine/modules/audio_coding/main/interface/opus_complexity_controller.h"
 #include "audio_engine/modules/audio_device/include/audio_device.h"
 #include "audio_engine/modules/audio_processing/include/audio_processing.h"
 #include "audio_engine/modules/utility/interface/process_thread.h"
@@ -27,6 +29,7 @@ class CriticalSectionWrapper;
 
 namespace voe {
 
+class LoadGovernor;
 class TransmitMixer;
 class OutputMixer;
 
@@ -37,12 +40,17 @@ public:
     uint32_t instance_id() const { return _instanceId; }
     Statistics& statistics() { return _engineStatistics; }
     ChannelManager& channel_manager() { return _channelManager; }
+    OpusComplexityController& opus_complexity_controller() {
+      return _opusComplexityController;
+    }
+    AudioCodecPool& codec_pool() { return _codecPool; }
     AudioDeviceModule* audio_device() { return _audioDevicePtr; }
     void set_audio_device(AudioDeviceModule* audio_device);
     AudioProcessing* audio_processing() { return audioproc_.get(); }
     void set_audio_processing(AudioProcessing* audio_processing);
     TransmitMixer* transmit_mixer() { return _transmitMixerPtr; }
     OutputMixer* output_mixer() { return _outputMixerPtr; }
+    LoadGovernor* load_governor() { return _loadGovernorPtr; }
     CriticalSectionWrapper* crit_sec() { return _apiCritPtr; }
     bool ext_recording() const { return _externalRecording; }
     void set_ext_recording(bool value) { _externalRecording = value; }
@@ -68,11 +76,17 @@ public:
 protected:
     const uint32_t _instanceId;
     CriticalSectionWrapper* _apiCritPtr;
+    // Declared before |_channelManager| since the channels' encoders are
+    // registered with it, and their codecs returned to the pool, until they
+    // are destroyed.
+    OpusComplexityController _opusComplexityController;
+    AudioCodecPool _codecPool;
     ChannelManager _channelManager;
     Statistics _engineStatistics;
     AudioDeviceModule* _audioDevicePtr;
     OutputMixer* _outputMixerPtr;
     TransmitMixer* _transmitMixerPtr;
+    LoadGovernor* _loadGovernorPtr;
     scoped_ptr<AudioProcessing> audioproc_;
     ProcessThread* _moduleProcessThreadPtr;
 
@@ -14,9 +14,11 @@
 #include "audio_engine/system_wrappers/interface/critical_section_wrapper.h"
 #include "audio_engine/system_wrappers/interface/event_wrapper.h"
 #include "audio_engine/system_wrappers/interface/logging.h"
+#include "audio_engine/system_wrappers/interface/tick_util.h"
 #include "audio_engine/system_wrappers/interface/trace.h"
 #include "audio_engine/voice_engine/channel.h"
 #include "audio_engine/voice_engine/channel_manager.h"
+#include "audio_engine/voice_engine/encode_worker_pool.h"
 #include "audio_engine/voice_engine/include/voe_external_media.h"
 #include "audio_engine/voice_engine/statistics.h"
 #include "audio_engine/voice_engine/utility.h"
@@ -202,7 +204,9 @@ TransmitMixer::TransmitMixer(uint32_t instanceId) :
     _mute(false),
     _remainingMuteMicTimeMs(0),
     stereo_codec_(false),
-    swap_stereo_channels_(false)
+    swap_stereo_channels_(false),
+    _captureTimeUs(0),
+    _encodeCritSect(*CriticalSectionWrapper::CreateCriticalSection())
 {
     WEBRTC_TRACE(kTraceMemory, kTraceVoice, VoEId(_instanceId, -1),
                  "TransmitMixer::TransmitMixer() - ctor");
@@ -243,8 +247,14 @@ TransmitMixer::~TransmitMixer()
             _filePlayerPtr = NULL;
         }
     }
+    encode_pool_.reset();
+    for (size_t i = 0; i < send_format_frames_.size(); ++i)
+    {
+        delete send_format_frames_[i];
+    }
     delete &_critSect;
     delete &_callbackCritSect;
+    delete &_encodeCritSect;
 }
 
 int32_t
@@ -332,6 +342,12 @@ TransmitMixer::PrepareDemux(const void* audioSamples,
                  "currentMicLevel=%u)", nSamples, nChannels, samplesPerSec,
                  totalDelayMS, clockDrift, currentMicLevel);
 
+    _captureTimeUs = TickTime::MicrosecondTimestamp();
+    for (size_t i = 0; i < send_format_frames_.size(); ++i)
+    {
+        send_format_frames_[i]->updated = false;
+    }
+
     // --- Resample input audio and create/store the initial audio frame
     GenerateAudioFrame(static_cast<const int16_t*>(audioSamples),
                        nSamples,
@@ -423,9 +439,7 @@ TransmitMixer::DemuxAndMix()
         Channel* channelPtr = it.GetChannel();
         if (channelPtr->Sending())
         {
-            // Demultiplex makes a copy of its input.
-            channelPtr->Demultiplex(_audioFrame);
-            channelPtr->PrepareEncodeAndSend(_audioFrame.sample_rate_hz_);
+            Demultiplex(channelPtr);
         }
     }
     return 0;
@@ -438,40 +452,158 @@ void TransmitMixer::DemuxAndMix(const int voe_channels[],
     voe::Channel* channel_ptr = ch.channel();
     if (channel_ptr) {
       if (channel_ptr->Sending()) {
-        // Demultiplex makes a copy of its input.
-        channel_ptr->Demultiplex(_audioFrame);
-        channel_ptr->PrepareEncodeAndSend(_audioFrame.sample_rate_hz_);
+        Demultiplex(channel_ptr);
       }
     }
   }
 }
 
+void TransmitMixer::Demultiplex(Channel* channel) {
+  int codec_rate = 0;
+  int num_codec_channels = 0;
+  channel->GetSendFormat(&codec_rate, &num_codec_channels);
+  const AudioFrame& frame = ConvertedFrame(codec_rate, num_codec_channels);
+  // The channel encodes from |frame| in EncodeAndSend() and only copies it
+  // when it has to change the audio.
+  channel->Demultiplex(frame, _captureTimeUs);
+  channel->PrepareEncodeAndSend(frame.sample_rate_hz_);
+}
+
+const AudioFrame& TransmitMixer::ConvertedFrame(int codecRateHz,
+                                                int codecChannels) {
+  // Like DownConvertToCodecFormat(), never upsample or upmix here; the ACM
+  // does that at the end of the send chain.
+  int sample_rate_hz = _audioFrame.sample_rate_hz_;
+  // The channel runs its audio level analysis on the frame, so only convert
+  // to rates that AudioProcessing handles natively.
+  if (codecRateHz == 8000 || codecRateHz == 16000 || codecRateHz == 32000)
+    sample_rate_hz = std::min(codecRateHz, sample_rate_hz);
+  const int num_channels =
+      codecChannels > 0 ? std::min(codecChannels, _audioFrame.num_channels_)
+                        : _audioFrame.num_channels_;
+  if (sample_rate_hz == _audioFrame.sample_rate_hz_ &&
+      num_channels == _audioFrame.num_channels_) {
+    return _audioFrame;
+  }
+
+  SendFormatFrame* converted = NULL;
+  for (size_t i = 0; i < send_format_frames_.size(); ++i) {
+    if (send_format_frames_[i]->sample_rate_hz == sample_rate_hz &&
+        send_format_frames_[i]->num_channels == num_channels) {
+      converted = send_format_frames_[i];
+      break;
+    }
+  }
+  if (!converted) {
+    converted = new SendFormatFrame;
+    converted->sample_rate_hz = sample_rate_hz;
+    converted->num_channels = num_channels;
+    converted->updated = false;
+    send_format_frames_.push_back(converted);
+  }
+  if (!converted->updated) {
+    if (!mono_buffer_.get()) {
+      // Temporary space for DownConvertToCodecFormat.
+      mono_buffer_.reset(new int16_t[kMaxMonoDataSizeSamples]);
+    }
+    DownConvertToCodecFormat(_audioFrame.data_,
+                             _audioFrame.samples_per_channel_,
+                             _audioFrame.num_channels_,
+                             _audioFrame.sample_rate_hz_,
+                             num_channels,
+                             sample_rate_hz,
+                             mono_buffer_.get(),
+                             &converted->resampler,
+                             &converted->frame);
+    converted->frame.speech_type_ = _audioFrame.speech_type_;
+    converted->frame.vad_activity_ = _audioFrame.vad_activity_;
+    converted->updated = true;
+  }
+  return converted->frame;
+}
+
 int32_t
 TransmitMixer::EncodeAndSend()
 {
     WEBRTC_TRACE(kTraceStream, kTraceVoice, VoEId(_instanceId, -1),
                  "TransmitMixer::EncodeAndSend()");
 
-    for (ChannelManager::Iterator it(_channelManagerPtr); it.IsValid();
-         it.Increment())
+    // The iterator holds a reference to each channel until encoding is done.
+    ChannelManager::Iterator it(_channelManagerPtr);
+    std::vector<Channel*> channels;
+    for (; it.IsValid(); it.Increment())
     {
         Channel* channelPtr = it.GetChannel();
         if (channelPtr->Sending())
         {
-            channelPtr->EncodeAndSend();
+            channels.push_back(channelPtr);
         }
     }
+    EncodeChannels(channels);
     return 0;
 }
 
 void TransmitMixer::EncodeAndSend(const int voe_channels[],
                                   int number_of_voe_channels) {
+  std::vector<voe::ChannelOwner> owners;
+  std::vector<Channel*> channels;
   for (int i = 0; i < number_of_voe_channels; ++i) {
     voe::ChannelOwner ch = _channelManagerPtr->GetChannel(voe_channels[i]);
     voe::Channel* channel_ptr = ch.channel();
-    if (channel_ptr && channel_ptr->Sending())
-      channel_ptr->EncodeAndSend();
+    if (channel_ptr && channel_ptr->Sending()) {
+      owners.push_back(ch);
+      channels.push_back(channel_ptr);
+    }
   }
+  EncodeChannels(channels);
+}
+
+void TransmitMixer::EncodeChannels(const std::vector<Channel*>& channels) {
+  if (channels.empty())
+    return;
+  CriticalSectionScoped cs(&_encodeCritSect);
+  if (encode_pool_.get() && channels.size() > 1) {
+    encode_pool_->EncodeAndSend(&channels[0],
+                                static_cast<int>(channels.size()));
+    return;
+  }
+  for (size_t i = 0; i < channels.size(); ++i)
+    channels[i]->EncodeAndSend();
+}
+
+int TransmitMixer::SetEncodeThreads(int numThreads)
+{
+    WEBRTC_TRACE(kTraceInfo, kTraceVoice, VoEId(_instanceId, -1),
+                 "TransmitMixer::SetEncodeThreads(numThreads=%d)", numThreads);
+    if (numThreads < 0)
+    {
+        return -1;
+    }
+    scoped_ptr<EncodeWorkerPool> pool;
+    if (numThreads > 0)
+    {
+        pool.reset(new EncodeWorkerPool(numThreads));
+        if (!pool->Start())
+        {
+            WEBRTC_TRACE(kTraceError, kTraceVoice, VoEId(_instanceId, -1),
+                         "TransmitMixer::SetEncodeThreads() failed to start "
+                         "the worker threads");
+            return -1;
+        }
+    }
+    // Swap under the lock and let |pool| stop the old threads afterwards, so
+    // that the capture thread is not blocked while they are reclaimed.
+    {
+        CriticalSectionScoped cs(&_encodeCritSect);
+        encode_pool_.swap(pool);
+    }
+    return 0;
+}
+
+int TransmitMixer::EncodeThreads() const
+{
+    CriticalSectionScoped cs(&_encodeCritSect);
+    return encode_pool_.get() ? encode_pool_->num_threads() : 0;
 }
 
 uint32_t TransmitMixer::CaptureLevel() const
@@ -11,6 +11,8 @@
 #ifndef WEBRTC_VOICE_ENGINE_TRANSMIT_MIXER_H
 #define WEBRTC_VOICE_ENGINE_TRANSMIT_MIXER_H
 
+#include <vector>
+
 #include "audio_engine/common_audio/resampler/include/push_resampler.h"
 #include "audio_engine/include/common_types.h"
 #include "audio_engine/modules/audio_processing/typing_detection.h"
@@ -32,7 +34,9 @@ class VoEMediaProcess;
 
 namespace voe {
 
+class Channel;
 class ChannelManager;
+class EncodeWorkerPool;
 class MixedAudio;
 class Statistics;
 
@@ -70,6 +74,13 @@ public:
     // channels for encoding and sending to the network.
     void EncodeAndSend(const int voe_channels[], int number_of_voe_channels);
 
+    // Spreads EncodeAndSend() over |numThreads| worker threads in addition to
+    // the capture thread. 0 (the default) encodes all channels on the capture
+    // thread. With worker threads, Transport::SendPacket() can be called
+    // concurrently for different channels.
+    int SetEncodeThreads(int numThreads);
+    int EncodeThreads() const;
+
     // Must be called on the same thread as PrepareDemux().
     uint32_t CaptureLevel() const;
 
@@ -190,6 +201,18 @@ private:
     void TypingDetection(bool keyPressed);
 #endif
 
+    // Encodes |channels| on the worker pool if there is one, otherwise on the
+    // calling thread.
+    void EncodeChannels(const std::vector<Channel*>& channels);
+
+    // Returns |_audioFrame| down-converted to at most |codecRateHz| and
+    // |codecChannels|. Each distinct format is converted once per captured
+    // frame and the result is shared by all channels sending that format.
+    const AudioFrame& ConvertedFrame(int codecRateHz, int codecChannels);
+
+    // Passes |_audioFrame| in the send format of |channel| to the channel.
+    void Demultiplex(Channel* channel);
+
     // uses
     Statistics* _engineStatisticsPtr;
     ChannelManager* _channelManagerPtr;
@@ -232,6 +255,22 @@ private:
     bool stereo_codec_;
     bool swap_stereo_channels_;
     scoped_ptr<int16_t[]> mono_buffer_;
+    // |_audioFrame| in each send format that differs from its own. Entries
+    // are kept across frames so that the resampler state stays continuous.
+    struct SendFormatFrame {
+        int sample_rate_hz;
+        int num_channels;
+        bool updated;
+        AudioFrame frame;
+        PushResampler<int16_t> resampler;
+    };
+    std::vector<SendFormatFrame*> send_format_frames_;
+    // Time at which the frame in |_audioFrame| was delivered by the ADM.
+    int64_t _captureTimeUs;
+    // Held by the capture thread while encoding and while the pool is
+    // replaced.
+    CriticalSectionWrapper& _encodeCritSect;
+    scoped_ptr<EncodeWorkerPool> encode_pool_;
 };
 
 }  // namespace voe
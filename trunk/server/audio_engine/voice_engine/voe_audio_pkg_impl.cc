@@ -511,6 +511,28 @@ int VoERTP_RTCPImpl::GetRTCPStatistics(int channel, CallStatistics& stats)
     return channelPtr->GetRTPStatistics(stats);
 }
 
+int VoERTP_RTCPImpl::GetCaptureToPacketLatency(int channel,
+                                               int& averageUs,
+                                               int& maxUs)
+{
+    WEBRTC_TRACE(kTraceApiCall, kTraceVoice, VoEId(_shared->instance_id(), -1),
+                 "GetCaptureToPacketLatency(channel=%d)", channel);
+    if (!_shared->statistics().Initialized())
+    {
+        _shared->SetLastError(VE_NOT_INITED, kTraceError);
+        return -1;
+    }
+    voe::ChannelOwner ch = _shared->channel_manager().GetChannel(channel);
+    voe::Channel* channelPtr = ch.channel();
+    if (channelPtr == NULL)
+    {
+        _shared->SetLastError(VE_CHANNEL_NOT_VALID, kTraceError,
+            "GetCaptureToPacketLatency() failed to locate channel");
+        return -1;
+    }
+    return channelPtr->GetCaptureToPacketLatency(averageUs, maxUs);
+}
+
 int VoERTP_RTCPImpl::GetRemoteRTCPSenderInfo(int channel,
                                              SenderInfo* sender_info) {
   WEBRTC_TRACE(kTraceApiCall, kTraceVoice, VoEId(_shared->instance_id(), -1),
@@ -86,6 +86,10 @@ public:
 
     virtual int GetRTCPStatistics(int channel, CallStatistics& stats);
 
+    virtual int GetCaptureToPacketLatency(int channel,
+                                          int& averageUs,
+                                          int& maxUs);
+
     virtual int GetRemoteRTCPSenderInfo(int channel, SenderInfo* sender_info);
 
     virtual int GetRemoteRTCPReportBlocks(
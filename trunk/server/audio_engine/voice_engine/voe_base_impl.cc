@@ -17,9 +17,11 @@
 #include "audio_engine/modules/audio_processing/include/audio_processing.h"
 #include "audio_engine/system_wrappers/interface/critical_section_wrapper.h"
 #include "audio_engine/system_wrappers/interface/file_wrapper.h"
+#include "audio_engine/system_wrappers/interface/tick_util.h"
 #include "audio_engine/system_wrappers/interface/trace.h"
 #include "audio_engine/voice_engine/channel.h"
 #include "audio_engine/voice_engine/include/voe_errors.h"
+#include "audio_engine/voice_engine/load_governor.h"
 #include "audio_engine/voice_engine/output_mixer.h"
 #include "audio_engine/voice_engine/transmit_mixer.h"
 #include "audio_engine/voice_engine/utility.h"
@@ -261,6 +263,7 @@ int VoEBaseImpl::RegisterAudioEngineObserver(AudioEngineObserver& observer)
     }
 
     _shared->transmit_mixer()->RegisterVoiceEngineObserver(observer);
+    _shared->load_governor()->RegisterVoiceEngineObserver(observer);
 
     _voiceEngineObserverPtr = &observer;
     _voiceEngineObserver = true;
@@ -282,6 +285,7 @@ int VoEBaseImpl::DeRegisterAudioEngineObserver()
 
     _voiceEngineObserver = false;
     _voiceEngineObserverPtr = NULL;
+    _shared->load_governor()->DeRegisterVoiceEngineObserver();
 
     // Deregister the observer in all active channels
     for (voe::ChannelManager::Iterator it(&_shared->channel_manager());
@@ -525,6 +529,9 @@ int VoEBaseImpl::CreateChannel(const Config& config) {
 
 int VoEBaseImpl::InitializeChannel(voe::ChannelOwner* channel_owner)
 {
+    // Before Init(), which registers the codecs. Not fatal; the channel then
+    // allocates its codecs itself.
+    channel_owner->channel()->SetCodecPool(&_shared->codec_pool());
     if (channel_owner->channel()->SetEngineInformation(
             _shared->statistics(),
             *_shared->output_mixer(),
@@ -551,6 +558,10 @@ int VoEBaseImpl::InitializeChannel(voe::ChannelOwner* channel_owner)
           .DestroyChannel(channel_owner->channel()->ChannelId());
       return -1;
     }
+    // Not fatal; the channel then encodes at the default Opus complexity.
+    channel_owner->channel()->SetOpusComplexityController(
+        &_shared->opus_complexity_controller());
+    channel_owner->channel()->SetLoadGovernor(_shared->load_governor());
 
     WEBRTC_TRACE(kTraceStateInfo, kTraceVoice,
         VoEId(_shared->instance_id(), -1),
@@ -873,6 +884,50 @@ int VoEBaseImpl::LastError()
     return (_shared->statistics().LastError());
 }
 
+int VoEBaseImpl::SetEncodeThreads(int numThreads)
+{
+    WEBRTC_TRACE(kTraceApiCall, kTraceVoice, VoEId(_shared->instance_id(), -1),
+                 "SetEncodeThreads(numThreads=%d)", numThreads);
+    if (numThreads < 0)
+    {
+        _shared->SetLastError(VE_INVALID_ARGUMENT, kTraceError,
+            "SetEncodeThreads() invalid number of threads");
+        return -1;
+    }
+    if (_shared->transmit_mixer()->SetEncodeThreads(numThreads) != 0)
+    {
+        _shared->SetLastError(VE_THREAD_ERROR, kTraceError,
+            "SetEncodeThreads() failed to start the encode threads");
+        return -1;
+    }
+    return 0;
+}
+
+int VoEBaseImpl::GetEncodeThreads(int& numThreads)
+{
+    WEBRTC_TRACE(kTraceApiCall, kTraceVoice, VoEId(_shared->instance_id(), -1),
+                 "GetEncodeThreads()");
+    numThreads = _shared->transmit_mixer()->EncodeThreads();
+    return 0;
+}
+
+int VoEBaseImpl::SetLoadShedding(bool enable)
+{
+    WEBRTC_TRACE(kTraceApiCall, kTraceVoice, VoEId(_shared->instance_id(), -1),
+                 "SetLoadShedding(enable=%d)", enable);
+    _shared->load_governor()->SetEnabled(enable);
+    return 0;
+}
+
+int VoEBaseImpl::GetLoadSheddingStatus(bool& enabled, LoadSheddingLevels& level)
+{
+    WEBRTC_TRACE(kTraceApiCall, kTraceVoice, VoEId(_shared->instance_id(), -1),
+                 "GetLoadSheddingStatus()");
+    enabled = _shared->load_governor()->Enabled();
+    level = _shared->load_governor()->Level();
+    return 0;
+}
+
 int32_t VoEBaseImpl::StartPlayout()
 {
     WEBRTC_TRACE(kTraceInfo, kTraceVoice, VoEId(_shared->instance_id(), -1),
@@ -1045,6 +1100,7 @@ int VoEBaseImpl::ProcessRecordedDataWithAPM(
   assert(_shared->transmit_mixer() != NULL);
   assert(_shared->audio_device() != NULL);
 
+  const int64_t start_time_us = TickTime::MicrosecondTimestamp();
   uint32_t max_volume = 0;
   uint16_t voe_mic_level = 0;
   // Check for zero to skip this calculation; the consumer may use this to
@@ -1090,6 +1146,9 @@ int VoEBaseImpl::ProcessRecordedDataWithAPM(
     _shared->transmit_mixer()->EncodeAndSend(voe_channels,
                                              number_of_voe_channels);
   }
+  _shared->load_governor()->TickProcessed(
+      voe::LoadGovernor::kCaptureTick,
+      static_cast<int>(TickTime::MicrosecondTimestamp() - start_time_us));
 
   // Scale from VoE to ADM level range.
   uint32_t new_voe_mic_level = _shared->transmit_mixer()->CaptureLevel();
@@ -1110,6 +1169,8 @@ void VoEBaseImpl::GetPlayoutData(int sample_rate, int number_of_channels,
                                  void* audio_data) {
   assert(_shared->output_mixer() != NULL);
 
+  const int64_t start_time_us = TickTime::MicrosecondTimestamp();
+
   // TODO(andrew): if the device is running in mono, we should tell the mixer
   // here so that it will only request mono from AudioCodingModule.
   // Perform mixing of all active participants (channel-based mixing)
@@ -1122,6 +1183,10 @@ void VoEBaseImpl::GetPlayoutData(int sample_rate, int number_of_channels,
   _shared->output_mixer()->GetMixedAudio(sample_rate, number_of_channels,
                                          &_audioFrame);
 
+  _shared->load_governor()->TickProcessed(
+      voe::LoadGovernor::kPlayoutTick,
+      static_cast<int>(TickTime::MicrosecondTimestamp() - start_time_us));
+
   assert(number_of_frames == _audioFrame.samples_per_channel_);
   assert(sample_rate == _audioFrame.sample_rate_hz_);
 
@@ -60,6 +60,15 @@ public:
 
     virtual int LastError();
 
+    virtual int SetEncodeThreads(int numThreads);
+
+    virtual int GetEncodeThreads(int& numThreads);
+
+    virtual int SetLoadShedding(bool enable);
+
+    virtual int GetLoadSheddingStatus(bool& enabled,
+                                      LoadSheddingLevels& level);
+
     virtual AudioTransport* audio_transport() { return this; }
 
     // AudioTransport
@@ -566,6 +566,88 @@ int VoECodecImpl::RemoveSecondarySendCodec(int channel) {
   return 0;
 }
 
+int VoECodecImpl::SetOpusComplexityBudget(int cpuPercent, bool perStream) {
+  WEBRTC_TRACE(kTraceApiCall, kTraceVoice, VoEId(_shared->instance_id(), -1),
+               "SetOpusComplexityBudget(cpuPercent=%d, perStream=%d)",
+               cpuPercent, perStream);
+  if (!_shared->statistics().Initialized()) {
+    _shared->SetLastError(VE_NOT_INITED, kTraceError);
+    return -1;
+  }
+  if (_shared->opus_complexity_controller().SetBudget(
+          cpuPercent, perStream ? OpusComplexityController::kPerStream
+                                : OpusComplexityController::kGlobal) != 0) {
+    _shared->SetLastError(VE_INVALID_ARGUMENT, kTraceError,
+                          "SetOpusComplexityBudget() invalid budget");
+    return -1;
+  }
+  return 0;
+}
+
+int VoECodecImpl::GetEncodingStatistics(int channel,
+                                        AudioEncodingStats& stats) {
+  WEBRTC_TRACE(kTraceApiCall, kTraceVoice, VoEId(_shared->instance_id(), -1),
+               "GetEncodingStatistics(channel=%d)", channel);
+  if (!_shared->statistics().Initialized()) {
+    _shared->SetLastError(VE_NOT_INITED, kTraceError);
+    return -1;
+  }
+  voe::ChannelOwner ch = _shared->channel_manager().GetChannel(channel);
+  voe::Channel* channelPtr = ch.channel();
+  if (channelPtr == NULL) {
+    _shared->SetLastError(VE_CHANNEL_NOT_VALID, kTraceError,
+                          "GetEncodingStatistics() failed to locate channel");
+    return -1;
+  }
+  stats = AudioEncodingStats();
+  channelPtr->GetEncodingStatistics(&stats);
+  return 0;
+}
+
+int VoECodecImpl::PrewarmCodecPool(const CodecInst& codec, int numInstances) {
+  WEBRTC_TRACE(kTraceApiCall, kTraceVoice, VoEId(_shared->instance_id(), -1),
+               "PrewarmCodecPool(codec=%s, numInstances=%d)", codec.plname,
+               numInstances);
+  if (!_shared->statistics().Initialized()) {
+    _shared->SetLastError(VE_NOT_INITED, kTraceError);
+    return -1;
+  }
+  if (_shared->codec_pool().Prewarm(codec, numInstances) != 0) {
+    _shared->SetLastError(VE_INVALID_ARGUMENT, kTraceError,
+                          "PrewarmCodecPool() invalid codec or count");
+    return -1;
+  }
+  return 0;
+}
+
+int VoECodecImpl::SetDecoderIdleTimeout(int channel, int timeoutMs) {
+  WEBRTC_TRACE(kTraceApiCall, kTraceVoice, VoEId(_shared->instance_id(), -1),
+               "SetDecoderIdleTimeout(channel=%d, timeoutMs=%d)", channel,
+               timeoutMs);
+  if (!_shared->statistics().Initialized()) {
+    _shared->SetLastError(VE_NOT_INITED, kTraceError);
+    return -1;
+  }
+  voe::ChannelOwner ch = _shared->channel_manager().GetChannel(channel);
+  voe::Channel* channelPtr = ch.channel();
+  if (channelPtr == NULL) {
+    _shared->SetLastError(VE_CHANNEL_NOT_VALID, kTraceError,
+                          "SetDecoderIdleTimeout() failed to locate channel");
+    return -1;
+  }
+  if (timeoutMs < 0) {
+    _shared->SetLastError(VE_INVALID_ARGUMENT, kTraceError,
+                          "SetDecoderIdleTimeout() invalid timeout");
+    return -1;
+  }
+  if (channelPtr->SetDecoderIdleTimeout(timeoutMs) != 0) {
+    _shared->SetLastError(VE_AUDIO_CODING_MODULE_ERROR, kTraceError,
+                          "SetDecoderIdleTimeout() not supported by the ACM");
+    return -1;
+  }
+  return 0;
+}
+
 #endif  // VOIP_AUDIO_ENGINE_CODEC_API
 
 }  // namespace VoIP
@@ -58,6 +58,14 @@ public:
 
     virtual int GetSecondarySendCodec(int channel, CodecInst& codec);
 
+    virtual int SetOpusComplexityBudget(int cpuPercent, bool perStream);
+
+    virtual int GetEncodingStatistics(int channel, AudioEncodingStats& stats);
+
+    virtual int PrewarmCodecPool(const CodecInst& codec, int numInstances);
+
+    virtual int SetDecoderIdleTimeout(int channel, int timeoutMs);
+
 protected:
     VoECodecImpl(voe::SharedData* shared);
     virtual ~VoECodecImpl();
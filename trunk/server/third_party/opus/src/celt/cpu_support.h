@@ -42,6 +42,17 @@
  */
 #define OPUS_ARCHMASK 3
 
+#elif defined(OPUS_HAVE_RTCD) && defined(OPUS_X86_MAY_HAVE_SSE)
+#include "x86/x86cpu.h"
+
+/* We currently support 3 x86 variants:
+ * arch[0] -> C
+ * arch[1] -> SSE
+ * arch[2] -> SSE2
+ * arch[3] is never selected and uses the SSE2 code.
+ */
+#define OPUS_ARCHMASK 3
+
 #else
 #define OPUS_ARCHMASK 0
 
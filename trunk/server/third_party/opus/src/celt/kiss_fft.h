@@ -118,7 +118,7 @@ kiss_fft_state *opus_fft_alloc_twiddles(int nfft,void * mem,size_t * lenmem, con
 kiss_fft_state *opus_fft_alloc(int nfft,void * mem,size_t * lenmem);
 
 /**
- * opus_fft(cfg,in_out_buf)
+ * opus_fft(cfg,in_out_buf,arch)
  *
  * Perform an FFT on a complex input buffer.
  * for a forward FFT,
@@ -126,9 +126,22 @@ kiss_fft_state *opus_fft_alloc(int nfft,void * mem,size_t * lenmem);
  * fout will be   F[0] , F[1] , ... ,F[nfft-1]
  * Note that each element is complex and can be accessed like
     f[k].r and f[k].i
+ * arch is the value returned by opus_select_arch() and picks the
+ * implementation when run-time CPU detection is enabled.
  * */
-void opus_fft(const kiss_fft_state *cfg,const kiss_fft_cpx *fin,kiss_fft_cpx *fout);
-void opus_ifft(const kiss_fft_state *cfg,const kiss_fft_cpx *fin,kiss_fft_cpx *fout);
+void opus_fft_c(const kiss_fft_state *cfg,const kiss_fft_cpx *fin,kiss_fft_cpx *fout);
+void opus_ifft_c(const kiss_fft_state *cfg,const kiss_fft_cpx *fin,kiss_fft_cpx *fout);
+
+#if defined(OPUS_X86_MAY_HAVE_SSE) && !defined(FIXED_POINT)
+#include "x86/kiss_fft_sse.h"
+#endif
+
+#if !defined(OVERRIDE_OPUS_FFT)
+#define opus_fft(_cfg, _fin, _fout, arch) \
+   ((void)(arch), opus_fft_c(_cfg, _fin, _fout))
+#define opus_ifft(_cfg, _fin, _fout, arch) \
+   ((void)(arch), opus_ifft_c(_cfg, _fin, _fout))
+#endif
 
 void opus_fft_free(const kiss_fft_state *cfg);
 
@@ -57,14 +57,25 @@ int clt_mdct_init(mdct_lookup *l,int N, int maxshift);
 void clt_mdct_clear(mdct_lookup *l);
 
 /** Compute a forward MDCT and scale by 4/N, trashes the input array */
-void clt_mdct_forward(const mdct_lookup *l, kiss_fft_scalar *in,
+void clt_mdct_forward_c(const mdct_lookup *l, kiss_fft_scalar *in,
       kiss_fft_scalar * OPUS_RESTRICT out,
       const opus_val16 *window, int overlap, int shift, int stride);
 
 /** Compute a backward MDCT (no scaling) and performs weighted overlap-add
     (scales implicitly by 1/2) */
-void clt_mdct_backward(const mdct_lookup *l, kiss_fft_scalar *in,
+void clt_mdct_backward_c(const mdct_lookup *l, kiss_fft_scalar *in,
       kiss_fft_scalar * OPUS_RESTRICT out,
       const opus_val16 * OPUS_RESTRICT window, int overlap, int shift, int stride);
 
+#if defined(OPUS_X86_MAY_HAVE_SSE) && !defined(FIXED_POINT)
+#include "x86/mdct_sse.h"
+#endif
+
+#if !defined(OVERRIDE_OPUS_MDCT)
+#define clt_mdct_forward(_l, _in, _out, _window, _overlap, _shift, _stride, arch) \
+   ((void)(arch), clt_mdct_forward_c(_l, _in, _out, _window, _overlap, _shift, _stride))
+#define clt_mdct_backward(_l, _in, _out, _window, _overlap, _shift, _stride, arch) \
+   ((void)(arch), clt_mdct_backward_c(_l, _in, _out, _window, _overlap, _shift, _stride))
+#endif
+
 #endif
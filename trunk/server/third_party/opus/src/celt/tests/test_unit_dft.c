@@ -43,6 +43,9 @@
 #include "kiss_fft.c"
 #include "mathops.c"
 #include "entcode.c"
+#if defined(OPUS_X86_MAY_HAVE_SSE) && !defined(FIXED_POINT)
+#include "x86/kiss_fft_sse.c"
+#endif
 
 
 #ifndef M_PI
@@ -122,14 +125,30 @@ void test1d(int nfft,int isinverse)
     /*for (k=0;k<nfft;++k) printf("%d %d ", in[k].r, in[k].i);printf("\n");*/
 
     if (isinverse)
-       opus_ifft(cfg,in,out);
+       opus_ifft_c(cfg,in,out);
     else
-       opus_fft(cfg,in,out);
+       opus_fft_c(cfg,in,out);
 
     /*for (k=0;k<nfft;++k) printf("%d %d ", out[k].r, out[k].i);printf("\n");*/
 
     check(in,out,nfft,isinverse);
 
+#if defined(OPUS_X86_MAY_HAVE_SSE) && !defined(FIXED_POINT)
+    {
+       kiss_fft_cpx  * out_sse = (kiss_fft_cpx*)malloc(buflen);
+       if (isinverse)
+          opus_ifft_sse(cfg,in,out_sse);
+       else
+          opus_fft_sse(cfg,in,out_sse);
+       /* The SSE version must be bit-exact with the C version */
+       if (memcmp(out, out_sse, buflen) != 0) {
+          printf("** nfft=%d inverse=%d, SSE output differs from C **\n", nfft, isinverse);
+          ret = 1;
+       }
+       free(out_sse);
+    }
+#endif
+
     free(in);
     free(out);
     free(cfg);
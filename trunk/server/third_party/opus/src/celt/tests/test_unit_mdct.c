@@ -45,6 +45,10 @@
 #include "mdct.c"
 #include "mathops.c"
 #include "entcode.c"
+#if defined(OPUS_X86_MAY_HAVE_SSE) && !defined(FIXED_POINT)
+#include "x86/kiss_fft_sse.c"
+#include "x86/mdct_sse.c"
+#endif
 
 #ifndef M_PI
 #define M_PI 3.141592653
@@ -146,17 +150,45 @@ void test1d(int nfft,int isinverse)
        in_copy[k] = in[k];
     /*for (k=0;k<nfft;++k) printf("%d %d ", in[k].r, in[k].i);printf("\n");*/
 
+#if defined(OPUS_X86_MAY_HAVE_SSE) && !defined(FIXED_POINT)
+    {
+       /* The SSE version must be bit-exact with the C version */
+       kiss_fft_scalar  * in_sse = (kiss_fft_scalar*)malloc(buflen);
+       kiss_fft_scalar  * out_sse = (kiss_fft_scalar*)malloc(buflen);
+       for (k=0;k<nfft;++k)
+          in_sse[k] = in[k];
+       for (k=0;k<nfft;++k)
+          out[k] = out_sse[k] = 0;
+       if (isinverse)
+       {
+          clt_mdct_backward_c(&cfg,in,out, window, nfft/2, 0, 1);
+          clt_mdct_backward_sse(&cfg,in_sse,out_sse, window, nfft/2, 0, 1);
+       } else {
+          clt_mdct_forward_c(&cfg,in,out, window, nfft/2, 0, 1);
+          clt_mdct_forward_sse(&cfg,in_sse,out_sse, window, nfft/2, 0, 1);
+       }
+       if (memcmp(out, out_sse, buflen) != 0) {
+          printf("** nfft=%d inverse=%d, SSE output differs from C **\n", nfft, isinverse);
+          ret = 1;
+       }
+       for (k=0;k<nfft;++k)
+          in[k] = in_copy[k];
+       free(in_sse);
+       free(out_sse);
+    }
+#endif
+
     if (isinverse)
     {
        for (k=0;k<nfft;++k)
           out[k] = 0;
-       clt_mdct_backward(&cfg,in,out, window, nfft/2, 0, 1);
+       clt_mdct_backward_c(&cfg,in,out, window, nfft/2, 0, 1);
        /* apply TDAC because clt_mdct_backward() no longer does that */
        for (k=0;k<nfft/4;++k)
           out[nfft-k-1] = out[nfft/2+k];
        check_inv(in,out,nfft,isinverse);
     } else {
-       clt_mdct_forward(&cfg,in,out,window, nfft/2, 0, 1);
+       clt_mdct_forward_c(&cfg,in,out,window, nfft/2, 0, 1);
        check(in_copy,out,nfft,isinverse);
     }
     /*for (k=0;k<nfft;++k) printf("%d %d ", out[k].r, out[k].i);printf("\n");*/
@@ -44,6 +44,7 @@
  * @param N Number of samples to encode
  * @param K Number of pulses to use
  * @param enc Entropy encoder state
+ * @param arch CPU variant returned by opus_select_arch()
  * @ret A mask indicating which blocks in the band received pulses
 */
 unsigned alg_quant(celt_norm *X, int N, int K, int spread, int B,
@@ -51,7 +52,26 @@ unsigned alg_quant(celt_norm *X, int N, int K, int spread, int B,
 #ifdef RESYNTH
       , opus_val16 gain
 #endif
-      );
+      , int arch);
+
+/** Pulse vector search of alg_quant(). Finds the vector iy of K pulses that
+  * is closest in angle to X.
+ * @param X Signal to quantise (the signs are removed and put back)
+ * @param iy Pulse vector (returned)
+ * @param K Number of pulses to use
+ * @param N Number of samples to encode
+ * @ret The energy of iy
+*/
+opus_val16 op_pvq_search_c(celt_norm *X, int *iy, int K, int N);
+
+#if defined(OPUS_X86_MAY_HAVE_SSE) && !defined(FIXED_POINT)
+#include "x86/vq_sse.h"
+#endif
+
+#if !defined(OVERRIDE_OP_PVQ_SEARCH)
+#define op_pvq_search(X, iy, K, N, arch) \
+   ((void)(arch), op_pvq_search_c(X, iy, K, N))
+#endif
 
 /** Algebraic pulse decoder
  * @param X Decoded normalised spectrum (returned)
@@ -0,0 +1,393 @@
+/* Copyright (c) 2014 The WebRTC project authors */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef SKIP_CONFIG_H
+#  ifdef HAVE_CONFIG_H
+#    include "config.h"
+#  endif
+#endif
+
+#include "_kiss_fft_guts.h"
+#include "arch.h"
+#include "os_support.h"
+
+#if defined(OPUS_X86_MAY_HAVE_SSE) && !defined(FIXED_POINT)
+
+#include <xmmintrin.h>
+
+/* SSE versions of opus_fft_c() and opus_ifft_c(). A complex value is two
+   floats, so each butterfly works on two points of a stage at a time, one per
+   half of a register. The arithmetic is done in the same order as the C
+   butterflies and negations only flip sign bits, so the output is bit-exact
+   with the C version. */
+
+/* Loads the complex values at a and b into the low and high halves. */
+static OPUS_INLINE __m128 load_pair(const void *a, const void *b)
+{
+   return _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)a),
+         (const __m64*)b);
+}
+
+/* Stores the halves of v to a and b. When a==b both halves are the same. */
+static OPUS_INLINE void store_pair(kiss_fft_cpx *a, kiss_fft_cpx *b, __m128 v)
+{
+   _mm_storeh_pi((__m64*)b, v);
+   _mm_storel_pi((__m64*)a, v);
+}
+
+/* (r,i) -> (i,r) */
+static OPUS_INLINE __m128 swap_ri(__m128 a)
+{
+   return _mm_shuffle_ps(a, a, _MM_SHUFFLE(2,3,0,1));
+}
+
+/* Sign masks for the real and the imaginary parts. */
+#define SIGN_RE _mm_set_ps(0.f, -0.f, 0.f, -0.f)
+#define SIGN_IM _mm_set_ps(-0.f, 0.f, -0.f, 0.f)
+
+/* C_MUL(): (a.r*b.r - a.i*b.i, a.r*b.i + a.i*b.r) */
+static OPUS_INLINE __m128 cmul(__m128 a, __m128 b)
+{
+   __m128 ar = _mm_shuffle_ps(a, a, _MM_SHUFFLE(2,2,0,0));
+   __m128 ai = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3,3,1,1));
+   return _mm_add_ps(_mm_mul_ps(ar, b),
+         _mm_xor_ps(_mm_mul_ps(ai, swap_ri(b)), SIGN_RE));
+}
+
+/* C_MULC(): (a.r*b.r + a.i*b.i, a.i*b.r - a.r*b.i) */
+static OPUS_INLINE __m128 cmulc(__m128 a, __m128 b)
+{
+   __m128 ar = _mm_shuffle_ps(a, a, _MM_SHUFFLE(2,2,0,0));
+   __m128 ai = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3,3,1,1));
+   return _mm_add_ps(_mm_mul_ps(ai, swap_ri(b)),
+         _mm_xor_ps(_mm_mul_ps(ar, b), SIGN_IM));
+}
+
+/* The butterflies of a stage go over N groups of m points, i.e. point (i,j)
+   is at Fout[i*mm+j]. Points are taken two at a time in the order of the
+   nested loops of the C version; if N*m is odd, the last point is paired with
+   itself. This moves (i,j) to the next point. */
+static OPUS_INLINE void next_point(int *i, int *j, int m)
+{
+   if (++*j == m)
+   {
+      *j = 0;
+      ++*i;
+   }
+}
+
+static void kf_bfly2_sse(kiss_fft_cpx *Fout, const size_t fstride,
+      const kiss_fft_state *st, int m, int N, int mm, int inverse)
+{
+   const kiss_twiddle_cpx *tw = st->twiddles;
+   int i0, j0, i1, j1, k;
+
+   i0 = j0 = 0;
+   for (k = N*m; k > 0; k -= 2)
+   {
+      kiss_fft_cpx *Fa, *Fb;
+      __m128 f0, f1, t;
+      i1 = i0; j1 = j0;
+      if (k > 1)
+         next_point(&i1, &j1, m);
+      Fa = Fout + i0*mm + j0;
+      Fb = Fout + i1*mm + j1;
+
+      f0 = load_pair(Fa, Fb);
+      f1 = load_pair(Fa + m, Fb + m);
+      t = load_pair(&tw[j0*fstride], &tw[j1*fstride]);
+      t = inverse ? cmulc(f1, t) : cmul(f1, t);
+      store_pair(Fa + m, Fb + m, _mm_sub_ps(f0, t));
+      store_pair(Fa, Fb, _mm_add_ps(f0, t));
+
+      i0 = i1; j0 = j1;
+      next_point(&i0, &j0, m);
+   }
+}
+
+static void kf_bfly4_sse(kiss_fft_cpx *Fout, const size_t fstride,
+      const kiss_fft_state *st, int m, int N, int mm, int inverse)
+{
+   const kiss_twiddle_cpx *tw = st->twiddles;
+   int i0, j0, i1, j1, k;
+
+   i0 = j0 = 0;
+   for (k = N*m; k > 0; k -= 2)
+   {
+      kiss_fft_cpx *Fa, *Fb;
+      __m128 f0, s0, s1, s2, s3, s4, s5;
+      i1 = i0; j1 = j0;
+      if (k > 1)
+         next_point(&i1, &j1, m);
+      Fa = Fout + i0*mm + j0;
+      Fb = Fout + i1*mm + j1;
+
+      f0 = load_pair(Fa, Fb);
+      s0 = load_pair(Fa + m, Fb + m);
+      s1 = load_pair(Fa + 2*m, Fb + 2*m);
+      s2 = load_pair(Fa + 3*m, Fb + 3*m);
+      if (inverse)
+      {
+         s0 = cmulc(s0, load_pair(&tw[j0*fstride], &tw[j1*fstride]));
+         s1 = cmulc(s1, load_pair(&tw[2*j0*fstride], &tw[2*j1*fstride]));
+         s2 = cmulc(s2, load_pair(&tw[3*j0*fstride], &tw[3*j1*fstride]));
+      } else {
+         s0 = cmul(s0, load_pair(&tw[j0*fstride], &tw[j1*fstride]));
+         s1 = cmul(s1, load_pair(&tw[2*j0*fstride], &tw[2*j1*fstride]));
+         s2 = cmul(s2, load_pair(&tw[3*j0*fstride], &tw[3*j1*fstride]));
+      }
+
+      s5 = _mm_sub_ps(f0, s1);
+      f0 = _mm_add_ps(f0, s1);
+      s3 = _mm_add_ps(s0, s2);
+      s4 = _mm_sub_ps(s0, s2);
+      store_pair(Fa + 2*m, Fb + 2*m, _mm_sub_ps(f0, s3));
+      store_pair(Fa, Fb, _mm_add_ps(f0, s3));
+
+      /* (s4.i, -s4.r) */
+      s4 = _mm_xor_ps(swap_ri(s4), SIGN_IM);
+      if (inverse)
+      {
+         store_pair(Fa + m, Fb + m, _mm_sub_ps(s5, s4));
+         store_pair(Fa + 3*m, Fb + 3*m, _mm_add_ps(s5, s4));
+      } else {
+         store_pair(Fa + m, Fb + m, _mm_add_ps(s5, s4));
+         store_pair(Fa + 3*m, Fb + 3*m, _mm_sub_ps(s5, s4));
+      }
+
+      i0 = i1; j0 = j1;
+      next_point(&i0, &j0, m);
+   }
+}
+
+#ifndef RADIX_TWO_ONLY
+
+static void kf_bfly3_sse(kiss_fft_cpx *Fout, const size_t fstride,
+      const kiss_fft_state *st, int m, int N, int mm, int inverse)
+{
+   const kiss_twiddle_cpx *tw = st->twiddles;
+   const __m128 half = _mm_set1_ps(.5f);
+   __m128 epi3;
+   int i0, j0, i1, j1, k;
+
+   epi3 = _mm_set1_ps(inverse ? -tw[fstride*m].i : tw[fstride*m].i);
+   i0 = j0 = 0;
+   for (k = N*m; k > 0; k -= 2)
+   {
+      kiss_fft_cpx *Fa, *Fb;
+      __m128 f0, f1, s0, s1, s2, s3;
+      i1 = i0; j1 = j0;
+      if (k > 1)
+         next_point(&i1, &j1, m);
+      Fa = Fout + i0*mm + j0;
+      Fb = Fout + i1*mm + j1;
+
+      f0 = load_pair(Fa, Fb);
+      s1 = load_pair(Fa + m, Fb + m);
+      s2 = load_pair(Fa + 2*m, Fb + 2*m);
+      if (inverse)
+      {
+         s1 = cmulc(s1, load_pair(&tw[j0*fstride], &tw[j1*fstride]));
+         s2 = cmulc(s2, load_pair(&tw[2*j0*fstride], &tw[2*j1*fstride]));
+      } else {
+         s1 = cmul(s1, load_pair(&tw[j0*fstride], &tw[j1*fstride]));
+         s2 = cmul(s2, load_pair(&tw[2*j0*fstride], &tw[2*j1*fstride]));
+      }
+
+      s3 = _mm_add_ps(s1, s2);
+      s0 = _mm_sub_ps(s1, s2);
+      f1 = _mm_sub_ps(f0, _mm_mul_ps(s3, half));
+      s0 = _mm_mul_ps(s0, epi3);
+      store_pair(Fa, Fb, _mm_add_ps(f0, s3));
+
+      /* (s0.i, -s0.r) */
+      s0 = _mm_xor_ps(swap_ri(s0), SIGN_IM);
+      store_pair(Fa + 2*m, Fb + 2*m, _mm_add_ps(f1, s0));
+      store_pair(Fa + m, Fb + m, _mm_sub_ps(f1, s0));
+
+      i0 = i1; j0 = j1;
+      next_point(&i0, &j0, m);
+   }
+}
+
+static void kf_bfly5_sse(kiss_fft_cpx *Fout, const size_t fstride,
+      const kiss_fft_state *st, int m, int N, int mm, int inverse)
+{
+   const kiss_twiddle_cpx *tw = st->twiddles;
+   __m128 yar, yai, ybr, ybi;
+   int i0, j0, i1, j1, k;
+
+   yar = _mm_set1_ps(tw[fstride*m].r);
+   yai = _mm_set1_ps(tw[fstride*m].i);
+   ybr = _mm_set1_ps(tw[fstride*2*m].r);
+   ybi = _mm_set1_ps(tw[fstride*2*m].i);
+   i0 = j0 = 0;
+   for (k = N*m; k > 0; k -= 2)
+   {
+      kiss_fft_cpx *Fa, *Fb;
+      __m128 s0, s1, s2, s3, s4, s5, s6, s7, s8, s9, s10, s11, s12;
+      i1 = i0; j1 = j0;
+      if (k > 1)
+         next_point(&i1, &j1, m);
+      Fa = Fout + i0*mm + j0;
+      Fb = Fout + i1*mm + j1;
+
+      s0 = load_pair(Fa, Fb);
+      s1 = load_pair(Fa + m, Fb + m);
+      s2 = load_pair(Fa + 2*m, Fb + 2*m);
+      s3 = load_pair(Fa + 3*m, Fb + 3*m);
+      s4 = load_pair(Fa + 4*m, Fb + 4*m);
+      if (inverse)
+      {
+         s1 = cmulc(s1, load_pair(&tw[j0*fstride], &tw[j1*fstride]));
+         s2 = cmulc(s2, load_pair(&tw[2*j0*fstride], &tw[2*j1*fstride]));
+         s3 = cmulc(s3, load_pair(&tw[3*j0*fstride], &tw[3*j1*fstride]));
+         s4 = cmulc(s4, load_pair(&tw[4*j0*fstride], &tw[4*j1*fstride]));
+      } else {
+         s1 = cmul(s1, load_pair(&tw[j0*fstride], &tw[j1*fstride]));
+         s2 = cmul(s2, load_pair(&tw[2*j0*fstride], &tw[2*j1*fstride]));
+         s3 = cmul(s3, load_pair(&tw[3*j0*fstride], &tw[3*j1*fstride]));
+         s4 = cmul(s4, load_pair(&tw[4*j0*fstride], &tw[4*j1*fstride]));
+      }
+
+      s7 = _mm_add_ps(s1, s4);
+      s10 = _mm_sub_ps(s1, s4);
+      s8 = _mm_add_ps(s2, s3);
+      s9 = _mm_sub_ps(s2, s3);
+
+      store_pair(Fa, Fb, _mm_add_ps(s0, _mm_add_ps(s7, s8)));
+
+      s5 = _mm_add_ps(_mm_add_ps(s0, _mm_mul_ps(s7, yar)), _mm_mul_ps(s8, ybr));
+      s11 = _mm_add_ps(_mm_add_ps(s0, _mm_mul_ps(s7, ybr)), _mm_mul_ps(s8, yar));
+
+      s10 = swap_ri(s10);
+      s9 = swap_ri(s9);
+      /* (s10.i*ya.i + s9.i*yb.i, s10.r*ya.i + s9.r*yb.i) */
+      s6 = _mm_add_ps(_mm_mul_ps(s10, yai), _mm_mul_ps(s9, ybi));
+      /* (s10.i*yb.i - s9.i*ya.i, s10.r*yb.i - s9.r*ya.i) */
+      s12 = _mm_sub_ps(_mm_mul_ps(s10, ybi), _mm_mul_ps(s9, yai));
+      if (inverse)
+      {
+         s6 = _mm_xor_ps(s6, SIGN_RE);
+         s12 = _mm_xor_ps(s12, SIGN_IM);
+      } else {
+         s6 = _mm_xor_ps(s6, SIGN_IM);
+         s12 = _mm_xor_ps(s12, SIGN_RE);
+      }
+
+      store_pair(Fa + m, Fb + m, _mm_sub_ps(s5, s6));
+      store_pair(Fa + 4*m, Fb + 4*m, _mm_add_ps(s5, s6));
+      store_pair(Fa + 2*m, Fb + 2*m, _mm_add_ps(s11, s12));
+      store_pair(Fa + 3*m, Fb + 3*m, _mm_sub_ps(s11, s12));
+
+      i0 = i1; j0 = j1;
+      next_point(&i0, &j0, m);
+   }
+}
+
+#endif
+
+static void opus_fft_impl_sse(const kiss_fft_state *st, const kiss_fft_cpx *fin,
+      kiss_fft_cpx *fout, int inverse)
+{
+   int m2, m;
+   int p;
+   int L;
+   int fstride[MAXFACTORS];
+   int i;
+   int shift;
+
+   /* st->shift can be -1 */
+   shift = st->shift>0 ? st->shift : 0;
+
+   celt_assert2 (fin != fout, "In-place FFT not supported");
+   /* Bit-reverse the input */
+   if (inverse)
+   {
+      for (i=0;i<st->nfft;i++)
+         fout[st->bitrev[i]] = fin[i];
+   } else {
+      __m128 scale = _mm_set1_ps(st->scale);
+      for (i=0;i+1<st->nfft;i+=2)
+      {
+         __m128 x = _mm_mul_ps(load_pair(&fin[i], &fin[i+1]), scale);
+         store_pair(&fout[st->bitrev[i]], &fout[st->bitrev[i+1]], x);
+      }
+      for (;i<st->nfft;i++)
+      {
+         fout[st->bitrev[i]] = fin[i];
+         fout[st->bitrev[i]].r *= st->scale;
+         fout[st->bitrev[i]].i *= st->scale;
+      }
+   }
+
+   fstride[0] = 1;
+   L=0;
+   do {
+      p = st->factors[2*L];
+      m = st->factors[2*L+1];
+      fstride[L+1] = fstride[L]*p;
+      L++;
+   } while(m!=1);
+   m = st->factors[2*L-1];
+   for (i=L-1;i>=0;i--)
+   {
+      if (i!=0)
+         m2 = st->factors[2*i-1];
+      else
+         m2 = 1;
+      switch (st->factors[2*i])
+      {
+      case 2:
+         kf_bfly2_sse(fout,fstride[i]<<shift,st,m, fstride[i], m2, inverse);
+         break;
+      case 4:
+         kf_bfly4_sse(fout,fstride[i]<<shift,st,m, fstride[i], m2, inverse);
+         break;
+#ifndef RADIX_TWO_ONLY
+      case 3:
+         kf_bfly3_sse(fout,fstride[i]<<shift,st,m, fstride[i], m2, inverse);
+         break;
+      case 5:
+         kf_bfly5_sse(fout,fstride[i]<<shift,st,m, fstride[i], m2, inverse);
+         break;
+#endif
+      }
+      m = m2;
+   }
+}
+
+void opus_fft_sse(const kiss_fft_state *st,const kiss_fft_cpx *fin,kiss_fft_cpx *fout)
+{
+   opus_fft_impl_sse(st, fin, fout, 0);
+}
+
+void opus_ifft_sse(const kiss_fft_state *st,const kiss_fft_cpx *fin,kiss_fft_cpx *fout)
+{
+   opus_fft_impl_sse(st, fin, fout, 1);
+}
+
+#endif
@@ -0,0 +1,58 @@
+/* Copyright (c) 2014 The WebRTC project authors */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#if !defined(KISS_FFT_SSE_H)
+# define KISS_FFT_SSE_H
+
+# include "cpu_support.h"
+# include "x86cpu.h"
+
+void opus_fft_sse(const kiss_fft_state *cfg,const kiss_fft_cpx *fin,kiss_fft_cpx *fout);
+void opus_ifft_sse(const kiss_fft_state *cfg,const kiss_fft_cpx *fin,kiss_fft_cpx *fout);
+
+# define OVERRIDE_OPUS_FFT
+# if defined(OPUS_X86_PRESUME_SSE)
+#  define opus_fft(_cfg, _fin, _fout, arch) \
+   ((void)(arch), opus_fft_sse(_cfg, _fin, _fout))
+#  define opus_ifft(_cfg, _fin, _fout, arch) \
+   ((void)(arch), opus_ifft_sse(_cfg, _fin, _fout))
+# elif defined(OPUS_HAVE_RTCD)
+extern void (*const OPUS_FFT_IMPL[OPUS_ARCHMASK+1])(const kiss_fft_state *,
+      const kiss_fft_cpx *, kiss_fft_cpx *);
+extern void (*const OPUS_IFFT_IMPL[OPUS_ARCHMASK+1])(const kiss_fft_state *,
+      const kiss_fft_cpx *, kiss_fft_cpx *);
+#  define opus_fft(_cfg, _fin, _fout, arch) \
+   ((*OPUS_FFT_IMPL[(arch)&OPUS_ARCHMASK])(_cfg, _fin, _fout))
+#  define opus_ifft(_cfg, _fin, _fout, arch) \
+   ((*OPUS_IFFT_IMPL[(arch)&OPUS_ARCHMASK])(_cfg, _fin, _fout))
+# else
+#  define opus_fft(_cfg, _fin, _fout, arch) \
+   ((void)(arch), opus_fft_c(_cfg, _fin, _fout))
+#  define opus_ifft(_cfg, _fin, _fout, arch) \
+   ((void)(arch), opus_ifft_c(_cfg, _fin, _fout))
+# endif
+
+#endif
@@ -0,0 +1,408 @@
+/* Copyright (c) 2014 The WebRTC project authors */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef SKIP_CONFIG_H
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#endif
+
+#include "mdct.h"
+#include "kiss_fft.h"
+#include "_kiss_fft_guts.h"
+#include "os_support.h"
+#include "mathops.h"
+#include "stack_alloc.h"
+
+#if defined(OPUS_X86_MAY_HAVE_SSE) && !defined(FIXED_POINT)
+
+#include <xmmintrin.h>
+
+/* SSE versions of clt_mdct_forward_c() and clt_mdct_backward_c(). The
+   rotations, the copy part of the fold and the TDAC mirror work on four
+   points at a time and the FFTs are opus_fft_sse() and opus_ifft_sse(). The
+   arithmetic is done in the same order as in mdct.c, so the output is
+   bit-exact with the C version. */
+
+#define SIGN_MASK _mm_set1_ps(-0.f)
+
+/* Returns (t[i], t[i+step], t[i+2*step], t[i+3*step]). */
+static OPUS_INLINE __m128 gather4(const kiss_twiddle_scalar *t, int i, int step)
+{
+   return _mm_set_ps(t[i+3*step], t[i+2*step], t[i+step], t[i]);
+}
+
+/* Returns (x[0], x[-1], x[-2], x[-3]). */
+static OPUS_INLINE __m128 load_reversed(const float *x)
+{
+   __m128 v = _mm_loadu_ps(x-3);
+   return _mm_shuffle_ps(v, v, _MM_SHUFFLE(0,1,2,3));
+}
+
+/* Stores (v0, v1, v2, v3) to x[0], x[-1], x[-2], x[-3]. */
+static OPUS_INLINE void store_reversed(float *x, __m128 v)
+{
+   _mm_storeu_ps(x-3, _mm_shuffle_ps(v, v, _MM_SHUFFLE(0,1,2,3)));
+}
+
+void clt_mdct_forward_sse(const mdct_lookup *l, kiss_fft_scalar *in, kiss_fft_scalar * OPUS_RESTRICT out,
+      const opus_val16 *window, int overlap, int shift, int stride)
+{
+   int i;
+   int N, N2, N4;
+   kiss_twiddle_scalar sine;
+   VARDECL(kiss_fft_scalar, f);
+   VARDECL(kiss_fft_scalar, f2);
+   SAVE_STACK;
+   N = l->n;
+   N >>= shift;
+   N2 = N>>1;
+   N4 = N>>2;
+   ALLOC(f, N2, kiss_fft_scalar);
+   ALLOC(f2, N2, kiss_fft_scalar);
+   /* sin(x) ~= x here */
+   sine = (kiss_twiddle_scalar)2*PI*(.125f)/N;
+
+   /* Consider the input to be composed of four blocks: [a, b, c, d] */
+   /* Window, shuffle, fold */
+   {
+      const kiss_fft_scalar * OPUS_RESTRICT xp1 = in+(overlap>>1);
+      const kiss_fft_scalar * OPUS_RESTRICT xp2 = in+N2-1+(overlap>>1);
+      kiss_fft_scalar * OPUS_RESTRICT yp = f;
+      const opus_val16 * OPUS_RESTRICT wp1 = window+(overlap>>1);
+      const opus_val16 * OPUS_RESTRICT wp2 = window+(overlap>>1)-1;
+      int end;
+      for(i=0;i<((overlap+3)>>2);i++)
+      {
+         /* Real part arranged as -d-cR, Imag part arranged as -b+aR*/
+         *yp++ = MULT16_32_Q15(*wp2, xp1[N2]) + MULT16_32_Q15(*wp1,*xp2);
+         *yp++ = MULT16_32_Q15(*wp1, *xp1)    - MULT16_32_Q15(*wp2, xp2[-N2]);
+         xp1+=2;
+         xp2-=2;
+         wp1+=2;
+         wp2-=2;
+      }
+      wp1 = window;
+      wp2 = window+overlap-1;
+      end = N4-((overlap+3)>>2);
+      for(;i+4<=end;i+=4)
+      {
+         /* Real part arranged as a-bR, Imag part arranged as -c-dR */
+         __m128 a, b, re, im;
+         a = _mm_loadu_ps(xp2-7);
+         b = _mm_loadu_ps(xp2-3);
+         re = _mm_shuffle_ps(b, a, _MM_SHUFFLE(1,3,1,3));
+         a = _mm_loadu_ps(xp1);
+         b = _mm_loadu_ps(xp1+4);
+         im = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2,0,2,0));
+         _mm_storeu_ps(yp, _mm_unpacklo_ps(re, im));
+         _mm_storeu_ps(yp+4, _mm_unpackhi_ps(re, im));
+         yp+=8;
+         xp1+=8;
+         xp2-=8;
+      }
+      for(;i<end;i++)
+      {
+         *yp++ = *xp2;
+         *yp++ = *xp1;
+         xp1+=2;
+         xp2-=2;
+      }
+      for(;i<N4;i++)
+      {
+         /* Real part arranged as a-bR, Imag part arranged as -c-dR */
+         *yp++ =  -MULT16_32_Q15(*wp1, xp1[-N2]) + MULT16_32_Q15(*wp2, *xp2);
+         *yp++ = MULT16_32_Q15(*wp2, *xp1)     + MULT16_32_Q15(*wp1, xp2[N2]);
+         xp1+=2;
+         xp2-=2;
+         wp1+=2;
+         wp2-=2;
+      }
+   }
+   /* Pre-rotation */
+   {
+      kiss_fft_scalar * OPUS_RESTRICT yp = f;
+      const kiss_twiddle_scalar *t = &l->trig[0];
+      const __m128 vsine = _mm_set1_ps(sine);
+      for(i=0;i+4<=N4;i+=4)
+      {
+         __m128 a, b, re, im, t0, t1, yr, yi;
+         a = _mm_loadu_ps(yp);
+         b = _mm_loadu_ps(yp+4);
+         re = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2,0,2,0));
+         im = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3,1,3,1));
+         t0 = gather4(t, i<<shift, 1<<shift);
+         t1 = gather4(t, (N4-i)<<shift, -(1<<shift));
+         yr = _mm_sub_ps(_mm_xor_ps(_mm_mul_ps(re, t0), SIGN_MASK),
+               _mm_mul_ps(im, t1));
+         yi = _mm_add_ps(_mm_xor_ps(_mm_mul_ps(im, t0), SIGN_MASK),
+               _mm_mul_ps(re, t1));
+         /* works because the cos is nearly one */
+         a = _mm_add_ps(yr, _mm_mul_ps(yi, vsine));
+         b = _mm_sub_ps(yi, _mm_mul_ps(yr, vsine));
+         _mm_storeu_ps(yp, _mm_unpacklo_ps(a, b));
+         _mm_storeu_ps(yp+4, _mm_unpackhi_ps(a, b));
+         yp += 8;
+      }
+      for(;i<N4;i++)
+      {
+         kiss_fft_scalar re, im, yr, yi;
+         re = yp[0];
+         im = yp[1];
+         yr = -S_MUL(re,t[i<<shift])  -  S_MUL(im,t[(N4-i)<<shift]);
+         yi = -S_MUL(im,t[i<<shift])  +  S_MUL(re,t[(N4-i)<<shift]);
+         /* works because the cos is nearly one */
+         *yp++ = yr + S_MUL(yi,sine);
+         *yp++ = yi - S_MUL(yr,sine);
+      }
+   }
+
+   /* N/4 complex FFT, down-scales by 4/N */
+   opus_fft_sse(l->kfft[shift], (kiss_fft_cpx *)f, (kiss_fft_cpx *)f2);
+
+   /* Post-rotate */
+   {
+      const kiss_fft_scalar * OPUS_RESTRICT fp = f2;
+      kiss_fft_scalar * OPUS_RESTRICT yp1 = out;
+      kiss_fft_scalar * OPUS_RESTRICT yp2 = out+stride*(N2-1);
+      const kiss_twiddle_scalar *t = &l->trig[0];
+      const __m128 vsine = _mm_set1_ps(sine);
+      for(i=0;i+4<=N4;i+=4)
+      {
+         __m128 a, b, re, im, t0, t1, yr, yi;
+         float o1[4], o2[4];
+         int k;
+         a = _mm_loadu_ps(fp);
+         b = _mm_loadu_ps(fp+4);
+         re = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2,0,2,0));
+         im = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3,1,3,1));
+         t0 = gather4(t, i<<shift, 1<<shift);
+         t1 = gather4(t, (N4-i)<<shift, -(1<<shift));
+         yr = _mm_add_ps(_mm_mul_ps(im, t1), _mm_mul_ps(re, t0));
+         yi = _mm_sub_ps(_mm_mul_ps(re, t1), _mm_mul_ps(im, t0));
+         /* works because the cos is nearly one */
+         a = _mm_sub_ps(yr, _mm_mul_ps(yi, vsine));
+         b = _mm_add_ps(yi, _mm_mul_ps(yr, vsine));
+         _mm_storeu_ps(o1, a);
+         _mm_storeu_ps(o2, b);
+         for (k=0;k<4;k++)
+         {
+            *yp1 = o1[k];
+            *yp2 = o2[k];
+            yp1 += 2*stride;
+            yp2 -= 2*stride;
+         }
+         fp += 8;
+      }
+      for(;i<N4;i++)
+      {
+         kiss_fft_scalar yr, yi;
+         yr = S_MUL(fp[1],t[(N4-i)<<shift]) + S_MUL(fp[0],t[i<<shift]);
+         yi = S_MUL(fp[0],t[(N4-i)<<shift]) - S_MUL(fp[1],t[i<<shift]);
+         /* works because the cos is nearly one */
+         *yp1 = yr - S_MUL(yi,sine);
+         *yp2 = yi + S_MUL(yr,sine);
+         fp += 2;
+         yp1 += 2*stride;
+         yp2 -= 2*stride;
+      }
+   }
+   RESTORE_STACK;
+}
+
+void clt_mdct_backward_sse(const mdct_lookup *l, kiss_fft_scalar *in, kiss_fft_scalar * OPUS_RESTRICT out,
+      const opus_val16 * OPUS_RESTRICT window, int overlap, int shift, int stride)
+{
+   int i;
+   int N, N2, N4;
+   kiss_twiddle_scalar sine;
+   VARDECL(kiss_fft_scalar, f2);
+   SAVE_STACK;
+   N = l->n;
+   N >>= shift;
+   N2 = N>>1;
+   N4 = N>>2;
+   ALLOC(f2, N2, kiss_fft_scalar);
+   /* sin(x) ~= x here */
+   sine = (kiss_twiddle_scalar)2*PI*(.125f)/N;
+
+   /* Pre-rotate */
+   {
+      const kiss_fft_scalar * OPUS_RESTRICT xp1 = in;
+      const kiss_fft_scalar * OPUS_RESTRICT xp2 = in+stride*(N2-1);
+      kiss_fft_scalar * OPUS_RESTRICT yp = f2;
+      const kiss_twiddle_scalar *t = &l->trig[0];
+      const __m128 vsine = _mm_set1_ps(sine);
+      for(i=0;i+4<=N4;i+=4)
+      {
+         __m128 x1, x2, t0, t1, yr, yi, a, b;
+         x1 = gather4(xp1, 0, 2*stride);
+         x2 = gather4(xp2, 0, -2*stride);
+         t0 = gather4(t, i<<shift, 1<<shift);
+         t1 = gather4(t, (N4-i)<<shift, -(1<<shift));
+         yr = _mm_add_ps(_mm_xor_ps(_mm_mul_ps(x2, t0), SIGN_MASK),
+               _mm_mul_ps(x1, t1));
+         yi = _mm_sub_ps(_mm_xor_ps(_mm_mul_ps(x2, t1), SIGN_MASK),
+               _mm_mul_ps(x1, t0));
+         /* works because the cos is nearly one */
+         a = _mm_sub_ps(yr, _mm_mul_ps(yi, vsine));
+         b = _mm_add_ps(yi, _mm_mul_ps(yr, vsine));
+         _mm_storeu_ps(yp, _mm_unpacklo_ps(a, b));
+         _mm_storeu_ps(yp+4, _mm_unpackhi_ps(a, b));
+         yp += 8;
+         xp1 += 8*stride;
+         xp2 -= 8*stride;
+      }
+      for(;i<N4;i++)
+      {
+         kiss_fft_scalar yr, yi;
+         yr = -S_MUL(*xp2, t[i<<shift]) + S_MUL(*xp1,t[(N4-i)<<shift]);
+         yi =  -S_MUL(*xp2, t[(N4-i)<<shift]) - S_MUL(*xp1,t[i<<shift]);
+         /* works because the cos is nearly one */
+         *yp++ = yr - S_MUL(yi,sine);
+         *yp++ = yi + S_MUL(yr,sine);
+         xp1+=2*stride;
+         xp2-=2*stride;
+      }
+   }
+
+   /* Inverse N/4 complex FFT. This one should *not* downscale even in fixed-point */
+   opus_ifft_sse(l->kfft[shift], (kiss_fft_cpx *)f2, (kiss_fft_cpx *)(out+(overlap>>1)));
+
+   /* Post-rotate and de-shuffle from both ends of the buffer at once to make
+      it in-place. Four pairs from each end are done at a time; the pairs of
+      different iterations never overlap, so the result is the same as doing
+      them one by one. */
+   {
+      kiss_fft_scalar * OPUS_RESTRICT yp0 = out+(overlap>>1);
+      kiss_fft_scalar * OPUS_RESTRICT yp1 = out+(overlap>>1)+N2-2;
+      const kiss_twiddle_scalar *t = &l->trig[0];
+      const __m128 vsine = _mm_set1_ps(sine);
+      const int end = (N4+1)>>1;
+      for(i=0;i+4<=end;i+=4)
+      {
+         __m128 a, b, re0, im0, re1, im1, t0, t1, yr, yi;
+         __m128 out0r, out0i, out1r, out1i;
+         a = _mm_loadu_ps(yp0);
+         b = _mm_loadu_ps(yp0+4);
+         re0 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2,0,2,0));
+         im0 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3,1,3,1));
+         a = _mm_loadu_ps(yp1-6);
+         b = _mm_loadu_ps(yp1-2);
+         re1 = _mm_shuffle_ps(b, a, _MM_SHUFFLE(0,2,0,2));
+         im1 = _mm_shuffle_ps(b, a, _MM_SHUFFLE(1,3,1,3));
+
+         t0 = gather4(t, i<<shift, 1<<shift);
+         t1 = gather4(t, (N4-i)<<shift, -(1<<shift));
+         /* We'd scale up by 2 here, but instead it's done when mixing the windows */
+         yr = _mm_sub_ps(_mm_mul_ps(re0, t0), _mm_mul_ps(im0, t1));
+         yi = _mm_add_ps(_mm_mul_ps(im0, t0), _mm_mul_ps(re0, t1));
+         /* works because the cos is nearly one */
+         out0r = _mm_xor_ps(_mm_sub_ps(yr, _mm_mul_ps(yi, vsine)), SIGN_MASK);
+         out1i = _mm_add_ps(yi, _mm_mul_ps(yr, vsine));
+
+         t0 = gather4(t, (N4-i-1)<<shift, -(1<<shift));
+         t1 = gather4(t, (i+1)<<shift, 1<<shift);
+         yr = _mm_sub_ps(_mm_mul_ps(re1, t0), _mm_mul_ps(im1, t1));
+         yi = _mm_add_ps(_mm_mul_ps(im1, t0), _mm_mul_ps(re1, t1));
+         out1r = _mm_xor_ps(_mm_sub_ps(yr, _mm_mul_ps(yi, vsine)), SIGN_MASK);
+         out0i = _mm_add_ps(yi, _mm_mul_ps(yr, vsine));
+
+         _mm_storeu_ps(yp0, _mm_unpacklo_ps(out0r, out0i));
+         _mm_storeu_ps(yp0+4, _mm_unpackhi_ps(out0r, out0i));
+         a = _mm_unpackhi_ps(out1r, out1i);
+         b = _mm_unpacklo_ps(out1r, out1i);
+         _mm_storeu_ps(yp1-6, _mm_shuffle_ps(a, a, _MM_SHUFFLE(1,0,3,2)));
+         _mm_storeu_ps(yp1-2, _mm_shuffle_ps(b, b, _MM_SHUFFLE(1,0,3,2)));
+         yp0 += 8;
+         yp1 -= 8;
+      }
+      for(;i<end;i++)
+      {
+         kiss_fft_scalar re, im, yr, yi;
+         kiss_twiddle_scalar t0, t1;
+         re = yp0[0];
+         im = yp0[1];
+         t0 = t[i<<shift];
+         t1 = t[(N4-i)<<shift];
+         /* We'd scale up by 2 here, but instead it's done when mixing the windows */
+         yr = S_MUL(re,t0) - S_MUL(im,t1);
+         yi = S_MUL(im,t0) + S_MUL(re,t1);
+         re = yp1[0];
+         im = yp1[1];
+         /* works because the cos is nearly one */
+         yp0[0] = -(yr - S_MUL(yi,sine));
+         yp1[1] = yi + S_MUL(yr,sine);
+
+         t0 = t[(N4-i-1)<<shift];
+         t1 = t[(i+1)<<shift];
+         /* We'd scale up by 2 here, but instead it's done when mixing the windows */
+         yr = S_MUL(re,t0) - S_MUL(im,t1);
+         yi = S_MUL(im,t0) + S_MUL(re,t1);
+         /* works because the cos is nearly one */
+         yp1[0] = -(yr - S_MUL(yi,sine));
+         yp0[1] = yi + S_MUL(yr,sine);
+         yp0 += 2;
+         yp1 -= 2;
+      }
+   }
+
+   /* Mirror on both sides for TDAC */
+   {
+      kiss_fft_scalar * OPUS_RESTRICT xp1 = out+overlap-1;
+      kiss_fft_scalar * OPUS_RESTRICT yp1 = out;
+      const opus_val16 * OPUS_RESTRICT wp1 = window;
+      const opus_val16 * OPUS_RESTRICT wp2 = window+overlap-1;
+
+      for(i = 0; i+4 <= overlap/2; i+=4)
+      {
+         __m128 x1, x2, w1, w2;
+         x1 = load_reversed(xp1);
+         x2 = _mm_loadu_ps(yp1);
+         w1 = _mm_loadu_ps(wp1);
+         w2 = load_reversed(wp2);
+         _mm_storeu_ps(yp1, _mm_sub_ps(_mm_mul_ps(w2, x2), _mm_mul_ps(w1, x1)));
+         store_reversed(xp1, _mm_add_ps(_mm_mul_ps(w1, x2), _mm_mul_ps(w2, x1)));
+         yp1 += 4;
+         xp1 -= 4;
+         wp1 += 4;
+         wp2 -= 4;
+      }
+      for(; i < overlap/2; i++)
+      {
+         kiss_fft_scalar x1, x2;
+         x1 = *xp1;
+         x2 = *yp1;
+         *yp1++ = MULT16_32_Q15(*wp2, x2) - MULT16_32_Q15(*wp1, x1);
+         *xp1-- = MULT16_32_Q15(*wp1, x2) + MULT16_32_Q15(*wp2, x1);
+         wp1++;
+         wp2--;
+      }
+   }
+   RESTORE_STACK;
+}
+
+#endif
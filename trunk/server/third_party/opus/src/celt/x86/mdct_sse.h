@@ -0,0 +1,64 @@
+/* Copyright (c) 2014 The WebRTC project authors */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#if !defined(MDCT_SSE_H)
+# define MDCT_SSE_H
+
+# include "cpu_support.h"
+# include "x86cpu.h"
+
+void clt_mdct_forward_sse(const mdct_lookup *l, kiss_fft_scalar *in,
+      kiss_fft_scalar * OPUS_RESTRICT out,
+      const opus_val16 *window, int overlap, int shift, int stride);
+void clt_mdct_backward_sse(const mdct_lookup *l, kiss_fft_scalar *in,
+      kiss_fft_scalar * OPUS_RESTRICT out,
+      const opus_val16 * OPUS_RESTRICT window, int overlap, int shift, int stride);
+
+# define OVERRIDE_OPUS_MDCT
+# if defined(OPUS_X86_PRESUME_SSE)
+#  define clt_mdct_forward(_l, _in, _out, _window, _overlap, _shift, _stride, arch) \
+   ((void)(arch), clt_mdct_forward_sse(_l, _in, _out, _window, _overlap, _shift, _stride))
+#  define clt_mdct_backward(_l, _in, _out, _window, _overlap, _shift, _stride, arch) \
+   ((void)(arch), clt_mdct_backward_sse(_l, _in, _out, _window, _overlap, _shift, _stride))
+# elif defined(OPUS_HAVE_RTCD)
+extern void (*const CLT_MDCT_FORWARD_IMPL[OPUS_ARCHMASK+1])(const mdct_lookup *,
+      kiss_fft_scalar *, kiss_fft_scalar *, const opus_val16 *, int, int, int);
+extern void (*const CLT_MDCT_BACKWARD_IMPL[OPUS_ARCHMASK+1])(const mdct_lookup *,
+      kiss_fft_scalar *, kiss_fft_scalar *, const opus_val16 *, int, int, int);
+#  define clt_mdct_forward(_l, _in, _out, _window, _overlap, _shift, _stride, arch) \
+   ((*CLT_MDCT_FORWARD_IMPL[(arch)&OPUS_ARCHMASK])(_l, _in, _out, \
+         _window, _overlap, _shift, _stride))
+#  define clt_mdct_backward(_l, _in, _out, _window, _overlap, _shift, _stride, arch) \
+   ((*CLT_MDCT_BACKWARD_IMPL[(arch)&OPUS_ARCHMASK])(_l, _in, _out, \
+         _window, _overlap, _shift, _stride))
+# else
+#  define clt_mdct_forward(_l, _in, _out, _window, _overlap, _shift, _stride, arch) \
+   ((void)(arch), clt_mdct_forward_c(_l, _in, _out, _window, _overlap, _shift, _stride))
+#  define clt_mdct_backward(_l, _in, _out, _window, _overlap, _shift, _stride, arch) \
+   ((void)(arch), clt_mdct_backward_c(_l, _in, _out, _window, _overlap, _shift, _stride))
+# endif
+
+#endif
@@ -0,0 +1,97 @@
+/* Copyright (c) 2014 The WebRTC project authors */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "x86/x86cpu.h"
+#include "kiss_fft.h"
+#include "mdct.h"
+#include "pitch.h"
+#include "vq.h"
+
+#if defined(OPUS_HAVE_RTCD) && defined(OPUS_X86_MAY_HAVE_SSE)
+
+# if defined(FIXED_POINT)
+opus_val32 (*const CELT_PITCH_XCORR_IMPL[OPUS_ARCHMASK+1])(const opus_val16 *,
+    const opus_val16 *, opus_val32 *, int , int) = {
+  celt_pitch_xcorr_c,              /* C */
+  celt_pitch_xcorr_c,              /* SSE */
+  celt_pitch_xcorr_c,              /* SSE2 */
+  celt_pitch_xcorr_c               /* unused */
+};
+# else
+void (*const CELT_PITCH_XCORR_IMPL[OPUS_ARCHMASK+1])(const opus_val16 *,
+    const opus_val16 *, opus_val32 *, int , int) = {
+  celt_pitch_xcorr_c,              /* C */
+  MAY_HAVE_SSE(celt_pitch_xcorr),  /* SSE */
+  MAY_HAVE_SSE(celt_pitch_xcorr),  /* SSE2 */
+  MAY_HAVE_SSE(celt_pitch_xcorr)   /* unused */
+};
+
+void (*const OPUS_FFT_IMPL[OPUS_ARCHMASK+1])(const kiss_fft_state *,
+    const kiss_fft_cpx *, kiss_fft_cpx *) = {
+  opus_fft_c,                      /* C */
+  MAY_HAVE_SSE(opus_fft),          /* SSE */
+  MAY_HAVE_SSE(opus_fft),          /* SSE2 */
+  MAY_HAVE_SSE(opus_fft)           /* unused */
+};
+
+void (*const OPUS_IFFT_IMPL[OPUS_ARCHMASK+1])(const kiss_fft_state *,
+    const kiss_fft_cpx *, kiss_fft_cpx *) = {
+  opus_ifft_c,                     /* C */
+  MAY_HAVE_SSE(opus_ifft),         /* SSE */
+  MAY_HAVE_SSE(opus_ifft),         /* SSE2 */
+  MAY_HAVE_SSE(opus_ifft)          /* unused */
+};
+
+void (*const CLT_MDCT_FORWARD_IMPL[OPUS_ARCHMASK+1])(const mdct_lookup *,
+    kiss_fft_scalar *, kiss_fft_scalar *, const opus_val16 *, int, int, int) = {
+  clt_mdct_forward_c,              /* C */
+  MAY_HAVE_SSE(clt_mdct_forward),  /* SSE */
+  MAY_HAVE_SSE(clt_mdct_forward),  /* SSE2 */
+  MAY_HAVE_SSE(clt_mdct_forward)   /* unused */
+};
+
+void (*const CLT_MDCT_BACKWARD_IMPL[OPUS_ARCHMASK+1])(const mdct_lookup *,
+    kiss_fft_scalar *, kiss_fft_scalar *, const opus_val16 *, int, int, int) = {
+  clt_mdct_backward_c,             /* C */
+  MAY_HAVE_SSE(clt_mdct_backward), /* SSE */
+  MAY_HAVE_SSE(clt_mdct_backward), /* SSE2 */
+  MAY_HAVE_SSE(clt_mdct_backward)  /* unused */
+};
+
+opus_val16 (*const OP_PVQ_SEARCH_IMPL[OPUS_ARCHMASK+1])(celt_norm *,
+    int *, int, int) = {
+  op_pvq_search_c,                 /* C */
+  MAY_HAVE_SSE(op_pvq_search),     /* SSE */
+  MAY_HAVE_SSE(op_pvq_search),     /* SSE2 */
+  MAY_HAVE_SSE(op_pvq_search)      /* unused */
+};
+# endif
+
+#endif
@@ -36,4 +36,8 @@ celt/arm/fixed_armv5e.h \
 celt/arm/kiss_fft_armv4.h \
 celt/arm/kiss_fft_armv5e.h \
 celt/arm/pitch_arm.h \
-celt/x86/pitch_sse.h
+celt/x86/kiss_fft_sse.h \
+celt/x86/mdct_sse.h \
+celt/x86/pitch_sse.h \
+celt/x86/vq_sse.h \
+celt/x86/x86cpu.h
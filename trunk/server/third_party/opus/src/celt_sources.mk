@@ -21,6 +21,14 @@ CELT_SOURCES_ARM = \
 celt/arm/armcpu.c \
 celt/arm/arm_celt_map.c
 
+CELT_SOURCES_X86 = \
+celt/x86/x86cpu.c \
+celt/x86/x86_celt_map.c \
+celt/x86/pitch_sse.c \
+celt/x86/kiss_fft_sse.c \
+celt/x86/mdct_sse.c \
+celt/x86/vq_sse.c
+
 CELT_SOURCES_ARM_ASM = \
 celt/arm/celt_pitch_xcorr_arm.s
 
@@ -0,0 +1,73 @@
+/***********************************************************************
+Copyright (c) 2014, The WebRTC project authors. All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+- Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+- Neither the name of Internet Society, IETF or IETF Trust, nor the
+names of specific contributors, may be used to endorse or promote
+products derived from this software without specific prior written
+permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+***********************************************************************/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "SigProc_FLP.h"
+
+#if defined(OPUS_X86_MAY_HAVE_SSE2)
+
+#include <emmintrin.h>
+
+/* Version of silk_inner_product_FLP_c() for x86 with SSE2. The products  */
+/* are exact in double precision, but they are summed in two interleaved  */
+/* accumulators of two lanes each, so the result can differ from the C    */
+/* version in the last bits.                                              */
+double silk_inner_product_FLP_sse2(
+    const silk_float    *data1,
+    const silk_float    *data2,
+    opus_int            dataSize
+)
+{
+    opus_int i;
+    double   result;
+    __m128d  acc0, acc1;
+
+    acc0 = _mm_setzero_pd();
+    acc1 = _mm_setzero_pd();
+    for( i = 0; i < dataSize - 3; i += 4 ) {
+        __m128 x = _mm_loadu_ps( &data1[ i ] );
+        __m128 y = _mm_loadu_ps( &data2[ i ] );
+        acc0 = _mm_add_pd( acc0, _mm_mul_pd( _mm_cvtps_pd( x ), _mm_cvtps_pd( y ) ) );
+        acc1 = _mm_add_pd( acc1, _mm_mul_pd( _mm_cvtps_pd( _mm_movehl_ps( x, x ) ),
+                                             _mm_cvtps_pd( _mm_movehl_ps( y, y ) ) ) );
+    }
+    acc0 = _mm_add_pd( acc0, acc1 );
+    acc0 = _mm_add_sd( acc0, _mm_unpackhi_pd( acc0, acc0 ) );
+    result = _mm_cvtsd_f64( acc0 );
+
+    /* add any remaining products */
+    for( ; i < dataSize; i++ ) {
+        result += data1[ i ] * (double)data2[ i ];
+    }
+
+    return result;
+}
+
+#endif
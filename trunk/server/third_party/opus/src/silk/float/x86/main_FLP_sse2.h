@@ -0,0 +1,56 @@
+/***********************************************************************
+Copyright (c) 2014, The WebRTC project authors. All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+- Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+- Neither the name of Internet Society, IETF or IETF Trust, nor the
+names of specific contributors, may be used to endorse or promote
+products derived from this software without specific prior written
+permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+***********************************************************************/
+
+#ifndef SILK_MAIN_FLP_SSE2_H
+#define SILK_MAIN_FLP_SSE2_H
+
+#include "cpu_support.h"
+#include "x86/x86cpu.h"
+
+void silk_warped_autocorrelation_FLP_sse2(
+    silk_float                      *corr,
+    const silk_float                *input,
+    const silk_float                warping,
+    const opus_int                  length,
+    const opus_int                  order
+);
+
+#define OVERRIDE_SILK_WARPED_AUTOCORRELATION_FLP
+#if defined(OPUS_X86_PRESUME_SSE2)
+#define silk_warped_autocorrelation_FLP( corr, input, warping, length, order, arch ) \
+    ((void)(arch), silk_warped_autocorrelation_FLP_sse2( corr, input, warping, length, order ))
+#elif defined(OPUS_HAVE_RTCD)
+extern void (*const SILK_WARPED_AUTOCORRELATION_FLP_IMPL[ OPUS_ARCHMASK + 1 ])(
+    silk_float *, const silk_float *, const silk_float, const opus_int, const opus_int );
+#define silk_warped_autocorrelation_FLP( corr, input, warping, length, order, arch ) \
+    ((*SILK_WARPED_AUTOCORRELATION_FLP_IMPL[ (arch) & OPUS_ARCHMASK ])( corr, input, warping, length, order ))
+#else
+#define silk_warped_autocorrelation_FLP( corr, input, warping, length, order, arch ) \
+    ((void)(arch), silk_warped_autocorrelation_FLP_c( corr, input, warping, length, order ))
+#endif
+
+#endif
@@ -0,0 +1,116 @@
+/***********************************************************************
+Copyright (c) 2014, The WebRTC project authors. All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+- Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+- Neither the name of Internet Society, IETF or IETF Trust, nor the
+names of specific contributors, may be used to endorse or promote
+products derived from this software without specific prior written
+permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+***********************************************************************/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "main_FLP.h"
+
+#if defined(OPUS_X86_MAY_HAVE_SSE2)
+
+#include <emmintrin.h>
+
+/* Version of silk_warped_autocorrelation_FLP_c() for x86 with SSE2.          */
+/* In the C version every allpass section waits for the output of the one     */
+/* before it for the same sample, so the loop is bound by the latency of that */
+/* chain. Here section k runs k samples behind section 0, which makes all     */
+/* sections of one step independent of each other; the vector y[ j ] holds    */
+/* sections 2 * j and 2 * j + 1. Each section still does the same operations  */
+/* in the same order as in the C version, so the result is bit-exact.         */
+void silk_warped_autocorrelation_FLP_sse2(
+    silk_float                      *corr,                              /* O    Result [order + 1]                          */
+    const silk_float                *input,                             /* I    Input data to correlate                     */
+    const silk_float                warping,                            /* I    Warping coefficient                         */
+    const opus_int                  length,                             /* I    Length of input                             */
+    const opus_int                  order                               /* I    Correlation order (even)                    */
+)
+{
+    opus_int    n, i, j, nb_vec, last;
+    __m128d     y[ MAX_SHAPE_LPC_ORDER / 2 + 1 ], y_prev[ MAX_SHAPE_LPC_ORDER / 2 + 1 ];
+    __m128d     C[ MAX_SHAPE_LPC_ORDER / 2 + 1 ];
+    __m128d     w, tmp, x;
+    /* Input in reversed order, zero padded on both sides */
+    double      x_rev[ SHAPE_LPC_WIN_MAX + 2 * MAX_SHAPE_LPC_ORDER + 1 ];
+    double      C_out[ MAX_SHAPE_LPC_ORDER + 2 ];
+
+    /* Order must be even */
+    silk_assert( ( order & 1 ) == 0 );
+
+    if( length > SHAPE_LPC_WIN_MAX || order > MAX_SHAPE_LPC_ORDER ) {
+        silk_warped_autocorrelation_FLP_c( corr, input, warping, length, order );
+        return;
+    }
+
+    /* input[ n ] is at x_rev[ last - n ] */
+    last = length - 1 + order;
+    for( i = 0; i < length + 2 * order + 1; i++ ) {
+        x_rev[ i ] = 0;
+    }
+    for( n = 0; n < length; n++ ) {
+        x_rev[ last - n ] = input[ n ];
+    }
+
+    nb_vec = order / 2 + 1;
+    for( j = 0; j < nb_vec; j++ ) {
+        y[ j ] = _mm_setzero_pd();
+        y_prev[ j ] = _mm_setzero_pd();
+        C[ j ] = _mm_setzero_pd();
+    }
+    w = _mm_set1_pd( warping );
+
+    /* In step n, section k computes its output for input sample n - k */
+    for( n = 0; n < length + order; n++ ) {
+        /* Going down, y[ j - 1 ] still holds the outputs of the previous step */
+        for( j = nb_vec - 1; j > 0; j-- ) {
+            /* Inputs of sections 2 * j and 2 * j + 1 */
+            tmp = _mm_shuffle_pd( y[ j - 1 ], y[ j ], 1 );
+            /* Output of allpass section */
+            y[ j ] = _mm_add_pd( y_prev[ j ], _mm_mul_pd( w, _mm_sub_pd( y[ j ], tmp ) ) );
+            y_prev[ j ] = tmp;
+            x = _mm_loadu_pd( &x_rev[ last - n + 2 * j ] );
+            C[ j ] = _mm_add_pd( C[ j ], _mm_mul_pd( x, y[ j ] ) );
+        }
+        /* Section 0 outputs the input itself */
+        tmp = _mm_shuffle_pd( y[ 0 ], y[ 0 ], 0 );
+        y[ 0 ] = _mm_add_pd( y_prev[ 0 ], _mm_mul_pd( w, _mm_sub_pd( y[ 0 ], tmp ) ) );
+        y_prev[ 0 ] = tmp;
+        x = _mm_loadu_pd( &x_rev[ last - n ] );
+        y[ 0 ] = _mm_move_sd( y[ 0 ], x );
+        C[ 0 ] = _mm_add_pd( C[ 0 ], _mm_mul_pd( x, y[ 0 ] ) );
+    }
+
+    /* Copy correlations in silk_float output format */
+    for( j = 0; j < nb_vec; j++ ) {
+        _mm_storeu_pd( &C_out[ 2 * j ], C[ j ] );
+    }
+    for( i = 0; i < order + 1; i++ ) {
+        corr[ i ] = ( silk_float )C_out[ i ];
+    }
+}
+
+#endif
@@ -0,0 +1,139 @@
+/***********************************************************************
+Copyright (c) 2014, The WebRTC project authors. All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+- Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+- Neither the name of Internet Society, IETF or IETF Trust, nor the
+names of specific contributors, may be used to endorse or promote
+products derived from this software without specific prior written
+permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+***********************************************************************/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "main_FLP.h"
+#include "inner_product_FLP.c"
+#include "warped_autocorrelation_FLP.c"
+#if defined(OPUS_X86_MAY_HAVE_SSE2)
+#include "x86/inner_product_FLP_sse2.c"
+#include "x86/warped_autocorrelation_FLP_sse2.c"
+#endif
+
+#define MAX_LENGTH SHAPE_LPC_WIN_MAX
+
+static int ret = 0;
+
+static void fill_random( silk_float *x, int length )
+{
+    int i;
+    for( i = 0; i < length; i++ ) {
+        x[ i ] = ( silk_float )( ( rand() % 65535 ) - 32767 ) * 0.37f;
+    }
+}
+
+/* Without warping the result is the plain autocorrelation */
+static void test_unwarped( int length, int order )
+{
+    silk_float x[ MAX_LENGTH ], corr[ MAX_SHAPE_LPC_ORDER + 1 ];
+    double     ref, energy;
+    int        i, k;
+
+    fill_random( x, length );
+    silk_warped_autocorrelation_FLP_c( corr, x, 0.0f, length, order );
+    energy = silk_inner_product_FLP_c( x, x, length );
+    for( k = 0; k <= order; k++ ) {
+        ref = 0;
+        for( i = k; i < length; i++ ) {
+            ref += x[ i ] * (double)x[ i - k ];
+        }
+        if( fabs( corr[ k ] - ref ) > 1e-6 * energy ) {
+            printf( "** length=%d order=%d lag=%d: %f, expected %f **\n", length, order, k, corr[ k ], ref );
+            ret = 1;
+        }
+    }
+}
+
+#if defined(OPUS_X86_MAY_HAVE_SSE2)
+/* The SSE2 version must be bit-exact with the C version */
+static void test_warped_sse2( int length, int order, silk_float warping )
+{
+    silk_float x[ MAX_LENGTH ];
+    silk_float corr_c[ MAX_SHAPE_LPC_ORDER + 1 ], corr_sse2[ MAX_SHAPE_LPC_ORDER + 1 ];
+
+    fill_random( x, length );
+    silk_warped_autocorrelation_FLP_c( corr_c, x, warping, length, order );
+    silk_warped_autocorrelation_FLP_sse2( corr_sse2, x, warping, length, order );
+    if( memcmp( corr_c, corr_sse2, ( order + 1 ) * sizeof( silk_float ) ) != 0 ) {
+        printf( "** length=%d order=%d warping=%f, SSE2 output differs from C **\n", length, order, warping );
+        ret = 1;
+    }
+}
+
+/* The SSE2 version sums in a different order, so only rounding may differ */
+static void test_inner_product_sse2( int length )
+{
+    silk_float x[ MAX_LENGTH ], y[ MAX_LENGTH ];
+    double     c, sse2, bound;
+    int        i;
+
+    fill_random( x, length );
+    fill_random( y, length );
+    c = silk_inner_product_FLP_c( x, y, length );
+    sse2 = silk_inner_product_FLP_sse2( x, y, length );
+    bound = 0;
+    for( i = 0; i < length; i++ ) {
+        bound += fabs( x[ i ] * (double)y[ i ] );
+    }
+    if( fabs( c - sse2 ) > 1e-13 * bound ) {
+        printf( "** length=%d, SSE2 inner product %f differs from C %f **\n", length, sse2, c );
+        ret = 1;
+    }
+}
+#endif
+
+int main( void )
+{
+    int length, order;
+
+    for( order = 0; order <= MAX_SHAPE_LPC_ORDER; order += 2 ) {
+        test_unwarped( MAX_LENGTH, order );
+    }
+#if defined(OPUS_X86_MAY_HAVE_SSE2)
+    for( length = 1; length <= MAX_LENGTH; length++ ) {
+        for( order = 0; order <= MAX_SHAPE_LPC_ORDER; order += 2 ) {
+            test_warped_sse2( length, order, 0.0f );
+            test_warped_sse2( length, order, 0.25f * ( rand() % 4 + 1 ) / 4 );
+        }
+        test_inner_product_sse2( length );
+    }
+#else
+    (void)length;
+#endif
+    if( ret == 0 ) {
+        printf( "All tests passed\n" );
+    }
+    return ret;
+}
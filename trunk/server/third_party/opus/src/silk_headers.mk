@@ -27,4 +27,6 @@ silk/fixed/main_FIX.h \
 silk/fixed/structs_FIX.h \
 silk/float/main_FLP.h \
 silk/float/structs_FLP.h \
-silk/float/SigProc_FLP.h
+silk/float/SigProc_FLP.h \
+silk/float/x86/main_FLP_sse2.h \
+silk/float/x86/SigProc_FLP_sse2.h
@@ -136,3 +136,8 @@ silk/float/scale_copy_vector_FLP.c \
 silk/float/scale_vector_FLP.c \
 silk/float/schur_FLP.c \
 silk/float/sort_FLP.c
+
+SILK_SOURCES_FLOAT_X86 = \
+silk/float/x86/inner_product_FLP_sse2.c \
+silk/float/x86/warped_autocorrelation_FLP_sse2.c \
+silk/float/x86/x86_silk_FLP_map.c
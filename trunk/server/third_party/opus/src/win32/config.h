@@ -40,6 +40,22 @@ POSSIBILITY OF SUCH DAMAGE.
 #define __SSE__               1
 #endif
 
+/* Build the SSE and SSE2 kernels on x86. They are called directly when the
+   compiler may already assume that instruction set, and are selected from the
+   CPUID flags at run time otherwise. */
+#if !defined(FIXED_POINT) && (defined(_M_IX86) || defined(_M_X64))
+#define OPUS_X86_MAY_HAVE_SSE  1
+#define OPUS_X86_MAY_HAVE_SSE2 1
+#if defined(__SSE__)
+#define OPUS_X86_PRESUME_SSE   1
+#endif
+#if defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define OPUS_X86_PRESUME_SSE2  1
+#else
+#define OPUS_HAVE_RTCD         1
+#endif
+#endif
+
 #include "version.h"
 
 #endif /* CONFIG_H */